@@ -0,0 +1,371 @@
+/**
+ * @file UniversityBench.cpp
+ * @brief Замеры производительности слоев хранилища и моделей
+ *
+ * @class UniversityBench
+ * @brief Набор QBENCHMARK на синтетических данных
+ *
+ * Перед замерами хранилище заполняется детерминированным набором студентов
+ * с русскими ФИО: генератор инициализируется постоянным зерном, поэтому
+ * каждый запуск работает с одинаковыми данными. Замеряются:
+ * - getAllStudents() хранилища
+ * - reload() модели StudentListModel — то, что выполняет
+ *   UniversityViewModel::refresh() для каждого списка
+ * - форматирование toString() всех записей
+ * - задержка добавления и удаления одной записи
+ *
+ * Набор данных задается переменными окружения:
+ * - UNIVERSITY_BENCH_STORAGE — хранилище в формате UNIVERSITY_DB_STORAGE
+ *   (memory, sqlite или sqlite:путь), по умолчанию memory
+ * - UNIVERSITY_BENCH_ROWS — количество студентов (10000, 100000, 1000000),
+ *   по умолчанию 10000
+ * - UNIVERSITY_BENCH_RESULTS — файл для результатов в JSON,
+ *   по умолчанию university_db_bench.json в текущей директории
+ *
+ * Пиковый объем резидентной памяти монотонен в пределах процесса, поэтому
+ * каждый набор данных запускается отдельным процессом.
+ *
+ * @note Цель собирается только с -DUNIVERSITY_BUILD_BENCH=ON и не входит в ctest
+ */
+
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPromise>
+#include <QRandomGenerator>
+#include <QSysInfo>
+
+#include "DatabaseManager.h"
+#include "StorageBackend.h"
+#include "StudentListModel.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Зерно генератора синтетических данных
+ */
+static const quint32 DATASET_SEED = 20240901;
+
+/**
+ * @brief Размер пакета при заполнении хранилища
+ */
+static const int SEED_BATCH_SIZE = 10000;
+
+/**
+ * @brief Получить пиковый объем резидентной памяти процесса
+ * @return qint64 Килобайты или -1, если платформа не поддерживается
+ */
+static qint64 peakRssKb()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MACOS
+        // На macOS ru_maxrss в байтах
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief Сгенерировать детерминированный набор студентов
+ * @param count Количество записей
+ * @return QList<StudentRecord> Записи без id
+ *
+ * @details Мужские и женские ФИО собираются из согласованных по роду частей,
+ * оценки распределены от 2 до 5
+ */
+static QList<StudentRecord> generateStudents(int count)
+{
+    static const QStringList maleSurnames = {
+        "Иванов", "Смирнов", "Кузнецов", "Попов", "Васильев", "Петров",
+        "Соколов", "Михайлов", "Новиков", "Федоров", "Морозов", "Волков",
+        "Алексеев", "Лебедев", "Семёнов", "Егоров", "Павлов", "Козлов",
+        "Степанов", "Николаев", "Орлов", "Андреев", "Макаров", "Никитин"
+    };
+    static const QStringList maleNames = {
+        "Александр", "Дмитрий", "Максим", "Сергей", "Андрей", "Алексей",
+        "Артём", "Илья", "Кирилл", "Михаил", "Никита", "Матвей", "Роман",
+        "Егор", "Арсений", "Иван", "Денис", "Евгений", "Тимофей", "Владимир"
+    };
+    static const QStringList femaleNames = {
+        "Анастасия", "Мария", "Анна", "Виктория", "Екатерина", "Наталья",
+        "Марина", "Полина", "София", "Дарья", "Алиса", "Ксения", "Александра",
+        "Елена", "Ольга", "Татьяна", "Юлия", "Алёна", "Вероника", "Ирина"
+    };
+    static const QStringList patronymicStems = {
+        "Александров", "Дмитриев", "Сергеев", "Андреев", "Алексеев",
+        "Михайлов", "Иванов", "Николаев", "Владимиров", "Евгеньев",
+        "Петров", "Викторов", "Олегов", "Юрьев", "Павлов", "Романов"
+    };
+
+    QRandomGenerator random(DATASET_SEED);
+    QList<StudentRecord> records;
+    records.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const bool female = random.bounded(2) == 1;
+        const QString &surname = maleSurnames.at(random.bounded(maleSurnames.size()));
+        const QString &stem = patronymicStems.at(random.bounded(patronymicStems.size()));
+
+        StudentRecord record;
+        if (female) {
+            record.fullName = surname + "а " + femaleNames.at(random.bounded(femaleNames.size()))
+                              + ' ' + stem + "на";
+        } else {
+            record.fullName = surname + ' ' + maleNames.at(random.bounded(maleNames.size()))
+                              + ' ' + stem + "ич";
+        }
+        record.grade = 2 + random.bounded(4);
+        records.append(record);
+    }
+    return records;
+}
+
+/**
+ * @brief Дождаться завершения QFuture, обрабатывая события
+ * @param future Ожидаемый результат
+ *
+ * @details Продолжения .then(context, ...) выполняются через цикл событий
+ * потока модели, поэтому простое ожидание заблокировало бы их
+ */
+static void waitFor(const QFuture<void> &future)
+{
+    while (!future.isFinished()) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+}
+
+class UniversityBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Создать хранилище и заполнить его синтетическими данными
+     */
+    void initTestCase();
+
+    /**
+     * @brief Сохранить результаты в JSON
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Замер чтения всех студентов из хранилища
+     */
+    void getAllStudents();
+
+    /**
+     * @brief Замер полной перезагрузки модели списка
+     */
+    void reloadModel();
+
+    /**
+     * @brief Замер форматирования записей для отображения
+     */
+    void formatRecords();
+
+    /**
+     * @brief Замер добавления и удаления одной записи
+     */
+    void addDeleteLatency();
+
+private:
+    /**
+     * @brief Запомнить результат замера
+     * @param name Название замера
+     * @param iterations Количество итераций QBENCHMARK
+     * @param elapsedNs Суммарное время итераций в наносекундах
+     */
+    void record(const QString &name, int iterations, qint64 elapsedNs);
+
+    DatabaseManager *m_manager = nullptr;   ///< Заполненное хранилище
+    QString m_storageSpec;                  ///< Описание хранилища
+    int m_rows = 0;                         ///< Количество студентов
+    qint64 m_seedMs = 0;                    ///< Время заполнения хранилища
+    qint64 m_seedPeakRssKb = 0;             ///< Пиковая память после заполнения
+    QJsonArray m_results;                   ///< Результаты замеров
+};
+
+/**
+ * @brief Создание хранилища и заполнение его синтетическими данными
+ *
+ * @details Записи вставляются пакетами по SEED_BATCH_SIZE через addStudents(),
+ * как при импорте
+ */
+void UniversityBench::initTestCase()
+{
+    m_storageSpec = qEnvironmentVariable("UNIVERSITY_BENCH_STORAGE", "memory");
+    bool ok = false;
+    m_rows = qEnvironmentVariableIntValue("UNIVERSITY_BENCH_ROWS", &ok);
+    if (!ok || m_rows < 1) {
+        m_rows = 10000;
+    }
+
+    m_manager = new DatabaseManager(StorageBackend::create(m_storageSpec), this);
+    QVERIFY2(m_manager->connectToDatabase(), qPrintable(m_manager->storage()->lastError()));
+
+    const QList<StudentRecord> students = generateStudents(m_rows);
+    QElapsedTimer timer;
+    timer.start();
+    for (qsizetype offset = 0; offset < students.size(); offset += SEED_BATCH_SIZE) {
+        const QList<int> ids = m_manager->addStudents(students.mid(offset, SEED_BATCH_SIZE));
+        QVERIFY2(!ids.isEmpty(), qPrintable(m_manager->storage()->lastError()));
+    }
+    m_seedMs = timer.elapsed();
+    m_seedPeakRssKb = peakRssKb();
+
+    qInfo().noquote() << "Хранилище" << m_manager->storage()->name() << ":" << m_rows
+                      << "студентов за" << m_seedMs << "мс";
+}
+
+/**
+ * @brief Сохранение результатов в JSON
+ */
+void UniversityBench::cleanupTestCase()
+{
+    QJsonObject dataset;
+    dataset["storage"] = m_storageSpec;
+    dataset["rows"] = m_rows;
+    dataset["seed"] = static_cast<qint64>(DATASET_SEED);
+    dataset["seedMs"] = m_seedMs;
+    dataset["seedPeakRssKb"] = m_seedPeakRssKb;
+
+    QJsonObject report;
+    report["dataset"] = dataset;
+    report["platform"] = QSysInfo::prettyProductName();
+    report["qt"] = QString::fromLatin1(qVersion());
+    report["results"] = m_results;
+    report["peakRssKb"] = peakRssKb();
+
+    const QString path = qEnvironmentVariable("UNIVERSITY_BENCH_RESULTS", "university_db_bench.json");
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(QJsonDocument(report).toJson());
+        qInfo().noquote() << "Результаты записаны в" << path;
+    } else {
+        qWarning() << "Не удалось записать результаты в" << path << ":" << file.errorString();
+    }
+
+    delete m_manager;
+    m_manager = nullptr;
+}
+
+/**
+ * @brief Запомнить результат замера
+ * @param name Название замера
+ * @param iterations Количество итераций QBENCHMARK
+ * @param elapsedNs Суммарное время итераций в наносекундах
+ *
+ * @details Среднее считается по всем итерациям, включая прогревочную
+ */
+void UniversityBench::record(const QString &name, int iterations, qint64 elapsedNs)
+{
+    QJsonObject result;
+    result["name"] = name;
+    result["iterations"] = iterations;
+    result["nsPerIteration"] = iterations > 0 ? static_cast<double>(elapsedNs) / iterations : 0.0;
+    result["peakRssKb"] = peakRssKb();
+    m_results.append(result);
+}
+
+/**
+ * @brief Замер чтения всех студентов из хранилища
+ */
+void UniversityBench::getAllStudents()
+{
+    int iterations = 0;
+    qsizetype rows = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        rows = m_manager->getAllStudents().size();
+        ++iterations;
+    }
+    record("getAllStudents", iterations, timer.nsecsElapsed());
+    QCOMPARE(rows, static_cast<qsizetype>(m_rows));
+}
+
+/**
+ * @brief Замер полной перезагрузки модели списка
+ *
+ * @details Размер страницы равен числу строк, поэтому reload() читает
+ * всю таблицу и применяет ее через setRecords(). Первая итерация заполняет
+ * пустую модель, следующие сравнивают совпадающие наборы.
+ */
+void UniversityBench::reloadModel()
+{
+    StudentListModel model;
+    model.setPageLoader([this](int afterId, int limit) {
+        QPromise<QList<StudentRecord>> promise;
+        promise.start();
+        promise.addResult(m_manager->getStudentsPage(afterId, limit));
+        promise.finish();
+        return promise.future();
+    }, m_rows);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        waitFor(model.reload());
+        ++iterations;
+    }
+    record("reloadModel", iterations, timer.nsecsElapsed());
+    QCOMPARE(model.rowCount(), m_rows);
+}
+
+/**
+ * @brief Замер форматирования записей для отображения
+ */
+void UniversityBench::formatRecords()
+{
+    const QList<StudentRecord> students = m_manager->getAllStudents();
+
+    int iterations = 0;
+    qsizetype length = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        length = 0;
+        for (const StudentRecord &student : students) {
+            length += student.toString().size();
+        }
+        ++iterations;
+    }
+    record("formatRecords", iterations, timer.nsecsElapsed());
+    QVERIFY(length > 0);
+}
+
+/**
+ * @brief Замер добавления и удаления одной записи
+ *
+ * @details Каждая итерация добавляет и удаляет запись, поэтому размер
+ * таблицы не меняется между итерациями
+ */
+void UniversityBench::addDeleteLatency()
+{
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        const StudentRecord added = m_manager->addStudent("Тестов Тест Тестович", 4);
+        QVERIFY(added.isValid());
+        QCOMPARE(m_manager->deleteStudent(added.id), added.id);
+        ++iterations;
+    }
+    record("addDeleteLatency", iterations, timer.nsecsElapsed());
+}
+
+QTEST_GUILESS_MAIN(UniversityBench)
+
+#include "UniversityBench.moc"
@@ -22,10 +22,14 @@
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QDebug>
 
+#include "src/models/StartupReport.h"
+#include "src/models/StorageBackend.h"
 #include "src/viewmodels/UniversityViewModel.h"
 
 /**
@@ -38,25 +42,49 @@
  *             - -1: Ошибка загрузки QML интерфейса
  * 
  * @details Выполняет инициализацию приложения:
- * 1. Создает объект QApplication
+ * 1. Создает объект QApplication и разбирает аргументы командной строки
  * 2. Регистрирует типы для QML
  * 3. Создает ViewModel
  * 4. Регистрирует ViewModel в QML контексте
  * 5. Загружает QML интерфейс
  * 6. Запускает главный цикл приложения
  * 
- * @note Для корректной работы требуется:
+ * Подключение к БД не задерживает первый кадр: оно выполняется в рабочем
+ * потоке после запуска цикла событий. Время этапов запуска выводится
+ * в лог после загрузки первых данных (см. StartupReport).
+ * 
+ * Флаг --storage выбирает хранилище: postgres (по умолчанию), sqlite,
+ * sqlite:путь или memory. Без флага используется переменная окружения
+ * UNIVERSITY_DB_STORAGE.
+ * 
+ * @note Для работы с PostgreSQL требуется:
  * - Установленный PostgreSQL
  * - База данных "university"
- * - Таблицы teachers, students, subjects
  */
 int main(int argc, char *argv[])
 {
+    StartupReport::instance().mark("main");
+    
     // Инициализация Qt приложения
     QApplication app(argc, argv);
     
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption storageOption("storage",
+                                     "Хранилище: postgres, sqlite, sqlite:<файл> или memory.",
+                                     "spec");
+    parser.addOption(storageOption);
+    parser.process(app);
+    
+    // Менеджер БД создается в ViewModel и читает выбор из окружения
+    if (parser.isSet(storageOption)) {
+        qputenv(StorageBackend::STORAGE_ENV, parser.value(storageOption).toUtf8());
+    }
+    
     // Регистрируем типы для QML
     qmlRegisterType<UniversityViewModel>("UniversityDB", 1, 0, "UniversityViewModel");
+    qmlRegisterUncreatableType<AsyncDatabaseManager>("UniversityDB", 1, 0, "Database",
+                                                     "Доступны только перечисления");
     
     // Создаем ViewModel
     UniversityViewModel viewModel;
@@ -75,6 +103,13 @@ int main(int argc, char *argv[])
         return -1;
     }
     
+    // Первый кадр отмечается один раз, когда окно уже показано пользователю
+    if (auto *window = qobject_cast<QQuickWindow *>(engine.rootObjects().constFirst())) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, &app, []() {
+            StartupReport::instance().mark("первый кадр");
+        }, static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::SingleShotConnection));
+    }
+    
     qDebug() << "✅ Приложение запущено успешно!";
     return app.exec();
 }
\ No newline at end of file
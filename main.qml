@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Window 2.15
+import QtQuick.Dialogs
 import UniversityDB 1.0
 
 ApplicationWindow {
@@ -15,6 +16,17 @@ ApplicationWindow {
     // Переменная для текущей вкладки
     property int currentTab: 0
     
+    // Таблицы вкладок для импорта
+    readonly property var tableNames: ["teachers", "students", "subjects"]
+    
+    // Выбор файла для импорта в таблицу текущей вкладки
+    FileDialog {
+        id: importDialog
+        title: "Импорт из файла"
+        nameFilters: ["CSV и JSON (*.csv *.json *.ndjson *.jsonl)"]
+        onAccepted: viewModel.importer.start(selectedFile, tableNames[currentTab])
+    }
+    
     // Функция для обновления всех данных
     function refreshAll() {
         viewModel.refresh()
@@ -45,15 +57,48 @@ ApplicationWindow {
                 
                 Item { Layout.fillWidth: true }
                 
+                // Фильтр загруженных строк или поиск по всем таблицам в БД
+                TextField {
+                    id: searchInput
+                    placeholderText: viewModel.searching ? "🔍 Поиск..." : "🔍 Поиск по имени или названию"
+                    Layout.preferredWidth: 280
+                    onTextChanged: applySearch()
+                    
+                    function applySearch() {
+                        viewModel.filterText = serverSearch.checked ? "" : text
+                        viewModel.searchText = serverSearch.checked ? text : ""
+                    }
+                }
+                
+                CheckBox {
+                    id: serverSearch
+                    text: "в БД"
+                    checked: false
+                    onCheckedChanged: searchInput.applySearch()
+                }
+                
                 Rectangle {
-                    width: 120
+                    width: Math.max(160, connectionText.implicitWidth + 20)
                     height: 30
-                    color: viewModel.isConnected ? "#27ae60" : "#e74c3c"
+                    color: viewModel.isConnected ? "#27ae60"
+                         : viewModel.connectionState === Database.Connecting ? "#f39c12" : "#e74c3c"
                     radius: 4
                     
                     Text {
+                        id: connectionText
                         anchors.centerIn: parent
-                        text: viewModel.isConnected ? "PostgreSQL ✅" : "PostgreSQL ❌"
+                        text: {
+                            switch (viewModel.connectionState) {
+                            case Database.Connected:
+                                return viewModel.storageName + " ✅"
+                            case Database.Connecting:
+                                return "Подключение..."
+                            case Database.Retrying:
+                                return "Повтор через " + Math.ceil(viewModel.retryDelay / 1000) + " с"
+                            default:
+                                return viewModel.storageName + " ❌"
+                            }
+                        }
                         color: "white"
                         font.bold: true
                         font.pixelSize: 12
@@ -253,6 +298,28 @@ ApplicationWindow {
                                 }
                                 validator: IntValidator { bottom: 1 }
                             }
+                            
+                            Button {
+                                text: "🗑️ Удалить выбранные (" + teachersList.selectedCount + ")"
+                                font.bold: true
+                                padding: 10
+                                enabled: teachersList.selectedCount > 0
+                                
+                                background: Rectangle {
+                                    color: parent.enabled ? "#e74c3c" : "#bdc3c7"
+                                    radius: 4
+                                }
+                                
+                                contentItem: Text {
+                                    text: parent.text
+                                    color: "white"
+                                    horizontalAlignment: Text.AlignHCenter
+                                    verticalAlignment: Text.AlignVCenter
+                                }
+                                
+                                // Все отмеченные записи удаляются одним запросом
+                                onClicked: viewModel.deleteTeachers(teachersList.takeSelected())
+                            }
                         }
                     }
                 }
@@ -279,9 +346,31 @@ ApplicationWindow {
                         
                         ListView {
                             id: teachersList
+                            
+                            // Отмеченные записи: id -> true
+                            property var selectedIds: ({})
+                            property int selectedCount: 0
+                            
+                            function toggleSelected(recordId, selected) {
+                                var ids = Object.assign({}, selectedIds)
+                                if (selected) {
+                                    ids[recordId] = true
+                                } else {
+                                    delete ids[recordId]
+                                }
+                                selectedIds = ids
+                                selectedCount = Object.keys(ids).length
+                            }
+                            
+                            function takeSelected() {
+                                var ids = Object.keys(selectedIds).map(Number)
+                                selectedIds = ({})
+                                selectedCount = 0
+                                return ids
+                            }
                             Layout.fillWidth: true
                             Layout.fillHeight: true
-                            model: viewModel.teachers
+                            model: viewModel.searchText.length > 0 ? viewModel.teacherResults : viewModel.teacherFilter
                             clip: true
                             spacing: 1
                             
@@ -289,16 +378,26 @@ ApplicationWindow {
                                 width: ListView.view.width
                                 height: 50
                                 color: index % 2 === 0 ? "#ffffff" : "#f8f9fa"
+                                // Запись еще не подтверждена базой
+                                opacity: model.pending ? 0.5 : 1.0
                                 
                                 RowLayout {
                                     anchors.fill: parent
                                     anchors.leftMargin: 15
                                     anchors.rightMargin: 15
                                     
+                                    CheckBox {
+                                        // Временные и еще не загруженные строки не выбираются
+                                        enabled: model.recordId > 0
+                                        checked: teachersList.selectedIds[model.recordId] === true
+                                        onToggled: teachersList.toggleSelected(model.recordId, checked)
+                                    }
+                                    
                                     Text {
-                                        text: modelData
+                                        text: model.display
                                         color: "#2c3e50"
                                         font.pixelSize: 14
+                                        font.italic: model.pending === true
                                         Layout.fillWidth: true
                                     }
                                 }
@@ -428,6 +527,100 @@ ApplicationWindow {
                                 }
                                 validator: IntValidator { bottom: 1 }
                             }
+                            
+                            Button {
+                                text: "🗑️ Удалить выбранные (" + studentsList.selectedCount + ")"
+                                font.bold: true
+                                padding: 10
+                                enabled: studentsList.selectedCount > 0
+                                
+                                background: Rectangle {
+                                    color: parent.enabled ? "#e74c3c" : "#bdc3c7"
+                                    radius: 4
+                                }
+                                
+                                contentItem: Text {
+                                    text: parent.text
+                                    color: "white"
+                                    horizontalAlignment: Text.AlignHCenter
+                                    verticalAlignment: Text.AlignVCenter
+                                }
+                                
+                                // Все отмеченные записи удаляются одним запросом
+                                onClicked: viewModel.deleteStudents(studentsList.takeSelected())
+                            }
+                        }
+                    }
+                }
+                
+                // Распределение оценок
+                Rectangle {
+                    Layout.fillWidth: true
+                    height: 130
+                    color: "white"
+                    border.color: "#ddd"
+                    radius: 8
+                    
+                    RowLayout {
+                        anchors.fill: parent
+                        anchors.margins: 15
+                        spacing: 20
+                        
+                        ColumnLayout {
+                            Text {
+                                text: "Средний балл: " + viewModel.gradeAnalytics.mean.toFixed(2)
+                                font.bold: true
+                                color: "#2c3e50"
+                                font.pixelSize: 16
+                            }
+                            
+                            Text {
+                                text: viewModel.gradeAnalytics.loading ? "Загрузка..." : "Студентов: " + viewModel.gradeAnalytics.count
+                                color: "#7f8c8d"
+                                font.pixelSize: 12
+                            }
+                        }
+                        
+                        // Гистограмма оценок 1..5
+                        Row {
+                            Layout.fillHeight: true
+                            spacing: 6
+                            
+                            Repeater {
+                                model: viewModel.gradeAnalytics.histogram
+                                
+                                Column {
+                                    anchors.bottom: parent.bottom
+                                    spacing: 2
+                                    
+                                    Rectangle {
+                                        readonly property real peak: Math.max(1, Math.max.apply(null, viewModel.gradeAnalytics.histogram))
+                                        width: 28
+                                        height: Math.max(1, 70 * modelData / peak)
+                                        color: "#3498db"
+                                        radius: 2
+                                    }
+                                    
+                                    Text {
+                                        text: index + 1
+                                        width: 28
+                                        horizontalAlignment: Text.AlignHCenter
+                                        color: "#2c3e50"
+                                        font.pixelSize: 11
+                                    }
+                                }
+                            }
+                        }
+                        
+                        Text {
+                            Layout.fillWidth: true
+                            text: "Лучшие: " + viewModel.gradeAnalytics.topStudents.map(s => s.fullName + " (" + s.grade + ")").join(", ")
+                                  + "\nХудшие: " + viewModel.gradeAnalytics.bottomStudents.map(s => s.fullName + " (" + s.grade + ")").join(", ")
+                            color: "#2c3e50"
+                            font.pixelSize: 12
+                            wrapMode: Text.Wrap
+                            elide: Text.ElideRight
+                            maximumLineCount: 4
                         }
                     }
                 }
@@ -443,20 +636,53 @@ ApplicationWindow {
                     ColumnLayout {
                         anchors.fill: parent
                         
-                        Text {
-                            text: "Список студентов:"
-                            font.bold: true
-                            color: "#2c3e50"
-                            font.pixelSize: 16
+                        RowLayout {
                             Layout.topMargin: 15
                             Layout.leftMargin: 15
+                            
+                            Text {
+                                text: "Список студентов:"
+                                font.bold: true
+                                color: "#2c3e50"
+                                font.pixelSize: 16
+                            }
+                            
+                            // Снимок таблицы читается окнами через серверный курсор
+                            CheckBox {
+                                text: "Курсор"
+                                checked: viewModel.cursorBrowsing
+                                onToggled: viewModel.cursorBrowsing = checked
+                            }
                         }
                         
                         ListView {
                             id: studentsList
+                            
+                            // Отмеченные записи: id -> true
+                            property var selectedIds: ({})
+                            property int selectedCount: 0
+                            
+                            function toggleSelected(recordId, selected) {
+                                var ids = Object.assign({}, selectedIds)
+                                if (selected) {
+                                    ids[recordId] = true
+                                } else {
+                                    delete ids[recordId]
+                                }
+                                selectedIds = ids
+                                selectedCount = Object.keys(ids).length
+                            }
+                            
+                            function takeSelected() {
+                                var ids = Object.keys(selectedIds).map(Number)
+                                selectedIds = ({})
+                                selectedCount = 0
+                                return ids
+                            }
                             Layout.fillWidth: true
                             Layout.fillHeight: true
-                            model: viewModel.students
+                            model: viewModel.searchText.length > 0 ? viewModel.studentResults
+                                 : viewModel.cursorBrowsing ? viewModel.studentWindow : viewModel.studentFilter
                             clip: true
                             spacing: 1
                             
@@ -464,16 +690,27 @@ ApplicationWindow {
                                 width: ListView.view.width
                                 height: 50
                                 color: index % 2 === 0 ? "#ffffff" : "#f8f9fa"
+                                // Запись еще не подтверждена базой
+                                opacity: model.pending ? 0.5 : 1.0
                                 
                                 RowLayout {
                                     anchors.fill: parent
                                     anchors.leftMargin: 15
                                     anchors.rightMargin: 15
                                     
+                                    CheckBox {
+                                        // Временные и еще не загруженные строки не выбираются
+                                        enabled: model.recordId > 0
+                                        checked: studentsList.selectedIds[model.recordId] === true
+                                        onToggled: studentsList.toggleSelected(model.recordId, checked)
+                                    }
+                                    
                                     Text {
-                                        text: modelData
+                                        // Окно курсора может еще загружаться
+                                        text: model.display !== undefined ? model.display : "Загрузка..."
                                         color: "#2c3e50"
                                         font.pixelSize: 14
+                                        font.italic: model.pending === true
                                         Layout.fillWidth: true
                                     }
                                 }
@@ -583,10 +820,139 @@ ApplicationWindow {
                                 }
                                 validator: IntValidator { bottom: 1 }
                             }
+                            
+                            Button {
+                                text: "🗑️ Удалить выбранные (" + subjectsList.selectedCount + ")"
+                                font.bold: true
+                                padding: 10
+                                enabled: subjectsList.selectedCount > 0
+                                
+                                background: Rectangle {
+                                    color: parent.enabled ? "#e74c3c" : "#bdc3c7"
+                                    radius: 4
+                                }
+                                
+                                contentItem: Text {
+                                    text: parent.text
+                                    color: "white"
+                                    horizontalAlignment: Text.AlignHCenter
+                                    verticalAlignment: Text.AlignVCenter
+                                }
+                                
+                                // Все отмеченные записи удаляются одним запросом
+                                onClicked: viewModel.deleteSubjects(subjectsList.takeSelected())
+                            }
                         }
                     }
                 }
-                
+
+                // Состав предмета: записи студентов и назначения преподавателей
+                Rectangle {
+                    Layout.fillWidth: true
+                    height: 240
+                    color: "white"
+                    border.color: "#ddd"
+                    radius: 8
+
+                    ColumnLayout {
+                        anchors.fill: parent
+                        anchors.margins: 15
+
+                        Text {
+                            text: viewModel.rosterSubjectId > 0
+                                  ? "Состав предмета (ID: " + viewModel.rosterSubjectId + "): " + viewModel.roster.length
+                                  : "Состав предмета:"
+                            font.bold: true
+                            color: "#2c3e50"
+                            font.pixelSize: 16
+                        }
+
+                        RowLayout {
+                            spacing: 10
+
+                            TextField {
+                                id: rosterSubjectIdInput
+                                placeholderText: "ID предмета"
+                                Layout.preferredWidth: 110
+                                font.pixelSize: 14
+                                padding: 10
+                                color: "black"
+                                validator: IntValidator { bottom: 1 }
+                            }
+
+                            TextField {
+                                id: rosterStudentIdInput
+                                placeholderText: "ID студента"
+                                Layout.preferredWidth: 110
+                                font.pixelSize: 14
+                                padding: 10
+                                color: "black"
+                                validator: IntValidator { bottom: 1 }
+                            }
+
+                            SpinBox {
+                                id: rosterGradeInput
+                                from: 0
+                                to: 5
+                                value: 0
+                                // 0 — оценка еще не выставлена
+                                textFromValue: function(value) { return value === 0 ? "—" : value.toString() }
+                            }
+
+                            Button {
+                                text: "➕ Записать"
+                                padding: 10
+                                enabled: rosterSubjectIdInput.text && rosterStudentIdInput.text
+                                onClicked: viewModel.enrollStudent(parseInt(rosterStudentIdInput.text),
+                                                                   parseInt(rosterSubjectIdInput.text),
+                                                                   rosterGradeInput.value)
+                            }
+
+                            TextField {
+                                id: rosterTeacherIdInput
+                                placeholderText: "ID преподавателя"
+                                Layout.preferredWidth: 130
+                                font.pixelSize: 14
+                                padding: 10
+                                color: "black"
+                                validator: IntValidator { bottom: 1 }
+                            }
+
+                            Button {
+                                text: "👨‍🏫 Назначить"
+                                padding: 10
+                                enabled: rosterSubjectIdInput.text && rosterTeacherIdInput.text
+                                onClicked: viewModel.assignTeacher(parseInt(rosterTeacherIdInput.text),
+                                                                   parseInt(rosterSubjectIdInput.text))
+                            }
+
+                            Button {
+                                text: "📋 Показать"
+                                padding: 10
+                                enabled: rosterSubjectIdInput.text
+                                onClicked: viewModel.loadRoster(parseInt(rosterSubjectIdInput.text))
+                            }
+                        }
+
+                        ListView {
+                            Layout.fillWidth: true
+                            Layout.fillHeight: true
+                            model: viewModel.roster
+                            clip: true
+                            spacing: 1
+
+                            delegate: Text {
+                                width: ListView.view.width
+                                text: modelData.studentId + ". " + modelData.studentName
+                                      + (modelData.grade > 0 ? " (Оценка: " + modelData.grade + ")" : "")
+                                      + (modelData.teacherId > 0 ? " — " + modelData.teacherName : "")
+                                color: "#2c3e50"
+                                font.pixelSize: 13
+                            }
+                        }
+                    }
+                }
+
                 // Список предметов
                 Rectangle {
                     Layout.fillWidth: true
@@ -609,9 +975,31 @@ ApplicationWindow {
                         
                         ListView {
                             id: subjectsList
+                            
+                            // Отмеченные записи: id -> true
+                            property var selectedIds: ({})
+                            property int selectedCount: 0
+                            
+                            function toggleSelected(recordId, selected) {
+                                var ids = Object.assign({}, selectedIds)
+                                if (selected) {
+                                    ids[recordId] = true
+                                } else {
+                                    delete ids[recordId]
+                                }
+                                selectedIds = ids
+                                selectedCount = Object.keys(ids).length
+                            }
+                            
+                            function takeSelected() {
+                                var ids = Object.keys(selectedIds).map(Number)
+                                selectedIds = ({})
+                                selectedCount = 0
+                                return ids
+                            }
                             Layout.fillWidth: true
                             Layout.fillHeight: true
-                            model: viewModel.subjects
+                            model: viewModel.searchText.length > 0 ? viewModel.subjectResults : viewModel.subjectFilter
                             clip: true
                             spacing: 1
                             
@@ -619,16 +1007,26 @@ ApplicationWindow {
                                 width: ListView.view.width
                                 height: 50
                                 color: index % 2 === 0 ? "#ffffff" : "#f8f9fa"
+                                // Запись еще не подтверждена базой
+                                opacity: model.pending ? 0.5 : 1.0
                                 
                                 RowLayout {
                                     anchors.fill: parent
                                     anchors.leftMargin: 15
                                     anchors.rightMargin: 15
                                     
+                                    CheckBox {
+                                        // Временные и еще не загруженные строки не выбираются
+                                        enabled: model.recordId > 0
+                                        checked: subjectsList.selectedIds[model.recordId] === true
+                                        onToggled: subjectsList.toggleSelected(model.recordId, checked)
+                                    }
+                                    
                                     Text {
-                                        text: modelData
+                                        text: model.display
                                         color: "#2c3e50"
                                         font.pixelSize: 14
+                                        font.italic: model.pending === true
                                         Layout.fillWidth: true
                                     }
                                 }
@@ -663,11 +1061,68 @@ ApplicationWindow {
                     onClicked: refreshAll()
                 }
                 
+                Button {
+                    text: viewModel.importer.running ? "⏹ Отменить импорт" : "📥 Импорт"
+                    enabled: viewModel.isConnected
+                    onClicked: viewModel.importer.running ? viewModel.importer.cancel() : importDialog.open()
+                }
+                
+                ProgressBar {
+                    visible: viewModel.importer.running
+                    value: viewModel.importer.progress
+                    Layout.preferredWidth: 120
+                }
+                
+                Text {
+                    visible: viewModel.importer.running || viewModel.importer.importedRows > 0
+                    text: "Импорт: " + viewModel.importer.importedRows
+                          + " (отклонено " + viewModel.importer.rejectedRows + "), "
+                          + Math.round(viewModel.importer.rowsPerSecond) + " стр/с"
+                    color: "#bdc3c7"
+                    font.pixelSize: 11
+                    Layout.leftMargin: 10
+                }
+                
+                Text {
+                    text: "Кэш запросов: " + Math.round(viewModel.statementCacheHitRate * 100) + "%"
+                    color: "#bdc3c7"
+                    font.pixelSize: 11
+                    Layout.leftMargin: 10
+                }
+
                 Text {
-                    text: "Записей: " + viewModel.totalRecords
+                    // Щелчок сохраняет статистику запросов в JSON рядом с программой
+                    visible: viewModel.queryMetrics.slowQueries > 0
+                    text: "Медленных запросов: " + viewModel.queryMetrics.slowQueries
+                    color: "#f39c12"
+                    font.pixelSize: 11
+                    Layout.leftMargin: 10
+
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: viewModel.dumpQueryMetrics("query_metrics.json")
+                    }
+                }
+
+                Text {
+                    text: (viewModel.estimatedCounts ? "Записей ≈ " : "Записей: ") + viewModel.totalRecords
                     color: "white"
                     font.bold: true
                     Layout.leftMargin: 10
+                    
+                    ToolTip.visible: countArea.containsMouse
+                    ToolTip.text: "Преподаватели: " + viewModel.teacherCount
+                                  + "\nСтуденты: " + viewModel.studentCount
+                                  + "\nПредметы: " + viewModel.subjectCount
+                                  + "\nЩелчок — " + (viewModel.estimatedCounts ? "точный подсчет" : "оценка планировщика")
+                    
+                    MouseArea {
+                        id: countArea
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        onClicked: viewModel.estimatedCounts = !viewModel.estimatedCounts
+                    }
                 }
             }
         }
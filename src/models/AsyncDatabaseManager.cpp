@@ -0,0 +1,797 @@
+/**
+ * @file AsyncDatabaseManager.cpp
+ * @brief Реализация класса AsyncDatabaseManager
+ * @ingroup Models
+ */
+
+#include "AsyncDatabaseManager.h"
+#include "QueryMetrics.h"
+#include <QDebug>
+#include <QPromise>
+#include <QMetaObject>
+#include <QtGlobal>
+#include <memory>
+
+/**
+ * @brief Конструктор AsyncDatabaseManager
+ * @param parent Родительский QObject
+ *
+ * @details Переносит DatabaseManager в рабочий поток и пробрасывает его сигналы.
+ * Сигналы приходят через очередь событий потока владельца.
+ * Одно соединение пула занимает рабочий поток, остальные достаются
+ * потокам чтения.
+ */
+AsyncDatabaseManager::AsyncDatabaseManager(QObject *parent)
+    : QObject(parent)
+    , m_manager(new DatabaseManager)
+    , m_readPool(new QThreadPool(this))
+    , m_writeBatcher(new WriteBatcher([this](const QList<WriteOperation> &operations) {
+          return applyWrites(operations);
+      }, this))
+    , m_connected(false)
+    , m_state(Disconnected)
+    , m_retryAttempt(0)
+    , m_rosterRefreshing(false)
+    , m_rosterStale(false)
+{
+    bool ok = false;
+    int poolSize = qEnvironmentVariableIntValue("UNIVERSITY_DB_POOL_SIZE", &ok);
+    if (!ok || poolSize < 1) {
+        poolSize = ConnectionPool::DEFAULT_MAX_CONNECTIONS;
+    }
+    // У хранилища в памяти нет пула соединений
+    if (ConnectionPool *pool = m_manager->connectionPool()) {
+        pool->setMaxConnections(poolSize);
+        if (qEnvironmentVariableIsSet("UNIVERSITY_DB_CONNECT_TIMEOUT")) {
+            pool->setConnectTimeout(qEnvironmentVariableIntValue("UNIVERSITY_DB_CONNECT_TIMEOUT"));
+        }
+    }
+
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &AsyncDatabaseManager::connectToDatabase);
+    m_readPool->setMaxThreadCount(qMax(1, poolSize - 1));
+
+    m_rosterTimer.setSingleShot(true);
+    m_rosterTimer.setInterval(ROSTER_REFRESH_DELAY);
+    connect(&m_rosterTimer, &QTimer::timeout, this, [this]() {
+        m_rosterRefreshing = true;
+        m_rosterStale = false;
+        refreshRosters().then(this, [this](bool success) {
+            m_rosterRefreshing = false;
+            if (m_rosterStale) {
+                m_rosterTimer.start();
+            }
+            emit rostersRefreshed(success);
+        });
+    });
+
+    m_thread.setObjectName("DatabaseThread");
+    m_manager->moveToThread(&m_thread);
+
+    // DatabaseManager удаляется в своем потоке после остановки цикла событий
+    connect(&m_thread, &QThread::finished, m_manager, &QObject::deleteLater);
+
+    connect(m_manager, &DatabaseManager::databaseConnected, this, [this](bool success) {
+        m_connected = success;
+        if (success) {
+            m_retryAttempt = 0;
+            setConnectionState(Connected);
+        } else {
+            // 1, 2, 4, ... секунды, но не больше MAX_RETRY_DELAY
+            const int shift = qMin(m_retryAttempt++, 15);
+            m_retryTimer.start(qMin(INITIAL_RETRY_DELAY << shift, MAX_RETRY_DELAY));
+            qWarning() << "Повтор подключения через" << m_retryTimer.interval() << "мс";
+            setConnectionState(Retrying);
+        }
+        emit databaseConnected(success);
+    });
+    connect(m_manager, &DatabaseManager::teacherAdded, this, &AsyncDatabaseManager::teacherAdded);
+    connect(m_manager, &DatabaseManager::teacherDeleted, this, &AsyncDatabaseManager::teacherDeleted);
+    connect(m_manager, &DatabaseManager::teachersAdded, this, &AsyncDatabaseManager::teachersAdded);
+    connect(m_manager, &DatabaseManager::studentAdded, this, &AsyncDatabaseManager::studentAdded);
+    connect(m_manager, &DatabaseManager::studentDeleted, this, &AsyncDatabaseManager::studentDeleted);
+    connect(m_manager, &DatabaseManager::studentsAdded, this, &AsyncDatabaseManager::studentsAdded);
+    connect(m_manager, &DatabaseManager::subjectAdded, this, &AsyncDatabaseManager::subjectAdded);
+    connect(m_manager, &DatabaseManager::subjectDeleted, this, &AsyncDatabaseManager::subjectDeleted);
+    connect(m_manager, &DatabaseManager::subjectsAdded, this, &AsyncDatabaseManager::subjectsAdded);
+    connect(m_manager, &DatabaseManager::teachersUpdated, this, &AsyncDatabaseManager::teachersUpdated);
+    connect(m_manager, &DatabaseManager::teachersDeleted, this, &AsyncDatabaseManager::teachersDeleted);
+    connect(m_manager, &DatabaseManager::studentsUpdated, this, &AsyncDatabaseManager::studentsUpdated);
+    connect(m_manager, &DatabaseManager::studentsDeleted, this, &AsyncDatabaseManager::studentsDeleted);
+    connect(m_manager, &DatabaseManager::subjectsUpdated, this, &AsyncDatabaseManager::subjectsUpdated);
+    connect(m_manager, &DatabaseManager::subjectsDeleted, this, &AsyncDatabaseManager::subjectsDeleted);
+    connect(m_manager, &DatabaseManager::tableReloadRequired, this, &AsyncDatabaseManager::tableReloadRequired);
+
+    // Удаление меняет составы каскадно, изменение имени — их содержимое
+    connect(m_manager, &DatabaseManager::rostersChanged, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::teacherDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::studentDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::subjectDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::teachersDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::studentsDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::subjectsDeleted, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::teachersUpdated, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::studentsUpdated, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+    connect(m_manager, &DatabaseManager::tableReloadRequired, this, &AsyncDatabaseManager::scheduleRosterRefresh);
+
+    m_thread.start();
+}
+
+/**
+ * @brief Деструктор AsyncDatabaseManager
+ *
+ * @details Сначала отправляет накопленные операции записи и дожидается
+ * их фиксации, чтобы изменения пользователя не потерялись при выходе:
+ * записи должны завершиться, пока соединения пула еще открыты. Затем
+ * удаляет пул потоков чтения: его потоки завершаются и закрывают свои
+ * соединения, пока ConnectionPool еще существует. После этого
+ * останавливает рабочий поток. Незавершенные QFuture будут отменены.
+ */
+AsyncDatabaseManager::~AsyncDatabaseManager()
+{
+    m_writeBatcher->flush().waitForFinished();
+
+    delete m_readPool;
+    m_readPool = nullptr;
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+/**
+ * @brief Выполнение функции в рабочем потоке
+ * @param function Функция, выполняемая над DatabaseManager
+ * @return QFuture<Result> Результат выполнения
+ *
+ * @details Если поток будет остановлен до выполнения, QPromise уничтожится
+ * незавершенным и QFuture перейдет в состояние canceled. Операция,
+ * отмененная через QFuture::cancel() до начала выполнения, пропускается.
+ */
+template <typename Result, typename Function>
+QFuture<Result> AsyncDatabaseManager::run(Function function)
+{
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+
+    DatabaseManager *manager = m_manager;
+    QMetaObject::invokeMethod(m_manager, [promise, manager, function]() {
+        if (!promise->isCanceled()) {
+            promise->addResult(function(manager));
+        }
+        promise->finish();
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
+/**
+ * @brief Выполнение функции чтения в пуле потоков
+ * @param function Функция, выполняемая над DatabaseManager
+ * @return QFuture<Result> Результат выполнения
+ *
+ * @details Методы чтения DatabaseManager берут соединение текущего потока
+ * из ConnectionPool, поэтому могут выполняться одновременно с рабочим потоком.
+ */
+template <typename Result, typename Function>
+QFuture<Result> AsyncDatabaseManager::runParallel(Function function)
+{
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+
+    DatabaseManager *manager = m_manager;
+    m_readPool->start([promise, manager, function]() {
+        if (!promise->isCanceled()) {
+            promise->addResult(function(manager));
+        }
+        promise->finish();
+    });
+
+    return future;
+}
+
+/**
+ * @brief Проверка подключения к базе данных
+ * @return bool Состояние подключения
+ */
+bool AsyncDatabaseManager::isConnected() const
+{
+    return m_connected;
+}
+
+/**
+ * @brief Получение доли попаданий в кэш подготовленных запросов
+ * @return double Значение от 0 до 1
+ */
+double AsyncDatabaseManager::statementCacheHitRate() const
+{
+    return m_manager->statementCacheHitRate();
+}
+
+/**
+ * @brief Получение названия хранилища
+ * @return QString Название
+ *
+ * @details Название не меняется после создания хранилища, поэтому
+ * читается из GUI потока без синхронизации
+ */
+QString AsyncDatabaseManager::storageName() const
+{
+    return m_manager->storage()->name();
+}
+
+/**
+ * @brief Получение снимка статистики операций
+ * @return QVariantMap Снимок
+ */
+QVariantMap AsyncDatabaseManager::queryMetrics() const
+{
+    return m_manager->storage()->metrics()->snapshot();
+}
+
+/**
+ * @brief Получение статистики операций в JSON
+ * @return QJsonObject Снимок
+ */
+QJsonObject AsyncDatabaseManager::queryMetricsJson() const
+{
+    return m_manager->storage()->metrics()->toJson();
+}
+
+/**
+ * @brief Получение порога медленного запроса
+ * @return int Миллисекунды
+ */
+int AsyncDatabaseManager::slowQueryThreshold() const
+{
+    return m_manager->storage()->metrics()->slowQueryThreshold();
+}
+
+/**
+ * @brief Установка порога медленного запроса
+ * @param msecs Миллисекунды
+ */
+void AsyncDatabaseManager::setSlowQueryThreshold(int msecs)
+{
+    m_manager->storage()->metrics()->setSlowQueryThreshold(msecs);
+}
+
+/**
+ * @brief Получение состояния подключения
+ * @return ConnectionState Состояние
+ */
+AsyncDatabaseManager::ConnectionState AsyncDatabaseManager::connectionState() const
+{
+    return m_state;
+}
+
+/**
+ * @brief Получение задержки до повтора подключения
+ * @return int Задержка в миллисекундах
+ */
+int AsyncDatabaseManager::retryDelay() const
+{
+    return m_retryTimer.isActive() ? m_retryTimer.remainingTime() : 0;
+}
+
+/**
+ * @brief Смена состояния подключения
+ * @param state Новое состояние
+ */
+void AsyncDatabaseManager::setConnectionState(ConnectionState state)
+{
+    if (m_state != state) {
+        m_state = state;
+        emit connectionStateChanged(state);
+    }
+}
+
+/**
+ * @brief Подключение к базе данных
+ * @return QFuture<bool> Результат подключения
+ */
+QFuture<bool> AsyncDatabaseManager::connectToDatabase()
+{
+    m_retryTimer.stop();
+    setConnectionState(Connecting);
+    return run<bool>([](DatabaseManager *db) {
+        return db->connectToDatabase();
+    });
+}
+
+/**
+ * @brief Получение списка всех преподавателей
+ * @return QFuture<QList<TeacherRecord>> Список преподавателей
+ */
+QFuture<QList<TeacherRecord>> AsyncDatabaseManager::getAllTeachers()
+{
+    return runParallel<QList<TeacherRecord>>([](DatabaseManager *db) {
+        return db->getAllTeachers();
+    });
+}
+
+/**
+ * @brief Получение страницы преподавателей
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей на странице
+ * @return QFuture<QList<TeacherRecord>> Записи с id больше afterId
+ */
+QFuture<QList<TeacherRecord>> AsyncDatabaseManager::getTeachersPage(int afterId, int limit)
+{
+    return runParallel<QList<TeacherRecord>>([afterId, limit](DatabaseManager *db) {
+        return db->getTeachersPage(afterId, limit);
+    });
+}
+
+/**
+ * @brief Добавление нового преподавателя
+ * @param fullName Полное имя преподавателя
+ * @param department Кафедра преподавателя
+ * @return QFuture<TeacherRecord> Добавленная запись или невалидная запись при ошибке
+ */
+QFuture<TeacherRecord> AsyncDatabaseManager::addTeacher(const QString &fullName, const QString &department)
+{
+    return run<TeacherRecord>([fullName, department](DatabaseManager *db) {
+        return db->addTeacher(fullName, department);
+    });
+}
+
+/**
+ * @brief Пакетное добавление преподавателей
+ * @param records Новые записи
+ * @return QFuture<QList<int>> Идентификаторы добавленных записей
+ */
+QFuture<QList<int>> AsyncDatabaseManager::addTeachers(const QList<TeacherRecord> &records)
+{
+    return run<QList<int>>([records](DatabaseManager *db) {
+        return db->addTeachers(records);
+    });
+}
+
+/**
+ * @brief Удаление преподавателя по ID
+ * @param id Идентификатор преподавателя
+ * @return QFuture<int> Идентификатор удаленной записи или 0
+ */
+QFuture<int> AsyncDatabaseManager::deleteTeacher(int id)
+{
+    return run<int>([id](DatabaseManager *db) {
+        return db->deleteTeacher(id);
+    });
+}
+
+/**
+ * @brief Поиск преподавателя по ID
+ * @param id Идентификатор преподавателя
+ * @return QFuture<TeacherRecord> Найденная запись или невалидная запись
+ */
+QFuture<TeacherRecord> AsyncDatabaseManager::getTeacherById(int id)
+{
+    return run<TeacherRecord>([id](DatabaseManager *db) {
+        return db->getTeacherById(id);
+    });
+}
+
+/**
+ * @brief Удаление преподавателей по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<WriteResult>> Результаты по id
+ */
+QFuture<QList<WriteResult>> AsyncDatabaseManager::deleteTeachers(const QList<int> &ids)
+{
+    m_writeBatcher->flush();
+    return run<QList<WriteResult>>([ids](DatabaseManager *db) {
+        return db->deleteTeachers(ids);
+    });
+}
+
+/**
+ * @brief Поиск преподавателей по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<TeacherRecord>> Найденные записи
+ */
+QFuture<QList<TeacherRecord>> AsyncDatabaseManager::getTeachersByIds(const QList<int> &ids)
+{
+    return runParallel<QList<TeacherRecord>>([ids](DatabaseManager *db) {
+        return db->getTeachersByIds(ids);
+    });
+}
+
+/**
+ * @brief Получение списка всех студентов
+ * @return QFuture<QList<StudentRecord>> Список студентов
+ */
+QFuture<QList<StudentRecord>> AsyncDatabaseManager::getAllStudents()
+{
+    return runParallel<QList<StudentRecord>>([](DatabaseManager *db) {
+        return db->getAllStudents();
+    });
+}
+
+/**
+ * @brief Получение страницы студентов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей на странице
+ * @return QFuture<QList<StudentRecord>> Записи с id больше afterId
+ */
+QFuture<QList<StudentRecord>> AsyncDatabaseManager::getStudentsPage(int afterId, int limit)
+{
+    return runParallel<QList<StudentRecord>>([afterId, limit](DatabaseManager *db) {
+        return db->getStudentsPage(afterId, limit);
+    });
+}
+
+/**
+ * @brief Добавление нового студента
+ * @param fullName Полное имя студента
+ * @param grade Оценка студента
+ * @return QFuture<StudentRecord> Добавленная запись или невалидная запись при ошибке
+ */
+QFuture<StudentRecord> AsyncDatabaseManager::addStudent(const QString &fullName, int grade)
+{
+    return run<StudentRecord>([fullName, grade](DatabaseManager *db) {
+        return db->addStudent(fullName, grade);
+    });
+}
+
+/**
+ * @brief Пакетное добавление студентов
+ * @param records Новые записи
+ * @return QFuture<QList<int>> Идентификаторы добавленных записей
+ */
+QFuture<QList<int>> AsyncDatabaseManager::addStudents(const QList<StudentRecord> &records)
+{
+    return run<QList<int>>([records](DatabaseManager *db) {
+        return db->addStudents(records);
+    });
+}
+
+/**
+ * @brief Удаление студента по ID
+ * @param id Идентификатор студента
+ * @return QFuture<int> Идентификатор удаленной записи или 0
+ */
+QFuture<int> AsyncDatabaseManager::deleteStudent(int id)
+{
+    return run<int>([id](DatabaseManager *db) {
+        return db->deleteStudent(id);
+    });
+}
+
+/**
+ * @brief Поиск студента по ID
+ * @param id Идентификатор студента
+ * @return QFuture<StudentRecord> Найденная запись или невалидная запись
+ */
+QFuture<StudentRecord> AsyncDatabaseManager::getStudentById(int id)
+{
+    return run<StudentRecord>([id](DatabaseManager *db) {
+        return db->getStudentById(id);
+    });
+}
+
+/**
+ * @brief Удаление студентов по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<WriteResult>> Результаты по id
+ */
+QFuture<QList<WriteResult>> AsyncDatabaseManager::deleteStudents(const QList<int> &ids)
+{
+    m_writeBatcher->flush();
+    return run<QList<WriteResult>>([ids](DatabaseManager *db) {
+        return db->deleteStudents(ids);
+    });
+}
+
+/**
+ * @brief Поиск студентов по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<StudentRecord>> Найденные записи
+ */
+QFuture<QList<StudentRecord>> AsyncDatabaseManager::getStudentsByIds(const QList<int> &ids)
+{
+    return runParallel<QList<StudentRecord>>([ids](DatabaseManager *db) {
+        return db->getStudentsByIds(ids);
+    });
+}
+
+/**
+ * @brief Получение списка всех предметов
+ * @return QFuture<QList<SubjectRecord>> Список предметов
+ */
+QFuture<QList<SubjectRecord>> AsyncDatabaseManager::getAllSubjects()
+{
+    return runParallel<QList<SubjectRecord>>([](DatabaseManager *db) {
+        return db->getAllSubjects();
+    });
+}
+
+/**
+ * @brief Получение страницы предметов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей на странице
+ * @return QFuture<QList<SubjectRecord>> Записи с id больше afterId
+ */
+QFuture<QList<SubjectRecord>> AsyncDatabaseManager::getSubjectsPage(int afterId, int limit)
+{
+    return runParallel<QList<SubjectRecord>>([afterId, limit](DatabaseManager *db) {
+        return db->getSubjectsPage(afterId, limit);
+    });
+}
+
+/**
+ * @brief Добавление нового предмета
+ * @param name Название предмета
+ * @return QFuture<SubjectRecord> Добавленная запись или невалидная запись при ошибке
+ */
+QFuture<SubjectRecord> AsyncDatabaseManager::addSubject(const QString &name)
+{
+    return run<SubjectRecord>([name](DatabaseManager *db) {
+        return db->addSubject(name);
+    });
+}
+
+/**
+ * @brief Пакетное добавление предметов
+ * @param records Новые записи
+ * @return QFuture<QList<int>> Идентификаторы добавленных записей
+ */
+QFuture<QList<int>> AsyncDatabaseManager::addSubjects(const QList<SubjectRecord> &records)
+{
+    return run<QList<int>>([records](DatabaseManager *db) {
+        return db->addSubjects(records);
+    });
+}
+
+/**
+ * @brief Удаление предмета по ID
+ * @param id Идентификатор предмета
+ * @return QFuture<int> Идентификатор удаленной записи или 0
+ */
+QFuture<int> AsyncDatabaseManager::deleteSubject(int id)
+{
+    return run<int>([id](DatabaseManager *db) {
+        return db->deleteSubject(id);
+    });
+}
+
+/**
+ * @brief Поиск предмета по ID
+ * @param id Идентификатор предмета
+ * @return QFuture<SubjectRecord> Найденная запись или невалидная запись
+ */
+QFuture<SubjectRecord> AsyncDatabaseManager::getSubjectById(int id)
+{
+    return run<SubjectRecord>([id](DatabaseManager *db) {
+        return db->getSubjectById(id);
+    });
+}
+
+/**
+ * @brief Удаление предметов по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<WriteResult>> Результаты по id
+ */
+QFuture<QList<WriteResult>> AsyncDatabaseManager::deleteSubjects(const QList<int> &ids)
+{
+    m_writeBatcher->flush();
+    return run<QList<WriteResult>>([ids](DatabaseManager *db) {
+        return db->deleteSubjects(ids);
+    });
+}
+
+/**
+ * @brief Поиск предметов по списку ID
+ * @param ids Идентификаторы
+ * @return QFuture<QList<SubjectRecord>> Найденные записи
+ */
+QFuture<QList<SubjectRecord>> AsyncDatabaseManager::getSubjectsByIds(const QList<int> &ids)
+{
+    return runParallel<QList<SubjectRecord>>([ids](DatabaseManager *db) {
+        return db->getSubjectsByIds(ids);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск преподавателей
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QFuture<QList<TeacherRecord>> Результаты поиска
+ */
+QFuture<QList<TeacherRecord>> AsyncDatabaseManager::searchTeachers(const QString &text, int limit)
+{
+    return runParallel<QList<TeacherRecord>>([text, limit](DatabaseManager *db) {
+        return db->searchTeachers(text, limit);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск студентов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QFuture<QList<StudentRecord>> Результаты поиска
+ */
+QFuture<QList<StudentRecord>> AsyncDatabaseManager::searchStudents(const QString &text, int limit)
+{
+    return runParallel<QList<StudentRecord>>([text, limit](DatabaseManager *db) {
+        return db->searchStudents(text, limit);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск предметов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QFuture<QList<SubjectRecord>> Результаты поиска
+ */
+QFuture<QList<SubjectRecord>> AsyncDatabaseManager::searchSubjects(const QString &text, int limit)
+{
+    return runParallel<QList<SubjectRecord>>([text, limit](DatabaseManager *db) {
+        return db->searchSubjects(text, limit);
+    });
+}
+
+/**
+ * @brief Открытие курсора по студентам
+ * @return QFuture<qint64> Количество строк или -1
+ */
+QFuture<qint64> AsyncDatabaseManager::openStudentCursor()
+{
+    return run<qint64>([](DatabaseManager *db) {
+        return db->openStudentCursor();
+    });
+}
+
+/**
+ * @brief Чтение окна строк курсора
+ * @param offset Номер первой строки
+ * @param limit Максимальное количество строк
+ * @return QFuture<QList<StudentRecord>> Строки окна
+ */
+QFuture<QList<StudentRecord>> AsyncDatabaseManager::fetchStudentCursor(qint64 offset, int limit)
+{
+    return run<QList<StudentRecord>>([offset, limit](DatabaseManager *db) {
+        return db->fetchStudentCursor(offset, limit);
+    });
+}
+
+/**
+ * @brief Закрытие курсора по студентам
+ * @return QFuture<bool> Всегда true
+ */
+QFuture<bool> AsyncDatabaseManager::closeStudentCursor()
+{
+    return run<bool>([](DatabaseManager *db) {
+        db->closeStudentCursor();
+        return true;
+    });
+}
+
+/**
+ * @brief Запись студента на предмет
+ * @param studentId Идентификатор студента
+ * @param subjectId Идентификатор предмета
+ * @param grade Оценка или 0
+ * @return QFuture<bool> Результат операции
+ */
+QFuture<bool> AsyncDatabaseManager::enrollStudent(int studentId, int subjectId, int grade)
+{
+    return run<bool>([studentId, subjectId, grade](DatabaseManager *db) {
+        return db->enrollStudent(studentId, subjectId, grade);
+    });
+}
+
+/**
+ * @brief Назначение преподавателя на предмет
+ * @param teacherId Идентификатор преподавателя
+ * @param subjectId Идентификатор предмета
+ * @return QFuture<bool> Результат операции
+ */
+QFuture<bool> AsyncDatabaseManager::assignTeacher(int teacherId, int subjectId)
+{
+    return run<bool>([teacherId, subjectId](DatabaseManager *db) {
+        return db->assignTeacher(teacherId, subjectId);
+    });
+}
+
+/**
+ * @brief Получение состава предмета
+ * @param subjectId Идентификатор предмета
+ * @return QFuture<QList<RosterEntry>> Строки состава
+ */
+QFuture<QList<RosterEntry>> AsyncDatabaseManager::getSubjectRoster(int subjectId)
+{
+    return runParallel<QList<RosterEntry>>([subjectId](DatabaseManager *db) {
+        return db->getSubjectRoster(subjectId);
+    });
+}
+
+/**
+ * @brief Пересборка составов предметов
+ * @return QFuture<bool> Результат операции
+ */
+QFuture<bool> AsyncDatabaseManager::refreshRosters()
+{
+    return runParallel<bool>([](DatabaseManager *db) {
+        return db->refreshRosters();
+    });
+}
+
+/**
+ * @brief Планирование пересборки составов предметов
+ */
+void AsyncDatabaseManager::scheduleRosterRefresh()
+{
+    if (m_rosterRefreshing) {
+        m_rosterStale = true;
+    } else if (!m_rosterTimer.isActive()) {
+        m_rosterTimer.start();
+    }
+}
+
+/**
+ * @brief Получение количества строк по таблицам
+ * @param mode Способ подсчета
+ * @return QFuture<RecordCounts> Количество строк
+ */
+QFuture<RecordCounts> AsyncDatabaseManager::getRecordCounts(DatabaseManager::CountMode mode)
+{
+    return runParallel<RecordCounts>([mode](DatabaseManager *db) {
+        return db->getRecordCounts(mode);
+    });
+}
+
+/**
+ * @brief Получение общего количества записей
+ * @return QFuture<int> Суммарное количество записей во всех таблицах
+ */
+QFuture<int> AsyncDatabaseManager::getTotalRecords()
+{
+    return runParallel<int>([](DatabaseManager *db) {
+        return db->getTotalRecords();
+    });
+}
+
+/**
+ * @brief Получение распределения оценок
+ * @param limit Сколько студентов вернуть с каждого края
+ * @return QFuture<GradeSummary> Гистограмма и крайние студенты
+ */
+QFuture<GradeSummary> AsyncDatabaseManager::getGradeSummary(int limit)
+{
+    return runParallel<GradeSummary>([limit](DatabaseManager *db) {
+        return db->getGradeSummary(limit);
+    });
+}
+
+/**
+ * @brief Выполнение пакета операций записи
+ * @param operations Операции
+ * @return QFuture<QList<WriteResult>> Результаты по операциям
+ */
+QFuture<QList<WriteResult>> AsyncDatabaseManager::applyWrites(const QList<WriteOperation> &operations)
+{
+    return run<QList<WriteResult>>([operations](DatabaseManager *db) {
+        return db->applyWrites(operations);
+    });
+}
+
+/**
+ * @brief Постановка операции записи в очередь
+ * @param operation Операция
+ * @return QFuture<WriteResult> Результат операции
+ */
+QFuture<WriteResult> AsyncDatabaseManager::enqueueWrite(const WriteOperation &operation)
+{
+    return m_writeBatcher->enqueue(operation);
+}
+
+/**
+ * @brief Получение очереди пакетной записи
+ * @return WriteBatcher* Очередь
+ */
+WriteBatcher *AsyncDatabaseManager::writeBatcher() const
+{
+    return m_writeBatcher;
+}
@@ -0,0 +1,658 @@
+/**
+ * @file AsyncDatabaseManager.h
+ * @brief Заголовочный файл класса AsyncDatabaseManager
+ * @ingroup Models
+ *
+ * @class AsyncDatabaseManager
+ * @brief Асинхронная обертка над DatabaseManager
+ *
+ * Отвечает за:
+ * - Запуск DatabaseManager в отдельном рабочем потоке
+ * - Параллельное выполнение операций чтения в пуле потоков
+ * - Возврат результатов операций через QFuture
+ *
+ * Операции записи ставятся в очередь рабочего потока и выполняются по порядку.
+ * Записи из интерфейса дополнительно собираются WriteBatcher в пакеты,
+ * каждый пакет выполняется одной транзакцией (enqueueWrite()).
+ * Операции чтения выполняются в пуле потоков, каждый поток получает
+ * собственное соединение из ConnectionPool, поэтому таблицы загружаются
+ * одновременно, а долгое чтение не задерживает запись.
+ * Размер пула соединений задается переменной окружения UNIVERSITY_DB_POOL_SIZE,
+ * хранилище — переменной UNIVERSITY_DB_STORAGE (см. StorageBackend::create()).
+ *
+ * Подключение ограничено таймаутом (UNIVERSITY_DB_CONNECT_TIMEOUT, секунды).
+ * Неудачная попытка повторяется с экспоненциальной задержкой от
+ * INITIAL_RETRY_DELAY до MAX_RETRY_DELAY, пока подключение не удастся.
+ * Текущее состояние сообщает connectionState().
+ * После изменения записей на предметы, назначений или удаления записей
+ * составы предметов пересобираются в пуле потоков не чаще одного раза
+ * за ROSTER_REFRESH_DELAY, о завершении сообщает rostersRefreshed().
+ * GUI поток не блокируется на время обращения к PostgreSQL.
+ * Результат удобно получать через QFuture::then() с контекстным объектом,
+ * тогда продолжение выполнится в потоке получателя.
+ */
+
+#ifndef ASYNCDATABASEMANAGER_H
+#define ASYNCDATABASEMANAGER_H
+
+#include <QObject>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QFuture>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+#include "DatabaseManager.h"
+#include "WriteBatcher.h"
+
+class AsyncDatabaseManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Состояние подключения
+     */
+    enum ConnectionState {
+        Disconnected,   ///< Подключение не запрашивалось
+        Connecting,     ///< Идет попытка подключения
+        Connected,      ///< Подключено
+        Retrying        ///< Попытка не удалась, ожидание повтора
+    };
+    Q_ENUM(ConnectionState)
+
+    /**
+     * @brief Задержка перед первым повтором подключения, мс
+     */
+    static constexpr int INITIAL_RETRY_DELAY = 1000;
+
+    /**
+     * @brief Максимальная задержка между повторами подключения, мс
+     */
+    static constexpr int MAX_RETRY_DELAY = 30000;
+
+    /**
+     * @brief Задержка пересборки составов после изменения, мс
+     * @details Изменения за это время пересобираются одним REFRESH
+     */
+    static constexpr int ROSTER_REFRESH_DELAY = 500;
+
+    /**
+     * @brief Конструктор класса AsyncDatabaseManager
+     * @param parent Родительский QObject
+     *
+     * @details Создает DatabaseManager и запускает рабочий поток
+     */
+    explicit AsyncDatabaseManager(QObject *parent = nullptr);
+
+    /**
+     * @brief Деструктор класса AsyncDatabaseManager
+     * @details Дожидается операций чтения, останавливает рабочий поток
+     * и дожидается его завершения. DatabaseManager удаляется внутри рабочего потока.
+     */
+    ~AsyncDatabaseManager();
+
+    /**
+     * @brief Проверить подключение к базе данных
+     * @return bool true если последнее подключение было успешным
+     *
+     * @note Значение обновляется в потоке владельца по сигналу databaseConnected
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Получить долю попаданий в кэш подготовленных запросов
+     * @return double Значение от 0 до 1
+     *
+     * @note Счетчики атомарные, метод можно вызывать из потока владельца
+     */
+    double statementCacheHitRate() const;
+
+    /**
+     * @brief Получить название хранилища
+     * @return QString Название, например "PostgreSQL" или "Память"
+     */
+    QString storageName() const;
+
+    /**
+     * @brief Получить снимок статистики операций хранилища
+     * @return QVariantMap Снимок QueryMetrics::snapshot()
+     *
+     * @note Статистика синхронизирована, метод можно вызывать из потока владельца
+     */
+    QVariantMap queryMetrics() const;
+
+    /**
+     * @brief Получить статистику операций хранилища в JSON
+     * @return QJsonObject Снимок QueryMetrics::toJson()
+     */
+    QJsonObject queryMetricsJson() const;
+
+    /**
+     * @brief Получить порог медленного запроса
+     * @return int Миллисекунды, 0 — журнал отключен
+     */
+    int slowQueryThreshold() const;
+
+    /**
+     * @brief Задать порог медленного запроса
+     * @param msecs Миллисекунды, 0 отключает журнал
+     */
+    void setSlowQueryThreshold(int msecs);
+
+    /**
+     * @brief Получить состояние подключения
+     * @return ConnectionState Состояние
+     */
+    ConnectionState connectionState() const;
+
+    /**
+     * @brief Получить задержку до следующей попытки подключения
+     * @return int Задержка в миллисекундах или 0, если повтор не запланирован
+     */
+    int retryDelay() const;
+
+    /**
+     * @brief Подключиться к базе данных в рабочем потоке
+     * @return QFuture<bool> Результат подключения
+     *
+     * @details Отменяет запланированный повтор. При неудаче следующий
+     * повтор планируется автоматически.
+     */
+    QFuture<bool> connectToDatabase();
+
+    // Teacher operations
+
+    /**
+     * @brief Получить всех преподавателей
+     * @return QFuture<QList<TeacherRecord>> Список преподавателей
+     */
+    QFuture<QList<TeacherRecord>> getAllTeachers();
+
+    /**
+     * @brief Получить страницу преподавателей (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QFuture<QList<TeacherRecord>> Записи с id больше afterId
+     */
+    QFuture<QList<TeacherRecord>> getTeachersPage(int afterId, int limit);
+
+    /**
+     * @brief Добавить нового преподавателя
+     * @param fullName Полное имя преподавателя
+     * @param department Кафедра преподавателя
+     * @return QFuture<TeacherRecord> Добавленная запись или невалидная запись при ошибке
+     */
+    QFuture<TeacherRecord> addTeacher(const QString &fullName, const QString &department);
+
+    /**
+     * @brief Добавить пакет преподавателей одной транзакцией
+     * @param records Новые записи (поле id игнорируется)
+     * @return QFuture<QList<int>> Идентификаторы добавленных записей или пустой список при ошибке
+     */
+    QFuture<QList<int>> addTeachers(const QList<TeacherRecord> &records);
+
+    /**
+     * @brief Удалить преподавателя по ID
+     * @param id Идентификатор преподавателя
+     * @return QFuture<int> Идентификатор удаленной записи или 0
+     */
+    QFuture<int> deleteTeacher(int id);
+
+    /**
+     * @brief Найти преподавателя по ID
+     * @param id Идентификатор преподавателя
+     * @return QFuture<TeacherRecord> Найденная запись или невалидная запись
+     */
+    QFuture<TeacherRecord> getTeacherById(int id);
+
+    /**
+     * @brief Удалить преподавателей по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<WriteResult>> Результат по каждому id в порядке ids
+     *
+     * @details Операции, накопленные в очереди пакетной записи, отправляются
+     * раньше, чтобы порядок записи совпадал с порядком вызовов
+     */
+    QFuture<QList<WriteResult>> deleteTeachers(const QList<int> &ids);
+
+    /**
+     * @brief Найти преподавателей по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<TeacherRecord>> Найденные записи в порядке возрастания id
+     */
+    QFuture<QList<TeacherRecord>> getTeachersByIds(const QList<int> &ids);
+
+    // Student operations
+
+    /**
+     * @brief Получить всех студентов
+     * @return QFuture<QList<StudentRecord>> Список студентов
+     */
+    QFuture<QList<StudentRecord>> getAllStudents();
+
+    /**
+     * @brief Получить страницу студентов (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QFuture<QList<StudentRecord>> Записи с id больше afterId
+     */
+    QFuture<QList<StudentRecord>> getStudentsPage(int afterId, int limit);
+
+    /**
+     * @brief Добавить нового студента
+     * @param fullName Полное имя студента
+     * @param grade Оценка студента (1-5)
+     * @return QFuture<StudentRecord> Добавленная запись или невалидная запись при ошибке
+     */
+    QFuture<StudentRecord> addStudent(const QString &fullName, int grade);
+
+    /**
+     * @brief Добавить пакет студентов одной транзакцией
+     * @param records Новые записи (поле id игнорируется)
+     * @return QFuture<QList<int>> Идентификаторы добавленных записей или пустой список при ошибке
+     */
+    QFuture<QList<int>> addStudents(const QList<StudentRecord> &records);
+
+    /**
+     * @brief Удалить студента по ID
+     * @param id Идентификатор студента
+     * @return QFuture<int> Идентификатор удаленной записи или 0
+     */
+    QFuture<int> deleteStudent(int id);
+
+    /**
+     * @brief Найти студента по ID
+     * @param id Идентификатор студента
+     * @return QFuture<StudentRecord> Найденная запись или невалидная запись
+     */
+    QFuture<StudentRecord> getStudentById(int id);
+
+    /**
+     * @brief Удалить студентов по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<WriteResult>> Результат по каждому id в порядке ids
+     *
+     * @details Операции, накопленные в очереди пакетной записи, отправляются
+     * раньше, чтобы порядок записи совпадал с порядком вызовов
+     */
+    QFuture<QList<WriteResult>> deleteStudents(const QList<int> &ids);
+
+    /**
+     * @brief Найти студентов по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<StudentRecord>> Найденные записи в порядке возрастания id
+     */
+    QFuture<QList<StudentRecord>> getStudentsByIds(const QList<int> &ids);
+
+    // Subject operations
+
+    /**
+     * @brief Получить все предметы
+     * @return QFuture<QList<SubjectRecord>> Список предметов
+     */
+    QFuture<QList<SubjectRecord>> getAllSubjects();
+
+    /**
+     * @brief Получить страницу предметов (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QFuture<QList<SubjectRecord>> Записи с id больше afterId
+     */
+    QFuture<QList<SubjectRecord>> getSubjectsPage(int afterId, int limit);
+
+    /**
+     * @brief Добавить новый предмет
+     * @param name Название предмета
+     * @return QFuture<SubjectRecord> Добавленная запись или невалидная запись при ошибке
+     */
+    QFuture<SubjectRecord> addSubject(const QString &name);
+
+    /**
+     * @brief Добавить пакет предметов одной транзакцией
+     * @param records Новые записи (поле id игнорируется)
+     * @return QFuture<QList<int>> Идентификаторы добавленных записей или пустой список при ошибке
+     */
+    QFuture<QList<int>> addSubjects(const QList<SubjectRecord> &records);
+
+    /**
+     * @brief Удалить предмет по ID
+     * @param id Идентификатор предмета
+     * @return QFuture<int> Идентификатор удаленной записи или 0
+     */
+    QFuture<int> deleteSubject(int id);
+
+    /**
+     * @brief Найти предмет по ID
+     * @param id Идентификатор предмета
+     * @return QFuture<SubjectRecord> Найденная запись или невалидная запись
+     */
+    QFuture<SubjectRecord> getSubjectById(int id);
+
+    /**
+     * @brief Удалить предметы по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<WriteResult>> Результат по каждому id в порядке ids
+     *
+     * @details Операции, накопленные в очереди пакетной записи, отправляются
+     * раньше, чтобы порядок записи совпадал с порядком вызовов
+     */
+    QFuture<QList<WriteResult>> deleteSubjects(const QList<int> &ids);
+
+    /**
+     * @brief Найти предметы по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QFuture<QList<SubjectRecord>> Найденные записи в порядке возрастания id
+     */
+    QFuture<QList<SubjectRecord>> getSubjectsByIds(const QList<int> &ids);
+
+    // Search
+
+    /**
+     * @brief Нечеткий поиск преподавателей
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QFuture<QList<TeacherRecord>> Записи по убыванию сходства
+     *
+     * @note QFuture::cancel() до начала выполнения отменяет запрос к БД
+     */
+    QFuture<QList<TeacherRecord>> searchTeachers(const QString &text, int limit);
+
+    /**
+     * @brief Нечеткий поиск студентов
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QFuture<QList<StudentRecord>> Записи по убыванию сходства
+     *
+     * @note QFuture::cancel() до начала выполнения отменяет запрос к БД
+     */
+    QFuture<QList<StudentRecord>> searchStudents(const QString &text, int limit);
+
+    /**
+     * @brief Нечеткий поиск предметов
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QFuture<QList<SubjectRecord>> Записи по убыванию сходства
+     *
+     * @note QFuture::cancel() до начала выполнения отменяет запрос к БД
+     */
+    QFuture<QList<SubjectRecord>> searchSubjects(const QString &text, int limit);
+
+    // Cursor browsing
+
+    /**
+     * @brief Открыть курсор по студентам
+     * @return QFuture<qint64> Количество строк в снимке или -1, если курсоры
+     * не поддерживаются хранилищем
+     *
+     * @details Курсор живет в рабочем потоке, окна читаются по очереди с записью
+     */
+    QFuture<qint64> openStudentCursor();
+
+    /**
+     * @brief Прочитать окно строк курсора по студентам
+     * @param offset Номер первой строки, начиная с 0
+     * @param limit Максимальное количество строк
+     * @return QFuture<QList<StudentRecord>> Строки окна
+     *
+     * @note QFuture::cancel() до начала выполнения отменяет чтение
+     */
+    QFuture<QList<StudentRecord>> fetchStudentCursor(qint64 offset, int limit);
+
+    /**
+     * @brief Закрыть курсор по студентам
+     * @return QFuture<bool> Завершается после закрытия
+     */
+    QFuture<bool> closeStudentCursor();
+
+    // Enrollments and rosters
+
+    /**
+     * @brief Записать студента на предмет или изменить его оценку
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка от 1 до 5 или 0
+     * @return QFuture<bool> Результат записи
+     */
+    QFuture<bool> enrollStudent(int studentId, int subjectId, int grade);
+
+    /**
+     * @brief Назначить преподавателя на предмет
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return QFuture<bool> Результат назначения
+     */
+    QFuture<bool> assignTeacher(int teacherId, int subjectId);
+
+    /**
+     * @brief Получить состав предмета
+     * @param subjectId Идентификатор предмета
+     * @return QFuture<QList<RosterEntry>> Строки состава
+     */
+    QFuture<QList<RosterEntry>> getSubjectRoster(int subjectId);
+
+    /**
+     * @brief Пересобрать составы предметов в пуле потоков
+     * @return QFuture<bool> Результат пересборки
+     *
+     * @details Пересборка идет на соединении потока чтения и не задерживает
+     * очередь записи. Обычно вызывается автоматически, см. ROSTER_REFRESH_DELAY.
+     */
+    QFuture<bool> refreshRosters();
+
+    // Statistics
+
+    /**
+     * @brief Получить количество строк в каждой таблице
+     * @param mode Точные счетчики или оценка планировщика
+     * @return QFuture<RecordCounts> Количество строк
+     */
+    QFuture<RecordCounts> getRecordCounts(DatabaseManager::CountMode mode = DatabaseManager::CountMode::Exact);
+
+    /**
+     * @brief Получить общее количество записей во всех таблицах
+     * @return QFuture<int> Суммарное количество записей
+     */
+    QFuture<int> getTotalRecords();
+
+    /**
+     * @brief Получить распределение оценок и крайних по оценке студентов
+     * @param limit Сколько студентов вернуть с каждого края
+     * @return QFuture<GradeSummary> Гистограмма и крайние студенты
+     */
+    QFuture<GradeSummary> getGradeSummary(int limit);
+
+    // Batched writes
+
+    /**
+     * @brief Выполнить пакет операций записи в одной транзакции
+     * @param operations Операции в порядке выполнения
+     * @return QFuture<QList<WriteResult>> Результаты в порядке operations
+     */
+    QFuture<QList<WriteResult>> applyWrites(const QList<WriteOperation> &operations);
+
+    /**
+     * @brief Поставить операцию записи в очередь пакетной записи
+     * @param operation Операция
+     * @return QFuture<WriteResult> Результат после фиксации пакета
+     *
+     * @details Изменения моделям сообщаются сигналами *sAdded и *sDeleted
+     * по одному на таблицу и пакет
+     */
+    QFuture<WriteResult> enqueueWrite(const WriteOperation &operation);
+
+    /**
+     * @brief Получить очередь пакетной записи
+     * @return WriteBatcher* Очередь, принадлежит менеджеру
+     */
+    WriteBatcher *writeBatcher() const;
+
+signals:
+    /**
+     * @brief Сигнал о изменении состояния подключения к БД
+     * @param success true если подключение успешно установлено
+     */
+    void databaseConnected(bool success);
+
+    /**
+     * @brief Сигнал об изменении состояния подключения
+     * @param state Новое состояние
+     */
+    void connectionStateChanged(AsyncDatabaseManager::ConnectionState state);
+
+    /**
+     * @brief Сигнал о добавлении записи в таблицу teachers
+     * @param record Добавленная запись
+     */
+    void teacherAdded(const TeacherRecord &record);
+
+    /**
+     * @brief Сигнал об удалении записи из таблицы teachers
+     * @param id Идентификатор удаленной записи
+     */
+    void teacherDeleted(int id);
+
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу teachers
+     * @param records Добавленные записи в порядке возрастания id
+     */
+    void teachersAdded(const QList<TeacherRecord> &records);
+
+    /**
+     * @brief Сигнал о добавлении записи в таблицу students
+     * @param record Добавленная запись
+     */
+    void studentAdded(const StudentRecord &record);
+
+    /**
+     * @brief Сигнал об удалении записи из таблицы students
+     * @param record Удаленная запись
+     */
+    void studentDeleted(const StudentRecord &record);
+
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу students
+     * @param records Добавленные записи в порядке возрастания id
+     */
+    void studentsAdded(const QList<StudentRecord> &records);
+
+    /**
+     * @brief Сигнал о добавлении записи в таблицу subjects
+     * @param record Добавленная запись
+     */
+    void subjectAdded(const SubjectRecord &record);
+
+    /**
+     * @brief Сигнал об удалении записи из таблицы subjects
+     * @param id Идентификатор удаленной записи
+     */
+    void subjectDeleted(int id);
+
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу subjects
+     * @param records Добавленные записи в порядке возрастания id
+     */
+    void subjectsAdded(const QList<SubjectRecord> &records);
+
+    /**
+     * @brief Сигнал об изменении записей таблицы teachers другим клиентом
+     * @param records Новые значения записей
+     */
+    void teachersUpdated(const QList<TeacherRecord> &records);
+
+    /**
+     * @brief Сигнал об удалении записей из таблицы teachers другим клиентом
+     * @param ids Идентификаторы удаленных записей
+     */
+    void teachersDeleted(const QList<int> &ids);
+
+    /**
+     * @brief Сигнал об изменении записей таблицы students другим клиентом
+     * @param records Новые значения записей
+     * @param previousGrades Оценки до изменения в порядке records, 0 если неизвестна
+     */
+    void studentsUpdated(const QList<StudentRecord> &records, const QList<int> &previousGrades);
+
+    /**
+     * @brief Сигнал об удалении записей из таблицы students другим клиентом
+     * @param records Удаленные записи; об удалениях другими клиентами известны
+     * только id и оценка (0, если неизвестна)
+     */
+    void studentsDeleted(const QList<StudentRecord> &records);
+
+    /**
+     * @brief Сигнал об изменении записей таблицы subjects другим клиентом
+     * @param records Новые значения записей
+     */
+    void subjectsUpdated(const QList<SubjectRecord> &records);
+
+    /**
+     * @brief Сигнал об удалении записей из таблицы subjects другим клиентом
+     * @param ids Идентификаторы удаленных записей
+     */
+    void subjectsDeleted(const QList<int> &ids);
+
+    /**
+     * @brief Сигнал о том, что таблицу нужно перечитать целиком
+     * @param table Имя таблицы
+     */
+    void tableReloadRequired(const QString &table);
+
+    /**
+     * @brief Сигнал о завершении автоматической пересборки составов
+     * @param success true если составы пересобраны
+     */
+    void rostersRefreshed(bool success);
+
+private:
+    /**
+     * @brief Выполнить функцию в рабочем потоке
+     * @tparam Result Тип результата
+     * @tparam Function Тип функции вида Result(DatabaseManager *)
+     * @param function Функция, выполняемая над DatabaseManager
+     * @return QFuture<Result> Результат выполнения
+     */
+    template <typename Result, typename Function>
+    QFuture<Result> run(Function function);
+
+    /**
+     * @brief Выполнить функцию чтения в пуле потоков
+     * @tparam Result Тип результата
+     * @tparam Function Тип функции вида Result(DatabaseManager *)
+     * @param function Функция, выполняемая над DatabaseManager
+     * @return QFuture<Result> Результат выполнения
+     *
+     * @note Функция не должна испускать сигналы DatabaseManager
+     */
+    template <typename Result, typename Function>
+    QFuture<Result> runParallel(Function function);
+
+    /**
+     * @brief Сменить состояние подключения
+     * @param state Новое состояние
+     */
+    void setConnectionState(ConnectionState state);
+
+    /**
+     * @brief Запланировать пересборку составов предметов
+     *
+     * @details Если пересборка уже идет, следующая начнется после нее
+     */
+    void scheduleRosterRefresh();
+
+    QThread m_thread;               ///< Рабочий поток базы данных
+    DatabaseManager *m_manager;     ///< Менеджер БД, живущий в рабочем потоке
+    QThreadPool *m_readPool;        ///< Потоки для параллельного чтения
+    WriteBatcher *m_writeBatcher;   ///< Очередь пакетной записи
+    bool m_connected;               ///< Кэшированное состояние подключения
+    ConnectionState m_state;        ///< Состояние подключения
+    QTimer m_retryTimer;            ///< Таймер повтора подключения
+    int m_retryAttempt;             ///< Номер неудачной попытки подряд
+    QTimer m_rosterTimer;           ///< Отложенная пересборка составов
+    bool m_rosterRefreshing;        ///< Пересборка составов выполняется
+    bool m_rosterStale;             ///< Составы изменились во время пересборки
+};
+
+#endif // ASYNCDATABASEMANAGER_H
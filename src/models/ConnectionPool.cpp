@@ -0,0 +1,410 @@
+/**
+ * @file ConnectionPool.cpp
+ * @brief Реализация класса ConnectionPool
+ * @ingroup Models
+ */
+
+#include "ConnectionPool.h"
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QThread>
+
+/**
+ * @brief Конструктор ConnectionPool
+ * @param settings Параметры подключения
+ * @param parent Родительский QObject
+ */
+ConnectionPool::ConnectionPool(const ConnectionSettings &settings, QObject *parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_maxConnections(DEFAULT_MAX_CONNECTIONS)
+    , m_healthCheckInterval(DEFAULT_HEALTH_CHECK_INTERVAL)
+    , m_nextId(0)
+    , m_statementHits(0)
+    , m_statementMisses(0)
+{
+}
+
+/**
+ * @brief Деструктор ConnectionPool
+ *
+ * @details Соединения других потоков удалить отсюда нельзя:
+ * QSqlDatabase закрывается только в своем потоке
+ */
+ConnectionPool::~ConnectionPool()
+{
+    removeSlot(QThread::currentThread());
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_slots.isEmpty()) {
+        qWarning() << "Пул соединений удален при" << m_slots.size() << "открытых соединениях других потоков";
+    }
+}
+
+/**
+ * @brief Получение соединения текущего потока
+ * @return QSqlDatabase Соединение потока
+ */
+QSqlDatabase ConnectionPool::database()
+{
+    QThread *thread = QThread::currentThread();
+    ConnectionSettings settings;
+    QString name;
+    std::shared_ptr<StatementCache> statements;
+    bool created = false;
+    bool needsCheck = false;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_slots.find(thread);
+        if (it == m_slots.end()) {
+            if (m_slots.size() >= m_maxConnections) {
+                m_lastError = QString("Пул соединений исчерпан (%1)").arg(m_maxConnections);
+                qWarning() << m_lastError;
+                return QSqlDatabase();
+            }
+            Slot slot;
+            // Адрес пула в имени разделяет соединения нескольких пулов процесса
+            slot.name = QString("university_connection_%1_%2")
+                            .arg(reinterpret_cast<quintptr>(this), 0, 16)
+                            .arg(++m_nextId);
+            slot.statements = std::make_shared<StatementCache>();
+            it = m_slots.insert(thread, slot);
+            created = true;
+            settings = m_settings;
+        } else {
+            needsCheck = !it->lastUsed.isValid() || it->lastUsed.elapsed() >= m_healthCheckInterval;
+        }
+        name = it->name;
+        statements = it->statements;
+    }
+
+    if (created) {
+        // Соединение закрывается в завершающемся потоке, пока он еще владеет им
+        connect(thread, &QThread::finished, this, [this, thread]() {
+            removeSlot(thread);
+        }, Qt::DirectConnection);
+
+        addDatabase(settings, name);
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(name, false);
+    if (!db.isOpen()) {
+        statements->clear();
+        open(db);
+    } else if (needsCheck && !isAlive(db)) {
+        qWarning() << "Соединение" << name << "не отвечает, переподключение";
+        // Подготовленные запросы принадлежат старому сеансу сервера
+        statements->clear();
+        db.close();
+        open(db);
+    }
+
+    if (db.isOpen()) {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_slots.find(thread);
+        if (it != m_slots.end()) {
+            it->lastUsed.restart();
+        }
+    }
+
+    return db;
+}
+
+/**
+ * @brief Закрытие соединения текущего потока
+ */
+void ConnectionPool::releaseDatabase()
+{
+    removeSlot(QThread::currentThread());
+}
+
+/**
+ * @brief Открытие отдельного соединения
+ * @param purpose Назначение соединения
+ * @return QString Имя соединения или пустая строка
+ */
+QString ConnectionPool::openDedicated(const QString &purpose)
+{
+    ConnectionSettings settings;
+    QString name;
+    {
+        QMutexLocker locker(&m_mutex);
+        settings = m_settings;
+        name = QString("university_%1_%2_%3")
+                   .arg(purpose)
+                   .arg(reinterpret_cast<quintptr>(this), 0, 16)
+                   .arg(++m_nextId);
+    }
+
+    {
+        QSqlDatabase db = addDatabase(settings, name);
+        if (db.open()) {
+            return name;
+        }
+        QMutexLocker locker(&m_mutex);
+        m_lastError = db.lastError().text();
+    }
+    QSqlDatabase::removeDatabase(name);
+    return QString();
+}
+
+/**
+ * @brief Закрытие отдельного соединения
+ * @param name Имя соединения
+ */
+void ConnectionPool::closeDedicated(const QString &name)
+{
+    if (name.isEmpty()) {
+        return;
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        if (db.isOpen()) {
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
+/**
+ * @brief Получение подготовленного запроса
+ * @param sql Текст запроса
+ * @return QSqlQuery* Запрос или nullptr
+ */
+QSqlQuery *ConnectionPool::statement(const QString &sql)
+{
+    QSqlDatabase db = database();
+    if (!db.isOpen()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<StatementCache> statements;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_slots.constFind(QThread::currentThread());
+        if (it == m_slots.constEnd()) {
+            return nullptr;
+        }
+        statements = it->statements;
+    }
+
+    bool hit = false;
+    QSqlQuery *query = statements->prepare(db, sql, &hit);
+    if (hit) {
+        m_statementHits.fetchAndAddRelaxed(1);
+    } else {
+        m_statementMisses.fetchAndAddRelaxed(1);
+    }
+    return query;
+}
+
+/**
+ * @brief Получение количества попаданий в кэш
+ * @return quint64 Количество попаданий
+ */
+quint64 ConnectionPool::statementCacheHits() const
+{
+    return m_statementHits.loadRelaxed();
+}
+
+/**
+ * @brief Получение количества промахов кэша
+ * @return quint64 Количество промахов
+ */
+quint64 ConnectionPool::statementCacheMisses() const
+{
+    return m_statementMisses.loadRelaxed();
+}
+
+/**
+ * @brief Получение доли попаданий в кэш
+ * @return double Доля попаданий или 0, если запросов еще не было
+ */
+double ConnectionPool::statementCacheHitRate() const
+{
+    const quint64 hits = statementCacheHits();
+    const quint64 total = hits + statementCacheMisses();
+    return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+}
+
+/**
+ * @brief Получение параметров подключения
+ * @return ConnectionSettings Параметры подключения
+ */
+ConnectionSettings ConnectionPool::settings() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_settings;
+}
+
+/**
+ * @brief Получение размера пула
+ * @return int Максимальное количество соединений
+ */
+int ConnectionPool::maxConnections() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxConnections;
+}
+
+/**
+ * @brief Установка размера пула
+ * @param maxConnections Максимальное количество соединений
+ */
+void ConnectionPool::setMaxConnections(int maxConnections)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxConnections = qMax(1, maxConnections);
+}
+
+/**
+ * @brief Получение количества созданных соединений
+ * @return int Количество соединений
+ */
+int ConnectionPool::connectionCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_slots.size();
+}
+
+/**
+ * @brief Получение интервала проверки соединения
+ * @return int Интервал в миллисекундах
+ */
+int ConnectionPool::healthCheckInterval() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_healthCheckInterval;
+}
+
+/**
+ * @brief Установка интервала проверки соединения
+ * @param msec Интервал в миллисекундах
+ */
+void ConnectionPool::setHealthCheckInterval(int msec)
+{
+    QMutexLocker locker(&m_mutex);
+    m_healthCheckInterval = qMax(0, msec);
+}
+
+/**
+ * @brief Установка таймаута установки соединения
+ * @param seconds Таймаут в секундах
+ */
+void ConnectionPool::setConnectTimeout(int seconds)
+{
+    QMutexLocker locker(&m_mutex);
+    m_settings.connectTimeout = qMax(0, seconds);
+}
+
+/**
+ * @brief Получение текста последней ошибки
+ * @return QString Текст ошибки
+ */
+QString ConnectionPool::lastError() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+/**
+ * @brief Установка функции, вызываемой после открытия соединения
+ * @param handler Функция
+ */
+void ConnectionPool::setOpenHandler(const OpenHandler &handler)
+{
+    m_openHandler = handler;
+}
+
+/**
+ * @brief Открытие соединения
+ * @param db Соединение
+ * @return bool Результат открытия
+ */
+bool ConnectionPool::open(QSqlDatabase &db)
+{
+    if (db.open()) {
+        if (m_openHandler) {
+            m_openHandler(db);
+        }
+        return true;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_lastError = db.lastError().text();
+    return false;
+}
+
+/**
+ * @brief Регистрация соединения с параметрами пула
+ * @param settings Параметры подключения
+ * @param name Имя соединения
+ * @return QSqlDatabase Соединение
+ */
+QSqlDatabase ConnectionPool::addDatabase(const ConnectionSettings &settings, const QString &name)
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase(settings.driver, name);
+    db.setHostName(settings.hostName);
+    db.setDatabaseName(settings.databaseName);
+    db.setUserName(settings.userName);
+    db.setPassword(settings.password);
+    QStringList options;
+    if (!settings.connectOptions.isEmpty()) {
+        options.append(settings.connectOptions);
+    }
+    if (settings.connectTimeout > 0 && settings.driver == "QPSQL") {
+        // libpq не принимает значения меньше 2 секунд
+        options.append(QString("connect_timeout=%1").arg(qMax(2, settings.connectTimeout)));
+    }
+    db.setConnectOptions(options.join(';'));
+    return db;
+}
+
+/**
+ * @brief Проверка соединения
+ * @param db Соединение
+ * @return bool true если сервер ответил на SELECT 1
+ */
+bool ConnectionPool::isAlive(QSqlDatabase &db) const
+{
+    QSqlQuery query(db);
+    return query.exec("SELECT 1");
+}
+
+/**
+ * @brief Удаление соединения потока
+ * @param thread Поток-владелец
+ *
+ * @note Должно вызываться из потока-владельца соединения
+ */
+void ConnectionPool::removeSlot(QThread *thread)
+{
+    QString name;
+    std::shared_ptr<StatementCache> statements;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_slots.find(thread);
+        if (it == m_slots.end()) {
+            return;
+        }
+        name = it->name;
+        statements = it->statements;
+        m_slots.erase(it);
+    }
+
+    // Запросы должны быть удалены раньше соединения
+    statements->clear();
+
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        if (db.isOpen()) {
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(name);
+}
@@ -0,0 +1,264 @@
+/**
+ * @file ConnectionPool.h
+ * @brief Заголовочный файл класса ConnectionPool
+ * @ingroup Models
+ *
+ * @class ConnectionPool
+ * @brief Пул соединений с базой данных, по одному соединению на поток
+ *
+ * QSqlDatabase нельзя использовать из потока, отличного от того, в котором
+ * соединение было создано. Пул выдает каждому потоку его собственное
+ * именованное соединение и:
+ * - ограничивает общее количество соединений (maxConnections)
+ * - проверяет соединение, простаивавшее дольше healthCheckInterval(),
+ *   запросом SELECT 1 и переоткрывает его при обрыве
+ * - закрывает и удаляет соединение при завершении потока
+ * - ограничивает время установки соединения (connect_timeout libpq),
+ *   чтобы недоступный сервер не держал поток до таймаута TCP
+ * - хранит для каждого соединения StatementCache и считает попадания в него
+ *
+ * Все методы потокобезопасны.
+ */
+
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <functional>
+#include <memory>
+#include "StatementCache.h"
+
+class QThread;
+
+/**
+ * @struct ConnectionSettings
+ * @brief Параметры подключения к базе данных
+ */
+struct ConnectionSettings
+{
+    QString driver = "QPSQL";           ///< Драйвер Qt SQL
+    QString hostName = "localhost";     ///< Хост
+    QString databaseName = "university";///< Имя БД
+    QString userName = "postgres";      ///< Пользователь
+    QString password = "1488";          ///< Пароль
+    int connectTimeout = 5;             ///< Таймаут установки соединения, с (0 — ждать без ограничения)
+    QString connectOptions;             ///< Дополнительные параметры драйвера (QSqlDatabase::setConnectOptions)
+};
+
+class ConnectionPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Функция, вызываемая после открытия соединения
+     * @details Вызывается в потоке-владельце соединения, в том числе
+     * после переподключения
+     */
+    using OpenHandler = std::function<void(QSqlDatabase &db)>;
+
+    /**
+     * @brief Размер пула по умолчанию
+     */
+    static constexpr int DEFAULT_MAX_CONNECTIONS = 4;
+
+    /**
+     * @brief Интервал проверки простаивающего соединения по умолчанию, мс
+     */
+    static constexpr int DEFAULT_HEALTH_CHECK_INTERVAL = 30000;
+
+    /**
+     * @brief Конструктор пула
+     * @param settings Параметры подключения
+     * @param parent Родительский QObject
+     */
+    explicit ConnectionPool(const ConnectionSettings &settings, QObject *parent = nullptr);
+
+    /**
+     * @brief Деструктор пула
+     * @details Закрывает соединение текущего потока. Соединения других потоков
+     * должны быть закрыты до этого завершением их потоков.
+     */
+    ~ConnectionPool();
+
+    /**
+     * @brief Получить соединение текущего потока
+     * @return QSqlDatabase Открытое соединение или невалидное/закрытое при ошибке
+     *
+     * @details При первом обращении потока создает и открывает соединение.
+     * Если соединение простаивало дольше healthCheckInterval(), проверяет его
+     * и при необходимости переоткрывает.
+     */
+    QSqlDatabase database();
+
+    /**
+     * @brief Закрыть и удалить соединение текущего потока
+     */
+    void releaseDatabase();
+
+    /**
+     * @brief Открыть отдельное соединение вне пула
+     * @param purpose Назначение соединения, входит в его имя
+     * @return QString Имя открытого соединения или пустая строка при ошибке
+     *
+     * @details Соединение не занимает место в пуле, не проходит через
+     * обработчик открытия (не подписывается на уведомления) и не проверяется.
+     * Оно нужно для долгих транзакций, например курсоров, которые иначе
+     * заняли бы соединение потока. Используется только в вызывающем потоке
+     * и закрывается closeDedicated() до удаления пула.
+     */
+    QString openDedicated(const QString &purpose);
+
+    /**
+     * @brief Закрыть отдельное соединение
+     * @param name Имя, полученное от openDedicated()
+     */
+    void closeDedicated(const QString &name);
+
+    /**
+     * @brief Получить подготовленный запрос на соединении текущего потока
+     * @param sql Текст запроса
+     * @return QSqlQuery* Запрос с курсором только вперед или nullptr,
+     * если соединение недоступно или запрос не удалось подготовить
+     *
+     * @details Запрос подготавливается один раз на соединение, при повторных
+     * вызовах возвращается тот же объект. Указатель действителен в текущем
+     * потоке до следующего переподключения.
+     */
+    QSqlQuery *statement(const QString &sql);
+
+    /**
+     * @brief Получить количество попаданий в кэш запросов
+     * @return quint64 Количество повторно использованных запросов
+     */
+    quint64 statementCacheHits() const;
+
+    /**
+     * @brief Получить количество промахов кэша запросов
+     * @return quint64 Количество подготовленных запросов
+     */
+    quint64 statementCacheMisses() const;
+
+    /**
+     * @brief Получить долю попаданий в кэш запросов
+     * @return double Значение от 0 до 1
+     */
+    double statementCacheHitRate() const;
+
+    /**
+     * @brief Получить параметры подключения
+     * @return ConnectionSettings Параметры подключения
+     */
+    ConnectionSettings settings() const;
+
+    /**
+     * @brief Получить максимальное количество соединений
+     * @return int Размер пула
+     */
+    int maxConnections() const;
+
+    /**
+     * @brief Установить максимальное количество соединений
+     * @param maxConnections Размер пула (не меньше 1)
+     */
+    void setMaxConnections(int maxConnections);
+
+    /**
+     * @brief Получить количество созданных соединений
+     * @return int Количество соединений
+     */
+    int connectionCount() const;
+
+    /**
+     * @brief Получить интервал проверки соединения
+     * @return int Интервал в миллисекундах
+     */
+    int healthCheckInterval() const;
+
+    /**
+     * @brief Установить интервал проверки соединения
+     * @param msec Интервал в миллисекундах (0 — проверять при каждом обращении)
+     */
+    void setHealthCheckInterval(int msec);
+
+    /**
+     * @brief Установить таймаут установки соединения
+     * @param seconds Таймаут в секундах (0 — без ограничения)
+     *
+     * @details Применяется к соединениям, созданным после вызова
+     */
+    void setConnectTimeout(int seconds);
+
+    /**
+     * @brief Получить текст последней ошибки подключения
+     * @return QString Текст ошибки
+     */
+    QString lastError() const;
+
+    /**
+     * @brief Установить функцию, вызываемую после открытия соединения
+     * @param handler Функция или пустой объект
+     *
+     * @note Устанавливается до первого обращения к database()
+     */
+    void setOpenHandler(const OpenHandler &handler);
+
+private:
+    /**
+     * @struct Slot
+     * @brief Соединение, закрепленное за потоком
+     */
+    struct Slot
+    {
+        QString name;               ///< Имя соединения в QSqlDatabase
+        QElapsedTimer lastUsed;     ///< Время последнего успешного обращения
+        std::shared_ptr<StatementCache> statements; ///< Подготовленные запросы соединения
+    };
+
+    /**
+     * @brief Открыть соединение
+     * @param db Соединение
+     * @return bool true если соединение открыто
+     */
+    bool open(QSqlDatabase &db);
+
+    /**
+     * @brief Зарегистрировать соединение с параметрами пула
+     * @param settings Параметры подключения
+     * @param name Имя соединения в QSqlDatabase
+     * @return QSqlDatabase Неоткрытое соединение
+     */
+    static QSqlDatabase addDatabase(const ConnectionSettings &settings, const QString &name);
+
+    /**
+     * @brief Проверить соединение запросом SELECT 1
+     * @param db Соединение
+     * @return bool true если соединение отвечает
+     */
+    bool isAlive(QSqlDatabase &db) const;
+
+    /**
+     * @brief Удалить соединение потока
+     * @param thread Поток-владелец
+     */
+    void removeSlot(QThread *thread);
+
+    mutable QMutex m_mutex;             ///< Защита полей пула
+    ConnectionSettings m_settings;      ///< Параметры подключения
+    QHash<QThread*, Slot> m_slots;      ///< Соединения по потокам
+    int m_maxConnections;               ///< Размер пула
+    int m_healthCheckInterval;          ///< Интервал проверки, мс
+    int m_nextId;                       ///< Счетчик для имен соединений
+    QString m_lastError;                ///< Последняя ошибка подключения
+    OpenHandler m_openHandler;          ///< Настройка открытого соединения
+    QAtomicInteger<quint64> m_statementHits;    ///< Попадания в кэш запросов
+    QAtomicInteger<quint64> m_statementMisses;  ///< Промахи кэша запросов
+};
+
+#endif // CONNECTIONPOOL_H
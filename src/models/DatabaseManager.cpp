@@ -5,54 +5,249 @@
  */
 
 #include "DatabaseManager.h"
+#include "QueryMetrics.h"
 #include <QDebug>
-#include <QSqlError>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Оценить объем данных записи преподавателя
+ * @param record Запись
+ * @return qint64 Байты полей
+ */
+static qint64 payloadBytes(const TeacherRecord &record)
+{
+    return sizeof(int) + (record.fullName.size() + record.department.size()) * sizeof(QChar);
+}
+
+/**
+ * @brief Оценить объем данных записи студента
+ * @param record Запись
+ * @return qint64 Байты полей
+ */
+static qint64 payloadBytes(const StudentRecord &record)
+{
+    return 2 * sizeof(int) + record.fullName.size() * sizeof(QChar);
+}
+
+/**
+ * @brief Оценить объем данных записи предмета
+ * @param record Запись
+ * @return qint64 Байты полей
+ */
+static qint64 payloadBytes(const SubjectRecord &record)
+{
+    return sizeof(int) + record.name.size() * sizeof(QChar);
+}
+
+/**
+ * @brief Оценить объем строки состава предмета
+ * @param entry Строка состава
+ * @return qint64 Байты полей
+ */
+static qint64 payloadBytes(const RosterEntry &entry)
+{
+    return 4 * sizeof(int) + (entry.studentName.size() + entry.teacherName.size()) * sizeof(QChar);
+}
+
+/**
+ * @brief Оценить объем идентификатора
+ * @return qint64 Байты
+ */
+static qint64 payloadBytes(int)
+{
+    return sizeof(int);
+}
+
+/**
+ * @brief Оценить объем счетчиков строк
+ * @return qint64 Байты
+ */
+static qint64 payloadBytes(const RecordCounts &)
+{
+    return sizeof(RecordCounts);
+}
+
+/**
+ * @brief Оценить объем списка
+ * @param values Записи или идентификаторы
+ * @return qint64 Сумма по элементам
+ */
+template <typename T>
+static qint64 payloadBytes(const QList<T> &values)
+{
+    qint64 bytes = 0;
+    for (const T &value : values) {
+        bytes += payloadBytes(value);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Количество строк в результате одиночной операции
+ * @param record Запись
+ * @return qint64 1 для валидной записи, иначе 0
+ */
+template <typename Record>
+static qint64 rowCount(const Record &record)
+{
+    return record.isValid() ? 1 : 0;
+}
+
+/**
+ * @brief Количество строк, затронутых удалением
+ * @param id Идентификатор удаленной записи или 0
+ * @return qint64 1 или 0
+ */
+static qint64 rowCount(int id)
+{
+    return id != 0 ? 1 : 0;
+}
+
+/**
+ * @brief Количество строк, затронутых записью связи
+ * @param ok Результат операции
+ * @return qint64 1 или 0
+ *
+ * @details Без этой перегрузки bool выбрал бы шаблон для записей
+ */
+static qint64 rowCount(bool ok)
+{
+    return ok ? 1 : 0;
+}
+
+/**
+ * @brief Количество строк в счетчиках
+ * @return qint64 Один результат
+ */
+static qint64 rowCount(const RecordCounts &)
+{
+    return 1;
+}
+
+/**
+ * @brief Количество строк в списке
+ * @param values Записи или идентификаторы
+ * @return qint64 Размер списка
+ */
+template <typename T>
+static qint64 rowCount(const QList<T> &values)
+{
+    return values.size();
+}
+
+/**
+ * @brief Количество строк в снимке открытого курсора
+ * @param cursor Курсор или nullptr
+ * @return qint64 Количество строк или 0
+ */
+template <typename Record>
+static qint64 rowCount(const std::unique_ptr<RecordCursor<Record>> &cursor)
+{
+    return cursor ? cursor->count() : 0;
+}
+
+/**
+ * @brief Объем данных при открытии курсора
+ * @return qint64 0: строки читаются позже окнами
+ */
+template <typename Record>
+static qint64 payloadBytes(const std::unique_ptr<RecordCursor<Record>> &)
+{
+    return 0;
+}
+
+/**
+ * @brief Сопоставить запрошенные id с удаленными
+ * @param ids Запрошенные идентификаторы
+ * @param deleted Удаленные идентификаторы по возрастанию
+ * @return QList<WriteResult> Результат по каждому запрошенному id
+ */
+static QList<WriteResult> deleteResults(const QList<int> &ids, const QList<int> &deleted)
+{
+    QList<WriteResult> results;
+    results.reserve(ids.size());
+    for (int id : ids) {
+        results.append({std::binary_search(deleted.cbegin(), deleted.cend(), id), id});
+    }
+    return results;
+}
+
+/**
+ * @brief Выполнить операцию хранилища и учесть ее в статистике
+ * @param storage Хранилище, в статистику которого пишется замер
+ * @param operation Название операции
+ * @param call Вызов хранилища
+ * @return Результат вызова
+ */
+template <typename Call>
+static auto measured(const StorageBackend *storage, const char *operation, Call call)
+{
+    QElapsedTimer timer;
+    timer.start();
+    auto result = call();
+    storage->metrics()->record(QLatin1String(operation), timer.nsecsElapsed() / 1000,
+                    rowCount(result), payloadBytes(result));
+    return result;
+}
 
 /**
  * @brief Конструктор DatabaseManager
  * @param parent Родительский QObject
- * 
- * @details Создает подключение к базе данных PostgreSQL с именем "university_connection"
  */
 DatabaseManager::DatabaseManager(QObject *parent)
+    : DatabaseManager(StorageBackend::create(), parent)
+{
+}
+
+/**
+ * @brief Конструктор DatabaseManager с заданным хранилищем
+ * @param storage Хранилище
+ * @param parent Родительский QObject
+ * 
+ * @details Хранилище становится дочерним объектом менеджера и переносится
+ * в его поток вместе с ним
+ */
+DatabaseManager::DatabaseManager(StorageBackend *storage, QObject *parent)
     : QObject(parent)
+    , m_storage(storage)
+    , m_connected(false)
+    , m_changeTimer(new QTimer(this))
 {
-    m_database = QSqlDatabase::addDatabase("QPSQL", "university_connection");
+    m_storage->setParent(this);
+    connect(m_storage, &StorageBackend::rowsChanged, this, &DatabaseManager::onRowsChanged);
+    connect(m_storage, &StorageBackend::tableChanged, this, &DatabaseManager::onTableChanged);
+    
+    m_changeTimer->setSingleShot(true);
+    m_changeTimer->setInterval(CHANGE_COALESCE_INTERVAL);
+    connect(m_changeTimer, &QTimer::timeout, this, &DatabaseManager::applyPendingChanges);
 }
 
 /**
  * @brief Деструктор DatabaseManager
  * 
- * @details Закрывает соединение с базой данных если оно открыто
+ * @details Хранилище удаляется как дочерний объект
  */
 DatabaseManager::~DatabaseManager()
 {
-    if (m_database.isOpen()) {
-        m_database.close();
-    }
 }
 
 /**
  * @brief Подключение к базе данных
  * @return bool Результат операции подключения
- * 
- * @details Устанавливает параметры подключения и пытается открыть соединение.
- * В случае успеха инициализирует структуру базы данных.
  */
 bool DatabaseManager::connectToDatabase()
 {
-    m_database.setHostName("localhost");
-    m_database.setDatabaseName("university");
-    m_database.setUserName("postgres");
-    m_database.setPassword("1488");
-    
-    if (m_database.open()) {
-        qDebug() << "✅ PostgreSQL подключен успешно!";
-        initializeDatabase();
+    if (m_storage->open()) {
+        qDebug() << "✅" << m_storage->name() << "подключен успешно!";
+        m_connected = true;
         emit databaseConnected(true);
         return true;
     } else {
-        qCritical() << "❌ Ошибка подключения к PostgreSQL:" << m_database.lastError().text();
+        qCritical() << "❌ Ошибка подключения к" << m_storage->name() << ":" << m_storage->lastError();
+        m_connected = false;
         emit databaseConnected(false);
         return false;
     }
@@ -64,275 +259,668 @@ bool DatabaseManager::connectToDatabase()
  */
 bool DatabaseManager::isConnected() const
 {
-    return m_database.isOpen();
+    return m_connected;
 }
 
 /**
- * @brief Инициализация структуры базы данных
- * 
- * @details Создает три таблицы если они не существуют:
- * - teachers: преподаватели
- * - students: студенты  
- * - subjects: предметы
+ * @brief Получение хранилища
+ * @return StorageBackend* Хранилище
  */
-void DatabaseManager::initializeDatabase()
+StorageBackend *DatabaseManager::storage() const
 {
-    QSqlQuery query(m_database);
-    
-    // Create teachers table
-    query.exec("CREATE TABLE IF NOT EXISTS teachers ("
-               "id SERIAL PRIMARY KEY, "
-               "full_name VARCHAR(100) NOT NULL, "
-               "department VARCHAR(100) NOT NULL)");
-    
-    // Create students table
-    query.exec("CREATE TABLE IF NOT EXISTS students ("
-               "id SERIAL PRIMARY KEY, "
-               "full_name VARCHAR(100) NOT NULL, "
-               "grade INTEGER CHECK (grade >= 1 AND grade <= 5))");
-    
-    // Create subjects table
-    query.exec("CREATE TABLE IF NOT EXISTS subjects ("
-               "id SERIAL PRIMARY KEY, "
-               "name VARCHAR(100) NOT NULL)");
+    return m_storage;
 }
 
 /**
- * @brief Получение списка всех преподавателей
- * @return QList<Teacher*> Список преподавателей
- * 
- * @note Вызывающая сторона должна освободить память объектов Teacher
+ * @brief Получение пула соединений
+ * @return ConnectionPool* Пул соединений или nullptr
+ */
+ConnectionPool *DatabaseManager::connectionPool() const
+{
+    return m_storage->connectionPool();
+}
+
+/**
+ * @brief Получение доли попаданий в кэш подготовленных запросов
+ * @return double Значение от 0 до 1
  */
-QList<Teacher*> DatabaseManager::getAllTeachers()
+double DatabaseManager::statementCacheHitRate() const
 {
-    QList<Teacher*> teachers;
-    QSqlQuery query("SELECT id, full_name, department FROM teachers ORDER BY id", m_database);
+    return m_storage->statementCacheHitRate();
+}
+
+/**
+ * @brief Запоминание изменения строк другим клиентом
+ * @param table Имя таблицы
+ * @param ids Идентификаторы строк
+ * @param inserted Строки добавлены
+ * @param previousGrades Оценки студентов до изменения в порядке ids
+ */
+void DatabaseManager::onRowsChanged(const QString &table, const QList<int> &ids, bool inserted,
+                                    const QList<int> &previousGrades)
+{
+    QHash<int, PendingChange> &changes = m_pendingChanges[table];
+    for (qsizetype i = 0; i < ids.size(); ++i) {
+        if (!changes.contains(ids.at(i))) {
+            changes.insert(ids.at(i), {inserted, previousGrades.value(i)});
+        }
+    }
     
-    while (query.next()) {
-        Teacher *teacher = new Teacher(
-            query.value(0).toInt(),
-            query.value(1).toString(),
-            query.value(2).toString()
-        );
-        teachers.append(teacher);
+    if (!m_changeTimer->isActive()) {
+        m_changeTimer->start(CHANGE_COALESCE_INTERVAL);
     }
+}
+
+/**
+ * @brief Перечитывание таблицы, измененной целиком
+ * @param table Имя таблицы
+ *
+ * @details Накопленные строки таблицы прочитает полная перезагрузка
+ */
+void DatabaseManager::onTableChanged(const QString &table)
+{
+    m_pendingChanges.remove(table);
+    emit tableReloadRequired(table);
+}
+
+/**
+ * @brief Применение накопленных изменений
+ */
+void DatabaseManager::applyPendingChanges()
+{
+    const QHash<QString, QHash<int, PendingChange>> pending = std::exchange(m_pendingChanges, {});
     
-    return teachers;
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        const QString &table = it.key();
+        const QHash<int, PendingChange> &changes = it.value();
+        QList<int> ids = changes.keys();
+        std::sort(ids.begin(), ids.end());
+        
+        // Разделяет найденные строки на добавленные и измененные,
+        // ненайденные — на удаленные
+        auto split = [&changes, &ids](const auto &records, auto &added, auto &updated, QList<int> &deleted) {
+            int next = 0;
+            for (int id : ids) {
+                const bool inserted = changes.value(id).inserted;
+                if (next < records.size() && records.at(next).id == id) {
+                    (inserted ? added : updated).append(records.at(next));
+                    ++next;
+                } else if (!inserted) {
+                    deleted.append(id);
+                }
+            }
+        };
+        
+        QList<int> deleted;
+        if (table == "teachers") {
+            bool ok = false;
+            const QList<TeacherRecord> records = measured(m_storage, "getTeachersByIds", [&]() {
+                return m_storage->getTeachersByIds(ids, &ok);
+            });
+            if (!ok) {
+                requeueChanges(table, changes);
+                continue;
+            }
+            QList<TeacherRecord> added, updated;
+            split(records, added, updated, deleted);
+            if (!added.isEmpty()) emit teachersAdded(added);
+            if (!updated.isEmpty()) emit teachersUpdated(updated);
+            if (!deleted.isEmpty()) emit teachersDeleted(deleted);
+        } else if (table == "students") {
+            bool ok = false;
+            const QList<StudentRecord> records = measured(m_storage, "getStudentsByIds", [&]() {
+                return m_storage->getStudentsByIds(ids, &ok);
+            });
+            if (!ok) {
+                requeueChanges(table, changes);
+                continue;
+            }
+            QList<StudentRecord> added, updated;
+            split(records, added, updated, deleted);
+            // Прежние оценки пришли в уведомлении: аналитика обновит
+            // гистограмму без перечитывания таблицы
+            QList<int> previousGrades;
+            previousGrades.reserve(updated.size());
+            for (const StudentRecord &record : std::as_const(updated)) {
+                previousGrades.append(changes.value(record.id).previousGrade);
+            }
+            QList<StudentRecord> removed;
+            removed.reserve(deleted.size());
+            for (int id : std::as_const(deleted)) {
+                removed.append(StudentRecord{id, QString(), changes.value(id).previousGrade});
+            }
+            if (!added.isEmpty()) emit studentsAdded(added);
+            if (!updated.isEmpty()) emit studentsUpdated(updated, previousGrades);
+            if (!removed.isEmpty()) emit studentsDeleted(removed);
+        } else if (table == "subjects") {
+            bool ok = false;
+            const QList<SubjectRecord> records = measured(m_storage, "getSubjectsByIds", [&]() {
+                return m_storage->getSubjectsByIds(ids, &ok);
+            });
+            if (!ok) {
+                requeueChanges(table, changes);
+                continue;
+            }
+            QList<SubjectRecord> added, updated;
+            split(records, added, updated, deleted);
+            if (!added.isEmpty()) emit subjectsAdded(added);
+            if (!updated.isEmpty()) emit subjectsUpdated(updated);
+            if (!deleted.isEmpty()) emit subjectsDeleted(deleted);
+        }
+    }
+}
+
+/**
+ * @brief Возврат изменений, строки которых не удалось перечитать
+ * @param table Имя таблицы
+ * @param changes id -> первое изменение
+ *
+ * @details Пустой результат после ошибки не говорит об удалении строк,
+ * поэтому изменения перечитываются повторно через RETRY_CHANGES_DELAY.
+ * Уведомления, пришедшие за это время, новее возвращенных и уступают им.
+ */
+void DatabaseManager::requeueChanges(const QString &table, const QHash<int, PendingChange> &changes)
+{
+    QHash<int, PendingChange> &pending = m_pendingChanges[table];
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+        pending.insert(it.key(), it.value());
+    }
+    m_changeTimer->start(RETRY_CHANGES_DELAY);
+}
+
+/**
+ * @brief Получение списка всех преподавателей
+ * @return QList<TeacherRecord> Записи в порядке возрастания id
+ */
+QList<TeacherRecord> DatabaseManager::getAllTeachers()
+{
+    return measured(m_storage, "getAllTeachers", [&]() {
+        return m_storage->getAllTeachers();
+    });
+}
+
+/**
+ * @brief Получение страницы преподавателей
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<TeacherRecord> Записи с id больше afterId в порядке возрастания id
+ */
+QList<TeacherRecord> DatabaseManager::getTeachersPage(int afterId, int limit)
+{
+    return measured(m_storage, "getTeachersPage", [&]() {
+        return m_storage->getTeachersPage(afterId, limit);
+    });
 }
 
 /**
- * @brief Добавление нового преподавателя
+ * @brief Добавление преподавателя
  * @param fullName Полное имя преподавателя
  * @param department Кафедра преподавателя
- * @return bool Результат операции
+ * @return TeacherRecord Добавленная запись или невалидная запись при ошибке
  */
-bool DatabaseManager::addTeacher(const QString &fullName, const QString &department)
+TeacherRecord DatabaseManager::addTeacher(const QString &fullName, const QString &department)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO teachers (full_name, department) VALUES (?, ?)");
-    query.addBindValue(fullName);
-    query.addBindValue(department);
+    const TeacherRecord record = measured(m_storage, "addTeacher", [&]() {
+        return m_storage->addTeacher(fullName, department);
+    });
+    if (record.isValid()) {
+        emit teacherAdded(record);
+    }
+    return record;
+}
+
+/**
+ * @brief Пакетное добавление преподавателей
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
+ */
+QList<int> DatabaseManager::addTeachers(const QList<TeacherRecord> &records)
+{
+    const QList<int> ids = measured(m_storage, "addTeachers", [&]() {
+        return m_storage->addTeachers(records);
+    });
+    if (ids.isEmpty() || ids.size() != records.size()) {
+        return {};
+    }
     
-    if (query.exec()) {
-        emit dataChanged();
-        return true;
+    QList<TeacherRecord> added = records;
+    for (qsizetype i = 0; i < added.size(); ++i) {
+        added[i].id = ids.at(i);
     }
-    return false;
+    emit teachersAdded(added);
+    return ids;
 }
 
 /**
  * @brief Удаление преподавателя по ID
- * @param id Идентификатор преподавателя
- * @return bool Результат операции
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0 если запись не найдена
  */
-bool DatabaseManager::deleteTeacher(int id)
+int DatabaseManager::deleteTeacher(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM teachers WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.numRowsAffected() > 0) {
-        emit dataChanged();
-        return true;
+    const int deletedId = measured(m_storage, "deleteTeacher", [&]() {
+        return m_storage->deleteTeacher(id);
+    });
+    if (deletedId != 0) {
+        emit teacherDeleted(deletedId);
     }
-    return false;
+    return deletedId;
 }
 
 /**
  * @brief Поиск преподавателя по ID
- * @param id Идентификатор преподавателя
- * @return Teacher* Найденный преподаватель или nullptr
+ * @param id Идентификатор
+ * @return TeacherRecord Найденная запись или невалидная запись
  */
-Teacher* DatabaseManager::getTeacherById(int id)
+TeacherRecord DatabaseManager::getTeacherById(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, full_name, department FROM teachers WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.next()) {
-        return new Teacher(
-            query.value(0).toInt(),
-            query.value(1).toString(),
-            query.value(2).toString()
-        );
+    return measured(m_storage, "getTeacherById", [&]() {
+        return m_storage->getTeacherById(id);
+    });
+}
+
+/**
+ * @brief Удаление преподавателей по списку ID
+ * @param ids Идентификаторы
+ * @return QList<WriteResult> Результаты по id
+ */
+QList<WriteResult> DatabaseManager::deleteTeachers(const QList<int> &ids)
+{
+    const QList<int> deleted = measured(m_storage, "deleteTeachers", [&]() {
+        return m_storage->deleteTeachers(ids);
+    });
+    if (!deleted.isEmpty()) {
+        emit teachersDeleted(deleted);
     }
-    return nullptr;
+    return deleteResults(ids, deleted);
+}
+
+/**
+ * @brief Поиск преподавателей по списку ID
+ * @param ids Идентификаторы
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> DatabaseManager::getTeachersByIds(const QList<int> &ids) const
+{
+    return measured(m_storage, "getTeachersByIds", [&]() {
+        return m_storage->getTeachersByIds(ids);
+    });
 }
 
 /**
  * @brief Получение списка всех студентов
- * @return QList<Student*> Список студентов
+ * @return QList<StudentRecord> Записи в порядке возрастания id
  */
-QList<Student*> DatabaseManager::getAllStudents()
+QList<StudentRecord> DatabaseManager::getAllStudents()
 {
-    QList<Student*> students;
-    QSqlQuery query("SELECT id, full_name, grade FROM students ORDER BY id", m_database);
-    
-    while (query.next()) {
-        Student *student = new Student(
-            query.value(0).toInt(),
-            query.value(1).toString(),
-            query.value(2).toInt()
-        );
-        students.append(student);
-    }
-    
-    return students;
+    return measured(m_storage, "getAllStudents", [&]() {
+        return m_storage->getAllStudents();
+    });
 }
 
 /**
- * @brief Добавление нового студента
+ * @brief Получение страницы студентов
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<StudentRecord> Записи с id больше afterId в порядке возрастания id
+ */
+QList<StudentRecord> DatabaseManager::getStudentsPage(int afterId, int limit)
+{
+    return measured(m_storage, "getStudentsPage", [&]() {
+        return m_storage->getStudentsPage(afterId, limit);
+    });
+}
+
+/**
+ * @brief Добавление студента
  * @param fullName Полное имя студента
  * @param grade Оценка студента
- * @return bool Результат операции
+ * @return StudentRecord Добавленная запись или невалидная запись при ошибке
  */
-bool DatabaseManager::addStudent(const QString &fullName, int grade)
+StudentRecord DatabaseManager::addStudent(const QString &fullName, int grade)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO students (full_name, grade) VALUES (?, ?)");
-    query.addBindValue(fullName);
-    query.addBindValue(grade);
+    const StudentRecord record = measured(m_storage, "addStudent", [&]() {
+        return m_storage->addStudent(fullName, grade);
+    });
+    if (record.isValid()) {
+        emit studentAdded(record);
+    }
+    return record;
+}
+
+/**
+ * @brief Пакетное добавление студентов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
+ */
+QList<int> DatabaseManager::addStudents(const QList<StudentRecord> &records)
+{
+    const QList<int> ids = measured(m_storage, "addStudents", [&]() {
+        return m_storage->addStudents(records);
+    });
+    if (ids.isEmpty() || ids.size() != records.size()) {
+        return {};
+    }
     
-    if (query.exec()) {
-        emit dataChanged();
-        return true;
+    QList<StudentRecord> added = records;
+    for (qsizetype i = 0; i < added.size(); ++i) {
+        added[i].id = ids.at(i);
     }
-    return false;
+    emit studentsAdded(added);
+    return ids;
 }
 
 /**
  * @brief Удаление студента по ID
- * @param id Идентификатор студента
- * @return bool Результат операции
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0 если запись не найдена
  */
-bool DatabaseManager::deleteStudent(int id)
+int DatabaseManager::deleteStudent(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM students WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.numRowsAffected() > 0) {
-        emit dataChanged();
-        return true;
+    const StudentRecord record = measured(m_storage, "deleteStudent", [&]() {
+        return m_storage->deleteStudent(id);
+    });
+    if (record.isValid()) {
+        emit studentDeleted(record);
     }
-    return false;
+    return record.id;
 }
 
 /**
  * @brief Поиск студента по ID
- * @param id Идентификатор студента
- * @return Student* Найденный студент или nullptr
+ * @param id Идентификатор
+ * @return StudentRecord Найденная запись или невалидная запись
  */
-Student* DatabaseManager::getStudentById(int id)
+StudentRecord DatabaseManager::getStudentById(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, full_name, grade FROM students WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.next()) {
-        return new Student(
-            query.value(0).toInt(),
-            query.value(1).toString(),
-            query.value(2).toInt()
-        );
+    return measured(m_storage, "getStudentById", [&]() {
+        return m_storage->getStudentById(id);
+    });
+}
+
+/**
+ * @brief Удаление студентов по списку ID
+ * @param ids Идентификаторы
+ * @return QList<WriteResult> Результаты по id
+ */
+QList<WriteResult> DatabaseManager::deleteStudents(const QList<int> &ids)
+{
+    const QList<StudentRecord> deleted = measured(m_storage, "deleteStudents", [&]() {
+        return m_storage->deleteStudents(ids);
+    });
+    if (!deleted.isEmpty()) {
+        emit studentsDeleted(deleted);
     }
-    return nullptr;
+    QList<int> deletedIds;
+    deletedIds.reserve(deleted.size());
+    for (const StudentRecord &record : deleted) {
+        deletedIds.append(record.id);
+    }
+    return deleteResults(ids, deletedIds);
+}
+
+/**
+ * @brief Поиск студентов по списку ID
+ * @param ids Идентификаторы
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> DatabaseManager::getStudentsByIds(const QList<int> &ids) const
+{
+    return measured(m_storage, "getStudentsByIds", [&]() {
+        return m_storage->getStudentsByIds(ids);
+    });
 }
 
 /**
  * @brief Получение списка всех предметов
- * @return QList<Subject*> Список предметов
+ * @return QList<SubjectRecord> Записи в порядке возрастания id
  */
-QList<Subject*> DatabaseManager::getAllSubjects()
+QList<SubjectRecord> DatabaseManager::getAllSubjects()
 {
-    QList<Subject*> subjects;
-    QSqlQuery query("SELECT id, name FROM subjects ORDER BY id", m_database);
-    
-    while (query.next()) {
-        Subject *subject = new Subject(
-            query.value(0).toInt(),
-            query.value(1).toString()
-        );
-        subjects.append(subject);
-    }
-    
-    return subjects;
+    return measured(m_storage, "getAllSubjects", [&]() {
+        return m_storage->getAllSubjects();
+    });
 }
 
 /**
- * @brief Добавление нового предмета
+ * @brief Получение страницы предметов
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<SubjectRecord> Записи с id больше afterId в порядке возрастания id
+ */
+QList<SubjectRecord> DatabaseManager::getSubjectsPage(int afterId, int limit)
+{
+    return measured(m_storage, "getSubjectsPage", [&]() {
+        return m_storage->getSubjectsPage(afterId, limit);
+    });
+}
+
+/**
+ * @brief Добавление предмета
  * @param name Название предмета
- * @return bool Результат операции
+ * @return SubjectRecord Добавленная запись или невалидная запись при ошибке
+ */
+SubjectRecord DatabaseManager::addSubject(const QString &name)
+{
+    const SubjectRecord record = measured(m_storage, "addSubject", [&]() {
+        return m_storage->addSubject(name);
+    });
+    if (record.isValid()) {
+        emit subjectAdded(record);
+    }
+    return record;
+}
+
+/**
+ * @brief Пакетное добавление предметов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
  */
-bool DatabaseManager::addSubject(const QString &name)
+QList<int> DatabaseManager::addSubjects(const QList<SubjectRecord> &records)
 {
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO subjects (name) VALUES (?)");
-    query.addBindValue(name);
+    const QList<int> ids = measured(m_storage, "addSubjects", [&]() {
+        return m_storage->addSubjects(records);
+    });
+    if (ids.isEmpty() || ids.size() != records.size()) {
+        return {};
+    }
     
-    if (query.exec()) {
-        emit dataChanged();
-        return true;
+    QList<SubjectRecord> added = records;
+    for (qsizetype i = 0; i < added.size(); ++i) {
+        added[i].id = ids.at(i);
     }
-    return false;
+    emit subjectsAdded(added);
+    return ids;
 }
 
 /**
  * @brief Удаление предмета по ID
- * @param id Идентификатор предмета
- * @return bool Результат операции
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0 если запись не найдена
  */
-bool DatabaseManager::deleteSubject(int id)
+int DatabaseManager::deleteSubject(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM subjects WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.numRowsAffected() > 0) {
-        emit dataChanged();
-        return true;
+    const int deletedId = measured(m_storage, "deleteSubject", [&]() {
+        return m_storage->deleteSubject(id);
+    });
+    if (deletedId != 0) {
+        emit subjectDeleted(deletedId);
     }
-    return false;
+    return deletedId;
 }
 
 /**
  * @brief Поиск предмета по ID
- * @param id Идентификатор предмета
- * @return Subject* Найденный предмет или nullptr
+ * @param id Идентификатор
+ * @return SubjectRecord Найденная запись или невалидная запись
  */
-Subject* DatabaseManager::getSubjectById(int id)
+SubjectRecord DatabaseManager::getSubjectById(int id)
 {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, name FROM subjects WHERE id = ?");
-    query.addBindValue(id);
-    
-    if (query.exec() && query.next()) {
-        return new Subject(
-            query.value(0).toInt(),
-            query.value(1).toString()
-        );
+    return measured(m_storage, "getSubjectById", [&]() {
+        return m_storage->getSubjectById(id);
+    });
+}
+
+/**
+ * @brief Удаление предметов по списку ID
+ * @param ids Идентификаторы
+ * @return QList<WriteResult> Результаты по id
+ */
+QList<WriteResult> DatabaseManager::deleteSubjects(const QList<int> &ids)
+{
+    const QList<int> deleted = measured(m_storage, "deleteSubjects", [&]() {
+        return m_storage->deleteSubjects(ids);
+    });
+    if (!deleted.isEmpty()) {
+        emit subjectsDeleted(deleted);
+    }
+    return deleteResults(ids, deleted);
+}
+
+/**
+ * @brief Поиск предметов по списку ID
+ * @param ids Идентификаторы
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> DatabaseManager::getSubjectsByIds(const QList<int> &ids) const
+{
+    return measured(m_storage, "getSubjectsByIds", [&]() {
+        return m_storage->getSubjectsByIds(ids);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск преподавателей
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> DatabaseManager::searchTeachers(const QString &text, int limit) const
+{
+    return measured(m_storage, "searchTeachers", [&]() {
+        return m_storage->searchTeachers(text, limit);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск студентов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> DatabaseManager::searchStudents(const QString &text, int limit) const
+{
+    return measured(m_storage, "searchStudents", [&]() {
+        return m_storage->searchStudents(text, limit);
+    });
+}
+
+/**
+ * @brief Нечеткий поиск предметов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> DatabaseManager::searchSubjects(const QString &text, int limit) const
+{
+    return measured(m_storage, "searchSubjects", [&]() {
+        return m_storage->searchSubjects(text, limit);
+    });
+}
+
+/**
+ * @brief Открытие курсора по студентам
+ * @return qint64 Количество строк или -1
+ */
+qint64 DatabaseManager::openStudentCursor()
+{
+    m_studentCursor.reset();
+    m_studentCursor = measured(m_storage, "openStudentCursor", [&]() {
+        return m_storage->openStudentCursor();
+    });
+    return m_studentCursor ? m_studentCursor->count() : -1;
+}
+
+/**
+ * @brief Чтение окна строк курсора
+ * @param offset Номер первой строки
+ * @param limit Максимальное количество строк
+ * @return QList<StudentRecord> Строки окна
+ */
+QList<StudentRecord> DatabaseManager::fetchStudentCursor(qint64 offset, int limit)
+{
+    if (!m_studentCursor) {
+        return {};
+    }
+    return measured(m_storage, "fetchStudentCursor", [&]() {
+        return m_studentCursor->fetch(offset, limit);
+    });
+}
+
+/**
+ * @brief Закрытие курсора по студентам
+ */
+void DatabaseManager::closeStudentCursor()
+{
+    m_studentCursor.reset();
+}
+
+/**
+ * @brief Запись студента на предмет
+ * @param studentId Идентификатор студента
+ * @param subjectId Идентификатор предмета
+ * @param grade Оценка или 0
+ * @return bool Результат операции
+ */
+bool DatabaseManager::enrollStudent(int studentId, int subjectId, int grade)
+{
+    const bool ok = measured(m_storage, "enrollStudent", [&]() {
+        return m_storage->enrollStudent(studentId, subjectId, grade);
+    });
+    if (ok) {
+        emit rostersChanged();
+    }
+    return ok;
+}
+
+/**
+ * @brief Назначение преподавателя на предмет
+ * @param teacherId Идентификатор преподавателя
+ * @param subjectId Идентификатор предмета
+ * @return bool Результат операции
+ */
+bool DatabaseManager::assignTeacher(int teacherId, int subjectId)
+{
+    const bool ok = measured(m_storage, "assignTeacher", [&]() {
+        return m_storage->assignTeacher(teacherId, subjectId);
+    });
+    if (ok) {
+        emit rostersChanged();
     }
-    return nullptr;
+    return ok;
+}
+
+/**
+ * @brief Получение состава предмета
+ * @param subjectId Идентификатор предмета
+ * @return QList<RosterEntry> Строки состава
+ */
+QList<RosterEntry> DatabaseManager::getSubjectRoster(int subjectId) const
+{
+    return measured(m_storage, "getSubjectRoster", [&]() {
+        return m_storage->getSubjectRoster(subjectId);
+    });
+}
+
+/**
+ * @brief Пересборка составов предметов
+ * @return bool Результат операции
+ */
+bool DatabaseManager::refreshRosters()
+{
+    return measured(m_storage, "refreshRosters", [&]() {
+        return m_storage->refreshRosters();
+    });
 }
 
 /**
@@ -341,17 +929,155 @@ Subject* DatabaseManager::getSubjectById(int id)
  */
 int DatabaseManager::getTotalRecords() const
 {
-    int count = 0;
-    QSqlQuery query(m_database);
+    return static_cast<int>(getRecordCounts().total());
+}
+
+/**
+ * @brief Получение количества строк по таблицам
+ * @param mode Способ подсчета
+ * @return RecordCounts Количество строк
+ */
+RecordCounts DatabaseManager::getRecordCounts(CountMode mode) const
+{
+    return measured(m_storage, "getRecordCounts", [&]() {
+        return m_storage->getRecordCounts(mode);
+    });
+}
+
+/**
+ * @brief Получение распределения оценок
+ * @param limit Сколько студентов вернуть с каждого края
+ * @return GradeSummary Гистограмма и крайние студенты
+ */
+GradeSummary DatabaseManager::getGradeSummary(int limit) const
+{
+    return measured(m_storage, "getGradeSummary", [&]() {
+        return m_storage->getGradeSummary(limit);
+    });
+}
+
+/**
+ * @brief Выполнение пакета операций записи
+ * @param operations Операции
+ * @return QList<WriteResult> Результаты по операциям
+ * 
+ * @details Каждая операция учитывается в статистике под своим названием,
+ * весь пакет — под названием applyWrites. Ошибка точки сохранения
+ * откатывает весь пакет. Сигналы отправляются только после успешной фиксации.
+ */
+QList<WriteResult> DatabaseManager::applyWrites(const QList<WriteOperation> &operations)
+{
+    QList<WriteResult> results(operations.size());
+    if (operations.isEmpty()) {
+        return results;
+    }
     
-    query.exec("SELECT COUNT(*) FROM teachers");
-    if (query.next()) count += query.value(0).toInt();
+    QElapsedTimer timer;
+    timer.start();
+    if (!m_storage->beginTransaction()) {
+        return results;
+    }
     
-    query.exec("SELECT COUNT(*) FROM students");
-    if (query.next()) count += query.value(0).toInt();
+    QList<TeacherRecord> addedTeachers;
+    QList<StudentRecord> addedStudents;
+    QList<SubjectRecord> addedSubjects;
+    QList<int> deletedTeachers;
+    QList<StudentRecord> deletedStudents;
+    QList<int> deletedSubjects;
+    bool rosters = false;
     
-    query.exec("SELECT COUNT(*) FROM subjects");
-    if (query.next()) count += query.value(0).toInt();
+    bool ok = true;
+    for (qsizetype i = 0; ok && i < operations.size(); ++i) {
+        const WriteOperation &operation = operations.at(i);
+        if (!m_storage->setSavepoint()) {
+            ok = false;
+            continue;
+        }
+        
+        WriteResult &result = results[i];
+        switch (operation.type) {
+        case WriteOperation::AddTeacher: {
+            const TeacherRecord record = measured(m_storage, "addTeacher", [&]() {
+                return m_storage->addTeacher(operation.name, operation.department);
+            });
+            result = {record.isValid(), record.id};
+            if (result.ok) addedTeachers.append(record);
+            break;
+        }
+        case WriteOperation::AddStudent: {
+            const StudentRecord record = measured(m_storage, "addStudent", [&]() {
+                return m_storage->addStudent(operation.name, operation.grade);
+            });
+            result = {record.isValid(), record.id};
+            if (result.ok) addedStudents.append(record);
+            break;
+        }
+        case WriteOperation::AddSubject: {
+            const SubjectRecord record = measured(m_storage, "addSubject", [&]() {
+                return m_storage->addSubject(operation.name);
+            });
+            result = {record.isValid(), record.id};
+            if (result.ok) addedSubjects.append(record);
+            break;
+        }
+        case WriteOperation::DeleteTeacher:
+            result.id = measured(m_storage, "deleteTeacher", [&]() {
+                return m_storage->deleteTeacher(operation.id);
+            });
+            result.ok = result.id != 0;
+            if (result.ok) deletedTeachers.append(result.id);
+            break;
+        case WriteOperation::DeleteStudent: {
+            const StudentRecord record = measured(m_storage, "deleteStudent", [&]() {
+                return m_storage->deleteStudent(operation.id);
+            });
+            result = {record.isValid(), record.id};
+            if (result.ok) deletedStudents.append(record);
+            break;
+        }
+        case WriteOperation::DeleteSubject:
+            result.id = measured(m_storage, "deleteSubject", [&]() {
+                return m_storage->deleteSubject(operation.id);
+            });
+            result.ok = result.id != 0;
+            if (result.ok) deletedSubjects.append(result.id);
+            break;
+        case WriteOperation::EnrollStudent:
+            result.ok = measured(m_storage, "enrollStudent", [&]() {
+                return m_storage->enrollStudent(operation.id, operation.subjectId, operation.grade);
+            });
+            result.id = operation.id;
+            rosters = rosters || result.ok;
+            break;
+        case WriteOperation::AssignTeacher:
+            result.ok = measured(m_storage, "assignTeacher", [&]() {
+                return m_storage->assignTeacher(operation.id, operation.subjectId);
+            });
+            result.id = operation.id;
+            rosters = rosters || result.ok;
+            break;
+        }
+        
+        ok = m_storage->releaseSavepoint(result.ok);
+    }
     
-    return count;
-}
\ No newline at end of file
+    // Без точки сохранения неизвестно, какие операции уцелели
+    if (!ok || !m_storage->commitTransaction()) {
+        m_storage->rollbackTransaction();
+        return QList<WriteResult>(operations.size());
+    }
+    
+    const qsizetype applied = std::count_if(results.cbegin(), results.cend(), [](const WriteResult &result) {
+        return result.ok;
+    });
+    m_storage->metrics()->record(QStringLiteral("applyWrites"), timer.nsecsElapsed() / 1000, applied, 0);
+    
+    if (!addedTeachers.isEmpty()) emit teachersAdded(addedTeachers);
+    if (!deletedTeachers.isEmpty()) emit teachersDeleted(deletedTeachers);
+    if (!addedStudents.isEmpty()) emit studentsAdded(addedStudents);
+    if (!deletedStudents.isEmpty()) emit studentsDeleted(deletedStudents);
+    if (!addedSubjects.isEmpty()) emit subjectsAdded(addedSubjects);
+    if (!deletedSubjects.isEmpty()) emit subjectsDeleted(deletedSubjects);
+    if (rosters) emit rostersChanged();
+    return results;
+}
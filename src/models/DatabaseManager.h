@@ -7,37 +7,82 @@
  * @brief Класс для управления подключением и операциями с базой данных
  * 
  * Отвечает за:
- * - Подключение к PostgreSQL базе данных
- * - Создание таблиц при необходимости
- * - Выполнение CRUD операций
- * - Управление соединением с БД
+ * - Подключение к хранилищу
+ * - Выполнение CRUD операций и сигналы о них
+ * - Выполнение пакетов записи в одной транзакции (applyWrites())
+ * - Записи студентов на предметы, назначения преподавателей и составы предметов
+ * - Объединение изменений других клиентов
+ * - Замер задержки, строк и байт каждой операции (StorageBackend::metrics())
  * 
- * @warning Для работы требуется драйвер QPSQL
+ * Сами данные хранит StorageBackend: PostgreSQL (по умолчанию), SQLite
+ * или память процесса. Хранилище выбирается при создании менеджера,
+ * см. StorageBackend::create().
+ * 
+ * Изменения, сделанные другими клиентами, хранилище сообщает списками id
+ * (в PostgreSQL — через LISTEN/NOTIFY). Менеджер собирает их за
+ * CHANGE_COALESCE_INTERVAL, перечитывает только затронутые строки одним
+ * запросом на таблицу и сообщает о них сигналами *Added, *Updated и *Deleted.
+ * Если строк слишком много, хранилище их не перечисляет, и менеджер
+ * просит перечитать таблицу сигналом tableReloadRequired.
+ * 
+ * Все методы синхронные и потокобезопасные, если потокобезопасно хранилище
+ * (все реализации StorageBackend таковы). Для работы из GUI потока
+ * используйте AsyncDatabaseManager.
  */
 
 #ifndef DATABASEMANAGER_H
 #define DATABASEMANAGER_H
 
 #include <QObject>
-#include <QSqlDatabase>
-#include <QSqlQuery>
+#include <QHash>
 #include <QString>
 #include <QList>
+#include <atomic>
+#include <memory>
+#include "ConnectionPool.h"
+#include "StorageBackend.h"
 #include "Teacher.h"
 #include "Student.h"
 #include "Subject.h"
+#include "WriteOperation.h"
+
+class QTimer;
 
 class DatabaseManager : public QObject
 {
     Q_OBJECT
     
 public:
+    /**
+     * @brief Интервал, за который уведомления собираются в один запрос, мс
+     */
+    static constexpr int CHANGE_COALESCE_INTERVAL = 50;
+    
+    /**
+     * @brief Задержка повторного чтения измененных строк после ошибки, мс
+     */
+    static constexpr int RETRY_CHANGES_DELAY = 2000;
+    
+    /**
+     * @brief Способ подсчета строк
+     */
+    using CountMode = StorageBackend::CountMode;
+    
     /**
      * @brief Конструктор класса DatabaseManager
      * @param parent Родительский QObject
+     * 
+     * @details Хранилище создается по StorageBackend::defaultSpec()
      */
     explicit DatabaseManager(QObject *parent = nullptr);
     
+    /**
+     * @brief Конструктор с заданным хранилищем
+     * @param storage Хранилище, менеджер становится его владельцем
+     * @param parent Родительский QObject
+     */
+    explicit DatabaseManager(StorageBackend *storage, QObject *parent = nullptr);
+    
     /**
      * @brief Деструктор класса DatabaseManager
      * @details Закрывает соединение с базой данных при уничтожении объекта
@@ -48,119 +93,388 @@ public:
      * @brief Подключиться к базе данных
      * @return bool true если подключение успешно, иначе false
      * 
-     * @details Использует следующие параметры подключения:
-     * - Хост: localhost
-     * - Имя БД: university
-     * - Пользователь: postgres
-     * - Пароль: 1488
+     * @details Открывает хранилище в вызывающем потоке. Для PostgreSQL параметры
+     * подключения берутся из ConnectionSettings пула (по умолчанию localhost/university/postgres).
      */
     bool connectToDatabase();
     
     /**
      * @brief Проверить подключение к базе данных
-     * @return bool true если подключение активно
+     * @return bool true если последнее подключение было успешным
      */
     bool isConnected() const;
     
+    /**
+     * @brief Получить хранилище
+     * @return StorageBackend* Хранилище менеджера
+     */
+    StorageBackend *storage() const;
+    
+    /**
+     * @brief Получить пул соединений
+     * @return ConnectionPool* Пул соединений хранилища или nullptr для хранилища без SQL
+     */
+    ConnectionPool *connectionPool() const;
+    
+    /**
+     * @brief Получить долю попаданий в кэш подготовленных запросов
+     * @return double Значение от 0 до 1
+     * 
+     * @note Потокобезопасно, счетчики общие для всех соединений пула
+     */
+    double statementCacheHitRate() const;
+    
     // Teacher operations
     
     /**
      * @brief Получить всех преподавателей
-     * @return QList<Teacher*> Список указателей на объекты Teacher
-     * 
-     * @note Ответственность за удаление объектов лежит на вызывающей стороне
+     * @return QList<TeacherRecord> Записи в порядке возрастания id (непрерывный массив значений)
+     */
+    QList<TeacherRecord> getAllTeachers();
+    
+    /**
+     * @brief Получить страницу преподавателей (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QList<TeacherRecord> Записи с id больше afterId в порядке возрастания id
      */
-    QList<Teacher*> getAllTeachers();
+    QList<TeacherRecord> getTeachersPage(int afterId, int limit);
     
     /**
      * @brief Добавить нового преподавателя
      * @param fullName Полное имя преподавателя
      * @param department Кафедра преподавателя
-     * @return bool true если операция успешна
+     * @return TeacherRecord Добавленная запись (с id из БД) или невалидная запись при ошибке
+     */
+    TeacherRecord addTeacher(const QString &fullName, const QString &department);
+    
+    /**
+     * @brief Добавить пакет преподавателей
+     * @param records Новые записи (поле id игнорируется)
+     * @return QList<int> Идентификаторы добавленных записей в порядке входного списка,
+     * пустой список при ошибке (в этом случае не добавляется ни одна запись)
+     * 
+     * @details В PostgreSQL идентификаторы резервируются одним запросом к
+     * последовательности, строки передаются через COPY ... FROM STDIN, а без
+     * libpq — через execBatch подготовленного INSERT. Все выполняется в одной
+     * транзакции и завершается одним сигналом teachersAdded.
      */
-    bool addTeacher(const QString &fullName, const QString &department);
+    QList<int> addTeachers(const QList<TeacherRecord> &records);
     
     /**
      * @brief Удалить преподавателя по ID
      * @param id Идентификатор преподавателя
-     * @return bool true если удаление успешно
+     * @return int Идентификатор удаленной записи или 0 если запись не найдена
      */
-    bool deleteTeacher(int id);
+    int deleteTeacher(int id);
     
     /**
      * @brief Найти преподавателя по ID
      * @param id Идентификатор преподавателя
-     * @return Teacher* Указатель на объект Teacher или nullptr если не найден
+     * @return TeacherRecord Найденная запись или невалидная запись (id == 0)
      */
-    Teacher* getTeacherById(int id);
+    TeacherRecord getTeacherById(int id);
+    
+    /**
+     * @brief Удалить преподавателей по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<WriteResult> Результат по каждому id в порядке ids;
+     * ok == false, если записи с таким id не было или запрос не выполнен
+     * 
+     * @details Удаленные записи сообщаются одним сигналом teachersDeleted
+     */
+    QList<WriteResult> deleteTeachers(const QList<int> &ids);
+    
+    /**
+     * @brief Найти преподавателей по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<TeacherRecord> Найденные записи в порядке возрастания id;
+     * отсутствующих id в списке нет
+     */
+    QList<TeacherRecord> getTeachersByIds(const QList<int> &ids) const;
     
     // Student operations
     
     /**
      * @brief Получить всех студентов
-     * @return QList<Student*> Список указателей на объекты Student
+     * @return QList<StudentRecord> Записи в порядке возрастания id (непрерывный массив значений)
      */
-    QList<Student*> getAllStudents();
+    QList<StudentRecord> getAllStudents();
+    
+    /**
+     * @brief Получить страницу студентов (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QList<StudentRecord> Записи с id больше afterId в порядке возрастания id
+     */
+    QList<StudentRecord> getStudentsPage(int afterId, int limit);
     
     /**
      * @brief Добавить нового студента
      * @param fullName Полное имя студента
      * @param grade Оценка студента (1-5)
-     * @return bool true если операция успешна
+     * @return StudentRecord Добавленная запись (с id из БД) или невалидная запись при ошибке
+     */
+    StudentRecord addStudent(const QString &fullName, int grade);
+    
+    /**
+     * @brief Добавить пакет студентов
+     * @param records Новые записи (поле id игнорируется)
+     * @return QList<int> Идентификаторы добавленных записей в порядке входного списка,
+     * пустой список при ошибке (в этом случае не добавляется ни одна запись)
+     * 
+     * @details В PostgreSQL идентификаторы резервируются одним запросом к
+     * последовательности, строки передаются через COPY ... FROM STDIN, а без
+     * libpq — через execBatch подготовленного INSERT. Все выполняется в одной
+     * транзакции и завершается одним сигналом studentsAdded.
      */
-    bool addStudent(const QString &fullName, int grade);
+    QList<int> addStudents(const QList<StudentRecord> &records);
     
     /**
      * @brief Удалить студента по ID
      * @param id Идентификатор студента
-     * @return bool true если удаление успешно
+     * @return int Идентификатор удаленной записи или 0 если запись не найдена
      */
-    bool deleteStudent(int id);
+    int deleteStudent(int id);
     
     /**
      * @brief Найти студента по ID
      * @param id Идентификатор студента
-     * @return Student* Указатель на объект Student или nullptr если не найден
+     * @return StudentRecord Найденная запись или невалидная запись (id == 0)
+     */
+    StudentRecord getStudentById(int id);
+    
+    /**
+     * @brief Удалить студентов по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<WriteResult> Результат по каждому id в порядке ids;
+     * ok == false, если записи с таким id не было или запрос не выполнен
+     * 
+     * @details Удаленные записи сообщаются одним сигналом studentsDeleted
+     */
+    QList<WriteResult> deleteStudents(const QList<int> &ids);
+    
+    /**
+     * @brief Найти студентов по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<StudentRecord> Найденные записи в порядке возрастания id;
+     * отсутствующих id в списке нет
      */
-    Student* getStudentById(int id);
+    QList<StudentRecord> getStudentsByIds(const QList<int> &ids) const;
     
     // Subject operations
     
     /**
-     * @brief Получить все предметы
-     * @return QList<Subject*> Список указателей на объекты Subject
+     * @brief Получить всех предметов
+     * @return QList<SubjectRecord> Записи в порядке возрастания id (непрерывный массив значений)
      */
-    QList<Subject*> getAllSubjects();
+    QList<SubjectRecord> getAllSubjects();
+    
+    /**
+     * @brief Получить страницу предметов (keyset-пагинация)
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей на странице
+     * @return QList<SubjectRecord> Записи с id больше afterId в порядке возрастания id
+     */
+    QList<SubjectRecord> getSubjectsPage(int afterId, int limit);
     
     /**
      * @brief Добавить новый предмет
      * @param name Название предмета
-     * @return bool true если операция успешна
+     * @return SubjectRecord Добавленная запись (с id из БД) или невалидная запись при ошибке
+     */
+    SubjectRecord addSubject(const QString &name);
+    
+    /**
+     * @brief Добавить пакет предметов
+     * @param records Новые записи (поле id игнорируется)
+     * @return QList<int> Идентификаторы добавленных записей в порядке входного списка,
+     * пустой список при ошибке (в этом случае не добавляется ни одна запись)
+     * 
+     * @details В PostgreSQL идентификаторы резервируются одним запросом к
+     * последовательности, строки передаются через COPY ... FROM STDIN, а без
+     * libpq — через execBatch подготовленного INSERT. Все выполняется в одной
+     * транзакции и завершается одним сигналом subjectsAdded.
      */
-    bool addSubject(const QString &name);
+    QList<int> addSubjects(const QList<SubjectRecord> &records);
     
     /**
      * @brief Удалить предмет по ID
      * @param id Идентификатор предмета
-     * @return bool true если удаление успешно
+     * @return int Идентификатор удаленной записи или 0 если запись не найдена
      */
-    bool deleteSubject(int id);
+    int deleteSubject(int id);
     
     /**
-     * @brief Найти предмет по ID
+     * @brief Найти предмета по ID
      * @param id Идентификатор предмета
-     * @return Subject* Указатель на объект Subject или nullptr если не найден
+     * @return SubjectRecord Найденная запись или невалидная запись (id == 0)
+     */
+    SubjectRecord getSubjectById(int id);
+    
+    /**
+     * @brief Удалить предметы по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<WriteResult> Результат по каждому id в порядке ids;
+     * ok == false, если записи с таким id не было или запрос не выполнен
+     * 
+     * @details Удаленные записи сообщаются одним сигналом subjectsDeleted
+     */
+    QList<WriteResult> deleteSubjects(const QList<int> &ids);
+    
+    /**
+     * @brief Найти предметы по списку ID одним запросом
+     * @param ids Идентификаторы
+     * @return QList<SubjectRecord> Найденные записи в порядке возрастания id;
+     * отсутствующих id в списке нет
+     */
+    QList<SubjectRecord> getSubjectsByIds(const QList<int> &ids) const;
+    
+    // Search
+    
+    /**
+     * @brief Нечеткий поиск преподавателей
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<TeacherRecord> Записи по убыванию сходства со строкой поиска
+     * 
+     * @details В PostgreSQL с pg_trgm использует оператор <% (word_similarity)
+     * по GIN индексу, без него — ILIKE по подстроке с сортировкой по id.
+     * Остальные хранилища ищут подстроку без учета регистра
      */
-    Subject* getSubjectById(int id);
+    QList<TeacherRecord> searchTeachers(const QString &text, int limit) const;
+    
+    /**
+     * @brief Нечеткий поиск студентов
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<StudentRecord> Записи по убыванию сходства со строкой поиска
+     * 
+     * @details В PostgreSQL с pg_trgm использует оператор <% (word_similarity)
+     * по GIN индексу, без него — ILIKE по подстроке с сортировкой по id.
+     * Остальные хранилища ищут подстроку без учета регистра
+     */
+    QList<StudentRecord> searchStudents(const QString &text, int limit) const;
+    
+    /**
+     * @brief Нечеткий поиск предметов
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<SubjectRecord> Записи по убыванию сходства со строкой поиска
+     * 
+     * @details В PostgreSQL с pg_trgm использует оператор <% (word_similarity)
+     * по GIN индексу, без него — ILIKE по подстроке с сортировкой по id.
+     * Остальные хранилища ищут подстроку без учета регистра
+     */
+    QList<SubjectRecord> searchSubjects(const QString &text, int limit) const;
+    
+    // Cursor browsing
+    
+    /**
+     * @brief Открыть курсор по студентам
+     * @return qint64 Количество строк в снимке или -1, если хранилище
+     * не поддерживает курсоры или открыть курсор не удалось
+     * 
+     * @details Ранее открытый курсор закрывается. Курсор привязан к потоку
+     * менеджера, поэтому методы курсора нельзя вызывать из пула чтения.
+     */
+    qint64 openStudentCursor();
+    
+    /**
+     * @brief Прочитать окно строк открытого курсора
+     * @param offset Номер первой строки, начиная с 0
+     * @param limit Максимальное количество строк
+     * @return QList<StudentRecord> Строки окна или пустой список, если курсор не открыт
+     */
+    QList<StudentRecord> fetchStudentCursor(qint64 offset, int limit);
+    
+    /**
+     * @brief Закрыть курсор по студентам
+     */
+    void closeStudentCursor();
+    
+    // Enrollments and rosters
+    
+    /**
+     * @brief Записать студента на предмет или изменить его оценку
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка от 1 до 5 или 0, если оценки еще нет
+     * @return bool true если запись сохранена
+     * 
+     * @details При успехе отправляется rostersChanged()
+     */
+    bool enrollStudent(int studentId, int subjectId, int grade);
+    
+    /**
+     * @brief Назначить преподавателя на предмет
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return bool true если назначение сохранено или уже было
+     * 
+     * @details При успехе отправляется rostersChanged()
+     */
+    bool assignTeacher(int teacherId, int subjectId);
+    
+    /**
+     * @brief Получить состав предмета
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Студенты предмета с оценками и преподавателями
+     * 
+     * @details В PostgreSQL читается из subject_rosters одним поиском
+     * по индексу и отражает состояние на момент refreshRosters()
+     */
+    QList<RosterEntry> getSubjectRoster(int subjectId) const;
+    
+    /**
+     * @brief Пересобрать заранее собранные составы предметов
+     * @return bool true если составы актуальны
+     */
+    bool refreshRosters();
     
     // Statistics
     
+    /**
+     * @brief Получить количество строк в каждой таблице
+     * @param mode Точные счетчики или оценка планировщика
+     * @return RecordCounts Количество строк
+     * 
+     * @details В PostgreSQL точный режим читает счетчики university_stats,
+     * а оценка — pg_class.reltuples. Все таблицы читаются одним запросом.
+     */
+    RecordCounts getRecordCounts(CountMode mode = CountMode::Exact) const;
+    
     /**
      * @brief Получить общее количество записей во всех таблицах
      * @return int Суммарное количество записей
      */
     int getTotalRecords() const;
     
+    /**
+     * @brief Получить распределение оценок и крайних по оценке студентов
+     * @param limit Сколько студентов вернуть с каждого края
+     * @return GradeSummary Гистограмма по всей таблице и крайние студенты
+     * 
+     * @details Гистограмма считается на стороне хранилища, в память
+     * попадают только 2 * limit записей
+     */
+    GradeSummary getGradeSummary(int limit) const;
+    
+    // Batched writes
+    
+    /**
+     * @brief Выполнить пакет операций записи в одной транзакции
+     * @param operations Операции в порядке выполнения
+     * @return QList<WriteResult> Результаты в порядке operations
+     * 
+     * @details Каждая операция выполняется после точки сохранения: неудачная
+     * откатывается к ней, остальные фиксируются одним COMMIT. Если транзакцию
+     * не удалось начать или зафиксировать, неудачными считаются все операции.
+     * После фиксации изменения сообщаются одним сигналом *sAdded и одним
+     * *sDeleted на таблицу, а не сигналом на каждую запись.
+     */
+    QList<WriteResult> applyWrites(const QList<WriteOperation> &operations);
+    
 signals:
     /**
      * @brief Сигнал о изменении состояния подключения к БД
@@ -169,22 +483,166 @@ signals:
     void databaseConnected(bool success);
     
     /**
-     * @brief Сигнал об изменении данных в базе
-     * @details Генерируется при любых операциях изменения данных (добавление, удаление)
+     * @brief Сигнал о добавлении записи в таблицу teachers
+     * @param record Добавленная запись
+     */
+    void teacherAdded(const TeacherRecord &record);
+    
+    /**
+     * @brief Сигнал об удалении записи из таблицы teachers
+     * @param id Идентификатор удаленной записи
+     */
+    void teacherDeleted(int id);
+    
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу teachers
+     * @param records Добавленные записи в порядке возрастания id
+     */
+    void teachersAdded(const QList<TeacherRecord> &records);
+    
+    /**
+     * @brief Сигнал о добавлении записи в таблицу students
+     * @param record Добавленная запись
+     */
+    void studentAdded(const StudentRecord &record);
+    
+    /**
+     * @brief Сигнал об удалении записи из таблицы students
+     * @param record Удаленная запись
+     */
+    void studentDeleted(const StudentRecord &record);
+    
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу students
+     * @param records Добавленные записи в порядке возрастания id
      */
-    void dataChanged();
+    void studentsAdded(const QList<StudentRecord> &records);
+    
+    /**
+     * @brief Сигнал о добавлении записи в таблицу subjects
+     * @param record Добавленная запись
+     */
+    void subjectAdded(const SubjectRecord &record);
+    
+    /**
+     * @brief Сигнал об удалении записи из таблицы subjects
+     * @param id Идентификатор удаленной записи
+     */
+    void subjectDeleted(int id);
+    
+    /**
+     * @brief Сигнал о добавлении пакета записей в таблицу subjects
+     * @param records Добавленные записи в порядке возрастания id
+     */
+    void subjectsAdded(const QList<SubjectRecord> &records);
+    
+    /**
+     * @brief Сигнал об изменении записей таблицы teachers другим клиентом
+     * @param records Новые значения записей в порядке возрастания id
+     */
+    void teachersUpdated(const QList<TeacherRecord> &records);
+    
+    /**
+     * @brief Сигнал об удалении записей из таблицы teachers другим клиентом или пакетом записи
+     * @param ids Идентификаторы удаленных записей
+     */
+    void teachersDeleted(const QList<int> &ids);
+    
+    /**
+     * @brief Сигнал об изменении записей таблицы students другим клиентом
+     * @param records Новые значения записей в порядке возрастания id
+     * @param previousGrades Оценки до изменения в порядке records, 0 если неизвестна
+     */
+    void studentsUpdated(const QList<StudentRecord> &records, const QList<int> &previousGrades);
+    
+    /**
+     * @brief Сигнал об удалении записей из таблицы students другим клиентом или пакетом записи
+     * @param records Удаленные записи; об удалениях другими клиентами известны
+     * только id и оценка (0, если неизвестна)
+     */
+    void studentsDeleted(const QList<StudentRecord> &records);
+    
+    /**
+     * @brief Сигнал об изменении записей таблицы subjects другим клиентом
+     * @param records Новые значения записей в порядке возрастания id
+     */
+    void subjectsUpdated(const QList<SubjectRecord> &records);
+    
+    /**
+     * @brief Сигнал об удалении записей из таблицы subjects другим клиентом или пакетом записи
+     * @param ids Идентификаторы удаленных записей
+     */
+    void subjectsDeleted(const QList<int> &ids);
+    
+    /**
+     * @brief Сигнал об изменении записей на предметы или назначений
+     * @details Составы предметов, собранные заранее, нужно пересобрать
+     * (refreshRosters()). Удаление записей меняет составы каскадно
+     * и сообщается только сигналами *Deleted.
+     */
+    void rostersChanged();
+    
+    /**
+     * @brief Сигнал о том, что таблицу нужно перечитать целиком
+     * @param table Имя таблицы
+     * @details Другой клиент изменил слишком много строк, чтобы сообщать
+     * о них по отдельности (например, импортом через COPY)
+     */
+    void tableReloadRequired(const QString &table);
     
 private:
     /**
-     * @brief Инициализировать базу данных
-     * @details Создает необходимые таблицы если они не существуют
+     * @struct PendingChange
+     * @brief Первое изменение строки другим клиентом за интервал объединения
+     */
+    struct PendingChange
+    {
+        bool inserted = false;  ///< Строка добавлена
+        int previousGrade = 0;  ///< Оценка студента до изменения или 0
+    };
+    
+    /**
+     * @brief Запомнить изменение строк другим клиентом
+     * @param table Имя таблицы
+     * @param ids Идентификаторы строк
+     * @param inserted true если строки добавлены
+     * @param previousGrades Для students — оценки до изменения в порядке ids
+     * 
+     * @details Запоминается только первое изменение строки: INSERT,
+     * за которым следует DELETE, не должен быть виден вовсе, а прежняя
+     * оценка должна быть оценкой до всей серии изменений
      */
-    void initializeDatabase();
+    void onRowsChanged(const QString &table, const QList<int> &ids, bool inserted,
+                       const QList<int> &previousGrades);
     
     /**
-     * @brief Объект соединения с базой данных
+     * @brief Отбросить накопленные изменения таблицы и попросить перечитать ее
+     * @param table Имя таблицы
      */
-    QSqlDatabase m_database;
+    void onTableChanged(const QString &table);
+    
+    /**
+     * @brief Перечитать строки из накопленных изменений
+     * 
+     * @details Для каждой таблицы выполняется один запрос по списку id.
+     * Найденные строки сообщаются как добавленные или измененные
+     * (по первой операции), отсутствующие — как удаленные. Если запрос
+     * не выполнился, изменения таблицы откладываются (requeueChanges()).
+     */
+    void applyPendingChanges();
+    
+    /**
+     * @brief Вернуть изменения таблицы в очередь после ошибки чтения
+     * @param table Имя таблицы
+     * @param changes id -> первое изменение
+     */
+    void requeueChanges(const QString &table, const QHash<int, PendingChange> &changes);
+    
+    StorageBackend *m_storage;      ///< Хранилище данных
+    std::atomic<bool> m_connected;  ///< Результат последнего подключения
+    QTimer *m_changeTimer;          ///< Таймер объединения уведомлений
+    QHash<QString, QHash<int, PendingChange>> m_pendingChanges; ///< Таблица -> id -> первое изменение
+    std::unique_ptr<RecordCursor<StudentRecord>> m_studentCursor; ///< Открытый курсор по студентам
 };
 
 #endif // DATABASEMANAGER_H
\ No newline at end of file
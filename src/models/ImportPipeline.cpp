@@ -0,0 +1,687 @@
+/**
+ * @file ImportPipeline.cpp
+ * @brief Реализация класса ImportPipeline
+ * @ingroup Models
+ */
+
+#include "ImportPipeline.h"
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMutexLocker>
+#include <QThread>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Количество отклоненных строк, которые выводятся в лог
+ */
+static constexpr int MAX_LOGGED_REJECTIONS = 20;
+
+/**
+ * @brief Конструктор ImportPipeline
+ * @param dbManager Менеджер БД
+ * @param parent Родительский QObject
+ */
+ImportPipeline::ImportPipeline(AsyncDatabaseManager *dbManager, QObject *parent)
+    : QObject(parent)
+    , m_dbManager(dbManager)
+    , m_readerThread(nullptr)
+    , m_writerThread(nullptr)
+    , m_elapsedMs(0)
+    , m_running(false)
+    , m_table(Table::Students)
+    , m_format(Format::Csv)
+    , m_fileSize(0)
+    , m_readerDone(true)
+    , m_chunkCount(0)
+    , m_cancelled(false)
+    , m_bytesRead(0)
+    , m_importedRows(0)
+    , m_rejectedRows(0)
+    , m_loggedRejections(0)
+{
+    // Один поток занят чтением, один записью
+    m_parsePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 2));
+
+    m_progressTimer.setInterval(PROGRESS_INTERVAL);
+    connect(&m_progressTimer, &QTimer::timeout, this, &ImportPipeline::progressChanged);
+}
+
+/**
+ * @brief Деструктор ImportPipeline
+ */
+ImportPipeline::~ImportPipeline()
+{
+    cancel();
+    if (m_readerThread) {
+        m_readerThread->wait();
+        delete m_readerThread;
+    }
+    if (m_writerThread) {
+        m_writerThread->wait();
+        delete m_writerThread;
+    }
+    m_parsePool.waitForDone();
+}
+
+/**
+ * @brief Запуск импорта
+ * @param fileUrl Путь или URL файла
+ * @param table Имя таблицы
+ * @return bool true если импорт запущен
+ */
+bool ImportPipeline::start(const QUrl &fileUrl, const QString &table)
+{
+    if (m_running) {
+        emit errorOccurred("Импорт уже выполняется");
+        return false;
+    }
+
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+
+    if (table == "teachers") {
+        m_table = Table::Teachers;
+    } else if (table == "students") {
+        m_table = Table::Students;
+    } else if (table == "subjects") {
+        m_table = Table::Subjects;
+    } else {
+        emit errorOccurred(QString("Неизвестная таблица: %1").arg(table));
+        return false;
+    }
+
+    const QString path = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    const QFileInfo info(path);
+    if (!info.isFile() || !info.isReadable()) {
+        emit errorOccurred(QString("Файл недоступен: %1").arg(path));
+        return false;
+    }
+
+    const QString suffix = info.suffix().toLower();
+    if (suffix == "csv") {
+        m_format = Format::Csv;
+    } else if (suffix == "json" || suffix == "ndjson" || suffix == "jsonl") {
+        m_format = Format::Json;
+    } else {
+        emit errorOccurred(QString("Неподдерживаемый формат файла: %1").arg(suffix));
+        return false;
+    }
+
+    // Потоки прошлого импорта уже завершены в onWriterFinished()
+    m_fileSize = info.size();
+    m_results.clear();
+    m_readerDone = false;
+    m_chunkCount = 0;
+    m_lastError.clear();
+    m_cancelled = false;
+    m_bytesRead = 0;
+    m_importedRows = 0;
+    m_rejectedRows = 0;
+    m_loggedRejections = 0;
+    m_elapsedMs = 0;
+
+    // Семафор мог остаться неполным после отмены
+    m_inFlight.acquire(m_inFlight.available());
+    m_inFlight.release(maxInFlight());
+
+    m_readerThread = QThread::create([this, path]() { readFile(path); });
+    m_writerThread = QThread::create([this]() { writeResults(); });
+    m_readerThread->setObjectName("ImportReader");
+    m_writerThread->setObjectName("ImportWriter");
+    connect(m_writerThread, &QThread::finished, this, &ImportPipeline::onWriterFinished);
+
+    m_running = true;
+    m_elapsed.start();
+    m_progressTimer.start();
+    m_readerThread->start();
+    m_writerThread->start();
+
+    qDebug() << "Импорт" << path << "в" << table;
+    emit runningChanged();
+    emit progressChanged();
+    return true;
+}
+
+/**
+ * @brief Отмена импорта
+ */
+void ImportPipeline::cancel()
+{
+    m_cancelled = true;
+    QMutexLocker locker(&m_mutex);
+    m_resultReady.wakeAll();
+}
+
+/**
+ * @brief Проверка выполнения импорта
+ * @return bool Состояние импорта
+ */
+bool ImportPipeline::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief Получение доли прочитанного файла
+ * @return double Значение от 0 до 1
+ */
+double ImportPipeline::progress() const
+{
+    if (m_fileSize <= 0) {
+        return m_running ? 0.0 : 1.0;
+    }
+    return qMin(1.0, static_cast<double>(m_bytesRead) / static_cast<double>(m_fileSize));
+}
+
+/**
+ * @brief Получение количества записанных строк
+ * @return qint64 Количество строк
+ */
+qint64 ImportPipeline::importedRows() const
+{
+    return m_importedRows;
+}
+
+/**
+ * @brief Получение количества отклоненных строк
+ * @return qint64 Количество строк
+ */
+qint64 ImportPipeline::rejectedRows() const
+{
+    return m_rejectedRows;
+}
+
+/**
+ * @brief Получение скорости обработки
+ * @return double Обработанных (записанных и отклоненных) строк в секунду
+ */
+double ImportPipeline::rowsPerSecond() const
+{
+    const qint64 elapsed = m_running ? m_elapsed.elapsed() : m_elapsedMs;
+    if (elapsed <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_importedRows + m_rejectedRows) * 1000.0 / static_cast<double>(elapsed);
+}
+
+/**
+ * @brief Получение текста последней ошибки
+ * @return QString Текст ошибки
+ */
+QString ImportPipeline::lastError() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+/**
+ * @brief Получение предела блоков в обработке
+ * @return int Два блока на поток разбора и по одному для чтения и записи
+ */
+int ImportPipeline::maxInFlight() const
+{
+    return m_parsePool.maxThreadCount() * 2 + 2;
+}
+
+/**
+ * @brief Чтение файла
+ * @param path Путь к файлу
+ *
+ * @details Для CSV строки с незакрытой кавычкой склеиваются со следующими,
+ * чтобы значение с переводом строки не разрывалось между блоками
+ */
+void ImportPipeline::readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fail(QString("Не удалось открыть файл: %1").arg(file.errorString()));
+    } else {
+        Chunk chunk;
+        QString pending;
+        qint64 lineNumber = 0;
+        bool firstRecord = true;
+
+        while (!m_cancelled && !file.atEnd()) {
+            const QByteArray bytes = file.readLine();
+            m_bytesRead += bytes.size();
+            ++lineNumber;
+
+            QString line = QString::fromUtf8(bytes);
+            if (firstRecord && line.startsWith(QChar(0xFEFF))) {
+                line.remove(0, 1);
+            }
+            while (line.endsWith('\n') || line.endsWith('\r')) {
+                line.chop(1);
+            }
+
+            if (m_format == Format::Csv) {
+                if (!pending.isEmpty()) {
+                    line = pending + '\n' + line;
+                    pending.clear();
+                }
+                if (line.count('"') % 2 != 0 && !file.atEnd()) {
+                    pending = line;
+                    continue;
+                }
+            }
+
+            const QString trimmed = line.trimmed();
+            if (trimmed.isEmpty() || (m_format == Format::Json && (trimmed == "[" || trimmed == "]"))) {
+                continue;
+            }
+
+            if (firstRecord) {
+                firstRecord = false;
+                if (m_format == Format::Csv) {
+                    chunk.separator = line.count(';') > line.count(',') ? QChar(';') : QChar(',');
+                    const QString first = splitCsv(line, chunk.separator).value(0).trimmed();
+                    if (first.compare(columns().first(), Qt::CaseInsensitive) == 0
+                        || first.compare("fullName", Qt::CaseInsensitive) == 0) {
+                        // Строка заголовка
+                        continue;
+                    }
+                }
+            }
+
+            if (chunk.lines.isEmpty()) {
+                chunk.firstLine = lineNumber;
+            }
+            chunk.lines.append(line);
+
+            if (chunk.lines.size() >= CHUNK_ROWS) {
+                const QChar separator = chunk.separator;
+                if (!submitChunk(std::move(chunk))) {
+                    break;
+                }
+                chunk = Chunk();
+                chunk.separator = separator;
+            }
+        }
+
+        if (!m_cancelled && !chunk.lines.isEmpty()) {
+            submitChunk(std::move(chunk));
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_readerDone = true;
+    m_resultReady.wakeAll();
+}
+
+/**
+ * @brief Отправка блока на разбор
+ * @param chunk Блок строк
+ * @return bool Блок отправлен
+ *
+ * @details Обратное давление: если в обработке уже maxInFlight() блоков,
+ * поток чтения ждет, пока поток записи не заберет один из них
+ */
+bool ImportPipeline::submitChunk(Chunk chunk)
+{
+    while (!m_inFlight.tryAcquire(1, 100)) {
+        if (m_cancelled) {
+            return false;
+        }
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        chunk.index = m_chunkCount++;
+    }
+
+    m_parsePool.start([this, chunk = std::move(chunk)]() {
+        Rows rows = parseChunk(chunk);
+        QMutexLocker locker(&m_mutex);
+        m_results.insert(chunk.index, std::move(rows));
+        m_resultReady.wakeAll();
+    });
+    return true;
+}
+
+/**
+ * @brief Разбор и проверка блока
+ * @param chunk Блок строк
+ * @return Rows Результат разбора
+ */
+ImportPipeline::Rows ImportPipeline::parseChunk(const Chunk &chunk) const
+{
+    Rows rows;
+    QStringList fields;
+    qint64 lineNumber = chunk.firstLine;
+
+    for (const QString &line : chunk.lines) {
+        QString error;
+        if (!parseFields(line, chunk.separator, fields)) {
+            error = "Не удалось разобрать строку";
+        } else {
+            error = validate(fields, rows);
+        }
+
+        if (!error.isEmpty()) {
+            ++rows.rejected;
+            if (m_loggedRejections.fetch_add(1) < MAX_LOGGED_REJECTIONS) {
+                qWarning() << "Импорт: строка" << lineNumber << "отклонена:" << error;
+            }
+        }
+        // Номер приблизительный для записей CSV из нескольких строк
+        ++lineNumber;
+    }
+    return rows;
+}
+
+/**
+ * @brief Разбор строки в значения столбцов
+ * @param line Строка файла
+ * @param separator Разделитель CSV
+ * @param fields Значения столбцов
+ * @return bool Результат разбора
+ */
+bool ImportPipeline::parseFields(const QString &line, QChar separator, QStringList &fields) const
+{
+    const QStringList names = columns();
+    fields.clear();
+
+    if (m_format == Format::Csv) {
+        fields = splitCsv(line, separator);
+        if (fields.size() < names.size()) {
+            return false;
+        }
+        for (QString &field : fields) {
+            field = field.trimmed();
+        }
+        return true;
+    }
+
+    // Допускаем массив, записанный по объекту на строку
+    QString text = line.trimmed();
+    if (text.startsWith('[')) {
+        text.remove(0, 1);
+    }
+    if (text.endsWith(']')) {
+        text.chop(1);
+    }
+    if (text.endsWith(',')) {
+        text.chop(1);
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(text.toUtf8(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        return false;
+    }
+
+    const QJsonObject object = document.object();
+    for (const QString &name : names) {
+        QJsonValue value = object.value(name);
+        if (value.isUndefined() && name == "full_name") {
+            value = object.value("fullName");
+        }
+        if (value.isDouble()) {
+            // Дробное или не помещающееся в int число передается как есть,
+            // и validate() отклоняет его так же, как нечисловую оценку в CSV
+            const double number = value.toDouble();
+            const bool integral = std::trunc(number) == number
+                                  && number >= std::numeric_limits<int>::min()
+                                  && number <= std::numeric_limits<int>::max();
+            fields.append(integral ? QString::number(static_cast<int>(number))
+                                   : QString::number(number, 'g', 17));
+        } else {
+            fields.append(value.toString());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Проверка значений и добавление записи
+ * @param fields Значения столбцов
+ * @param rows Принятые записи
+ * @return QString Текст ошибки или пустая строка
+ */
+QString ImportPipeline::validate(const QStringList &fields, Rows &rows) const
+{
+    switch (m_table) {
+    case Table::Teachers: {
+        const TeacherRecord record{0, fields.at(0), fields.at(1)};
+        const QString error = record.validationError();
+        if (error.isEmpty()) {
+            rows.teachers.append(record);
+        }
+        return error;
+    }
+    case Table::Students: {
+        bool ok = false;
+        const int grade = fields.at(1).toInt(&ok);
+        if (!ok) {
+            return "Оценка должна быть числом";
+        }
+        const StudentRecord record{0, fields.at(0), grade};
+        const QString error = record.validationError();
+        if (error.isEmpty()) {
+            rows.students.append(record);
+        }
+        return error;
+    }
+    case Table::Subjects: {
+        const SubjectRecord record{0, fields.at(0)};
+        const QString error = record.validationError();
+        if (error.isEmpty()) {
+            rows.subjects.append(record);
+        }
+        return error;
+    }
+    }
+    return QString();
+}
+
+/**
+ * @brief Запись результатов
+ *
+ * @details Блоки забираются строго по номерам, поэтому записи попадают
+ * в БД в порядке файла. После отмены оставшиеся блоки только освобождают
+ * места семафора, чтобы поток чтения не завис.
+ */
+void ImportPipeline::writeResults()
+{
+    Rows batch;
+    int next = 0;
+
+    forever {
+        Rows rows;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_results.contains(next) && !(m_readerDone && next >= m_chunkCount)) {
+                m_resultReady.wait(&m_mutex);
+            }
+            if (!m_results.contains(next)) {
+                break;
+            }
+            rows = m_results.take(next);
+        }
+        ++next;
+        m_inFlight.release();
+
+        m_rejectedRows += rows.rejected;
+        if (m_cancelled) {
+            continue;
+        }
+
+        batch.append(rows);
+        if (batch.size() >= BATCH_ROWS) {
+            writeBatch(batch);
+            batch.clear();
+        }
+    }
+
+    if (!m_cancelled && batch.size() > 0) {
+        writeBatch(batch);
+    }
+}
+
+/**
+ * @brief Запись пакета
+ * @param batch Пакет записей
+ * @return bool Результат записи
+ */
+bool ImportPipeline::writeBatch(const Rows &batch)
+{
+    QFuture<QList<int>> future;
+    switch (m_table) {
+    case Table::Teachers:
+        future = m_dbManager->addTeachers(batch.teachers);
+        break;
+    case Table::Students:
+        future = m_dbManager->addStudents(batch.students);
+        break;
+    case Table::Subjects:
+        future = m_dbManager->addSubjects(batch.subjects);
+        break;
+    }
+
+    future.waitForFinished();
+    const int expected = batch.size();
+    if (future.isCanceled() || future.resultCount() == 0 || future.result().size() != expected) {
+        fail(QString("Не удалось записать пакет из %1 строк").arg(expected));
+        return false;
+    }
+
+    m_importedRows += expected;
+    return true;
+}
+
+/**
+ * @brief Завершение импорта
+ */
+void ImportPipeline::onWriterFinished()
+{
+    m_readerThread->wait();
+    delete m_readerThread;
+    m_readerThread = nullptr;
+    m_writerThread->deleteLater();
+    m_writerThread = nullptr;
+
+    m_elapsedMs = m_elapsed.elapsed();
+    m_progressTimer.stop();
+    m_running = false;
+
+    const QString error = lastError();
+    qDebug() << "Импорт завершен: записано" << importedRows() << "отклонено" << rejectedRows()
+             << "за" << m_elapsedMs << "мс";
+
+    emit progressChanged();
+    emit runningChanged();
+    if (!error.isEmpty()) {
+        emit errorOccurred(error);
+    }
+    emit finished(importedRows(), rejectedRows());
+}
+
+/**
+ * @brief Остановка импорта с ошибкой
+ * @param message Текст ошибки
+ */
+void ImportPipeline::fail(const QString &message)
+{
+    qWarning() << "Ошибка импорта:" << message;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = message;
+    }
+    cancel();
+}
+
+/**
+ * @brief Получение имен столбцов
+ * @return QStringList Столбцы целевой таблицы в порядке CSV
+ */
+QStringList ImportPipeline::columns() const
+{
+    switch (m_table) {
+    case Table::Teachers:
+        return {"full_name", "department"};
+    case Table::Students:
+        return {"full_name", "grade"};
+    case Table::Subjects:
+        return {"name"};
+    }
+    return {};
+}
+
+/**
+ * @brief Разделение записи CSV
+ * @param line Запись
+ * @param separator Разделитель
+ * @return QStringList Поля
+ *
+ * @details Удвоенная кавычка внутри поля в кавычках означает одну кавычку
+ */
+QStringList ImportPipeline::splitCsv(const QString &line, QChar separator)
+{
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+
+    for (int i = 0; i < line.size(); ++i) {
+        const QChar c = line.at(i);
+        if (quoted) {
+            if (c == '"') {
+                if (i + 1 < line.size() && line.at(i + 1) == '"') {
+                    field.append('"');
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            } else {
+                field.append(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == separator) {
+            fields.append(field);
+            field.clear();
+        } else {
+            field.append(c);
+        }
+    }
+    fields.append(field);
+    return fields;
+}
+
+/**
+ * @brief Количество принятых записей
+ * @return int Количество записей
+ */
+int ImportPipeline::Rows::size() const
+{
+    return static_cast<int>(teachers.size() + students.size() + subjects.size());
+}
+
+/**
+ * @brief Добавление записей другого блока
+ * @param other Записи блока
+ */
+void ImportPipeline::Rows::append(const Rows &other)
+{
+    teachers.append(other.teachers);
+    students.append(other.students);
+    subjects.append(other.subjects);
+    rejected += other.rejected;
+}
+
+/**
+ * @brief Очистка записей
+ */
+void ImportPipeline::Rows::clear()
+{
+    teachers.clear();
+    students.clear();
+    subjects.clear();
+    rejected = 0;
+}
@@ -0,0 +1,344 @@
+/**
+ * @file ImportPipeline.h
+ * @brief Заголовочный файл класса ImportPipeline
+ * @ingroup Models
+ *
+ * @class ImportPipeline
+ * @brief Многопоточный импорт записей из CSV и JSON файлов
+ *
+ * Импорт разбит на стадии:
+ * - чтение: отдельный поток читает файл построчно и режет его на блоки
+ *   по CHUNK_ROWS строк
+ * - разбор: блоки разбираются в пуле потоков (CSV или JSON в поля записи)
+ * - проверка: каждая запись проверяется validationError() — по тем же
+ *   правилам, что и ручной ввод в UniversityViewModel
+ * - запись: отдельный поток собирает блоки в исходном порядке и пишет их
+ *   пакетами по BATCH_ROWS строк через AsyncDatabaseManager::addStudents()
+ *   и аналогичные методы
+ *
+ * Одновременно в обработке находится не больше maxInFlight() блоков:
+ * поток чтения ждет на семафоре, пока запись не освободит место.
+ * Поэтому расход памяти не зависит от размера файла.
+ *
+ * Форматы:
+ * - CSV (.csv): разделитель «,» или «;», поля в кавычках по RFC 4180,
+ *   необязательная строка заголовка. Порядок столбцов: full_name, department
+ *   для teachers; full_name, grade для students; name для subjects.
+ * - JSON (.json, .ndjson, .jsonl): по одному объекту на строку. Массив
+ *   тоже принимается, если каждый объект записан в отдельной строке.
+ *   Ключи — имена столбцов (full_name) или свойств записи (fullName).
+ *
+ * @property bool ImportPipeline::running
+ * @brief Идет импорт
+ *
+ * @property double ImportPipeline::progress
+ * @brief Доля прочитанного файла (0..1)
+ *
+ * @property qint64 ImportPipeline::importedRows
+ * @brief Количество записанных в БД строк
+ *
+ * @property qint64 ImportPipeline::rejectedRows
+ * @brief Количество строк, не прошедших разбор или проверку
+ *
+ * @property double ImportPipeline::rowsPerSecond
+ * @brief Скорость обработки строк
+ *
+ * @property QString ImportPipeline::lastError
+ * @brief Текст последней ошибки импорта
+ */
+
+#ifndef IMPORTPIPELINE_H
+#define IMPORTPIPELINE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QMap>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <atomic>
+#include "AsyncDatabaseManager.h"
+
+class QThread;
+
+class ImportPipeline : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(qint64 importedRows READ importedRows NOTIFY progressChanged)
+    Q_PROPERTY(qint64 rejectedRows READ rejectedRows NOTIFY progressChanged)
+    Q_PROPERTY(double rowsPerSecond READ rowsPerSecond NOTIFY progressChanged)
+    Q_PROPERTY(QString lastError READ lastError NOTIFY progressChanged)
+
+public:
+    /**
+     * @brief Количество строк файла в одном блоке разбора
+     */
+    static constexpr int CHUNK_ROWS = 2000;
+
+    /**
+     * @brief Количество записей в одной транзакции записи
+     */
+    static constexpr int BATCH_ROWS = 10000;
+
+    /**
+     * @brief Интервал обновления прогресса в QML, мс
+     */
+    static constexpr int PROGRESS_INTERVAL = 200;
+
+    /**
+     * @brief Конструктор конвейера импорта
+     * @param dbManager Менеджер БД для записи пакетов
+     * @param parent Родительский QObject
+     */
+    explicit ImportPipeline(AsyncDatabaseManager *dbManager, QObject *parent = nullptr);
+
+    /**
+     * @brief Деструктор конвейера
+     * @details Отменяет импорт и дожидается завершения всех потоков
+     */
+    ~ImportPipeline();
+
+    /**
+     * @brief Запустить импорт файла (инвокабельный метод для QML)
+     * @param fileUrl Путь или file:// URL файла
+     * @param table Таблица: "teachers", "students" или "subjects"
+     * @return bool true если импорт запущен
+     *
+     * @details Ошибки запуска сообщаются сигналом errorOccurred
+     */
+    Q_INVOKABLE bool start(const QUrl &fileUrl, const QString &table);
+
+    /**
+     * @brief Отменить импорт (инвокабельный метод для QML)
+     * @details Уже записанные пакеты остаются в БД
+     */
+    Q_INVOKABLE void cancel();
+
+    /**
+     * @brief Проверить, идет ли импорт
+     * @return bool true если импорт выполняется
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Получить долю прочитанного файла
+     * @return double Значение от 0 до 1
+     */
+    double progress() const;
+
+    /**
+     * @brief Получить количество записанных строк
+     * @return qint64 Количество строк
+     */
+    qint64 importedRows() const;
+
+    /**
+     * @brief Получить количество отклоненных строк
+     * @return qint64 Количество строк
+     */
+    qint64 rejectedRows() const;
+
+    /**
+     * @brief Получить скорость обработки
+     * @return double Строк в секунду
+     */
+    double rowsPerSecond() const;
+
+    /**
+     * @brief Получить текст последней ошибки
+     * @return QString Текст ошибки
+     */
+    QString lastError() const;
+
+signals:
+    /**
+     * @brief Сигнал о запуске или завершении импорта
+     */
+    void runningChanged();
+
+    /**
+     * @brief Сигнал об изменении прогресса (не чаще PROGRESS_INTERVAL)
+     */
+    void progressChanged();
+
+    /**
+     * @brief Сигнал о завершении импорта
+     * @param importedRows Количество записанных строк
+     * @param rejectedRows Количество отклоненных строк
+     */
+    void finished(qint64 importedRows, qint64 rejectedRows);
+
+    /**
+     * @brief Сигнал об ошибке импорта
+     * @param message Текст ошибки
+     */
+    void errorOccurred(const QString &message);
+
+private:
+    /**
+     * @brief Целевая таблица
+     */
+    enum class Table { Teachers, Students, Subjects };
+
+    /**
+     * @brief Формат файла
+     */
+    enum class Format { Csv, Json };
+
+    /**
+     * @struct Chunk
+     * @brief Блок строк файла для разбора
+     */
+    struct Chunk
+    {
+        int index = 0;              ///< Порядковый номер блока
+        qint64 firstLine = 0;       ///< Номер первой строки в файле
+        QChar separator;            ///< Разделитель CSV
+        QStringList lines;          ///< Строки (записи CSV могут занимать несколько строк файла)
+    };
+
+    /**
+     * @struct Rows
+     * @brief Разобранные и проверенные записи
+     */
+    struct Rows
+    {
+        QList<TeacherRecord> teachers;  ///< Записи для teachers
+        QList<StudentRecord> students;  ///< Записи для students
+        QList<SubjectRecord> subjects;  ///< Записи для subjects
+        int rejected = 0;               ///< Количество отклоненных строк
+
+        /**
+         * @brief Получить количество принятых записей
+         * @return int Количество записей
+         */
+        int size() const;
+
+        /**
+         * @brief Дописать записи другого блока
+         * @param other Записи блока
+         */
+        void append(const Rows &other);
+
+        /**
+         * @brief Удалить все записи
+         */
+        void clear();
+    };
+
+    /**
+     * @brief Максимальное количество блоков в обработке
+     * @return int Количество блоков
+     */
+    int maxInFlight() const;
+
+    /**
+     * @brief Стадия чтения (поток чтения)
+     * @param path Путь к файлу
+     */
+    void readFile(const QString &path);
+
+    /**
+     * @brief Отправить блок на разбор
+     * @param chunk Блок строк
+     * @return bool false если импорт отменен во время ожидания места
+     */
+    bool submitChunk(Chunk chunk);
+
+    /**
+     * @brief Стадии разбора и проверки одного блока (пул потоков)
+     * @param chunk Блок строк
+     * @return Rows Принятые записи и количество отклоненных
+     */
+    Rows parseChunk(const Chunk &chunk) const;
+
+    /**
+     * @brief Разобрать строку в значения столбцов
+     * @param line Строка файла
+     * @param separator Разделитель CSV
+     * @param fields Сюда записываются значения в порядке columns()
+     * @return bool true если строка разобрана
+     */
+    bool parseFields(const QString &line, QChar separator, QStringList &fields) const;
+
+    /**
+     * @brief Проверить значения и добавить запись
+     * @param fields Значения столбцов
+     * @param rows Принятые записи
+     * @return QString Текст ошибки или пустая строка, если запись принята
+     */
+    QString validate(const QStringList &fields, Rows &rows) const;
+
+    /**
+     * @brief Стадия записи (поток записи)
+     */
+    void writeResults();
+
+    /**
+     * @brief Записать пакет в БД и дождаться результата
+     * @param batch Пакет записей
+     * @return bool true если все записи пакета добавлены
+     */
+    bool writeBatch(const Rows &batch);
+
+    /**
+     * @brief Обработать завершение потока записи (поток владельца)
+     */
+    void onWriterFinished();
+
+    /**
+     * @brief Запомнить ошибку и остановить импорт
+     * @param message Текст ошибки
+     */
+    void fail(const QString &message);
+
+    /**
+     * @brief Получить имена столбцов целевой таблицы
+     * @return QStringList Имена столбцов без id
+     */
+    QStringList columns() const;
+
+    /**
+     * @brief Разделить запись CSV на поля
+     * @param line Запись
+     * @param separator Разделитель
+     * @return QStringList Поля без кавычек
+     */
+    static QStringList splitCsv(const QString &line, QChar separator);
+
+    AsyncDatabaseManager *m_dbManager;  ///< Менеджер БД для записи
+    QThreadPool m_parsePool;            ///< Потоки разбора
+    QThread *m_readerThread;            ///< Поток чтения
+    QThread *m_writerThread;            ///< Поток записи
+    QTimer m_progressTimer;             ///< Таймер обновления прогресса
+    QElapsedTimer m_elapsed;            ///< Время с начала импорта
+    qint64 m_elapsedMs;                 ///< Длительность завершенного импорта
+    bool m_running;                     ///< Идет импорт
+
+    Table m_table;                      ///< Целевая таблица
+    Format m_format;                    ///< Формат файла
+    qint64 m_fileSize;                  ///< Размер файла в байтах
+
+    QSemaphore m_inFlight;              ///< Свободные места для блоков в обработке
+    mutable QMutex m_mutex;             ///< Защита m_results, m_readerDone, m_chunkCount, m_lastError
+    QWaitCondition m_resultReady;       ///< Появился разобранный блок или чтение завершено
+    QMap<int, Rows> m_results;          ///< Разобранные блоки по номеру
+    bool m_readerDone;                  ///< Чтение завершено
+    int m_chunkCount;                   ///< Количество отправленных на разбор блоков
+    QString m_lastError;                ///< Последняя ошибка
+
+    std::atomic<bool> m_cancelled;      ///< Импорт отменен
+    std::atomic<qint64> m_bytesRead;    ///< Прочитано байт
+    std::atomic<qint64> m_importedRows; ///< Записано строк
+    std::atomic<qint64> m_rejectedRows; ///< Отклонено строк
+    mutable std::atomic<int> m_loggedRejections; ///< Количество выведенных в лог отклонений
+};
+
+#endif // IMPORTPIPELINE_H
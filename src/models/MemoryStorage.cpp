@@ -0,0 +1,777 @@
+/**
+ * @file MemoryStorage.cpp
+ * @brief Реализация класса MemoryStorage
+ * @ingroup Models
+ */
+
+#include "MemoryStorage.h"
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Проверка допустимости оценки
+ * @param grade Оценка
+ * @return bool true для оценок от 1 до 5
+ */
+static bool isGradeValid(int grade)
+{
+    return grade >= 1 && grade <= 5;
+}
+
+/**
+ * @brief Текст ошибки недопустимой оценки
+ * @param grade Оценка
+ * @return QString Текст ошибки
+ */
+static QString gradeError(int grade)
+{
+    return QString("Оценка должна быть от 1 до 5, получено %1").arg(grade);
+}
+
+/**
+ * @brief Копирование записей по порядку id
+ * @tparam Record Тип записи
+ * @param table Таблица
+ * @param from Позиция в списке id
+ * @param limit Максимальное количество записей
+ * @return QList<Record> Записи
+ */
+template <typename Record, typename Table>
+static QList<Record> rowsFrom(const Table &table, qsizetype from, qsizetype limit)
+{
+    const qsizetype to = std::min(table.order.size(), from + limit);
+    QList<Record> records;
+    records.reserve(std::max<qsizetype>(0, to - from));
+    for (qsizetype i = from; i < to; ++i) {
+        records.append(table.rows.value(table.order.at(i)));
+    }
+    return records;
+}
+
+/**
+ * @brief Страница записей с id больше afterId
+ * @tparam Record Тип записи
+ * @param table Таблица
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<Record> Записи
+ */
+template <typename Record, typename Table>
+static QList<Record> pageRows(const Table &table, int afterId, int limit)
+{
+    const auto it = std::upper_bound(table.order.cbegin(), table.order.cend(), afterId);
+    return rowsFrom<Record>(table, it - table.order.cbegin(), limit);
+}
+
+/**
+ * @brief Записи по списку id
+ * @tparam Record Тип записи
+ * @param table Таблица
+ * @param ids Идентификаторы
+ * @return QList<Record> Найденные записи в порядке возрастания id
+ */
+template <typename Record, typename Table>
+static QList<Record> rowsByIds(const Table &table, QList<int> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    QList<Record> records;
+    records.reserve(ids.size());
+    for (int id : std::as_const(ids)) {
+        const auto it = table.rows.constFind(id);
+        if (it != table.rows.constEnd()) {
+            records.append(it.value());
+        }
+    }
+    return records;
+}
+
+/**
+ * @brief Добавление записи со следующим id
+ * @param table Таблица
+ * @param record Запись
+ * @return Record Запись с выданным id
+ */
+template <typename Record, typename Table>
+static Record insertRow(Table &table, Record record)
+{
+    record.id = ++table.lastId;
+    table.rows.insert(record.id, record);
+    // id растут, поэтому список остается отсортированным
+    table.order.append(record.id);
+    return record;
+}
+
+/**
+ * @brief Удаление записи
+ * @param table Таблица
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0
+ */
+template <typename Table>
+static int removeRow(Table &table, int id)
+{
+    if (!table.rows.remove(id)) {
+        return 0;
+    }
+    const auto it = std::lower_bound(table.order.begin(), table.order.end(), id);
+    table.order.erase(it);
+    return id;
+}
+
+/**
+ * @brief Удаление записей по списку id
+ * @param table Таблица
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей по возрастанию
+ *
+ * @details Список порядка перестраивается за один проход,
+ * а не сдвигается на каждую удаленную запись
+ */
+template <typename Table>
+static QList<int> removeRows(Table &table, const QList<int> &ids)
+{
+    QList<int> deleted;
+    deleted.reserve(ids.size());
+    for (int id : ids) {
+        if (table.rows.remove(id)) {
+            deleted.append(id);
+        }
+    }
+    if (deleted.isEmpty()) {
+        return deleted;
+    }
+
+    std::sort(deleted.begin(), deleted.end());
+    const auto removed = std::remove_if(table.order.begin(), table.order.end(), [&deleted](int id) {
+        return std::binary_search(deleted.cbegin(), deleted.cend(), id);
+    });
+    table.order.erase(removed, table.order.end());
+    return deleted;
+}
+
+/**
+ * @brief Добавление или изменение связи участника с предметом
+ * @param links Связи
+ * @param subjectId Идентификатор предмета
+ * @param memberId Идентификатор участника
+ * @param value Значение связи (оценка)
+ */
+template <typename Links>
+static void linkMember(Links &links, int subjectId, int memberId, int value)
+{
+    links.bySubject[subjectId].insert(memberId, value);
+    links.byMember[memberId].insert(subjectId);
+}
+
+/**
+ * @brief Удаление связей удаленных участников
+ * @param links Связи
+ * @param memberIds Идентификаторы участников
+ *
+ * @details Просматриваются только предметы самих участников
+ */
+template <typename Links>
+static void unlinkMembers(Links &links, const QList<int> &memberIds)
+{
+    for (int memberId : memberIds) {
+        const QSet<int> subjects = links.byMember.take(memberId);
+        for (int subjectId : subjects) {
+            auto it = links.bySubject.find(subjectId);
+            if (it != links.bySubject.end()) {
+                it->remove(memberId);
+                if (it->isEmpty()) {
+                    links.bySubject.erase(it);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Удаление связей удаленных предметов
+ * @param links Связи
+ * @param subjectIds Идентификаторы предметов
+ */
+template <typename Links>
+static void unlinkSubjects(Links &links, const QList<int> &subjectIds)
+{
+    for (int subjectId : subjectIds) {
+        const auto members = links.bySubject.take(subjectId);
+        for (auto it = members.cbegin(); it != members.cend(); ++it) {
+            auto member = links.byMember.find(it.key());
+            if (member != links.byMember.end()) {
+                member->remove(subjectId);
+                if (member->isEmpty()) {
+                    links.byMember.erase(member);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Поиск записей по условию в порядке id
+ * @tparam Record Тип записи
+ * @param table Таблица
+ * @param limit Максимальное количество результатов
+ * @param match Условие для записи
+ * @return QList<Record> Найденные записи
+ */
+template <typename Record, typename Table, typename Match>
+static QList<Record> searchRows(const Table &table, int limit, Match match)
+{
+    QList<Record> records;
+    for (qsizetype i = 0; i < table.order.size() && records.size() < limit; ++i) {
+        const Record record = table.rows.value(table.order.at(i));
+        if (match(record)) {
+            records.append(record);
+        }
+    }
+    return records;
+}
+
+/**
+ * @brief Конструктор MemoryStorage
+ * @param parent Родительский QObject
+ */
+MemoryStorage::MemoryStorage(QObject *parent)
+    : StorageBackend(parent)
+{
+}
+
+/**
+ * @brief Получение названия хранилища
+ * @return QString Название
+ */
+QString MemoryStorage::name() const
+{
+    return QStringLiteral("Память");
+}
+
+/**
+ * @brief Открытие хранилища
+ * @return bool Результат открытия
+ */
+bool MemoryStorage::open()
+{
+    return true;
+}
+
+/**
+ * @brief Получение текста последней ошибки
+ * @return QString Текст ошибки
+ */
+QString MemoryStorage::lastError() const
+{
+    QReadLocker locker(&m_lock);
+    return m_lastError;
+}
+
+/**
+ * @brief Получение списка всех преподавателей
+ * @return QList<TeacherRecord> Записи
+ */
+QList<TeacherRecord> MemoryStorage::getAllTeachers() const
+{
+    QReadLocker locker(&m_lock);
+    return rowsFrom<TeacherRecord>(m_teachers, 0, m_teachers.order.size());
+}
+
+/**
+ * @brief Получение страницы преподавателей
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<TeacherRecord> Записи страницы
+ */
+QList<TeacherRecord> MemoryStorage::getTeachersPage(int afterId, int limit) const
+{
+    QReadLocker locker(&m_lock);
+    return pageRows<TeacherRecord>(m_teachers, afterId, limit);
+}
+
+/**
+ * @brief Получение преподавателей по списку id
+ * @param ids Идентификаторы
+ * @param ok Всегда true
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> MemoryStorage::getTeachersByIds(const QList<int> &ids, bool *ok) const
+{
+    setOk(ok, true);
+    QReadLocker locker(&m_lock);
+    return rowsByIds<TeacherRecord>(m_teachers, ids);
+}
+
+/**
+ * @brief Поиск преподавателя по ID
+ * @param id Идентификатор
+ * @return TeacherRecord Запись или невалидная запись
+ */
+TeacherRecord MemoryStorage::getTeacherById(int id) const
+{
+    QReadLocker locker(&m_lock);
+    return m_teachers.rows.value(id);
+}
+
+/**
+ * @brief Добавление преподавателя
+ * @param fullName Полное имя
+ * @param department Кафедра
+ * @return TeacherRecord Добавленная запись
+ */
+TeacherRecord MemoryStorage::addTeacher(const QString &fullName, const QString &department)
+{
+    QWriteLocker locker(&m_lock);
+    return insertRow(m_teachers, TeacherRecord{0, fullName, department});
+}
+
+/**
+ * @brief Пакетное добавление преподавателей
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы
+ */
+QList<int> MemoryStorage::addTeachers(const QList<TeacherRecord> &records)
+{
+    QWriteLocker locker(&m_lock);
+    QList<int> ids;
+    ids.reserve(records.size());
+    m_teachers.rows.reserve(m_teachers.rows.size() + records.size());
+    for (const TeacherRecord &record : records) {
+        ids.append(insertRow(m_teachers, record).id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Удаление преподавателя
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0
+ */
+int MemoryStorage::deleteTeacher(int id)
+{
+    QWriteLocker locker(&m_lock);
+    const int deletedId = removeRow(m_teachers, id);
+    if (deletedId) {
+        unlinkMembers(m_assignments, {deletedId});
+    }
+    return deletedId;
+}
+
+/**
+ * @brief Удаление преподавателей по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> MemoryStorage::deleteTeachers(const QList<int> &ids)
+{
+    QWriteLocker locker(&m_lock);
+    const QList<int> deleted = removeRows(m_teachers, ids);
+    unlinkMembers(m_assignments, deleted);
+    return deleted;
+}
+
+/**
+ * @brief Поиск преподавателей
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> MemoryStorage::searchTeachers(const QString &text, int limit) const
+{
+    const QString folded = foldCase(text);
+    QReadLocker locker(&m_lock);
+    return searchRows<TeacherRecord>(m_teachers, limit, [&folded](const TeacherRecord &record) {
+        return foldCase(record.fullName).contains(folded) || foldCase(record.department).contains(folded);
+    });
+}
+
+/**
+ * @brief Получение списка всех студентов
+ * @return QList<StudentRecord> Записи
+ */
+QList<StudentRecord> MemoryStorage::getAllStudents() const
+{
+    QReadLocker locker(&m_lock);
+    return rowsFrom<StudentRecord>(m_students, 0, m_students.order.size());
+}
+
+/**
+ * @brief Получение страницы студентов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<StudentRecord> Записи страницы
+ */
+QList<StudentRecord> MemoryStorage::getStudentsPage(int afterId, int limit) const
+{
+    QReadLocker locker(&m_lock);
+    return pageRows<StudentRecord>(m_students, afterId, limit);
+}
+
+/**
+ * @brief Получение студентов по списку id
+ * @param ids Идентификаторы
+ * @param ok Всегда true
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> MemoryStorage::getStudentsByIds(const QList<int> &ids, bool *ok) const
+{
+    setOk(ok, true);
+    QReadLocker locker(&m_lock);
+    return rowsByIds<StudentRecord>(m_students, ids);
+}
+
+/**
+ * @brief Поиск студента по ID
+ * @param id Идентификатор
+ * @return StudentRecord Запись или невалидная запись
+ */
+StudentRecord MemoryStorage::getStudentById(int id) const
+{
+    QReadLocker locker(&m_lock);
+    return m_students.rows.value(id);
+}
+
+/**
+ * @brief Добавление студента
+ * @param fullName Полное имя
+ * @param grade Оценка
+ * @return StudentRecord Добавленная запись или невалидная запись при ошибке
+ *
+ * @details Оценка вне диапазона 1..5 отклоняется, как CHECK в таблице SQL
+ */
+StudentRecord MemoryStorage::addStudent(const QString &fullName, int grade)
+{
+    QWriteLocker locker(&m_lock);
+    if (!isGradeValid(grade)) {
+        m_lastError = gradeError(grade);
+        return StudentRecord();
+    }
+    m_lastError.clear();
+    return insertRow(m_students, StudentRecord{0, fullName, grade});
+}
+
+/**
+ * @brief Пакетное добавление студентов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы или пустой список при ошибке
+ *
+ * @details Как и транзакция SQL, пакет с недопустимой оценкой
+ * не добавляется целиком
+ */
+QList<int> MemoryStorage::addStudents(const QList<StudentRecord> &records)
+{
+    QWriteLocker locker(&m_lock);
+    for (const StudentRecord &record : records) {
+        if (!isGradeValid(record.grade)) {
+            m_lastError = gradeError(record.grade);
+            return QList<int>();
+        }
+    }
+    m_lastError.clear();
+    QList<int> ids;
+    ids.reserve(records.size());
+    m_students.rows.reserve(m_students.rows.size() + records.size());
+    for (const StudentRecord &record : records) {
+        ids.append(insertRow(m_students, record).id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Удаление студента
+ * @param id Идентификатор
+ * @return StudentRecord Удаленная запись или невалидная запись
+ */
+StudentRecord MemoryStorage::deleteStudent(int id)
+{
+    QWriteLocker locker(&m_lock);
+    const StudentRecord record = m_students.rows.value(id);
+    if (!removeRow(m_students, id)) {
+        return StudentRecord();
+    }
+    unlinkMembers(m_enrollments, {id});
+    return record;
+}
+
+/**
+ * @brief Удаление студентов по списку id
+ * @param ids Идентификаторы
+ * @return QList<StudentRecord> Удаленные записи
+ */
+QList<StudentRecord> MemoryStorage::deleteStudents(const QList<int> &ids)
+{
+    QWriteLocker locker(&m_lock);
+    const QList<StudentRecord> records = rowsByIds<StudentRecord>(m_students, ids);
+    unlinkMembers(m_enrollments, removeRows(m_students, ids));
+    return records;
+}
+
+/**
+ * @brief Поиск студентов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> MemoryStorage::searchStudents(const QString &text, int limit) const
+{
+    const QString folded = foldCase(text);
+    QReadLocker locker(&m_lock);
+    return searchRows<StudentRecord>(m_students, limit, [&folded](const StudentRecord &record) {
+        return foldCase(record.fullName).contains(folded);
+    });
+}
+
+/**
+ * @brief Получение списка всех предметов
+ * @return QList<SubjectRecord> Записи
+ */
+QList<SubjectRecord> MemoryStorage::getAllSubjects() const
+{
+    QReadLocker locker(&m_lock);
+    return rowsFrom<SubjectRecord>(m_subjects, 0, m_subjects.order.size());
+}
+
+/**
+ * @brief Получение страницы предметов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<SubjectRecord> Записи страницы
+ */
+QList<SubjectRecord> MemoryStorage::getSubjectsPage(int afterId, int limit) const
+{
+    QReadLocker locker(&m_lock);
+    return pageRows<SubjectRecord>(m_subjects, afterId, limit);
+}
+
+/**
+ * @brief Получение предметов по списку id
+ * @param ids Идентификаторы
+ * @param ok Всегда true
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> MemoryStorage::getSubjectsByIds(const QList<int> &ids, bool *ok) const
+{
+    setOk(ok, true);
+    QReadLocker locker(&m_lock);
+    return rowsByIds<SubjectRecord>(m_subjects, ids);
+}
+
+/**
+ * @brief Поиск предмета по ID
+ * @param id Идентификатор
+ * @return SubjectRecord Запись или невалидная запись
+ */
+SubjectRecord MemoryStorage::getSubjectById(int id) const
+{
+    QReadLocker locker(&m_lock);
+    return m_subjects.rows.value(id);
+}
+
+/**
+ * @brief Добавление предмета
+ * @param name Название
+ * @return SubjectRecord Добавленная запись
+ */
+SubjectRecord MemoryStorage::addSubject(const QString &name)
+{
+    QWriteLocker locker(&m_lock);
+    return insertRow(m_subjects, SubjectRecord{0, name});
+}
+
+/**
+ * @brief Пакетное добавление предметов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы
+ */
+QList<int> MemoryStorage::addSubjects(const QList<SubjectRecord> &records)
+{
+    QWriteLocker locker(&m_lock);
+    QList<int> ids;
+    ids.reserve(records.size());
+    m_subjects.rows.reserve(m_subjects.rows.size() + records.size());
+    for (const SubjectRecord &record : records) {
+        ids.append(insertRow(m_subjects, record).id);
+    }
+    return ids;
+}
+
+/**
+ * @brief Удаление предмета
+ * @param id Идентификатор
+ * @return int Идентификатор удаленной записи или 0
+ */
+int MemoryStorage::deleteSubject(int id)
+{
+    QWriteLocker locker(&m_lock);
+    const int deletedId = removeRow(m_subjects, id);
+    if (deletedId) {
+        unlinkSubjects(m_enrollments, {deletedId});
+        unlinkSubjects(m_assignments, {deletedId});
+    }
+    return deletedId;
+}
+
+/**
+ * @brief Удаление предметов по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> MemoryStorage::deleteSubjects(const QList<int> &ids)
+{
+    QWriteLocker locker(&m_lock);
+    const QList<int> deleted = removeRows(m_subjects, ids);
+    unlinkSubjects(m_enrollments, deleted);
+    unlinkSubjects(m_assignments, deleted);
+    return deleted;
+}
+
+/**
+ * @brief Поиск предметов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> MemoryStorage::searchSubjects(const QString &text, int limit) const
+{
+    const QString folded = foldCase(text);
+    QReadLocker locker(&m_lock);
+    return searchRows<SubjectRecord>(m_subjects, limit, [&folded](const SubjectRecord &record) {
+        return foldCase(record.name).contains(folded);
+    });
+}
+
+/**
+ * @brief Получение количества строк по таблицам
+ * @param mode Способ подсчета
+ * @return RecordCounts Количество строк
+ */
+RecordCounts MemoryStorage::getRecordCounts(CountMode mode) const
+{
+    QReadLocker locker(&m_lock);
+    RecordCounts counts;
+    counts.teachers = m_teachers.rows.size();
+    counts.students = m_students.rows.size();
+    counts.subjects = m_subjects.rows.size();
+    counts.estimated = mode == CountMode::Estimated;
+    return counts;
+}
+
+/**
+ * @brief Получение распределения оценок и крайних студентов
+ * @param limit Сколько студентов вернуть с каждого края
+ * @return GradeSummary Гистограмма и крайние студенты
+ *
+ * @details Проход идет по возрастанию id, поэтому в корзине каждой оценки
+ * оказываются первые limit id, как при ORDER BY grade, id
+ */
+GradeSummary MemoryStorage::getGradeSummary(int limit) const
+{
+    GradeSummary summary;
+    std::array<QList<StudentRecord>, 5> buckets;
+
+    QReadLocker locker(&m_lock);
+    for (int id : m_students.order) {
+        const StudentRecord record = m_students.rows.value(id);
+        if (record.grade < 1 || record.grade > 5) {
+            continue;
+        }
+        ++summary.histogram[record.grade - 1];
+        QList<StudentRecord> &bucket = buckets[record.grade - 1];
+        if (bucket.size() < limit) {
+            bucket.append(record);
+        }
+    }
+    locker.unlock();
+
+    for (int i = 0; i < 5; ++i) {
+        for (const StudentRecord &record : std::as_const(buckets[4 - i])) {
+            if (summary.top.size() < limit) {
+                summary.top.append(record);
+            }
+        }
+        for (const StudentRecord &record : std::as_const(buckets[i])) {
+            if (summary.bottom.size() < limit) {
+                summary.bottom.append(record);
+            }
+        }
+    }
+    return summary;
+}
+
+/**
+ * @brief Запись студента на предмет
+ * @param studentId Идентификатор студента
+ * @param subjectId Идентификатор предмета
+ * @param grade Оценка или 0
+ * @return bool Результат операции
+ */
+bool MemoryStorage::enrollStudent(int studentId, int subjectId, int grade)
+{
+    if (grade != 0 && !isGradeValid(grade)) {
+        return false;
+    }
+    QWriteLocker locker(&m_lock);
+    if (!m_students.rows.contains(studentId) || !m_subjects.rows.contains(subjectId)) {
+        return false;
+    }
+    linkMember(m_enrollments, subjectId, studentId, grade);
+    return true;
+}
+
+/**
+ * @brief Назначение преподавателя на предмет
+ * @param teacherId Идентификатор преподавателя
+ * @param subjectId Идентификатор предмета
+ * @return bool Результат операции
+ */
+bool MemoryStorage::assignTeacher(int teacherId, int subjectId)
+{
+    QWriteLocker locker(&m_lock);
+    if (!m_teachers.rows.contains(teacherId) || !m_subjects.rows.contains(subjectId)) {
+        return false;
+    }
+    linkMember(m_assignments, subjectId, teacherId, 0);
+    return true;
+}
+
+/**
+ * @brief Получение состава предмета
+ * @param subjectId Идентификатор предмета
+ * @return QList<RosterEntry> Строки состава
+ *
+ * @details Студенты и преподаватели предмета уже упорядочены по id,
+ * поэтому строки не сортируются
+ */
+QList<RosterEntry> MemoryStorage::getSubjectRoster(int subjectId) const
+{
+    QReadLocker locker(&m_lock);
+    QList<RosterEntry> roster;
+    const auto students = m_enrollments.bySubject.constFind(subjectId);
+    if (students == m_enrollments.bySubject.cend()) {
+        return roster;
+    }
+
+    const QMap<int, int> teachers = m_assignments.bySubject.value(subjectId);
+    roster.reserve(students->size() * std::max<qsizetype>(1, teachers.size()));
+    for (auto student = students->cbegin(); student != students->cend(); ++student) {
+        RosterEntry entry;
+        entry.subjectId = subjectId;
+        entry.studentId = student.key();
+        entry.studentName = m_students.rows.value(student.key()).fullName;
+        entry.grade = student.value();
+        if (teachers.isEmpty()) {
+            roster.append(entry);
+            continue;
+        }
+        for (auto teacher = teachers.cbegin(); teacher != teachers.cend(); ++teacher) {
+            entry.teacherId = teacher.key();
+            entry.teacherName = m_teachers.rows.value(teacher.key()).fullName;
+            roster.append(entry);
+        }
+    }
+    return roster;
+}
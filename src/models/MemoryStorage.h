@@ -0,0 +1,331 @@
+/**
+ * @file MemoryStorage.h
+ * @brief Заголовочный файл класса MemoryStorage
+ * @ingroup Models
+ *
+ * @class MemoryStorage
+ * @brief Хранилище в памяти процесса без SQL
+ *
+ * Каждая таблица — хеш-таблица id → запись и отсортированный список id
+ * для постраничного и полного чтения по возрастанию id. Идентификаторы
+ * выдаются счетчиком и не переиспользуются, как у SERIAL.
+ *
+ * Хранилище не зависит от драйверов Qt SQL и сети, поэтому стоимость
+ * операций определяется только копированием записей. Записи на предметы
+ * и назначения преподавателей хранятся по предмету и по участнику, поэтому
+ * состав предмета собирается без просмотра всех связей, а удаление записи
+ * удаляет ее связи, как ON DELETE CASCADE. Используется для
+ * замеров слоев ViewModel и UI и при разработке без PostgreSQL.
+ * Данные теряются при завершении процесса.
+ *
+ * Потокобезопасно: чтение идет параллельно под QReadWriteLock.
+ */
+
+#ifndef MEMORYSTORAGE_H
+#define MEMORYSTORAGE_H
+
+#include <QHash>
+#include <QMap>
+#include <QReadWriteLock>
+#include <QSet>
+#include "StorageBackend.h"
+
+class MemoryStorage : public StorageBackend
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Конструктор
+     * @param parent Родительский QObject
+     */
+    explicit MemoryStorage(QObject *parent = nullptr);
+
+    /**
+     * @brief Получить название хранилища
+     * @return QString "Память"
+     */
+    QString name() const override;
+
+    /**
+     * @brief Открыть хранилище
+     * @return bool Всегда true
+     */
+    bool open() override;
+
+    /**
+     * @brief Получить текст последней ошибки
+     * @return QString Причина отказа последнего добавления студентов или пустая строка
+     */
+    QString lastError() const override;
+
+    /**
+     * @brief Получить всех преподавателей
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     */
+    QList<TeacherRecord> getAllTeachers() const override;
+
+    /**
+     * @brief Получить страницу записей с id больше afterId
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<TeacherRecord> Записи страницы
+     */
+    QList<TeacherRecord> getTeachersPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить преподавателей по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<TeacherRecord> Найденные записи в порядке возрастания id
+     */
+    QList<TeacherRecord> getTeachersByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Найти преподавателя по id
+     * @param id Идентификатор
+     * @return TeacherRecord Запись или невалидная запись
+     */
+    TeacherRecord getTeacherById(int id) const override;
+
+    /**
+     * @brief Добавить преподавателя
+     * @param fullName Полное имя
+     * @param department Кафедра
+     * @return TeacherRecord Добавленная запись
+     */
+    TeacherRecord addTeacher(const QString &fullName, const QString &department) override;
+
+    /**
+     * @brief Добавить записи с идущими подряд id
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы в порядке records
+     */
+    QList<int> addTeachers(const QList<TeacherRecord> &records) override;
+
+    /**
+     * @brief Удалить преподавателя
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    int deleteTeacher(int id) override;
+
+    /**
+     * @brief Удалить преподавателей по списку id
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteTeachers(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти преподавателей по подстроке имени или кафедры без учета регистра
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     */
+    QList<TeacherRecord> searchTeachers(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить всех студентов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     */
+    QList<StudentRecord> getAllStudents() const override;
+
+    /**
+     * @brief Получить страницу записей с id больше afterId
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<StudentRecord> Записи страницы
+     */
+    QList<StudentRecord> getStudentsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить студентов по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<StudentRecord> Найденные записи в порядке возрастания id
+     */
+    QList<StudentRecord> getStudentsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Найти студента по id
+     * @param id Идентификатор
+     * @return StudentRecord Запись или невалидная запись
+     */
+    StudentRecord getStudentById(int id) const override;
+
+    /**
+     * @brief Добавить студента
+     * @param fullName Полное имя
+     * @param grade Оценка от 1 до 5
+     * @return StudentRecord Добавленная запись или невалидная при недопустимой оценке
+     */
+    StudentRecord addStudent(const QString &fullName, int grade) override;
+
+    /**
+     * @brief Добавить записи с идущими подряд id
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы в порядке records или пустой список,
+     *         если хотя бы одна оценка вне 1..5
+     */
+    QList<int> addStudents(const QList<StudentRecord> &records) override;
+
+    /**
+     * @brief Удалить студента
+     * @param id Идентификатор
+     * @return StudentRecord Удаленная запись или невалидная запись
+     */
+    StudentRecord deleteStudent(int id) override;
+
+    /**
+     * @brief Удалить студентов по списку id
+     * @param ids Идентификаторы
+     * @return QList<StudentRecord> Удаленные записи по возрастанию id
+     */
+    QList<StudentRecord> deleteStudents(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти студентов по подстроке имени без учета регистра
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     */
+    QList<StudentRecord> searchStudents(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить все предметы
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     */
+    QList<SubjectRecord> getAllSubjects() const override;
+
+    /**
+     * @brief Получить страницу записей с id больше afterId
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<SubjectRecord> Записи страницы
+     */
+    QList<SubjectRecord> getSubjectsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить предметы по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<SubjectRecord> Найденные записи в порядке возрастания id
+     */
+    QList<SubjectRecord> getSubjectsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Найти предмет по id
+     * @param id Идентификатор
+     * @return SubjectRecord Запись или невалидная запись
+     */
+    SubjectRecord getSubjectById(int id) const override;
+
+    /**
+     * @brief Добавить предмет
+     * @param name Название
+     * @return SubjectRecord Добавленная запись
+     */
+    SubjectRecord addSubject(const QString &name) override;
+
+    /**
+     * @brief Добавить записи с идущими подряд id
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы в порядке records
+     */
+    QList<int> addSubjects(const QList<SubjectRecord> &records) override;
+
+    /**
+     * @brief Удалить предмет
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    int deleteSubject(int id) override;
+
+    /**
+     * @brief Удалить предметы по списку id
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteSubjects(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти предметы по подстроке названия без учета регистра
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     */
+    QList<SubjectRecord> searchSubjects(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить количество строк по таблицам
+     * @param mode Способ подсчета (значение всегда точное)
+     * @return RecordCounts Количество строк
+     */
+    RecordCounts getRecordCounts(CountMode mode) const override;
+
+    /**
+     * @brief Получить распределение оценок одним проходом по студентам
+     * @param limit Сколько студентов вернуть с каждого края
+     * @return GradeSummary Гистограмма и крайние студенты
+     */
+    GradeSummary getGradeSummary(int limit) const override;
+
+    /**
+     * @brief Записать студента на предмет или изменить его оценку
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка или 0
+     * @return bool false если студента или предмета нет или оценка вне 1..5
+     */
+    bool enrollStudent(int studentId, int subjectId, int grade) override;
+
+    /**
+     * @brief Назначить преподавателя на предмет
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return bool false если преподавателя или предмета нет
+     */
+    bool assignTeacher(int teacherId, int subjectId) override;
+
+    /**
+     * @brief Собрать состав предмета из связей предмета
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Строки состава
+     */
+    QList<RosterEntry> getSubjectRoster(int subjectId) const override;
+
+private:
+    /**
+     * @struct Table
+     * @brief Таблица записей одного типа
+     * @tparam Record Тип записи с полем int id
+     */
+    template <typename Record>
+    struct Table
+    {
+        QHash<int, Record> rows;    ///< Записи по id
+        QList<int> order;           ///< id по возрастанию
+        int lastId = 0;             ///< Последний выданный id
+    };
+
+    /**
+     * @struct Links
+     * @brief Связи участников (студентов или преподавателей) с предметами
+     */
+    struct Links
+    {
+        QHash<int, QMap<int, int>> bySubject;   ///< Предмет → id участника по возрастанию → оценка
+        QHash<int, QSet<int>> byMember;         ///< Участник → предметы
+    };
+
+    Table<TeacherRecord> m_teachers;    ///< Преподаватели
+    Table<StudentRecord> m_students;    ///< Студенты
+    Table<SubjectRecord> m_subjects;    ///< Предметы
+    Links m_enrollments;                ///< Записи студентов на предметы с оценкой
+    Links m_assignments;                ///< Назначения преподавателей на предметы
+    QString m_lastError;                ///< Текст последней ошибки
+    mutable QReadWriteLock m_lock;      ///< Блокировка всех таблиц
+};
+
+#endif // MEMORYSTORAGE_H
@@ -0,0 +1,191 @@
+/**
+ * @file PgBinaryReader.cpp
+ * @brief Реализация класса PgBinaryReader
+ * @ingroup Models
+ */
+
+#include "PgBinaryReader.h"
+#include <QtEndian>
+
+#ifdef UNIVERSITY_HAVE_LIBPQ
+#include "PgConnection.h"
+
+/**
+ * @brief Формат результата libpq: двоичный
+ */
+static constexpr int BINARY_FORMAT = 1;
+
+/**
+ * @brief Отмена отправленного запроса
+ * @param conn Соединение libpq
+ *
+ * @details Результат читается до конца и отбрасывается, чтобы соединение
+ * освободилось для следующих запросов Qt
+ */
+static void cancel(PGconn *conn)
+{
+    if (PGcancel *request = PQgetCancel(conn)) {
+        char message[256];
+        PQcancel(request, message, sizeof(message));
+        PQfreeCancel(request);
+    }
+    while (PGresult *result = PQgetResult(conn)) {
+        PQclear(result);
+    }
+}
+
+#endif
+
+/**
+ * @brief Получение целого значения
+ * @param column Номер столбца
+ * @return int Значение
+ *
+ * @details В двоичном формате целые передаются в сетевом порядке байт,
+ * размер значения определяет тип столбца
+ */
+int PgBinaryReader::Row::intAt(int column) const
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    const PGresult *result = static_cast<const PGresult *>(m_result);
+    if (PQgetisnull(result, m_row, column)) {
+        return 0;
+    }
+    const uchar *data = reinterpret_cast<const uchar *>(PQgetvalue(result, m_row, column));
+    switch (PQgetlength(result, m_row, column)) {
+    case 2: return qFromBigEndian<qint16>(data);
+    case 4: return qFromBigEndian<qint32>(data);
+    case 8: return static_cast<int>(qFromBigEndian<qint64>(data));
+    default: return 0;
+    }
+#else
+    Q_UNUSED(column);
+    return 0;
+#endif
+}
+
+/**
+ * @brief Получение строкового значения
+ * @param column Номер столбца
+ * @return QString Значение
+ *
+ * @details Двоичный формат text и varchar — байты строки в кодировке
+ * клиента, QPSQL устанавливает UTF-8
+ */
+QString PgBinaryReader::Row::textAt(int column) const
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    const PGresult *result = static_cast<const PGresult *>(m_result);
+    if (PQgetisnull(result, m_row, column)) {
+        return QString();
+    }
+    return QString::fromUtf8(PQgetvalue(result, m_row, column), PQgetlength(result, m_row, column));
+#else
+    Q_UNUSED(column);
+    return QString();
+#endif
+}
+
+/**
+ * @brief Проверка поддержки двоичного чтения
+ * @param db Соединение
+ * @return bool true если чтение доступно
+ */
+bool PgBinaryReader::isAvailable(const QSqlDatabase &db)
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    return PgConnection::handle(db) != nullptr;
+#else
+    Q_UNUSED(db);
+    return false;
+#endif
+}
+
+/**
+ * @brief Чтение результата запроса
+ * @param db Соединение
+ * @param sql Текст запроса
+ * @param params Значения параметров
+ * @param handler Обработчик строк
+ * @param error Текст ошибки
+ * @return bool Результат чтения
+ *
+ * @details Результаты libpq читаются до конца даже после ошибки,
+ * иначе соединение останется занятым для следующих запросов Qt
+ */
+bool PgBinaryReader::read(const QSqlDatabase &db, const QString &sql, const QVariantList &params,
+                          const RowHandler &handler, QString *error)
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    PGconn *conn = PgConnection::handle(db);
+    if (!conn) {
+        *error = "Соединение не поддерживает двоичное чтение";
+        return false;
+    }
+
+    // Текстовые значения живут в values, пока libpq не отправит запрос
+    QList<QByteArray> values;
+    QList<const char *> pointers;
+    values.reserve(params.size());
+    pointers.reserve(params.size());
+    for (const QVariant &param : params) {
+        values.append(param.isNull() ? QByteArray() : param.toString().toUtf8());
+        pointers.append(param.isNull() ? nullptr : values.last().constData());
+    }
+
+    const QByteArray query = sql.toUtf8();
+    if (!PQsendQueryParams(conn, query.constData(), static_cast<int>(pointers.size()), nullptr,
+                           pointers.constData(), nullptr, nullptr, BINARY_FORMAT)) {
+        *error = QString::fromUtf8(PQerrorMessage(conn));
+        return false;
+    }
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    const bool rowMode = PQsetChunkedRowsMode(conn, CHUNK_ROWS) == 1;
+#else
+    const bool rowMode = PQsetSingleRowMode(conn) == 1;
+#endif
+    if (!rowMode) {
+        // Без порционного режима весь результат накопится в памяти libpq:
+        // запрос отменяется, а чтение уходит на QSqlQuery
+        *error = "Не удалось включить порционное чтение результата";
+        cancel(conn);
+        return false;
+    }
+
+    bool ok = true;
+    Row row;
+    PGresult *result = nullptr;
+    while ((result = PQgetResult(conn)) != nullptr) {
+        switch (PQresultStatus(result)) {
+#ifdef LIBPQ_HAS_CHUNK_MODE
+        case PGRES_TUPLES_CHUNK:
+#endif
+        case PGRES_SINGLE_TUPLE:
+        case PGRES_TUPLES_OK:
+            if (ok) {
+                row.m_result = result;
+                const int rows = PQntuples(result);
+                for (row.m_row = 0; row.m_row < rows; ++row.m_row) {
+                    handler(row);
+                }
+            }
+            break;
+        default:
+            if (ok) {
+                *error = QString::fromUtf8(PQresultErrorMessage(result));
+                ok = false;
+            }
+            break;
+        }
+        PQclear(result);
+    }
+    return ok;
+#else
+    Q_UNUSED(db);
+    Q_UNUSED(sql);
+    Q_UNUSED(params);
+    Q_UNUSED(handler);
+    *error = "Сборка без libpq, двоичное чтение недоступно";
+    return false;
+#endif
+}
@@ -0,0 +1,107 @@
+/**
+ * @file PgBinaryReader.h
+ * @brief Заголовочный файл класса PgBinaryReader
+ * @ingroup Models
+ *
+ * @class PgBinaryReader
+ * @brief Чтение результатов запроса через libpq в двоичном формате
+ *
+ * QSqlQuery получает результат в текстовом формате и отдает каждую ячейку
+ * как QVariant: число разбирается из строки, строка копируется дважды.
+ * Для полного чтения больших таблиц это основная часть времени на клиенте.
+ * Класс выполняет запрос напрямую через libpq (QSqlDriver::handle()
+ * соединения QPSQL) с двоичным форматом результата: целые числа читаются
+ * из сетевого порядка байт, строки декодируются из UTF-8 сразу в QString,
+ * без промежуточного QVariant. Параметры ($1, $2, ...) передаются
+ * в текстовом формате, их типы сервер выводит из запроса, поэтому так же
+ * читаются страницы по ключу, перечитывание по id и окна курсора.
+ *
+ * Строки приходят порциями по CHUNK_ROWS (PQsetChunkedRowsMode, libpq 17+)
+ * или по одной (PQsetSingleRowMode в более старых версиях), поэтому
+ * полный результат не накапливается в памяти libpq перед разбором.
+ * Если режим включить не удалось, запрос отменяется и read() возвращает
+ * false, а вызывающий код читает через QSqlQuery.
+ *
+ * Доступен только при сборке с libpq (определен UNIVERSITY_HAVE_LIBPQ).
+ * Без нее isAvailable() возвращает false и вызывающий код должен
+ * читать через QSqlQuery.
+ *
+ * @note На соединении не должно быть незавершенного QSqlQuery
+ * (вызывающий код освобождает результаты через QSqlQuery::finish())
+ */
+
+#ifndef PGBINARYREADER_H
+#define PGBINARYREADER_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QVariantList>
+#include <functional>
+
+class PgBinaryReader
+{
+public:
+    /**
+     * @class Row
+     * @brief Текущая строка результата
+     *
+     * @details Действительна только внутри обработчика строки
+     */
+    class Row
+    {
+    public:
+        /**
+         * @brief Получить целое значение столбца
+         * @param column Номер столбца
+         * @return int Значение int2, int4 или int8 (усеченное), 0 для NULL
+         */
+        int intAt(int column) const;
+
+        /**
+         * @brief Получить строковое значение столбца
+         * @param column Номер столбца
+         * @return QString Значение text или varchar, пустая строка для NULL
+         */
+        QString textAt(int column) const;
+
+    private:
+        friend class PgBinaryReader;
+
+        const void *m_result = nullptr; ///< PGresult текущей порции
+        int m_row = 0;                  ///< Номер строки в порции
+    };
+
+    /**
+     * @brief Обработчик строки результата
+     */
+    using RowHandler = std::function<void(const Row &)>;
+
+    /**
+     * @brief Количество строк в одной порции результата
+     */
+    static constexpr int CHUNK_ROWS = 1000;
+
+    /**
+     * @brief Проверить, поддерживает ли соединение двоичное чтение
+     * @param db Открытое соединение
+     * @return bool true если это соединение QPSQL и доступен libpq
+     */
+    static bool isAvailable(const QSqlDatabase &db);
+
+    /**
+     * @brief Выполнить запрос и передать строки обработчику
+     * @param db Открытое соединение QPSQL
+     * @param sql Текст запроса с параметрами $1, $2, ...
+     * @param params Значения параметров по порядку; невалидный QVariant — NULL
+     * @param handler Вызывается для каждой строки по порядку
+     * @param error Сюда записывается текст ошибки
+     * @return bool true если прочитан весь результат
+     *
+     * @details При ошибке в середине результата обработчик уже мог получить
+     * часть строк; вызывающий код отбрасывает их
+     */
+    static bool read(const QSqlDatabase &db, const QString &sql, const QVariantList &params,
+                     const RowHandler &handler, QString *error);
+};
+
+#endif // PGBINARYREADER_H
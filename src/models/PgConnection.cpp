@@ -0,0 +1,33 @@
+/**
+ * @file PgConnection.cpp
+ * @brief Реализация класса PgConnection
+ * @ingroup Models
+ */
+
+#include "PgConnection.h"
+
+#ifdef UNIVERSITY_HAVE_LIBPQ
+
+#include <QSqlDriver>
+#include <QVariant>
+
+/**
+ * @brief Получение соединения libpq
+ * @param db Соединение Qt
+ * @return PGconn* Соединение libpq или nullptr
+ *
+ * @details QPSQL возвращает из handle() QVariant с типом "PGconn*"
+ */
+PGconn *PgConnection::handle(const QSqlDatabase &db)
+{
+    if (!db.isOpen() || !db.driver()) {
+        return nullptr;
+    }
+    QVariant handle = db.driver()->handle();
+    if (handle.isValid() && qstrcmp(handle.typeName(), "PGconn*") == 0) {
+        return *static_cast<PGconn **>(handle.data());
+    }
+    return nullptr;
+}
+
+#endif // UNIVERSITY_HAVE_LIBPQ
@@ -0,0 +1,37 @@
+/**
+ * @file PgConnection.h
+ * @brief Заголовочный файл класса PgConnection
+ * @ingroup Models
+ *
+ * @class PgConnection
+ * @brief Доступ к соединению libpq под соединением QPSQL
+ *
+ * Общая часть PgCopyWriter и PgBinaryReader: оба работают с PGconn
+ * напрямую, получая его через QSqlDriver::handle().
+ *
+ * Доступен только при сборке с libpq (определен UNIVERSITY_HAVE_LIBPQ).
+ */
+
+#ifndef PGCONNECTION_H
+#define PGCONNECTION_H
+
+#ifdef UNIVERSITY_HAVE_LIBPQ
+
+#include <QSqlDatabase>
+#include <libpq-fe.h>
+
+class PgConnection
+{
+public:
+    /**
+     * @brief Получить соединение libpq из QSqlDatabase
+     * @param db Соединение Qt
+     * @return PGconn* Соединение libpq или nullptr для закрытого соединения
+     * и других драйверов
+     */
+    static PGconn *handle(const QSqlDatabase &db);
+};
+
+#endif // UNIVERSITY_HAVE_LIBPQ
+
+#endif // PGCONNECTION_H
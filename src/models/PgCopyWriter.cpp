@@ -0,0 +1,141 @@
+/**
+ * @file PgCopyWriter.cpp
+ * @brief Реализация класса PgCopyWriter
+ * @ingroup Models
+ */
+
+#include "PgCopyWriter.h"
+#include <QVariant>
+
+#ifdef UNIVERSITY_HAVE_LIBPQ
+#include "PgConnection.h"
+
+/**
+ * @brief Размер блока, передаваемого в PQputCopyData
+ */
+static constexpr int COPY_CHUNK_SIZE = 64 * 1024;
+
+#endif
+
+/**
+ * @brief Проверка поддержки COPY
+ * @param db Соединение
+ * @return bool true если COPY доступен
+ */
+bool PgCopyWriter::isAvailable(const QSqlDatabase &db)
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    return PgConnection::handle(db) != nullptr;
+#else
+    Q_UNUSED(db);
+    return false;
+#endif
+}
+
+/**
+ * @brief Запись строк через COPY
+ * @param db Соединение
+ * @param table Имя таблицы
+ * @param columns Имена столбцов
+ * @param values Значения по столбцам
+ * @param error Текст ошибки
+ * @return bool Результат записи
+ *
+ * @details Строки собираются в буфер и передаются блоками по COPY_CHUNK_SIZE.
+ * Если сервер отклонит данные, ошибка придет в результате после PQputCopyEnd.
+ */
+bool PgCopyWriter::copy(const QSqlDatabase &db, const QString &table, const QStringList &columns,
+                        const QList<QVariantList> &values, QString *error)
+{
+#ifdef UNIVERSITY_HAVE_LIBPQ
+    PGconn *conn = PgConnection::handle(db);
+    if (!conn) {
+        *error = "Соединение не поддерживает COPY";
+        return false;
+    }
+
+    const QByteArray sql = QString("COPY %1 (%2) FROM STDIN").arg(table, columns.join(", ")).toUtf8();
+    PGresult *result = PQexec(conn, sql.constData());
+    if (PQresultStatus(result) != PGRES_COPY_IN) {
+        *error = QString::fromUtf8(PQresultErrorMessage(result));
+        PQclear(result);
+        return false;
+    }
+    PQclear(result);
+
+    const int rowCount = values.isEmpty() ? 0 : static_cast<int>(values.first().size());
+    QByteArray buffer;
+    buffer.reserve(COPY_CHUNK_SIZE + 1024);
+    bool sent = true;
+
+    for (int row = 0; row < rowCount && sent; ++row) {
+        for (int column = 0; column < values.size(); ++column) {
+            if (column > 0) {
+                buffer.append('\t');
+            }
+            appendValue(values.at(column).at(row), buffer);
+        }
+        buffer.append('\n');
+
+        if (buffer.size() >= COPY_CHUNK_SIZE) {
+            sent = PQputCopyData(conn, buffer.constData(), static_cast<int>(buffer.size())) == 1;
+            buffer.clear();
+        }
+    }
+    if (sent && !buffer.isEmpty()) {
+        sent = PQputCopyData(conn, buffer.constData(), static_cast<int>(buffer.size())) == 1;
+    }
+
+    if (PQputCopyEnd(conn, sent ? nullptr : "client error") != 1) {
+        *error = QString::fromUtf8(PQerrorMessage(conn));
+        return false;
+    }
+
+    bool ok = sent;
+    while ((result = PQgetResult(conn)) != nullptr) {
+        if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+            *error = QString::fromUtf8(PQresultErrorMessage(result));
+            ok = false;
+        }
+        PQclear(result);
+    }
+    if (!sent && error->isEmpty()) {
+        *error = QString::fromUtf8(PQerrorMessage(conn));
+    }
+    return ok;
+#else
+    Q_UNUSED(db);
+    Q_UNUSED(table);
+    Q_UNUSED(columns);
+    Q_UNUSED(values);
+    *error = "Сборка без libpq, COPY недоступен";
+    return false;
+#endif
+}
+
+/**
+ * @brief Экранирование значения
+ * @param value Значение
+ * @param out Буфер
+ *
+ * @details NULL записывается как \N, обратная косая черта и управляющие
+ * символы табуляции и перевода строки экранируются
+ */
+void PgCopyWriter::appendValue(const QVariant &value, QByteArray &out)
+{
+    if (value.isNull()) {
+        out.append("\\N");
+        return;
+    }
+
+    const QByteArray text = value.toString().toUtf8();
+    for (char c : text) {
+        switch (c) {
+        case '\\': out.append("\\\\"); break;
+        case '\t': out.append("\\t"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        default: out.append(c); break;
+        }
+    }
+}
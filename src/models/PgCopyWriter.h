@@ -0,0 +1,60 @@
+/**
+ * @file PgCopyWriter.h
+ * @brief Заголовочный файл класса PgCopyWriter
+ * @ingroup Models
+ *
+ * @class PgCopyWriter
+ * @brief Потоковая запись строк в таблицу через COPY ... FROM STDIN
+ *
+ * Qt SQL не умеет выполнять COPY, поэтому класс работает напрямую с libpq
+ * через QSqlDriver::handle() соединения QPSQL. Строки передаются в текстовом
+ * формате COPY блоками, без отдельного запроса на каждую строку.
+ *
+ * Доступен только при сборке с libpq (определен UNIVERSITY_HAVE_LIBPQ).
+ * Без нее isAvailable() возвращает false и вызывающий код должен
+ * использовать обычный INSERT.
+ */
+
+#ifndef PGCOPYWRITER_H
+#define PGCOPYWRITER_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QList>
+
+class PgCopyWriter
+{
+public:
+    /**
+     * @brief Проверить, поддерживает ли соединение COPY
+     * @param db Открытое соединение
+     * @return bool true если это соединение QPSQL и доступен libpq
+     */
+    static bool isAvailable(const QSqlDatabase &db);
+
+    /**
+     * @brief Записать столбцы значений в таблицу
+     * @param db Открытое соединение QPSQL
+     * @param table Имя таблицы
+     * @param columns Имена столбцов
+     * @param values Значения по столбцам, все списки одной длины
+     * @param error Сюда записывается текст ошибки
+     * @return bool true если все строки записаны
+     *
+     * @note Транзакцией управляет вызывающий код
+     */
+    static bool copy(const QSqlDatabase &db, const QString &table, const QStringList &columns,
+                     const QList<QVariantList> &values, QString *error);
+
+private:
+    /**
+     * @brief Экранировать значение для текстового формата COPY
+     * @param value Значение
+     * @param out Буфер, в который дописывается значение
+     */
+    static void appendValue(const QVariant &value, QByteArray &out);
+};
+
+#endif // PGCOPYWRITER_H
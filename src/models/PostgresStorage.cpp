@@ -0,0 +1,1165 @@
+/**
+ * @file PostgresStorage.cpp
+ * @brief Реализация класса PostgresStorage
+ * @ingroup Models
+ */
+
+#include "PostgresStorage.h"
+#include "PgCopyWriter.h"
+#include "SchemaMigrator.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlError>
+#include <QThread>
+#include <algorithm>
+
+/**
+ * @brief Преобразовать список id в литерал массива PostgreSQL
+ * @param ids Идентификаторы
+ * @return QString Строка вида {1,2,3}
+ */
+static QString toIdArray(const QList<int> &ids)
+{
+    QStringList parts;
+    parts.reserve(ids.size());
+    for (int id : ids) {
+        parts.append(QString::number(id));
+    }
+    return "{" + parts.join(',') + "}";
+}
+
+/**
+ * @brief Построить шаблон ILIKE для поиска подстроки
+ * @param text Строка поиска
+ * @return QString Шаблон с экранированными % и _
+ */
+static QString likePattern(const QString &text)
+{
+    QString escaped = text;
+    escaped.replace('\\', "\\\\");
+    escaped.replace('%', "\\%");
+    escaped.replace('_', "\\_");
+    return "%" + escaped + "%";
+}
+
+/**
+ * @brief Имя серверного курсора
+ * @details Курсор живет на отдельном соединении, поэтому имя не пересекается
+ */
+static const char *CURSOR_NAME = "university_cursor";
+
+/**
+ * @class PgRecordCursor
+ * @brief Серверный курсор PostgreSQL на отдельном соединении
+ * @tparam Record Тип записи
+ *
+ * Владеет соединением и транзакцией, в которой объявлен курсор.
+ * Деструктор закрывает курсор, завершает транзакцию и соединение.
+ * Окна читаются через PgBinaryReader, если задан двоичный декодер,
+ * иначе через QSqlQuery.
+ */
+template <typename Record>
+class PgRecordCursor : public RecordCursor<Record>
+{
+public:
+    /**
+     * @brief Функция чтения записи из текущей строки запроса
+     */
+    using Decoder = Record (*)(const QSqlQuery &query);
+
+    /**
+     * @brief Функция чтения записи из строки двоичного результата
+     */
+    using BinaryDecoder = Record (*)(const PgBinaryReader::Row &row);
+
+    /**
+     * @brief Конструктор
+     * @param pool Пул, открывший соединение
+     * @param connection Имя соединения с открытой транзакцией и курсором
+     * @param count Количество строк в снимке
+     * @param decoder Чтение записи из строки
+     * @param binaryDecoder Чтение записи из двоичной строки (nullptr - только QSqlQuery)
+     */
+    PgRecordCursor(ConnectionPool *pool, const QString &connection, qint64 count,
+                   Decoder decoder, BinaryDecoder binaryDecoder)
+        : m_pool(pool)
+        , m_connection(connection)
+        , m_count(count)
+        , m_decoder(decoder)
+        , m_binaryDecoder(binaryDecoder)
+    {
+    }
+
+    /**
+     * @brief Деструктор
+     */
+    ~PgRecordCursor() override
+    {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+            if (db.isOpen()) {
+                QSqlQuery query(db);
+                query.exec(QString("CLOSE %1").arg(CURSOR_NAME));
+                db.commit();
+            }
+        }
+        m_pool->closeDedicated(m_connection);
+    }
+
+    /**
+     * @brief Получить количество строк в снимке
+     * @return qint64 Количество строк
+     */
+    qint64 count() const override
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Прочитать окно строк
+     * @param offset Номер первой строки с 0
+     * @param limit Максимальное количество строк
+     * @return QList<Record> Строки окна
+     *
+     * @details MOVE ABSOLUTE n ставит курсор на n-ю строку (нумерация с 1),
+     * поэтому следующий FETCH начинает со строки с номером offset от 0.
+     * Если двоичное чтение не удалось, окно перечитывается через QSqlQuery
+     * с повторным MOVE: прерванный FETCH мог сдвинуть курсор.
+     */
+    QList<Record> fetch(qint64 offset, int limit) override
+    {
+        QList<Record> records;
+        records.reserve(limit);
+        QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        const QString move = QString("MOVE ABSOLUTE %1 IN %2").arg(offset).arg(CURSOR_NAME);
+        const QString fetch = QString("FETCH FORWARD %1 FROM %2").arg(limit).arg(CURSOR_NAME);
+
+        if (m_binaryDecoder && PgBinaryReader::isAvailable(db)) {
+            if (!query.exec(move)) {
+                qWarning() << "Ошибка чтения курсора:" << query.lastError().text();
+                return records;
+            }
+            query.finish();
+
+            QString error;
+            const BinaryDecoder decoder = m_binaryDecoder;
+            if (PgBinaryReader::read(db, fetch, {}, [&records, decoder](const PgBinaryReader::Row &row) {
+                    records.append(decoder(row));
+                }, &error)) {
+                return records;
+            }
+            qWarning() << "Ошибка двоичного чтения курсора, повтор через QSqlQuery:" << error;
+            records.clear();
+        }
+
+        if (!query.exec(move) || !query.exec(fetch)) {
+            qWarning() << "Ошибка чтения курсора:" << query.lastError().text();
+            return records;
+        }
+
+        while (query.next()) {
+            records.append(m_decoder(query));
+        }
+        return records;
+    }
+
+private:
+    ConnectionPool *m_pool;     ///< Пул, открывший соединение
+    QString m_connection;       ///< Имя соединения курсора
+    qint64 m_count;             ///< Количество строк в снимке
+    Decoder m_decoder;          ///< Чтение записи из строки
+    BinaryDecoder m_binaryDecoder; ///< Чтение записи из двоичной строки
+};
+
+/**
+ * @brief Конструктор PostgresStorage
+ * @param parent Родительский QObject
+ * 
+ * @details На уведомления подписывается только соединение потока, в котором
+ * живет хранилище: у него есть цикл событий для доставки сигнала notification.
+ */
+PostgresStorage::PostgresStorage(QObject *parent)
+    : SqlStorage(ConnectionSettings(), parent)
+    , m_trigramSearch(false)
+    , m_rowCounters(false)
+    , m_rosterView(false)
+    , m_binaryReads(qEnvironmentVariable("UNIVERSITY_PG_BINARY_READS") != "0")
+{
+    m_pool->setOpenHandler([this](QSqlDatabase &db) {
+        if (QThread::currentThread() == thread()) {
+            subscribeToChanges(db);
+        }
+    });
+}
+
+/**
+ * @brief Получение названия хранилища
+ * @return QString Название
+ */
+QString PostgresStorage::name() const
+{
+    return QStringLiteral("PostgreSQL");
+}
+
+/**
+ * @brief Открытие хранилища
+ * @return bool Результат открытия
+ * 
+ * @details Применяет недостающие миграции SchemaMigrator (таблицы, триггеры
+ * уведомлений и счетчиков строк, индексы) и одним запросом определяет,
+ * доступны ли pg_trgm и счетчики строк. Для актуальной схемы это два
+ * запроса без DDL.
+ */
+bool PostgresStorage::open()
+{
+    QSqlDatabase db = database();
+    if (!db.isOpen()) {
+        return false;
+    }
+    
+    SchemaMigrator migrator(db);
+    if (!migrator.migrate()) {
+        qWarning() << "Схема не обновлена до версии" << SchemaMigrator::latestVersion()
+                   << ":" << migrator.lastError();
+    }
+    
+    // Флаги читают потоки пула чтения, а open() повторяется при переподключении,
+    // поэтому значения сначала вычисляются и только затем публикуются атомарно
+    QSqlQuery query(db);
+    if (query.exec("SELECT EXISTS (SELECT 1 FROM pg_extension WHERE extname = 'pg_trgm'), "
+                   "to_regclass('university_stats') IS NOT NULL, "
+                   "to_regclass('subject_rosters') IS NOT NULL") && query.next()) {
+        const bool trigramSearch = query.value(0).toBool();
+        const bool rowCounters = query.value(1).toBool();
+        const bool rosterView = query.value(2).toBool();
+        m_trigramSearch.store(trigramSearch);
+        m_rowCounters.store(rowCounters);
+        m_rosterView.store(rosterView);
+    }
+    if (!m_trigramSearch.load()) {
+        qWarning() << "pg_trgm недоступен, поиск без индекса";
+    }
+    return true;
+}
+
+/**
+ * @brief Подписка на уведомления об изменениях
+ * @param db Соединение рабочего потока
+ */
+void PostgresStorage::subscribeToChanges(QSqlDatabase &db)
+{
+    QSqlDriver *driver = db.driver();
+    if (!driver || !driver->hasFeature(QSqlDriver::EventNotifications)) {
+        return;
+    }
+    if (driver->subscribedToNotifications().contains(CHANGE_CHANNEL)) {
+        return;
+    }
+    
+    connect(driver, &QSqlDriver::notification, this, &PostgresStorage::onNotification, Qt::UniqueConnection);
+    if (!driver->subscribeToNotification(CHANGE_CHANNEL)) {
+        qWarning() << "Не удалось подписаться на" << CHANGE_CHANNEL << ":" << driver->lastError().text();
+    }
+}
+
+/**
+ * @brief Обработка уведомления
+ * @param name Имя канала
+ * @param source Источник уведомления
+ * @param payload Полезная нагрузка
+ * 
+ * @details Собственные изменения уже сообщены сигналами операций записи
+ */
+void PostgresStorage::onNotification(const QString &name, QSqlDriver::NotificationSource source, const QVariant &payload)
+{
+    if (name != CHANGE_CHANNEL || source == QSqlDriver::SelfSource) {
+        return;
+    }
+    
+    const QJsonObject change = QJsonDocument::fromJson(payload.toString().toUtf8()).object();
+    const QString table = change.value("table").toString();
+    if (table.isEmpty()) {
+        return;
+    }
+    if (change.value("reload").toBool()) {
+        emit tableChanged(table);
+        return;
+    }
+    
+    // grades есть только у изменений и удалений students
+    const QJsonArray changed = change.value("ids").toArray();
+    const QJsonArray grades = change.value("grades").toArray();
+    QList<int> ids;
+    QList<int> previousGrades;
+    ids.reserve(changed.size());
+    previousGrades.reserve(grades.size());
+    for (qsizetype i = 0; i < changed.size(); ++i) {
+        if (const int id = changed.at(i).toInt(); id > 0) {
+            ids.append(id);
+            if (!grades.isEmpty()) {
+                previousGrades.append(grades.at(i).toInt());
+            }
+        }
+    }
+    if (!ids.isEmpty()) {
+        emit rowsChanged(table, ids, change.value("op").toString() == "INSERT", previousGrades);
+    }
+}
+
+/**
+ * @brief Получение записей преподавателей по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> PostgresStorage::getTeachersByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<TeacherRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    records.reserve(ids.size());
+    if (readBinary("SELECT id, full_name, department FROM teachers WHERE id = ANY(CAST($1 AS int[])) ORDER BY id",
+                   {toIdArray(ids)}, [&records](const PgBinaryReader::Row &row) {
+        records.append(TeacherRecord{row.intAt(0), row.textAt(1), row.textAt(2)});
+    })) {
+        return records;
+    }
+    records.clear();
+    
+    QSqlQuery *query = statement("SELECT id, full_name, department FROM teachers "
+                                 "WHERE id = ANY(CAST(? AS int[])) ORDER BY id");
+    if (!query) {
+        setOk(ok, false);
+        return records;
+    }
+    query->bindValue(0, toIdArray(ids));
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки teachers по id:" << query->lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+    
+    records.reserve(ids.size());
+    while (query->next()) {
+        records.append(TeacherRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Получение записей студентов по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> PostgresStorage::getStudentsByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<StudentRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    records.reserve(ids.size());
+    if (readBinary("SELECT id, full_name, grade FROM students WHERE id = ANY(CAST($1 AS int[])) ORDER BY id",
+                   {toIdArray(ids)}, [&records](const PgBinaryReader::Row &row) {
+        records.append(StudentRecord{row.intAt(0), row.textAt(1), row.intAt(2)});
+    })) {
+        return records;
+    }
+    records.clear();
+    
+    QSqlQuery *query = statement("SELECT id, full_name, grade FROM students "
+                                 "WHERE id = ANY(CAST(? AS int[])) ORDER BY id");
+    if (!query) {
+        setOk(ok, false);
+        return records;
+    }
+    query->bindValue(0, toIdArray(ids));
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки students по id:" << query->lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+    
+    records.reserve(ids.size());
+    while (query->next()) {
+        records.append(StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Получение записей предметов по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> PostgresStorage::getSubjectsByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<SubjectRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    records.reserve(ids.size());
+    if (readBinary("SELECT id, name FROM subjects WHERE id = ANY(CAST($1 AS int[])) ORDER BY id",
+                   {toIdArray(ids)}, [&records](const PgBinaryReader::Row &row) {
+        records.append(SubjectRecord{row.intAt(0), row.textAt(1)});
+    })) {
+        return records;
+    }
+    records.clear();
+    
+    QSqlQuery *query = statement("SELECT id, name FROM subjects "
+                                 "WHERE id = ANY(CAST(? AS int[])) ORDER BY id");
+    if (!query) {
+        setOk(ok, false);
+        return records;
+    }
+    query->bindValue(0, toIdArray(ids));
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки subjects по id:" << query->lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+    
+    records.reserve(ids.size());
+    while (query->next()) {
+        records.append(SubjectRecord{
+            query->value(0).toInt(),
+            query->value(1).toString()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Резервирование идентификаторов
+ * @param table Имя таблицы
+ * @param count Количество идентификаторов
+ * @return QList<int> Зарезервированные идентификаторы
+ * 
+ * @details nextval() по generate_series выдает все идентификаторы за один
+ * запрос. Значения последовательности не откатываются, поэтому при ошибке
+ * вставки в нумерации остается пропуск — так же, как у обычного SERIAL.
+ */
+QList<int> PostgresStorage::reserveIds(const QString &table, int count) const
+{
+    QList<int> ids;
+    QSqlQuery *query = statement("SELECT nextval(pg_get_serial_sequence(?, 'id')) "
+                                 "FROM generate_series(1, ?)");
+    if (!query) {
+        return ids;
+    }
+    query->bindValue(0, table);
+    query->bindValue(1, count);
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка резервирования id" << table << ":" << query->lastError().text();
+        return ids;
+    }
+    
+    ids.reserve(count);
+    while (query->next()) {
+        ids.append(query->value(0).toInt());
+    }
+    query->finish();
+    
+    // nextval в одном запросе возвращает значения по возрастанию, но порядок
+    // строк результата не гарантирован без ORDER BY
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/**
+ * @brief Пакетная вставка строк
+ * @param table Имя таблицы
+ * @param columns Имена столбцов
+ * @param values Значения по столбцам
+ * @return bool Результат операции
+ */
+bool PostgresStorage::bulkInsert(const QString &table, const QStringList &columns, const QList<QVariantList> &values)
+{
+    QSqlDatabase db = database();
+    if (!db.isOpen() || !db.transaction()) {
+        qWarning() << "Не удалось начать транзакцию для" << table << ":" << db.lastError().text();
+        return false;
+    }
+    
+    bool ok = false;
+    if (PgCopyWriter::isAvailable(db)) {
+        QString error;
+        ok = PgCopyWriter::copy(db, table, columns, values, &error);
+        if (!ok) {
+            qWarning() << "Ошибка COPY в" << table << ":" << error;
+        }
+    } else {
+        QStringList placeholders;
+        for (int i = 0; i < columns.size(); ++i) {
+            placeholders.append("?");
+        }
+        QSqlQuery *query = statement(QString("INSERT INTO %1 (%2) VALUES (%3)")
+                                     .arg(table, columns.join(", "), placeholders.join(", ")));
+        if (query) {
+            for (int i = 0; i < values.size(); ++i) {
+                query->bindValue(i, values.at(i));
+            }
+            ok = execBatch(*query);
+            if (!ok) {
+                qWarning() << "Ошибка пакетной вставки в" << table << ":" << query->lastError().text();
+            }
+        }
+    }
+    
+    if (!ok) {
+        db.rollback();
+        return false;
+    }
+    if (!db.commit()) {
+        qWarning() << "Ошибка фиксации транзакции" << table << ":" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Нечеткий поиск преподавателей
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<TeacherRecord> Записи по убыванию сходства
+ */
+QList<TeacherRecord> PostgresStorage::searchTeachers(const QString &text, int limit) const
+{
+    QList<TeacherRecord> records;
+    QSqlQuery *query = nullptr;
+    
+    if (m_trigramSearch) {
+        query = statement("SELECT id, full_name, department FROM teachers "
+                          "WHERE ? <% full_name OR ? <% department "
+                          "ORDER BY GREATEST(word_similarity(?, full_name), word_similarity(?, department)) DESC, id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        query->bindValue(0, text);
+        query->bindValue(1, text);
+        query->bindValue(2, text);
+        query->bindValue(3, text);
+        query->bindValue(4, limit);
+    } else {
+        query = statement("SELECT id, full_name, department FROM teachers "
+                          "WHERE full_name ILIKE ? OR department ILIKE ? ORDER BY id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        const QString pattern = likePattern(text);
+        query->bindValue(0, pattern);
+        query->bindValue(1, pattern);
+        query->bindValue(2, limit);
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка поиска teachers:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(TeacherRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Нечеткий поиск студентов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<StudentRecord> Записи по убыванию сходства
+ */
+QList<StudentRecord> PostgresStorage::searchStudents(const QString &text, int limit) const
+{
+    QList<StudentRecord> records;
+    QSqlQuery *query = nullptr;
+    
+    if (m_trigramSearch) {
+        query = statement("SELECT id, full_name, grade FROM students "
+                          "WHERE ? <% full_name "
+                          "ORDER BY word_similarity(?, full_name) DESC, id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        query->bindValue(0, text);
+        query->bindValue(1, text);
+        query->bindValue(2, limit);
+    } else {
+        query = statement("SELECT id, full_name, grade FROM students "
+                          "WHERE full_name ILIKE ? ORDER BY id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        const QString pattern = likePattern(text);
+        query->bindValue(0, pattern);
+        query->bindValue(1, limit);
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка поиска students:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Открытие серверного курсора по студентам
+ * @return std::unique_ptr<RecordCursor<StudentRecord>> Курсор или nullptr
+ *
+ * @details Количество строк читается в той же транзакции, что и курсор,
+ * поэтому совпадает с числом строк, которые он вернет
+ */
+std::unique_ptr<RecordCursor<StudentRecord>> PostgresStorage::openStudentCursor()
+{
+    const QString connection = m_pool->openDedicated("cursor");
+    if (connection.isEmpty()) {
+        qWarning() << "Не удалось открыть соединение для курсора:" << m_pool->lastError();
+        return nullptr;
+    }
+
+    qint64 count = -1;
+    {
+        QSqlDatabase db = QSqlDatabase::database(connection, false);
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        bool ok = db.transaction()
+                  && query.exec("SET TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY")
+                  && query.exec(m_rowCounters
+                                ? "SELECT row_count FROM university_stats WHERE table_name = 'students'"
+                                : "SELECT COUNT(*) FROM students")
+                  && query.next();
+        if (ok) {
+            count = query.value(0).toLongLong();
+            query.finish();
+            // SCROLL позволяет возвращаться к уже прочитанным окнам
+            ok = query.exec(QString("DECLARE %1 SCROLL CURSOR FOR "
+                                    "SELECT id, full_name, grade FROM students ORDER BY id").arg(CURSOR_NAME));
+        }
+        if (!ok) {
+            qWarning() << "Ошибка открытия курсора students:" << query.lastError().text();
+            count = -1;
+        }
+    }
+    if (count < 0) {
+        m_pool->closeDedicated(connection);
+        return nullptr;
+    }
+
+    PgRecordCursor<StudentRecord>::BinaryDecoder binaryDecoder = nullptr;
+    if (m_binaryReads) {
+        binaryDecoder = [](const PgBinaryReader::Row &row) {
+            return StudentRecord{row.intAt(0), row.textAt(1), row.intAt(2)};
+        };
+    }
+
+    return std::make_unique<PgRecordCursor<StudentRecord>>(m_pool, connection, count, [](const QSqlQuery &query) {
+        return StudentRecord{
+            query.value(0).toInt(),
+            query.value(1).toString(),
+            query.value(2).toInt()
+        };
+    }, binaryDecoder);
+}
+
+/**
+ * @brief Нечеткий поиск предметов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<SubjectRecord> Записи по убыванию сходства
+ */
+QList<SubjectRecord> PostgresStorage::searchSubjects(const QString &text, int limit) const
+{
+    QList<SubjectRecord> records;
+    QSqlQuery *query = nullptr;
+    
+    if (m_trigramSearch) {
+        query = statement("SELECT id, name FROM subjects "
+                          "WHERE ? <% name "
+                          "ORDER BY word_similarity(?, name) DESC, id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        query->bindValue(0, text);
+        query->bindValue(1, text);
+        query->bindValue(2, limit);
+    } else {
+        query = statement("SELECT id, name FROM subjects "
+                          "WHERE name ILIKE ? ORDER BY id LIMIT ?");
+        if (!query) {
+            return records;
+        }
+        const QString pattern = likePattern(text);
+        query->bindValue(0, pattern);
+        query->bindValue(1, limit);
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка поиска subjects:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(SubjectRecord{
+            query->value(0).toInt(),
+            query->value(1).toString()
+        });
+    }
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Пакетное добавление преподавателей
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
+ */
+QList<int> PostgresStorage::addTeachers(const QList<TeacherRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+    
+    const QList<int> ids = reserveIds("teachers", static_cast<int>(records.size()));
+    if (ids.size() != records.size()) {
+        return {};
+    }
+    
+    QVariantList idColumn;
+    QVariantList fullNameColumn;
+    QVariantList departmentColumn;
+    idColumn.reserve(records.size());
+    fullNameColumn.reserve(records.size());
+    departmentColumn.reserve(records.size());
+    
+    for (int i = 0; i < records.size(); ++i) {
+        const TeacherRecord &record = records.at(i);
+        idColumn.append(ids.at(i));
+        fullNameColumn.append(record.fullName);
+        departmentColumn.append(record.department);
+    }
+    
+    if (!bulkInsert("teachers", {"id", "full_name", "department"}, {idColumn, fullNameColumn, departmentColumn})) {
+        return {};
+    }
+    return ids;
+}
+
+/**
+ * @brief Пакетное добавление студентов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
+ */
+QList<int> PostgresStorage::addStudents(const QList<StudentRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+    
+    const QList<int> ids = reserveIds("students", static_cast<int>(records.size()));
+    if (ids.size() != records.size()) {
+        return {};
+    }
+    
+    QVariantList idColumn;
+    QVariantList fullNameColumn;
+    QVariantList gradeColumn;
+    idColumn.reserve(records.size());
+    fullNameColumn.reserve(records.size());
+    gradeColumn.reserve(records.size());
+    
+    for (int i = 0; i < records.size(); ++i) {
+        const StudentRecord &record = records.at(i);
+        idColumn.append(ids.at(i));
+        fullNameColumn.append(record.fullName);
+        gradeColumn.append(record.grade);
+    }
+    
+    if (!bulkInsert("students", {"id", "full_name", "grade"}, {idColumn, fullNameColumn, gradeColumn})) {
+        return {};
+    }
+    return ids;
+}
+
+/**
+ * @brief Пакетное добавление предметов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей или пустой список при ошибке
+ */
+QList<int> PostgresStorage::addSubjects(const QList<SubjectRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+    
+    const QList<int> ids = reserveIds("subjects", static_cast<int>(records.size()));
+    if (ids.size() != records.size()) {
+        return {};
+    }
+    
+    QVariantList idColumn;
+    QVariantList nameColumn;
+    idColumn.reserve(records.size());
+    nameColumn.reserve(records.size());
+    
+    for (int i = 0; i < records.size(); ++i) {
+        const SubjectRecord &record = records.at(i);
+        idColumn.append(ids.at(i));
+        nameColumn.append(record.name);
+    }
+    
+    if (!bulkInsert("subjects", {"id", "name"}, {idColumn, nameColumn})) {
+        return {};
+    }
+    return ids;
+}
+
+/**
+ * @brief Получение количества строк по таблицам
+ * @param mode Способ подсчета
+ * @return RecordCounts Количество строк
+ */
+RecordCounts PostgresStorage::getRecordCounts(CountMode mode) const
+{
+    RecordCounts counts;
+    counts.estimated = mode == CountMode::Estimated;
+    
+    QSqlQuery *query = nullptr;
+    if (counts.estimated) {
+        // reltuples равен -1 у таблицы, для которой еще не собрана статистика
+        query = statement("SELECT relname, GREATEST(reltuples, 0)::bigint FROM pg_class "
+                          "WHERE oid IN ('teachers'::regclass, 'students'::regclass, 'subjects'::regclass)");
+    } else if (m_rowCounters) {
+        query = statement("SELECT table_name, row_count FROM university_stats "
+                          "WHERE table_name IN ('teachers', 'students', 'subjects')");
+    } else {
+        query = statement("SELECT 'teachers', (SELECT COUNT(*) FROM teachers) "
+                          "UNION ALL SELECT 'students', (SELECT COUNT(*) FROM students) "
+                          "UNION ALL SELECT 'subjects', (SELECT COUNT(*) FROM subjects)");
+    }
+    if (!query) {
+        return counts;
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка подсчета записей:" << query->lastError().text();
+        return counts;
+    }
+    while (query->next()) {
+        const QString table = query->value(0).toString();
+        const qint64 count = query->value(1).toLongLong();
+        if (table == "teachers") {
+            counts.teachers = count;
+        } else if (table == "students") {
+            counts.students = count;
+        } else if (table == "subjects") {
+            counts.subjects = count;
+        }
+    }
+    query->finish();
+    return counts;
+}
+
+/**
+ * @brief Удаление преподавателей по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> PostgresStorage::deleteTeachers(const QList<int> &ids)
+{
+    return deleteByIds("teachers", ids);
+}
+
+/**
+ * @brief Удаление студентов по списку id
+ * @param ids Идентификаторы
+ * @return QList<StudentRecord> Удаленные записи
+ */
+QList<StudentRecord> PostgresStorage::deleteStudents(const QList<int> &ids)
+{
+    QList<StudentRecord> deleted;
+    if (ids.isEmpty()) {
+        return deleted;
+    }
+    
+    QSqlQuery *query = statement("DELETE FROM students WHERE id = ANY(CAST(? AS int[])) "
+                                 "RETURNING id, full_name, grade");
+    if (!query) {
+        return deleted;
+    }
+    query->bindValue(0, toIdArray(ids));
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка удаления из students по id:" << query->lastError().text();
+        return deleted;
+    }
+    
+    deleted.reserve(ids.size());
+    while (query->next()) {
+        deleted.append(StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        });
+    }
+    query->finish();
+    
+    // RETURNING не гарантирует порядок строк
+    std::sort(deleted.begin(), deleted.end(), [](const StudentRecord &a, const StudentRecord &b) {
+        return a.id < b.id;
+    });
+    return deleted;
+}
+
+/**
+ * @brief Удаление предметов по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> PostgresStorage::deleteSubjects(const QList<int> &ids)
+{
+    return deleteByIds("subjects", ids);
+}
+
+/**
+ * @brief Удаление строк по массиву id
+ * @param table Имя таблицы
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных строк
+ */
+QList<int> PostgresStorage::deleteByIds(const QString &table, const QList<int> &ids)
+{
+    QList<int> deleted;
+    if (ids.isEmpty()) {
+        return deleted;
+    }
+    
+    QSqlQuery *query = statement(QString("DELETE FROM %1 WHERE id = ANY(CAST(? AS int[])) RETURNING id").arg(table));
+    if (!query) {
+        return deleted;
+    }
+    query->bindValue(0, toIdArray(ids));
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка удаления из" << table << "по id:" << query->lastError().text();
+        return deleted;
+    }
+    
+    deleted.reserve(ids.size());
+    while (query->next()) {
+        deleted.append(query->value(0).toInt());
+    }
+    query->finish();
+    
+    // RETURNING не гарантирует порядок строк
+    std::sort(deleted.begin(), deleted.end());
+    return deleted;
+}
+
+/**
+ * @brief Получение состава предмета
+ * @param subjectId Идентификатор предмета
+ * @return QList<RosterEntry> Строки состава
+ */
+QList<RosterEntry> PostgresStorage::getSubjectRoster(int subjectId) const
+{
+    if (!m_rosterView) {
+        return SqlStorage::getSubjectRoster(subjectId);
+    }
+    return readRoster("SELECT subject_id, student_id, student_name, grade, teacher_id, teacher_name "
+                      "FROM subject_rosters WHERE subject_id = ? "
+                      "ORDER BY student_id, teacher_id",
+                      subjectId);
+}
+
+/**
+ * @brief Пересборка составов предметов
+ * @return bool Результат операции
+ */
+bool PostgresStorage::refreshRosters()
+{
+    if (!m_rosterView) {
+        return true;
+    }
+
+    QSqlQuery query(database());
+    if (!exec(query, "REFRESH MATERIALIZED VIEW CONCURRENTLY subject_rosters")) {
+        qWarning() << "Ошибка пересборки subject_rosters:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Чтение результата запроса в двоичном формате
+ * @param sql Текст запроса
+ * @param params Значения параметров
+ * @param handler Обработчик строк
+ * @return bool Результат чтения
+ */
+bool PostgresStorage::readBinary(const QString &sql, const QVariantList &params,
+                                 const PgBinaryReader::RowHandler &handler) const
+{
+    QSqlDatabase db = database();
+    if (!m_binaryReads || !PgBinaryReader::isAvailable(db)) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    const bool ok = PgBinaryReader::read(db, sql, params, handler, &error);
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+    if (metrics()->isSlow(elapsedUs)) {
+        metrics()->logSlowQuery(sql, params, elapsedUs);
+    }
+    if (!ok) {
+        qWarning() << "Ошибка двоичного чтения, повтор через QSqlQuery:" << error;
+    }
+    return ok;
+}
+
+/**
+ * @brief Получение всех преподавателей
+ * @return QList<TeacherRecord> Записи в порядке возрастания id
+ */
+QList<TeacherRecord> PostgresStorage::getAllTeachers() const
+{
+    QList<TeacherRecord> records;
+    const bool ok = readBinary("SELECT id, full_name, department FROM teachers ORDER BY id", {},
+                               [&records](const PgBinaryReader::Row &row) {
+        records.append(TeacherRecord{row.intAt(0), row.textAt(1), row.textAt(2)});
+    });
+    return ok ? records : SqlStorage::getAllTeachers();
+}
+
+/**
+ * @brief Получение всех студентов
+ * @return QList<StudentRecord> Записи в порядке возрастания id
+ */
+QList<StudentRecord> PostgresStorage::getAllStudents() const
+{
+    QList<StudentRecord> records;
+    const bool ok = readBinary("SELECT id, full_name, grade FROM students ORDER BY id", {},
+                               [&records](const PgBinaryReader::Row &row) {
+        records.append(StudentRecord{row.intAt(0), row.textAt(1), row.intAt(2)});
+    });
+    return ok ? records : SqlStorage::getAllStudents();
+}
+
+/**
+ * @brief Получение всех предметов
+ * @return QList<SubjectRecord> Записи в порядке возрастания id
+ */
+QList<SubjectRecord> PostgresStorage::getAllSubjects() const
+{
+    QList<SubjectRecord> records;
+    const bool ok = readBinary("SELECT id, name FROM subjects ORDER BY id", {},
+                               [&records](const PgBinaryReader::Row &row) {
+        records.append(SubjectRecord{row.intAt(0), row.textAt(1)});
+    });
+    return ok ? records : SqlStorage::getAllSubjects();
+}
+
+/**
+ * @brief Получение страницы преподавателей
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<TeacherRecord> Записи страницы
+ */
+QList<TeacherRecord> PostgresStorage::getTeachersPage(int afterId, int limit) const
+{
+    QList<TeacherRecord> records;
+    records.reserve(limit);
+    const bool ok = readBinary("SELECT id, full_name, department FROM teachers WHERE id > $1 ORDER BY id LIMIT $2",
+                               {afterId, limit}, [&records](const PgBinaryReader::Row &row) {
+        records.append(TeacherRecord{row.intAt(0), row.textAt(1), row.textAt(2)});
+    });
+    return ok ? records : SqlStorage::getTeachersPage(afterId, limit);
+}
+
+/**
+ * @brief Получение страницы студентов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<StudentRecord> Записи страницы
+ */
+QList<StudentRecord> PostgresStorage::getStudentsPage(int afterId, int limit) const
+{
+    QList<StudentRecord> records;
+    records.reserve(limit);
+    const bool ok = readBinary("SELECT id, full_name, grade FROM students WHERE id > $1 ORDER BY id LIMIT $2",
+                               {afterId, limit}, [&records](const PgBinaryReader::Row &row) {
+        records.append(StudentRecord{row.intAt(0), row.textAt(1), row.intAt(2)});
+    });
+    return ok ? records : SqlStorage::getStudentsPage(afterId, limit);
+}
+
+/**
+ * @brief Получение страницы предметов
+ * @param afterId Идентификатор последней загруженной записи
+ * @param limit Максимальное количество записей
+ * @return QList<SubjectRecord> Записи страницы
+ */
+QList<SubjectRecord> PostgresStorage::getSubjectsPage(int afterId, int limit) const
+{
+    QList<SubjectRecord> records;
+    records.reserve(limit);
+    const bool ok = readBinary("SELECT id, name FROM subjects WHERE id > $1 ORDER BY id LIMIT $2",
+                               {afterId, limit}, [&records](const PgBinaryReader::Row &row) {
+        records.append(SubjectRecord{row.intAt(0), row.textAt(1)});
+    });
+    return ok ? records : SqlStorage::getSubjectsPage(afterId, limit);
+}
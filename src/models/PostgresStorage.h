@@ -0,0 +1,343 @@
+/**
+ * @file PostgresStorage.h
+ * @brief Заголовочный файл класса PostgresStorage
+ * @ingroup Models
+ *
+ * @class PostgresStorage
+ * @brief Хранилище в PostgreSQL
+ *
+ * Схема создается и обновляется миграциями SchemaMigrator. Поверх общих
+ * операций SqlStorage использует возможности PostgreSQL:
+ * - чтение таблиц, страниц по ключу и окон курсора через libpq
+ *   в двоичном формате (PgBinaryReader)
+ *   с QSqlQuery как запасным вариантом
+ * - чтение по списку id одним запросом через id = ANY(int[])
+ * - пакетную вставку через COPY (PgCopyWriter) с идентификаторами,
+ *   зарезервированными одним nextval() по generate_series
+ * - нечеткий поиск по триграммным индексам pg_trgm с ILIKE как запасным вариантом
+ * - счетчики строк university_stats и оценку pg_class.reltuples
+ * - составы предметов из материализованного представления subject_rosters,
+ *   которое пересобирается REFRESH MATERIALIZED VIEW CONCURRENTLY
+ *
+ * Изменения других клиентов приходят через LISTEN/NOTIFY: триггеры уровня
+ * оператора отправляют в канал CHANGE_CHANNEL одно уведомление на оператор.
+ * До NOTIFY_ROW_LIMIT строк полезная нагрузка {"table", "op", "ids"} перечисляет
+ * их (для изменений и удалений студентов еще и прежние оценки "grades"),
+ * и хранилище сообщает о них сигналом rowsChanged; для большего оператора
+ * (например, импорта через COPY) приходит {"table", "op", "reload": true}
+ * и сигнал tableChanged.
+ *
+ * @warning Для работы требуется драйвер QPSQL
+ */
+
+#ifndef POSTGRESSTORAGE_H
+#define POSTGRESSTORAGE_H
+
+#include <QSqlDriver>
+#include <QStringList>
+#include <QVariantList>
+#include <atomic>
+#include "PgBinaryReader.h"
+#include "SqlStorage.h"
+
+class PostgresStorage : public SqlStorage
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Канал уведомлений об изменениях таблиц
+     */
+    static constexpr const char *CHANGE_CHANNEL = "university_changes";
+
+    /**
+     * @brief Наибольшее количество id в одном уведомлении
+     * @details Полезная нагрузка NOTIFY ограничена 8000 байт
+     */
+    static constexpr int NOTIFY_ROW_LIMIT = 500;
+
+    /**
+     * @brief Конструктор
+     * @param parent Родительский QObject
+     *
+     * @details Параметры подключения берутся из ConnectionSettings
+     * по умолчанию (localhost/university/postgres). Двоичное чтение
+     * отключается переменной окружения UNIVERSITY_PG_BINARY_READS=0
+     */
+    explicit PostgresStorage(QObject *parent = nullptr);
+
+    /**
+     * @brief Получить название хранилища
+     * @return QString "PostgreSQL"
+     */
+    QString name() const override;
+
+    /**
+     * @brief Открыть соединение и применить миграции схемы
+     * @return bool true если соединение открыто
+     */
+    bool open() override;
+
+    /**
+     * @brief Получить всех преподавателей
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getAllTeachers()
+     */
+    QList<TeacherRecord> getAllTeachers() const override;
+
+    /**
+     * @brief Получить страницу преподавателей по ключу
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<TeacherRecord> Записи страницы
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getTeachersPage()
+     */
+    QList<TeacherRecord> getTeachersPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить преподавателей по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<TeacherRecord> Найденные записи
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе подготовленным запросом
+     */
+    QList<TeacherRecord> getTeachersByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить преподавателей через COPY
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addTeachers(const QList<TeacherRecord> &records) override;
+
+    /**
+     * @brief Удалить преподавателей одним DELETE ... WHERE id = ANY(массив)
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteTeachers(const QList<int> &ids) override;
+
+    /**
+     * @brief Нечеткий поиск преподавателей по имени и кафедре
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<TeacherRecord> Записи по убыванию сходства
+     */
+    QList<TeacherRecord> searchTeachers(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить всех студентов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getAllStudents()
+     */
+    QList<StudentRecord> getAllStudents() const override;
+
+    /**
+     * @brief Получить страницу студентов по ключу
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<StudentRecord> Записи страницы
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getStudentsPage()
+     */
+    QList<StudentRecord> getStudentsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить студентов по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<StudentRecord> Найденные записи
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе подготовленным запросом
+     */
+    QList<StudentRecord> getStudentsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить студентов через COPY
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addStudents(const QList<StudentRecord> &records) override;
+
+    /**
+     * @brief Удалить студентов одним DELETE ... WHERE id = ANY(массив)
+     * @param ids Идентификаторы
+     * @return QList<StudentRecord> Удаленные записи по возрастанию id
+     */
+    QList<StudentRecord> deleteStudents(const QList<int> &ids) override;
+
+    /**
+     * @brief Нечеткий поиск студентов по имени
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<StudentRecord> Записи по убыванию сходства
+     */
+    QList<StudentRecord> searchStudents(const QString &text, int limit) const override;
+
+    /**
+     * @brief Открыть серверный курсор по студентам
+     * @return std::unique_ptr<RecordCursor<StudentRecord>> Курсор или nullptr при ошибке
+     *
+     * @details Курсор (DECLARE ... SCROLL CURSOR) живет в транзакции
+     * REPEATABLE READ READ ONLY на отдельном соединении вне пула, поэтому
+     * не мешает записи в рабочем потоке. Окна читаются через MOVE ABSOLUTE
+     * и FETCH FORWARD; в памяти клиента остается только прочитанное окно.
+     */
+    std::unique_ptr<RecordCursor<StudentRecord>> openStudentCursor() override;
+
+    /**
+     * @brief Получить все предметы
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getAllSubjects()
+     */
+    QList<SubjectRecord> getAllSubjects() const override;
+
+    /**
+     * @brief Получить страницу предметов по ключу
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<SubjectRecord> Записи страницы
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе через SqlStorage::getSubjectsPage()
+     */
+    QList<SubjectRecord> getSubjectsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Получить предметы по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<SubjectRecord> Найденные записи
+     *
+     * @details Читается через PgBinaryReader, если он доступен,
+     * иначе подготовленным запросом
+     */
+    QList<SubjectRecord> getSubjectsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить предметы через COPY
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addSubjects(const QList<SubjectRecord> &records) override;
+
+    /**
+     * @brief Удалить предметы одним DELETE ... WHERE id = ANY(массив)
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteSubjects(const QList<int> &ids) override;
+
+    /**
+     * @brief Нечеткий поиск предметов по названию
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<SubjectRecord> Записи по убыванию сходства
+     */
+    QList<SubjectRecord> searchSubjects(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить количество строк по таблицам
+     * @param mode Exact — счетчики university_stats (или COUNT(*) без них),
+     * Estimated — pg_class.reltuples
+     * @return RecordCounts Количество строк
+     */
+    RecordCounts getRecordCounts(CountMode mode) const override;
+
+    /**
+     * @brief Получить состав предмета из subject_rosters
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Строки состава на момент последней пересборки
+     *
+     * @details Выборка по уникальному индексу subject_rosters_key, который
+     * включает все столбцы. Без представления (миграция не применена)
+     * состав собирается соединением таблиц, как в SqlStorage.
+     */
+    QList<RosterEntry> getSubjectRoster(int subjectId) const override;
+
+    /**
+     * @brief Пересобрать subject_rosters без блокировки чтения
+     * @return bool true если представление пересобрано
+     *
+     * @details CONCURRENTLY сравнивает новое содержимое со старым по
+     * уникальному индексу, поэтому чтение составов во время пересборки
+     * не ждет ее завершения
+     */
+    bool refreshRosters() override;
+
+private:
+    /**
+     * @brief Подписаться на уведомления об изменениях
+     * @param db Соединение потока хранилища
+     */
+    void subscribeToChanges(QSqlDatabase &db);
+
+    /**
+     * @brief Обработать уведомление PostgreSQL
+     * @param name Имя канала
+     * @param source Источник уведомления
+     * @param payload Полезная нагрузка в формате JSON
+     */
+    void onNotification(const QString &name, QSqlDriver::NotificationSource source, const QVariant &payload);
+
+    /**
+     * @brief Прочитать результат запроса в двоичном формате
+     * @param sql Текст запроса с параметрами $1, $2, ...
+     * @param params Значения параметров
+     * @param handler Обработчик строк
+     * @return bool true если прочитан весь результат; false если двоичное
+     * чтение недоступно или завершилось ошибкой
+     *
+     * @details Запрос дольше порога медленного запроса попадает в лог,
+     * как и запросы через SqlStorage::exec()
+     */
+    bool readBinary(const QString &sql, const QVariantList &params,
+                    const PgBinaryReader::RowHandler &handler) const;
+
+    /**
+     * @brief Зарезервировать идентификаторы в последовательности таблицы
+     * @param table Имя таблицы
+     * @param count Количество идентификаторов
+     * @return QList<int> Идентификаторы по возрастанию или пустой список при ошибке
+     */
+    QList<int> reserveIds(const QString &table, int count) const;
+
+    /**
+     * @brief Вставить строки одной транзакцией
+     * @param table Имя таблицы
+     * @param columns Имена столбцов
+     * @param values Значения по столбцам
+     * @return bool true если все строки вставлены
+     */
+    bool bulkInsert(const QString &table, const QStringList &columns, const QList<QVariantList> &values);
+
+    /**
+     * @brief Удалить строки по массиву id одним запросом
+     * @param table Имя таблицы
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных строк по возрастанию
+     *
+     * @details Массив передается одним параметром, поэтому текст запроса
+     * не зависит от количества id и подготавливается один раз
+     */
+    QList<int> deleteByIds(const QString &table, const QList<int> &ids);
+
+    std::atomic<bool> m_trigramSearch;  ///< Доступен pg_trgm и триграммные индексы
+    std::atomic<bool> m_rowCounters;    ///< Доступны счетчики строк university_stats
+    std::atomic<bool> m_rosterView;     ///< Доступно представление subject_rosters
+    const bool m_binaryReads;           ///< Чтение через PgBinaryReader разрешено (задается в конструкторе)
+};
+
+#endif // POSTGRESSTORAGE_H
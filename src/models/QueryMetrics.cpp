@@ -0,0 +1,178 @@
+/**
+ * @file QueryMetrics.cpp
+ * @brief Реализация класса QueryMetrics
+ * @ingroup Models
+ */
+
+#include "QueryMetrics.h"
+#include <QDebug>
+#include <QMutexLocker>
+#include <algorithm>
+
+/**
+ * @brief Конструктор
+ * @param parent Родительский QObject
+ *
+ * @details Порог медленного запроса берется из UNIVERSITY_SLOW_QUERY_MS
+ */
+QueryMetrics::QueryMetrics(QObject *parent)
+    : QObject(parent)
+    , m_slowQueries(0)
+    , m_slowQueryThreshold(DEFAULT_SLOW_QUERY_MS)
+{
+    bool ok = false;
+    const int threshold = qEnvironmentVariableIntValue("UNIVERSITY_SLOW_QUERY_MS", &ok);
+    if (ok) {
+        setSlowQueryThreshold(threshold);
+    }
+}
+
+/**
+ * @brief Учет выполнения операции
+ * @param operation Название операции
+ * @param elapsedUs Задержка в микросекундах
+ * @param rows Количество строк
+ * @param bytes Объем данных в байтах
+ */
+void QueryMetrics::record(const QString &operation, qint64 elapsedUs, qint64 rows, qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    Operation &stats = m_operations[operation];
+    if (stats.samples.size() < SAMPLE_CAPACITY) {
+        stats.samples.append(elapsedUs);
+    } else {
+        stats.samples[stats.next] = elapsedUs;
+    }
+    stats.next = (stats.next + 1) % SAMPLE_CAPACITY;
+    ++stats.count;
+    stats.rows += rows;
+    stats.bytes += bytes;
+    stats.maxUs = std::max(stats.maxUs, elapsedUs);
+}
+
+/**
+ * @brief Получение порога медленного запроса
+ * @return int Миллисекунды
+ */
+int QueryMetrics::slowQueryThreshold() const
+{
+    return m_slowQueryThreshold.loadRelaxed();
+}
+
+/**
+ * @brief Установка порога медленного запроса
+ * @param msecs Миллисекунды, отрицательные значения считаются нулем
+ */
+void QueryMetrics::setSlowQueryThreshold(int msecs)
+{
+    m_slowQueryThreshold.storeRelaxed(std::max(0, msecs));
+}
+
+/**
+ * @brief Проверка превышения порога
+ * @param elapsedUs Задержка в микросекундах
+ * @return bool Запрос медленный
+ */
+bool QueryMetrics::isSlow(qint64 elapsedUs) const
+{
+    const int threshold = slowQueryThreshold();
+    return threshold > 0 && elapsedUs >= threshold * 1000LL;
+}
+
+/**
+ * @brief Запись медленного запроса в лог
+ * @param sql Текст запроса
+ * @param values Привязанные значения
+ * @param elapsedUs Задержка в микросекундах
+ */
+void QueryMetrics::logSlowQuery(const QString &sql, const QVariantList &values, qint64 elapsedUs)
+{
+    const double msecs = elapsedUs / 1000.0;
+    qWarning().noquote() << "Медленный запрос" << msecs << "мс:" << sql.simplified()
+                         << "значения:" << values;
+
+    QVariantMap entry;
+    entry["sql"] = sql.simplified();
+    entry["values"] = values;
+    entry["ms"] = msecs;
+
+    QMutexLocker locker(&m_mutex);
+    ++m_slowQueries;
+    m_recentSlowQueries.append(entry);
+    if (m_recentSlowQueries.size() > RECENT_SLOW_QUERIES) {
+        m_recentSlowQueries.removeFirst();
+    }
+}
+
+/**
+ * @brief Получение снимка статистики
+ * @return QVariantMap Снимок
+ *
+ * @details Окна задержек копируются под блокировкой, сортировка
+ * выполняется после ее снятия
+ */
+QVariantMap QueryMetrics::snapshot() const
+{
+    QHash<QString, Operation> operations;
+    QVariantMap snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        operations = m_operations;
+        snapshot["slowQueries"] = m_slowQueries;
+        snapshot["recentSlowQueries"] = m_recentSlowQueries;
+    }
+    snapshot["slowQueryThreshold"] = slowQueryThreshold();
+
+    QVariantMap byOperation;
+    for (auto it = operations.begin(); it != operations.end(); ++it) {
+        QList<qint64> &sorted = it->samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        QVariantMap stats;
+        stats["count"] = it->count;
+        stats["rows"] = it->rows;
+        stats["bytes"] = it->bytes;
+        stats["p50"] = percentile(sorted, 50);
+        stats["p95"] = percentile(sorted, 95);
+        stats["p99"] = percentile(sorted, 99);
+        stats["max"] = it->maxUs / 1000.0;
+        byOperation[it.key()] = stats;
+    }
+    snapshot["operations"] = byOperation;
+    return snapshot;
+}
+
+/**
+ * @brief Получение снимка статистики в JSON
+ * @return QJsonObject Снимок
+ */
+QJsonObject QueryMetrics::toJson() const
+{
+    return QJsonObject::fromVariantMap(snapshot());
+}
+
+/**
+ * @brief Сброс статистики
+ */
+void QueryMetrics::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_operations.clear();
+    m_recentSlowQueries.clear();
+    m_slowQueries = 0;
+}
+
+/**
+ * @brief Вычисление перцентиля методом ближайшего ранга
+ * @param sorted Задержки по возрастанию
+ * @param percent Перцентиль
+ * @return double Миллисекунды
+ */
+double QueryMetrics::percentile(const QList<qint64> &sorted, int percent)
+{
+    if (sorted.isEmpty()) {
+        return 0.0;
+    }
+    const qsizetype rank = (sorted.size() * percent + 99) / 100;
+    return sorted.at(std::clamp<qsizetype>(rank - 1, 0, sorted.size() - 1)) / 1000.0;
+}
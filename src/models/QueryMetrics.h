@@ -0,0 +1,145 @@
+/**
+ * @file QueryMetrics.h
+ * @brief Заголовочный файл класса QueryMetrics
+ * @ingroup Models
+ *
+ * @class QueryMetrics
+ * @brief Статистика задержек операций хранилища и журнал медленных запросов
+ *
+ * Для каждой операции (getAllStudents, addTeacher, ...) хранит количество
+ * вызовов, сумму возвращенных строк и декодированных байт и последние
+ * SAMPLE_CAPACITY задержек, по которым считаются p50, p95 и p99.
+ * Задержки старше окна вытесняются, поэтому перцентили отражают
+ * текущую нагрузку, а не всю историю процесса.
+ *
+ * SQL запросы дольше порога slowQueryThreshold() пишутся в лог вместе
+ * с привязанными значениями, последние из них попадают в снимок.
+ * Порог задается переменной окружения UNIVERSITY_SLOW_QUERY_MS
+ * (по умолчанию DEFAULT_SLOW_QUERY_MS), 0 отключает журнал.
+ *
+ * Потокобезопасно: запись и снимок выполняются под QMutex.
+ */
+
+#ifndef QUERYMETRICS_H
+#define QUERYMETRICS_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QVariantList>
+#include <QVariantMap>
+
+class QueryMetrics : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Размер окна задержек на операцию
+     */
+    static const int SAMPLE_CAPACITY = 1024;
+
+    /**
+     * @brief Порог медленного запроса по умолчанию в миллисекундах
+     */
+    static const int DEFAULT_SLOW_QUERY_MS = 200;
+
+    /**
+     * @brief Количество медленных запросов, сохраняемых для снимка
+     */
+    static const int RECENT_SLOW_QUERIES = 20;
+
+    /**
+     * @brief Конструктор
+     * @param parent Родительский QObject
+     */
+    explicit QueryMetrics(QObject *parent = nullptr);
+
+    /**
+     * @brief Учесть выполнение операции
+     * @param operation Название операции
+     * @param elapsedUs Задержка в микросекундах
+     * @param rows Количество возвращенных или измененных строк
+     * @param bytes Объем декодированных данных в байтах
+     */
+    void record(const QString &operation, qint64 elapsedUs, qint64 rows, qint64 bytes);
+
+    /**
+     * @brief Получить порог медленного запроса
+     * @return int Миллисекунды, 0 — журнал отключен
+     */
+    int slowQueryThreshold() const;
+
+    /**
+     * @brief Задать порог медленного запроса
+     * @param msecs Миллисекунды, 0 отключает журнал
+     */
+    void setSlowQueryThreshold(int msecs);
+
+    /**
+     * @brief Проверить, превышает ли задержка порог
+     * @param elapsedUs Задержка в микросекундах
+     * @return bool true если журнал включен и порог превышен
+     */
+    bool isSlow(qint64 elapsedUs) const;
+
+    /**
+     * @brief Записать медленный запрос в лог
+     * @param sql Текст запроса
+     * @param values Привязанные значения
+     * @param elapsedUs Задержка в микросекундах
+     */
+    void logSlowQuery(const QString &sql, const QVariantList &values, qint64 elapsedUs);
+
+    /**
+     * @brief Получить снимок статистики
+     * @return QVariantMap operations (по операциям: count, rows, bytes, p50, p95, p99, max
+     * в миллисекундах), slowQueryThreshold, slowQueries и recentSlowQueries
+     */
+    QVariantMap snapshot() const;
+
+    /**
+     * @brief Получить снимок статистики в JSON
+     * @return QJsonObject Тот же снимок, что и snapshot()
+     */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Сбросить накопленную статистику
+     */
+    void reset();
+
+private:
+    /**
+     * @struct Operation
+     * @brief Накопленная статистика одной операции
+     */
+    struct Operation
+    {
+        QList<qint64> samples;  ///< Кольцевой буфер задержек в микросекундах
+        int next = 0;           ///< Позиция следующей записи в буфере
+        qint64 count = 0;       ///< Количество вызовов
+        qint64 rows = 0;        ///< Сумма строк
+        qint64 bytes = 0;       ///< Сумма байт
+        qint64 maxUs = 0;       ///< Максимальная задержка
+    };
+
+    /**
+     * @brief Посчитать перцентиль по отсортированным задержкам
+     * @param sorted Задержки по возрастанию
+     * @param percent Перцентиль от 0 до 100
+     * @return double Задержка в миллисекундах
+     */
+    static double percentile(const QList<qint64> &sorted, int percent);
+
+    mutable QMutex m_mutex;                 ///< Защита статистики
+    QHash<QString, Operation> m_operations; ///< Статистика по операциям
+    QVariantList m_recentSlowQueries;       ///< Последние медленные запросы
+    qint64 m_slowQueries;                   ///< Всего медленных запросов
+    QAtomicInt m_slowQueryThreshold;        ///< Порог в миллисекундах
+};
+
+#endif // QUERYMETRICS_H
@@ -0,0 +1,50 @@
+/**
+ * @file RecordCursor.h
+ * @brief Интерфейс курсора по таблице записей
+ * @ingroup Models
+ *
+ * @class RecordCursor
+ * @brief Произвольный доступ к строкам зафиксированного результата запроса
+ *
+ * Курсор открывается на снимке таблицы: количество строк и их порядок
+ * (по возрастанию id) не меняются, пока курсор открыт, даже если другие
+ * клиенты добавляют или удаляют записи. Клиент читает только нужные окна
+ * строк и не держит в памяти весь результат.
+ *
+ * Курсор привязан к потоку, в котором был создан, и не синхронизирован.
+ *
+ * @tparam Record Тип записи
+ */
+
+#ifndef RECORDCURSOR_H
+#define RECORDCURSOR_H
+
+#include <QList>
+#include <QtGlobal>
+
+template <typename Record>
+class RecordCursor
+{
+public:
+    /**
+     * @brief Деструктор
+     * @details Закрывает курсор и завершает его транзакцию
+     */
+    virtual ~RecordCursor() = default;
+
+    /**
+     * @brief Получить количество строк в снимке
+     * @return qint64 Количество строк
+     */
+    virtual qint64 count() const = 0;
+
+    /**
+     * @brief Прочитать окно строк
+     * @param offset Номер первой строки, начиная с 0
+     * @param limit Максимальное количество строк
+     * @return QList<Record> Строки окна или пустой список при ошибке
+     */
+    virtual QList<Record> fetch(qint64 offset, int limit) = 0;
+};
+
+#endif // RECORDCURSOR_H
@@ -0,0 +1,48 @@
+/**
+ * @file RosterEntry.cpp
+ * @brief Реализация структуры RosterEntry
+ * @ingroup Models
+ */
+
+#include "RosterEntry.h"
+
+/**
+ * @brief Преобразовать запись в строковое представление
+ * @return QString Строка формата "ID. Имя (Оценка: X) — Преподаватель"
+ */
+QString RosterEntry::toString() const
+{
+    QString text = QString("%1. %2").arg(studentId).arg(studentName);
+    if (grade > 0) {
+        text += QString(" (Оценка: %1)").arg(grade);
+    }
+    if (teacherId > 0) {
+        text += QString(" — %1").arg(teacherName);
+    }
+    return text;
+}
+
+/**
+ * @brief Сравнить записи по всем полям
+ * @param other Другая запись
+ * @return bool true если все поля совпадают
+ */
+bool RosterEntry::operator==(const RosterEntry &other) const
+{
+    return subjectId == other.subjectId &&
+           studentId == other.studentId &&
+           studentName == other.studentName &&
+           grade == other.grade &&
+           teacherId == other.teacherId &&
+           teacherName == other.teacherName;
+}
+
+/**
+ * @brief Проверить, отличаются ли записи
+ * @param other Другая запись
+ * @return bool true если хотя бы одно поле отличается
+ */
+bool RosterEntry::operator!=(const RosterEntry &other) const
+{
+    return !(*this == other);
+}
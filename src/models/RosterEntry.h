@@ -0,0 +1,62 @@
+/**
+ * @file RosterEntry.h
+ * @brief Заголовочный файл структуры RosterEntry
+ * @ingroup Models
+ *
+ * @struct RosterEntry
+ * @brief Строка состава предмета: студент, его оценка и преподаватель
+ *
+ * @details Легковесная копируемая запись без QObject и сигналов.
+ * В PostgreSQL строки берутся из материализованного представления
+ * subject_rosters, в остальных хранилищах собираются из enrollments
+ * и assignments при чтении. Если предмет ведут несколько преподавателей,
+ * студент входит в состав по одной строке на преподавателя; без
+ * преподавателя teacherId равен 0. Q_GADGET делает поля доступными из QML.
+ */
+
+#ifndef ROSTERENTRY_H
+#define ROSTERENTRY_H
+
+#include <QObject>
+#include <QString>
+
+struct RosterEntry
+{
+    Q_GADGET
+    Q_PROPERTY(int subjectId MEMBER subjectId)
+    Q_PROPERTY(int studentId MEMBER studentId)
+    Q_PROPERTY(QString studentName MEMBER studentName)
+    Q_PROPERTY(int grade MEMBER grade)
+    Q_PROPERTY(int teacherId MEMBER teacherId)
+    Q_PROPERTY(QString teacherName MEMBER teacherName)
+
+public:
+    int subjectId = 0;      ///< Идентификатор предмета
+    int studentId = 0;      ///< Идентификатор студента
+    QString studentName;    ///< Полное имя студента
+    int grade = 0;          ///< Оценка студента по предмету, 0 — не выставлена
+    int teacherId = 0;      ///< Идентификатор преподавателя, 0 — не назначен
+    QString teacherName;    ///< Полное имя преподавателя
+
+    /**
+     * @brief Преобразовать запись в строковое представление
+     * @return QString Строка в формате "ID. Имя (Оценка: X) — Преподаватель"
+     */
+    QString toString() const;
+
+    /**
+     * @brief Сравнить записи по всем полям
+     * @param other Другая запись
+     * @return bool true если все поля совпадают
+     */
+    bool operator==(const RosterEntry &other) const;
+
+    /**
+     * @brief Проверить, отличаются ли записи
+     * @param other Другая запись
+     * @return bool true если хотя бы одно поле отличается
+     */
+    bool operator!=(const RosterEntry &other) const;
+};
+
+#endif // ROSTERENTRY_H
@@ -0,0 +1,360 @@
+/**
+ * @file SchemaMigrator.cpp
+ * @brief Реализация класса SchemaMigrator
+ * @ingroup Models
+ */
+
+#include "SchemaMigrator.h"
+#include "PostgresStorage.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSqlError>
+#include <QSqlQuery>
+
+/**
+ * @brief Ключ advisory-блокировки миграций
+ */
+static constexpr qint64 MIGRATION_LOCK_KEY = 0x756E6976;
+
+/**
+ * @brief Таблицы с данными приложения
+ */
+static const QStringList TABLES = {"teachers", "students", "subjects"};
+
+/**
+ * @brief Конструктор
+ * @param db Открытое соединение
+ */
+SchemaMigrator::SchemaMigrator(const QSqlDatabase &db)
+    : m_db(db)
+{
+}
+
+/**
+ * @brief Применение недостающих миграций
+ * @return bool Результат
+ */
+bool SchemaMigrator::migrate()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const int current = currentVersion();
+    const int latest = latestVersion();
+    if (current >= latest) {
+        if (current > latest) {
+            qWarning() << "Версия схемы" << current << "новее приложения" << latest;
+        }
+        qDebug() << "Схема актуальна, версия" << current;
+        return true;
+    }
+
+    QSqlQuery query(m_db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS schema_version ("
+                    "version INTEGER PRIMARY KEY, "
+                    "description TEXT NOT NULL, "
+                    "applied_at TIMESTAMPTZ NOT NULL DEFAULT now())")) {
+        m_lastError = query.lastError().text();
+        qWarning() << "Не удалось создать schema_version:" << m_lastError;
+        return false;
+    }
+
+    for (const Migration &migration : migrations()) {
+        if (migration.version > current && !apply(migration)) {
+            qWarning() << "Миграция" << migration.version << "не применена:" << m_lastError;
+            return false;
+        }
+    }
+
+    qDebug() << "Схема обновлена с версии" << current << "до" << latest
+             << "за" << timer.elapsed() << "мс";
+    return true;
+}
+
+/**
+ * @brief Получение версии схемы
+ * @return int Номер версии
+ *
+ * @details До первой миграции таблицы schema_version нет, запрос
+ * завершается ошибкой и версия считается нулевой
+ */
+int SchemaMigrator::currentVersion() const
+{
+    QSqlQuery query(m_db);
+    if (query.exec("SELECT COALESCE(MAX(version), 0) FROM schema_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+/**
+ * @brief Получение текста последней ошибки
+ * @return QString Текст ошибки
+ */
+QString SchemaMigrator::lastError() const
+{
+    return m_lastError;
+}
+
+/**
+ * @brief Получение ожидаемой версии схемы
+ * @return int Номер последней миграции
+ */
+int SchemaMigrator::latestVersion()
+{
+    return migrations().isEmpty() ? 0 : migrations().last().version;
+}
+
+/**
+ * @brief Применение одной миграции
+ * @param migration Миграция
+ * @return bool Результат
+ *
+ * @details Версия перепроверяется после взятия блокировки: ее мог
+ * применить другой клиент, пока этот ждал
+ */
+bool SchemaMigrator::apply(const Migration &migration)
+{
+    if (!m_db.transaction()) {
+        m_lastError = m_db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(m_db);
+    bool ok = query.exec(QString("SELECT pg_advisory_xact_lock(%1)").arg(MIGRATION_LOCK_KEY));
+
+    if (ok) {
+        query.prepare("SELECT 1 FROM schema_version WHERE version = ?");
+        query.bindValue(0, migration.version);
+        ok = query.exec();
+        if (ok && query.next()) {
+            return m_db.commit();
+        }
+    }
+
+    for (int i = 0; ok && i < migration.statements.size(); ++i) {
+        ok = query.exec(migration.statements.at(i));
+    }
+
+    if (ok) {
+        query.prepare("INSERT INTO schema_version (version, description) VALUES (?, ?)");
+        query.bindValue(0, migration.version);
+        query.bindValue(1, migration.description);
+        ok = query.exec();
+    }
+
+    if (!ok) {
+        m_lastError = query.lastError().text();
+        m_db.rollback();
+        return false;
+    }
+
+    if (!m_db.commit()) {
+        m_lastError = m_db.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Применена миграция" << migration.version << "-" << migration.description;
+    return true;
+}
+
+/**
+ * @brief Получение списка миграций
+ * @return const QList<Migration>& Миграции
+ */
+const QList<SchemaMigrator::Migration> &SchemaMigrator::migrations()
+{
+    static const QList<Migration> list = []() {
+        QList<Migration> result;
+
+        // Таблицы могли быть созданы до появления миграций
+        result.append({1, "Базовые таблицы", {
+            "CREATE TABLE IF NOT EXISTS teachers ("
+            "id SERIAL PRIMARY KEY, "
+            "full_name VARCHAR(100) NOT NULL, "
+            "department VARCHAR(100) NOT NULL)",
+            "CREATE TABLE IF NOT EXISTS students ("
+            "id SERIAL PRIMARY KEY, "
+            "full_name VARCHAR(100) NOT NULL, "
+            "grade INTEGER CHECK (grade >= 1 AND grade <= 5))",
+            "CREATE TABLE IF NOT EXISTS subjects ("
+            "id SERIAL PRIMARY KEY, "
+            "name VARCHAR(100) NOT NULL)"
+        }});
+
+        // Уведомления об изменениях строк для других клиентов
+        Migration notify{2, "Уведомления об изменениях строк", {
+            QString("CREATE OR REPLACE FUNCTION university_notify_change() RETURNS trigger AS $$ "
+                    "BEGIN "
+                    "PERFORM pg_notify('%1', json_build_object("
+                    "'table', TG_TABLE_NAME, "
+                    "'op', TG_OP, "
+                    "'id', CASE WHEN TG_OP = 'DELETE' THEN OLD.id ELSE NEW.id END)::text); "
+                    "RETURN NULL; "
+                    "END; $$ LANGUAGE plpgsql").arg(QString::fromLatin1(PostgresStorage::CHANGE_CHANNEL))
+        }};
+        for (const QString &table : TABLES) {
+            notify.statements.append(QString("DROP TRIGGER IF EXISTS %1_notify_change ON %1").arg(table));
+            notify.statements.append(QString("CREATE TRIGGER %1_notify_change "
+                                             "AFTER INSERT OR UPDATE OR DELETE ON %1 "
+                                             "FOR EACH ROW EXECUTE FUNCTION university_notify_change()").arg(table));
+        }
+        result.append(notify);
+
+        // Счетчики строк по таблицам переходов. Переходные таблицы допускаются
+        // только в триггерах одного события, поэтому триггеров три на таблицу.
+        // Таблицы блокируются от записи, чтобы ни одна строка не прошла мимо счетчика.
+        Migration counters{3, "Счетчики строк", {
+            "CREATE TABLE IF NOT EXISTS university_stats ("
+            "table_name VARCHAR(63) PRIMARY KEY, "
+            "row_count BIGINT NOT NULL)",
+            "CREATE OR REPLACE FUNCTION university_count_rows() RETURNS trigger AS $$ "
+            "BEGIN "
+            "IF TG_OP = 'INSERT' THEN "
+            "UPDATE university_stats SET row_count = row_count + (SELECT COUNT(*) FROM new_rows) "
+            "WHERE table_name = TG_TABLE_NAME; "
+            "ELSIF TG_OP = 'DELETE' THEN "
+            "UPDATE university_stats SET row_count = row_count - (SELECT COUNT(*) FROM old_rows) "
+            "WHERE table_name = TG_TABLE_NAME; "
+            "ELSE "
+            "UPDATE university_stats SET row_count = 0 WHERE table_name = TG_TABLE_NAME; "
+            "END IF; "
+            "RETURN NULL; "
+            "END; $$ LANGUAGE plpgsql",
+            "LOCK TABLE teachers, students, subjects IN SHARE ROW EXCLUSIVE MODE"
+        }};
+        for (const QString &table : TABLES) {
+            counters.statements.append(QString("DROP TRIGGER IF EXISTS %1_count_insert ON %1").arg(table));
+            counters.statements.append(QString("DROP TRIGGER IF EXISTS %1_count_delete ON %1").arg(table));
+            counters.statements.append(QString("DROP TRIGGER IF EXISTS %1_count_truncate ON %1").arg(table));
+            counters.statements.append(QString("CREATE TRIGGER %1_count_insert AFTER INSERT ON %1 "
+                                               "REFERENCING NEW TABLE AS new_rows "
+                                               "FOR EACH STATEMENT EXECUTE FUNCTION university_count_rows()").arg(table));
+            counters.statements.append(QString("CREATE TRIGGER %1_count_delete AFTER DELETE ON %1 "
+                                               "REFERENCING OLD TABLE AS old_rows "
+                                               "FOR EACH STATEMENT EXECUTE FUNCTION university_count_rows()").arg(table));
+            counters.statements.append(QString("CREATE TRIGGER %1_count_truncate AFTER TRUNCATE ON %1 "
+                                               "FOR EACH STATEMENT EXECUTE FUNCTION university_count_rows()").arg(table));
+            counters.statements.append(QString("INSERT INTO university_stats (table_name, row_count) "
+                                               "SELECT '%1', COUNT(*) FROM %1 "
+                                               "ON CONFLICT (table_name) DO UPDATE SET row_count = EXCLUDED.row_count").arg(table));
+        }
+        result.append(counters);
+
+        // Без прав на расширение поиск работает через ILIKE, поэтому ошибка
+        // CREATE EXTENSION не должна откатывать миграцию
+        result.append({4, "Триграммные индексы для поиска", {
+            "DO $$ BEGIN "
+            "CREATE EXTENSION IF NOT EXISTS pg_trgm; "
+            "EXCEPTION WHEN OTHERS THEN RAISE NOTICE 'pg_trgm недоступен: %', SQLERRM; "
+            "END $$",
+            "DO $$ BEGIN "
+            "IF EXISTS (SELECT 1 FROM pg_extension WHERE extname = 'pg_trgm') THEN "
+            "CREATE INDEX IF NOT EXISTS teachers_full_name_trgm ON teachers USING gin (full_name gin_trgm_ops); "
+            "CREATE INDEX IF NOT EXISTS teachers_department_trgm ON teachers USING gin (department gin_trgm_ops); "
+            "CREATE INDEX IF NOT EXISTS students_full_name_trgm ON students USING gin (full_name gin_trgm_ops); "
+            "CREATE INDEX IF NOT EXISTS subjects_name_trgm ON subjects USING gin (name gin_trgm_ops); "
+            "END IF; "
+            "END $$"
+        }});
+
+        // Индексы для фильтров и сортировок без учета регистра
+        result.append({5, "Индексы по кафедре, оценке и имени", {
+            "CREATE INDEX IF NOT EXISTS teachers_department_idx ON teachers (department)",
+            "CREATE INDEX IF NOT EXISTS students_grade_idx ON students (grade)",
+            "CREATE INDEX IF NOT EXISTS teachers_lower_full_name_idx ON teachers (lower(full_name))",
+            "CREATE INDEX IF NOT EXISTS students_lower_full_name_idx ON students (lower(full_name))",
+            "CREATE INDEX IF NOT EXISTS subjects_lower_name_idx ON subjects (lower(name))"
+        }});
+
+        // Связи студентов и преподавателей с предметами. Первичные ключи
+        // начинаются с subject_id и покрывают чтение состава предмета,
+        // индексы по второму столбцу покрывают обратное чтение и каскадное
+        // удаление. Составы предметов заранее собраны в subject_rosters;
+        // уникальный индекс нужен для REFRESH MATERIALIZED VIEW CONCURRENTLY
+        // и покрывает выборку по subject_id без обращения к таблице.
+        result.append({6, "Записи на предметы, назначения и составы предметов", {
+            "CREATE TABLE IF NOT EXISTS enrollments ("
+            "subject_id INTEGER NOT NULL REFERENCES subjects (id) ON DELETE CASCADE, "
+            "student_id INTEGER NOT NULL REFERENCES students (id) ON DELETE CASCADE, "
+            "grade INTEGER CHECK (grade >= 1 AND grade <= 5), "
+            "PRIMARY KEY (subject_id, student_id) INCLUDE (grade))",
+            "CREATE INDEX IF NOT EXISTS enrollments_student_idx "
+            "ON enrollments (student_id) INCLUDE (subject_id, grade)",
+            "CREATE TABLE IF NOT EXISTS assignments ("
+            "subject_id INTEGER NOT NULL REFERENCES subjects (id) ON DELETE CASCADE, "
+            "teacher_id INTEGER NOT NULL REFERENCES teachers (id) ON DELETE CASCADE, "
+            "PRIMARY KEY (subject_id, teacher_id))",
+            "CREATE INDEX IF NOT EXISTS assignments_teacher_idx "
+            "ON assignments (teacher_id) INCLUDE (subject_id)",
+            "CREATE MATERIALIZED VIEW IF NOT EXISTS subject_rosters AS "
+            "SELECT e.subject_id, e.student_id, s.full_name AS student_name, "
+            "COALESCE(e.grade, 0) AS grade, "
+            "COALESCE(a.teacher_id, 0) AS teacher_id, "
+            "COALESCE(t.full_name, '') AS teacher_name "
+            "FROM enrollments e "
+            "JOIN students s ON s.id = e.student_id "
+            "LEFT JOIN assignments a ON a.subject_id = e.subject_id "
+            "LEFT JOIN teachers t ON t.id = a.teacher_id",
+            "CREATE UNIQUE INDEX IF NOT EXISTS subject_rosters_key "
+            "ON subject_rosters (subject_id, student_id, teacher_id) "
+            "INCLUDE (student_name, grade, teacher_name)"
+        }});
+
+        // Уведомления по операторам вместо строк: импорт COPY на миллион строк
+        // отправлял миллион NOTIFY. Переходные таблицы допускаются только
+        // в триггерах одного события, поэтому триггеров три на таблицу.
+        // Оператор больше NOTIFY_ROW_LIMIT строк сообщается подсказкой reload.
+        // Изменения и удаления студентов несут прежние оценки для аналитики.
+        Migration statementNotify{7, "Уведомления об изменениях по операторам", {
+            QString("CREATE OR REPLACE FUNCTION university_notify_changes() RETURNS trigger AS $$ "
+                    "DECLARE "
+                    "changed_ids INTEGER[]; "
+                    "old_grades INTEGER[]; "
+                    "BEGIN "
+                    "IF TG_OP = 'INSERT' THEN "
+                    "SELECT array_agg(id ORDER BY id) INTO changed_ids FROM (SELECT id FROM new_rows LIMIT %2) t; "
+                    "ELSIF TG_TABLE_NAME = 'students' THEN "
+                    "SELECT array_agg(id ORDER BY id), array_agg(COALESCE(grade, 0) ORDER BY id) "
+                    "INTO changed_ids, old_grades FROM (SELECT id, grade FROM old_rows LIMIT %2) t; "
+                    "ELSE "
+                    "SELECT array_agg(id ORDER BY id) INTO changed_ids FROM (SELECT id FROM old_rows LIMIT %2) t; "
+                    "END IF; "
+                    "IF changed_ids IS NULL THEN "
+                    "RETURN NULL; "
+                    "END IF; "
+                    "IF cardinality(changed_ids) > %3 THEN "
+                    "PERFORM pg_notify('%1', json_build_object("
+                    "'table', TG_TABLE_NAME, 'op', TG_OP, 'reload', true)::text); "
+                    "ELSE "
+                    "PERFORM pg_notify('%1', json_build_object("
+                    "'table', TG_TABLE_NAME, 'op', TG_OP, 'ids', changed_ids, 'grades', old_grades)::text); "
+                    "END IF; "
+                    "RETURN NULL; "
+                    "END; $$ LANGUAGE plpgsql")
+                .arg(QString::fromLatin1(PostgresStorage::CHANGE_CHANNEL))
+                .arg(PostgresStorage::NOTIFY_ROW_LIMIT + 1)
+                .arg(PostgresStorage::NOTIFY_ROW_LIMIT)
+        }};
+        for (const QString &table : TABLES) {
+            statementNotify.statements.append(QString("DROP TRIGGER IF EXISTS %1_notify_change ON %1").arg(table));
+            statementNotify.statements.append(QString("DROP TRIGGER IF EXISTS %1_notify_insert ON %1").arg(table));
+            statementNotify.statements.append(QString("DROP TRIGGER IF EXISTS %1_notify_update ON %1").arg(table));
+            statementNotify.statements.append(QString("DROP TRIGGER IF EXISTS %1_notify_delete ON %1").arg(table));
+            statementNotify.statements.append(QString("CREATE TRIGGER %1_notify_insert AFTER INSERT ON %1 "
+                                                      "REFERENCING NEW TABLE AS new_rows "
+                                                      "FOR EACH STATEMENT EXECUTE FUNCTION university_notify_changes()").arg(table));
+            statementNotify.statements.append(QString("CREATE TRIGGER %1_notify_update AFTER UPDATE ON %1 "
+                                                      "REFERENCING OLD TABLE AS old_rows NEW TABLE AS new_rows "
+                                                      "FOR EACH STATEMENT EXECUTE FUNCTION university_notify_changes()").arg(table));
+            statementNotify.statements.append(QString("CREATE TRIGGER %1_notify_delete AFTER DELETE ON %1 "
+                                                      "REFERENCING OLD TABLE AS old_rows "
+                                                      "FOR EACH STATEMENT EXECUTE FUNCTION university_notify_changes()").arg(table));
+        }
+        statementNotify.statements.append("DROP FUNCTION IF EXISTS university_notify_change()");
+        result.append(statementNotify);
+
+        return result;
+    }();
+    return list;
+}
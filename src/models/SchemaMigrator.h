@@ -0,0 +1,91 @@
+/**
+ * @file SchemaMigrator.h
+ * @brief Заголовочный файл класса SchemaMigrator
+ * @ingroup Models
+ *
+ * @class SchemaMigrator
+ * @brief Версионные миграции схемы базы данных
+ *
+ * Примененные миграции записываются в таблицу schema_version. При запуске
+ * читается только номер текущей версии: если схема актуальна, больше
+ * никаких DDL запросов не выполняется.
+ *
+ * Каждая миграция применяется в своей транзакции под advisory-блокировкой,
+ * поэтому несколько клиентов, запущенных одновременно, не применят ее дважды.
+ * Ошибка откатывает миграцию целиком и останавливает последующие.
+ *
+ * Новые изменения схемы добавляются только новой миграцией в конец
+ * списка migrations(): уже примененные миграции не перезапускаются.
+ */
+
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class SchemaMigrator
+{
+public:
+    /**
+     * @struct Migration
+     * @brief Одна миграция схемы
+     */
+    struct Migration
+    {
+        int version = 0;        ///< Номер версии, строго возрастает
+        QString description;    ///< Описание для schema_version и лога
+        QStringList statements; ///< SQL команды в порядке выполнения
+    };
+
+    /**
+     * @brief Конструктор
+     * @param db Открытое соединение
+     */
+    explicit SchemaMigrator(const QSqlDatabase &db);
+
+    /**
+     * @brief Применить недостающие миграции
+     * @return bool true если схема актуальна
+     */
+    bool migrate();
+
+    /**
+     * @brief Получить версию схемы в БД
+     * @return int Номер последней примененной миграции или 0
+     */
+    int currentVersion() const;
+
+    /**
+     * @brief Получить текст последней ошибки
+     * @return QString Текст ошибки
+     */
+    QString lastError() const;
+
+    /**
+     * @brief Получить версию схемы, которую ожидает приложение
+     * @return int Номер последней миграции
+     */
+    static int latestVersion();
+
+    /**
+     * @brief Получить список миграций
+     * @return const QList<Migration>& Миграции по возрастанию версии
+     */
+    static const QList<Migration> &migrations();
+
+private:
+    /**
+     * @brief Применить одну миграцию в транзакции
+     * @param migration Миграция
+     * @return bool true если миграция применена или уже была применена
+     */
+    bool apply(const Migration &migration);
+
+    QSqlDatabase m_db;      ///< Соединение
+    QString m_lastError;    ///< Последняя ошибка
+};
+
+#endif // SCHEMAMIGRATOR_H
@@ -0,0 +1,798 @@
+/**
+ * @file SqlStorage.cpp
+ * @brief Реализация класса SqlStorage
+ * @ingroup Models
+ */
+
+#include "SqlStorage.h"
+#include "QueryMetrics.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSqlError>
+
+/**
+ * @brief Конструктор SqlStorage
+ * @param settings Параметры подключения
+ * @param parent Родительский QObject
+ *
+ * @details Соединения открываются при первом обращении из каждого потока:
+ * QSqlDatabase можно использовать только в том потоке, где оно было создано.
+ */
+SqlStorage::SqlStorage(const ConnectionSettings &settings, QObject *parent)
+    : StorageBackend(parent)
+    , m_pool(new ConnectionPool(settings, this))
+{
+}
+
+/**
+ * @brief Получение текста последней ошибки
+ * @return QString Текст ошибки
+ */
+QString SqlStorage::lastError() const
+{
+    return m_pool->lastError();
+}
+
+/**
+ * @brief Получение пула соединений
+ * @return ConnectionPool* Пул соединений
+ */
+ConnectionPool *SqlStorage::connectionPool() const
+{
+    return m_pool;
+}
+
+/**
+ * @brief Получение соединения текущего потока
+ * @return QSqlDatabase Соединение из пула
+ */
+QSqlDatabase SqlStorage::database() const
+{
+    return m_pool->database();
+}
+
+/**
+ * @brief Получение подготовленного запроса из кэша соединения
+ * @param sql Текст запроса
+ * @return QSqlQuery* Запрос или nullptr при ошибке
+ */
+QSqlQuery *SqlStorage::statement(const QString &sql) const
+{
+    return m_pool->statement(sql);
+}
+
+/**
+ * @brief Выполнение запроса с журналом медленных запросов
+ * @param query Запрос
+ * @param sql Текст запроса или пустая строка
+ * @return bool Результат выполнения
+ */
+bool SqlStorage::exec(QSqlQuery &query, const QString &sql) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = sql.isEmpty() ? query.exec() : query.exec(sql);
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+    if (metrics()->isSlow(elapsedUs)) {
+        metrics()->logSlowQuery(query.lastQuery(), query.boundValues(), elapsedUs);
+    }
+    return ok;
+}
+
+/**
+ * @brief Выполнение пакетного запроса с журналом медленных запросов
+ * @param query Запрос
+ * @return bool Результат выполнения
+ *
+ * @details Для пакета в лог пишется только количество строк
+ * первого столбца, а не сами значения
+ */
+bool SqlStorage::execBatch(QSqlQuery &query) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = query.execBatch();
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+    if (metrics()->isSlow(elapsedUs)) {
+        const QVariantList values = query.boundValues();
+        const qsizetype rows = values.isEmpty() ? 0 : values.first().toList().size();
+        metrics()->logSlowQuery(query.lastQuery(), {QString("%1 строк").arg(rows)}, elapsedUs);
+    }
+    return ok;
+}
+
+/**
+ * @brief Получение списка всех преподавателей
+ * @return QList<TeacherRecord> Записи в порядке возрастания id
+ * 
+ * @details Записи хранятся в одном непрерывном буфере без отдельного
+ * выделения памяти на строку. Курсор только вперед избавляет драйвер
+ * от хранения прокручиваемой копии результата.
+ */
+QList<TeacherRecord> SqlStorage::getAllTeachers() const
+{
+    QList<TeacherRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, department FROM teachers ORDER BY id");
+    if (!query) {
+        return records;
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки teachers:" << query->lastError().text();
+        return records;
+    }
+    
+    if (query->size() > 0) {
+        records.reserve(query->size());
+    }
+    while (query->next()) {
+        records.append(TeacherRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Получение страницы преподавателей
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<TeacherRecord> Записи с id больше afterId в порядке возрастания id
+ * 
+ * @details Keyset-пагинация: WHERE id > :last ORDER BY id LIMIT :n использует
+ * индекс первичного ключа, поэтому стоимость страницы не зависит от ее номера
+ */
+QList<TeacherRecord> SqlStorage::getTeachersPage(int afterId, int limit) const
+{
+    QList<TeacherRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, department FROM teachers WHERE id > ? ORDER BY id LIMIT ?");
+    if (!query) {
+        return records;
+    }
+    query->bindValue(0, afterId);
+    query->bindValue(1, limit);
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки страницы teachers:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(TeacherRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Добавление нового преподавателя
+ * @param fullName Полное имя преподавателя
+ * @param department Кафедра преподавателя
+ * @return TeacherRecord Добавленная запись или невалидная запись при ошибке
+ * 
+ * @details Использует INSERT ... RETURNING, поэтому добавленная строка
+ * возвращается за тот же запрос, без повторного чтения таблицы
+ */
+TeacherRecord SqlStorage::addTeacher(const QString &fullName, const QString &department)
+{
+    QSqlQuery *query = statement("INSERT INTO teachers (full_name, department) VALUES (?, ?) "
+                                 "RETURNING id, full_name, department");
+    if (!query) {
+        return TeacherRecord();
+    }
+    query->bindValue(0, fullName);
+    query->bindValue(1, department);
+    
+    TeacherRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        };
+    }
+    // SQLite фиксирует автотранзакцию только после сброса запроса
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Удаление преподавателя по ID
+ * @param id Идентификатор преподавателя
+ * @return int Идентификатор удаленной записи или 0 если запись не найдена
+ */
+int SqlStorage::deleteTeacher(int id)
+{
+    QSqlQuery *query = statement("DELETE FROM teachers WHERE id = ? RETURNING id");
+    if (!query) {
+        return 0;
+    }
+    query->bindValue(0, id);
+    
+    int deletedId = 0;
+    if (exec(*query) && query->next()) {
+        deletedId = query->value(0).toInt();
+    }
+    query->finish();
+    return deletedId;
+}
+
+/**
+ * @brief Поиск преподавателя по ID
+ * @param id Идентификатор преподавателя
+ * @return TeacherRecord Найденная запись или невалидная запись
+ */
+TeacherRecord SqlStorage::getTeacherById(int id) const
+{
+    QSqlQuery *query = statement("SELECT id, full_name, department FROM teachers WHERE id = ?");
+    if (!query) {
+        return TeacherRecord();
+    }
+    query->bindValue(0, id);
+    
+    TeacherRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toString()
+        };
+    }
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Получение списка всех студентов
+ * @return QList<StudentRecord> Записи в порядке возрастания id
+ * 
+ * @details Записи хранятся в одном непрерывном буфере без отдельного
+ * выделения памяти на строку. Курсор только вперед избавляет драйвер
+ * от хранения прокручиваемой копии результата.
+ */
+QList<StudentRecord> SqlStorage::getAllStudents() const
+{
+    QList<StudentRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, grade FROM students ORDER BY id");
+    if (!query) {
+        return records;
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки students:" << query->lastError().text();
+        return records;
+    }
+    
+    if (query->size() > 0) {
+        records.reserve(query->size());
+    }
+    while (query->next()) {
+        records.append(StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Получение страницы студентов
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<StudentRecord> Записи с id больше afterId в порядке возрастания id
+ * 
+ * @details Keyset-пагинация: WHERE id > :last ORDER BY id LIMIT :n использует
+ * индекс первичного ключа, поэтому стоимость страницы не зависит от ее номера
+ */
+QList<StudentRecord> SqlStorage::getStudentsPage(int afterId, int limit) const
+{
+    QList<StudentRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, grade FROM students WHERE id > ? ORDER BY id LIMIT ?");
+    if (!query) {
+        return records;
+    }
+    query->bindValue(0, afterId);
+    query->bindValue(1, limit);
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки страницы students:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Добавление нового студента
+ * @param fullName Полное имя студента
+ * @param grade Оценка студента
+ * @return StudentRecord Добавленная запись или невалидная запись при ошибке
+ * 
+ * @details Использует INSERT ... RETURNING, поэтому добавленная строка
+ * возвращается за тот же запрос, без повторного чтения таблицы
+ */
+StudentRecord SqlStorage::addStudent(const QString &fullName, int grade)
+{
+    QSqlQuery *query = statement("INSERT INTO students (full_name, grade) VALUES (?, ?) "
+                                 "RETURNING id, full_name, grade");
+    if (!query) {
+        return StudentRecord();
+    }
+    query->bindValue(0, fullName);
+    query->bindValue(1, grade);
+    
+    StudentRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        };
+    }
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Удаление студента по ID
+ * @param id Идентификатор студента
+ * @return StudentRecord Удаленная запись или невалидная запись, если запись не найдена
+ */
+StudentRecord SqlStorage::deleteStudent(int id)
+{
+    QSqlQuery *query = statement("DELETE FROM students WHERE id = ? RETURNING id, full_name, grade");
+    if (!query) {
+        return StudentRecord();
+    }
+    query->bindValue(0, id);
+    
+    StudentRecord record;
+    if (exec(*query) && query->next()) {
+        record = StudentRecord{
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        };
+    }
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Поиск студента по ID
+ * @param id Идентификатор студента
+ * @return StudentRecord Найденная запись или невалидная запись
+ */
+StudentRecord SqlStorage::getStudentById(int id) const
+{
+    QSqlQuery *query = statement("SELECT id, full_name, grade FROM students WHERE id = ?");
+    if (!query) {
+        return StudentRecord();
+    }
+    query->bindValue(0, id);
+    
+    StudentRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString(),
+            query->value(2).toInt()
+        };
+    }
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Получение распределения оценок и крайних студентов
+ * @param limit Сколько студентов вернуть с каждого края
+ * @return GradeSummary Гистограмма и крайние студенты
+ *
+ * @details Студенты без оценки исключаются явно: в PostgreSQL NULL
+ * при сортировке по убыванию идут первыми
+ */
+GradeSummary SqlStorage::getGradeSummary(int limit) const
+{
+    GradeSummary summary;
+    QSqlQuery *query = statement("SELECT grade, COUNT(*) FROM students "
+                                 "WHERE grade BETWEEN 1 AND 5 GROUP BY grade");
+    if (!query) {
+        return summary;
+    }
+
+    if (exec(*query)) {
+        while (query->next()) {
+            summary.histogram[query->value(0).toInt() - 1] = query->value(1).toLongLong();
+        }
+    } else {
+        qWarning() << "Ошибка подсчета оценок:" << query->lastError().text();
+    }
+    query->finish();
+
+    summary.top = readStudents("SELECT id, full_name, grade FROM students WHERE grade BETWEEN 1 AND 5 "
+                               "ORDER BY grade DESC, id LIMIT ?", limit);
+    summary.bottom = readStudents("SELECT id, full_name, grade FROM students WHERE grade BETWEEN 1 AND 5 "
+                                  "ORDER BY grade, id LIMIT ?", limit);
+    return summary;
+}
+
+/**
+ * @brief Чтение студентов запросом с LIMIT
+ * @param sql Текст запроса
+ * @param limit Значение LIMIT
+ * @return QList<StudentRecord> Записи в порядке запроса
+ */
+QList<StudentRecord> SqlStorage::readStudents(const QString &sql, int limit) const
+{
+    QList<StudentRecord> records;
+    QSqlQuery *query = statement(sql);
+    if (!query) {
+        return records;
+    }
+    query->bindValue(0, limit);
+
+    if (exec(*query)) {
+        while (query->next()) {
+            records.append(StudentRecord{
+                query->value(0).toInt(),
+                query->value(1).toString(),
+                query->value(2).toInt()
+            });
+        }
+    } else {
+        qWarning() << "Ошибка чтения студентов по оценке:" << query->lastError().text();
+    }
+    query->finish();
+    return records;
+}
+
+/**
+ * @brief Получение списка всех предметов
+ * @return QList<SubjectRecord> Записи в порядке возрастания id
+ * 
+ * @details Записи хранятся в одном непрерывном буфере без отдельного
+ * выделения памяти на строку. Курсор только вперед избавляет драйвер
+ * от хранения прокручиваемой копии результата.
+ */
+QList<SubjectRecord> SqlStorage::getAllSubjects() const
+{
+    QList<SubjectRecord> records;
+    QSqlQuery *query = statement("SELECT id, name FROM subjects ORDER BY id");
+    if (!query) {
+        return records;
+    }
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки subjects:" << query->lastError().text();
+        return records;
+    }
+    
+    if (query->size() > 0) {
+        records.reserve(query->size());
+    }
+    while (query->next()) {
+        records.append(SubjectRecord{
+            query->value(0).toInt(),
+            query->value(1).toString()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Получение страницы предметов
+ * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+ * @param limit Максимальное количество записей на странице
+ * @return QList<SubjectRecord> Записи с id больше afterId в порядке возрастания id
+ * 
+ * @details Keyset-пагинация: WHERE id > :last ORDER BY id LIMIT :n использует
+ * индекс первичного ключа, поэтому стоимость страницы не зависит от ее номера
+ */
+QList<SubjectRecord> SqlStorage::getSubjectsPage(int afterId, int limit) const
+{
+    QList<SubjectRecord> records;
+    QSqlQuery *query = statement("SELECT id, name FROM subjects WHERE id > ? ORDER BY id LIMIT ?");
+    if (!query) {
+        return records;
+    }
+    query->bindValue(0, afterId);
+    query->bindValue(1, limit);
+    
+    if (!exec(*query)) {
+        qWarning() << "Ошибка загрузки страницы subjects:" << query->lastError().text();
+        return records;
+    }
+    
+    records.reserve(limit);
+    while (query->next()) {
+        records.append(SubjectRecord{
+            query->value(0).toInt(),
+            query->value(1).toString()
+        });
+    }
+    // Освобождаем результат, сам запрос остается в кэше
+    query->finish();
+    
+    return records;
+}
+
+/**
+ * @brief Добавление нового предмета
+ * @param name Название предмета
+ * @return SubjectRecord Добавленная запись или невалидная запись при ошибке
+ * 
+ * @details Использует INSERT ... RETURNING, поэтому добавленная строка
+ * возвращается за тот же запрос, без повторного чтения таблицы
+ */
+SubjectRecord SqlStorage::addSubject(const QString &name)
+{
+    QSqlQuery *query = statement("INSERT INTO subjects (name) VALUES (?) "
+                                 "RETURNING id, name");
+    if (!query) {
+        return SubjectRecord();
+    }
+    query->bindValue(0, name);
+    
+    SubjectRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString()
+        };
+    }
+    query->finish();
+    return record;
+}
+
+/**
+ * @brief Удаление предмета по ID
+ * @param id Идентификатор предмета
+ * @return int Идентификатор удаленной записи или 0 если запись не найдена
+ */
+int SqlStorage::deleteSubject(int id)
+{
+    QSqlQuery *query = statement("DELETE FROM subjects WHERE id = ? RETURNING id");
+    if (!query) {
+        return 0;
+    }
+    query->bindValue(0, id);
+    
+    int deletedId = 0;
+    if (exec(*query) && query->next()) {
+        deletedId = query->value(0).toInt();
+    }
+    query->finish();
+    return deletedId;
+}
+
+/**
+ * @brief Запись студента на предмет
+ * @param studentId Идентификатор студента
+ * @param subjectId Идентификатор предмета
+ * @param grade Оценка или 0
+ * @return bool Результат операции
+ *
+ * @details Повторная запись меняет только оценку. Синтаксис ON CONFLICT
+ * одинаков в PostgreSQL и SQLite 3.24+
+ */
+bool SqlStorage::enrollStudent(int studentId, int subjectId, int grade)
+{
+    QSqlQuery *query = statement("INSERT INTO enrollments (subject_id, student_id, grade) VALUES (?, ?, ?) "
+                                 "ON CONFLICT (subject_id, student_id) DO UPDATE SET grade = excluded.grade");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, subjectId);
+    query->bindValue(1, studentId);
+    query->bindValue(2, grade > 0 ? QVariant(grade) : QVariant(QMetaType::fromType<int>()));
+
+    const bool ok = exec(*query);
+    if (!ok) {
+        qWarning() << "Ошибка записи студента" << studentId << "на предмет" << subjectId
+                   << ":" << query->lastError().text();
+    }
+    query->finish();
+    return ok;
+}
+
+/**
+ * @brief Назначение преподавателя на предмет
+ * @param teacherId Идентификатор преподавателя
+ * @param subjectId Идентификатор предмета
+ * @return bool Результат операции
+ */
+bool SqlStorage::assignTeacher(int teacherId, int subjectId)
+{
+    QSqlQuery *query = statement("INSERT INTO assignments (subject_id, teacher_id) VALUES (?, ?) "
+                                 "ON CONFLICT (subject_id, teacher_id) DO NOTHING");
+    if (!query) {
+        return false;
+    }
+    query->bindValue(0, subjectId);
+    query->bindValue(1, teacherId);
+
+    const bool ok = exec(*query);
+    if (!ok) {
+        qWarning() << "Ошибка назначения преподавателя" << teacherId << "на предмет" << subjectId
+                   << ":" << query->lastError().text();
+    }
+    query->finish();
+    return ok;
+}
+
+/**
+ * @brief Получение состава предмета
+ * @param subjectId Идентификатор предмета
+ * @return QList<RosterEntry> Строки состава
+ */
+QList<RosterEntry> SqlStorage::getSubjectRoster(int subjectId) const
+{
+    return readRoster("SELECT e.subject_id, e.student_id, s.full_name, COALESCE(e.grade, 0), "
+                      "COALESCE(a.teacher_id, 0) AS teacher_id, COALESCE(t.full_name, '') "
+                      "FROM enrollments e "
+                      "JOIN students s ON s.id = e.student_id "
+                      "LEFT JOIN assignments a ON a.subject_id = e.subject_id "
+                      "LEFT JOIN teachers t ON t.id = a.teacher_id "
+                      "WHERE e.subject_id = ? "
+                      "ORDER BY e.student_id, teacher_id",
+                      subjectId);
+}
+
+/**
+ * @brief Чтение состава предмета запросом
+ * @param sql Текст запроса
+ * @param subjectId Идентификатор предмета
+ * @return QList<RosterEntry> Строки состава
+ */
+QList<RosterEntry> SqlStorage::readRoster(const QString &sql, int subjectId) const
+{
+    QList<RosterEntry> roster;
+    QSqlQuery *query = statement(sql);
+    if (!query) {
+        return roster;
+    }
+    query->bindValue(0, subjectId);
+
+    if (exec(*query)) {
+        while (query->next()) {
+            roster.append({
+                query->value(0).toInt(),
+                query->value(1).toInt(),
+                query->value(2).toString(),
+                query->value(3).toInt(),
+                query->value(4).toInt(),
+                query->value(5).toString()
+            });
+        }
+    } else {
+        qWarning() << "Ошибка чтения состава предмета" << subjectId << ":" << query->lastError().text();
+    }
+    query->finish();
+    return roster;
+}
+
+/**
+ * @brief Начало транзакции
+ * @return bool Результат операции
+ */
+bool SqlStorage::beginTransaction()
+{
+    QSqlDatabase db = database();
+    if (!db.isOpen() || !db.transaction()) {
+        qWarning() << "Не удалось начать транзакцию:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Фиксация транзакции
+ * @return bool Результат операции
+ */
+bool SqlStorage::commitTransaction()
+{
+    QSqlDatabase db = database();
+    if (!db.commit()) {
+        qWarning() << "Ошибка фиксации транзакции:" << db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Откат транзакции
+ */
+void SqlStorage::rollbackTransaction()
+{
+    database().rollback();
+}
+
+/**
+ * @brief Установка точки сохранения
+ * @return bool Результат операции
+ */
+bool SqlStorage::setSavepoint()
+{
+    QSqlQuery query(database());
+    if (!exec(query, QString("SAVEPOINT %1").arg(SAVEPOINT_NAME))) {
+        qWarning() << "Ошибка SAVEPOINT:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Снятие точки сохранения
+ * @param keep Оставить изменения после точки
+ * @return bool Результат операции
+ *
+ * @details После ROLLBACK TO точка остается, поэтому RELEASE выполняется
+ * в обоих случаях
+ */
+bool SqlStorage::releaseSavepoint(bool keep)
+{
+    QSqlQuery query(database());
+    if (!keep && !exec(query, QString("ROLLBACK TO SAVEPOINT %1").arg(SAVEPOINT_NAME))) {
+        qWarning() << "Ошибка ROLLBACK TO SAVEPOINT:" << query.lastError().text();
+        return false;
+    }
+    if (!exec(query, QString("RELEASE SAVEPOINT %1").arg(SAVEPOINT_NAME))) {
+        qWarning() << "Ошибка RELEASE SAVEPOINT:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Поиск предмета по ID
+ * @param id Идентификатор предмета
+ * @return SubjectRecord Найденная запись или невалидная запись
+ */
+SubjectRecord SqlStorage::getSubjectById(int id) const
+{
+    QSqlQuery *query = statement("SELECT id, name FROM subjects WHERE id = ?");
+    if (!query) {
+        return SubjectRecord();
+    }
+    query->bindValue(0, id);
+    
+    SubjectRecord record;
+    if (exec(*query) && query->next()) {
+        record = {
+            query->value(0).toInt(),
+            query->value(1).toString()
+        };
+    }
+    query->finish();
+    return record;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file SqlStorage.h
+ * @brief Заголовочный файл класса SqlStorage
+ * @ingroup Models
+ *
+ * @class SqlStorage
+ * @brief Общая часть хранилищ на Qt SQL
+ *
+ * Держит ConnectionPool и реализует операции, SQL которых одинаков
+ * в PostgreSQL и SQLite: полное и постраничное чтение, чтение по id,
+ * добавление одной строки через INSERT ... RETURNING и удаление через
+ * DELETE ... RETURNING. Чтение по списку id, пакетная вставка, поиск
+ * и подсчет строк зависят от диалекта и реализуются наследниками.
+ *
+ * Запросы берутся из StatementCache соединения вызывающего потока.
+ */
+
+#ifndef SQLSTORAGE_H
+#define SQLSTORAGE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "ConnectionPool.h"
+#include "StorageBackend.h"
+
+class SqlStorage : public StorageBackend
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Конструктор
+     * @param settings Параметры подключения
+     * @param parent Родительский QObject
+     */
+    explicit SqlStorage(const ConnectionSettings &settings, QObject *parent = nullptr);
+
+    /**
+     * @brief Получить текст последней ошибки пула
+     * @return QString Текст ошибки
+     */
+    QString lastError() const override;
+
+    /**
+     * @brief Получить пул соединений
+     * @return ConnectionPool* Пул хранилища
+     */
+    ConnectionPool *connectionPool() const override;
+
+    /**
+     * @brief Получить всех преподавателей
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     */
+    QList<TeacherRecord> getAllTeachers() const override;
+
+    /**
+     * @brief Получить страницу преподавателей
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<TeacherRecord> Записи страницы
+     */
+    QList<TeacherRecord> getTeachersPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Найти преподавателя по id
+     * @param id Идентификатор
+     * @return TeacherRecord Запись или невалидная запись
+     */
+    TeacherRecord getTeacherById(int id) const override;
+
+    /**
+     * @brief Добавить преподавателя
+     * @param fullName Полное имя
+     * @param department Кафедра
+     * @return TeacherRecord Добавленная запись или невалидная запись
+     */
+    TeacherRecord addTeacher(const QString &fullName, const QString &department) override;
+
+    /**
+     * @brief Удалить преподавателя
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    int deleteTeacher(int id) override;
+
+    /**
+     * @brief Получить всех студентов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     */
+    QList<StudentRecord> getAllStudents() const override;
+
+    /**
+     * @brief Получить страницу студентов
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<StudentRecord> Записи страницы
+     */
+    QList<StudentRecord> getStudentsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Найти студента по id
+     * @param id Идентификатор
+     * @return StudentRecord Запись или невалидная запись
+     */
+    StudentRecord getStudentById(int id) const override;
+
+    /**
+     * @brief Добавить студента
+     * @param fullName Полное имя
+     * @param grade Оценка
+     * @return StudentRecord Добавленная запись или невалидная запись
+     */
+    StudentRecord addStudent(const QString &fullName, int grade) override;
+
+    /**
+     * @brief Удалить студента
+     * @param id Идентификатор
+     * @return StudentRecord Удаленная запись или невалидная запись
+     */
+    StudentRecord deleteStudent(int id) override;
+
+    /**
+     * @brief Получить распределение оценок запросом GROUP BY grade
+     * и крайних студентов запросами ORDER BY grade ... LIMIT
+     * @param limit Сколько студентов вернуть с каждого края
+     * @return GradeSummary Гистограмма и крайние студенты
+     *
+     * @details Все три запроса идут по индексу students_grade_idx
+     * и не читают таблицу целиком в память приложения
+     */
+    GradeSummary getGradeSummary(int limit) const override;
+
+    /**
+     * @brief Получить все предметы
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     */
+    QList<SubjectRecord> getAllSubjects() const override;
+
+    /**
+     * @brief Получить страницу предметов
+     * @param afterId Идентификатор последней загруженной записи
+     * @param limit Максимальное количество записей
+     * @return QList<SubjectRecord> Записи страницы
+     */
+    QList<SubjectRecord> getSubjectsPage(int afterId, int limit) const override;
+
+    /**
+     * @brief Найти предмет по id
+     * @param id Идентификатор
+     * @return SubjectRecord Запись или невалидная запись
+     */
+    SubjectRecord getSubjectById(int id) const override;
+
+    /**
+     * @brief Добавить предмет
+     * @param name Название
+     * @return SubjectRecord Добавленная запись или невалидная запись
+     */
+    SubjectRecord addSubject(const QString &name) override;
+
+    /**
+     * @brief Удалить предмет
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    int deleteSubject(int id) override;
+
+    /**
+     * @brief Записать студента на предмет через INSERT ... ON CONFLICT DO UPDATE
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка или 0
+     * @return bool true если запись сохранена
+     */
+    bool enrollStudent(int studentId, int subjectId, int grade) override;
+
+    /**
+     * @brief Назначить преподавателя через INSERT ... ON CONFLICT DO NOTHING
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return bool true если назначение сохранено или уже было
+     */
+    bool assignTeacher(int teacherId, int subjectId) override;
+
+    /**
+     * @brief Собрать состав предмета соединением enrollments, students,
+     * assignments и teachers
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Строки состава
+     *
+     * @details Чтение начинается с первичного ключа enrollments по subject_id,
+     * поэтому затрагивает только строки предмета
+     */
+    QList<RosterEntry> getSubjectRoster(int subjectId) const override;
+
+    /**
+     * @brief Начать транзакцию на соединении текущего потока
+     * @return bool true если транзакция начата
+     */
+    bool beginTransaction() override;
+
+    /**
+     * @brief Зафиксировать транзакцию
+     * @return bool true если изменения зафиксированы
+     */
+    bool commitTransaction() override;
+
+    /**
+     * @brief Откатить транзакцию
+     */
+    void rollbackTransaction() override;
+
+    /**
+     * @brief Выполнить SAVEPOINT
+     * @return bool true если точка поставлена
+     */
+    bool setSavepoint() override;
+
+    /**
+     * @brief Выполнить RELEASE SAVEPOINT, при keep == false — после ROLLBACK TO
+     * @param keep Оставить изменения после точки
+     * @return bool true если точка снята
+     */
+    bool releaseSavepoint(bool keep) override;
+
+protected:
+    /**
+     * @brief Имя точки сохранения пакетной записи
+     */
+    static constexpr const char *SAVEPOINT_NAME = "university_write";
+
+    /**
+     * @brief Получить соединение текущего потока
+     * @return QSqlDatabase Соединение из пула
+     */
+    QSqlDatabase database() const;
+
+    /**
+     * @brief Получить подготовленный запрос из кэша соединения текущего потока
+     * @param sql Текст запроса
+     * @return QSqlQuery* Запрос или nullptr при ошибке
+     *
+     * @note Указатель действителен до переподключения или завершения потока
+     */
+    QSqlQuery *statement(const QString &sql) const;
+
+    /**
+     * @brief Выполнить запрос с учетом порога медленных запросов
+     * @param query Запрос
+     * @param sql Текст запроса или пустая строка для подготовленного запроса
+     * @return bool Результат QSqlQuery::exec()
+     *
+     * @details Запрос дольше metrics()->slowQueryThreshold() попадает в лог
+     * вместе с привязанными значениями
+     */
+    bool exec(QSqlQuery &query, const QString &sql = QString()) const;
+
+    /**
+     * @brief Выполнить пакетный запрос с учетом порога медленных запросов
+     * @param query Подготовленный запрос с привязанными списками значений
+     * @return bool Результат QSqlQuery::execBatch()
+     */
+    bool execBatch(QSqlQuery &query) const;
+
+    /**
+     * @brief Прочитать состав предмета запросом
+     * @param sql Запрос с одним параметром subject_id, возвращающий столбцы
+     * subject_id, student_id, student_name, grade, teacher_id, teacher_name
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Строки состава
+     */
+    QList<RosterEntry> readRoster(const QString &sql, int subjectId) const;
+
+    /**
+     * @brief Прочитать студентов запросом с одним параметром LIMIT
+     * @param sql Запрос, возвращающий столбцы id, full_name, grade
+     * @param limit Значение LIMIT
+     * @return QList<StudentRecord> Записи в порядке запроса
+     */
+    QList<StudentRecord> readStudents(const QString &sql, int limit) const;
+
+    ConnectionPool *m_pool;     ///< Пул соединений
+};
+
+#endif // SQLSTORAGE_H
@@ -0,0 +1,583 @@
+/**
+ * @file SqliteStorage.cpp
+ * @brief Реализация класса SqliteStorage
+ * @ingroup Models
+ */
+
+#include "SqliteStorage.h"
+#include <QDebug>
+#include <QSqlError>
+#include <algorithm>
+
+/**
+ * @brief Преобразовать список id в список для IN (...)
+ * @param ids Идентификаторы
+ * @return QString Строка вида 1,2,3
+ *
+ * @details Значения целые, поэтому подстановка в текст запроса безопасна
+ */
+static QString toIdList(const QList<int> &ids)
+{
+    QStringList parts;
+    parts.reserve(ids.size());
+    for (int id : ids) {
+        parts.append(QString::number(id));
+    }
+    return parts.join(',');
+}
+
+/**
+ * @brief Имя файла временной базы во временном каталоге
+ */
+static const char *TEMPORARY_DATABASE = "university.db";
+
+/**
+ * @brief Конструктор SqliteStorage
+ * @param path Путь к файлу базы
+ * @param parent Родительский QObject
+ */
+SqliteStorage::SqliteStorage(const QString &path, QObject *parent)
+    : SqliteStorage(path == ":memory:" ? QString() : path,
+                    path.isEmpty() || path == ":memory:" ? std::make_unique<QTemporaryDir>() : nullptr,
+                    parent)
+{
+}
+
+/**
+ * @brief Конструктор SqliteStorage с временным каталогом
+ * @param path Путь к файлу базы или пустая строка
+ * @param tempDir Каталог временной базы
+ * @param parent Родительский QObject
+ */
+SqliteStorage::SqliteStorage(const QString &path, std::unique_ptr<QTemporaryDir> tempDir, QObject *parent)
+    : SqlStorage(settingsFor(tempDir ? tempDir->filePath(TEMPORARY_DATABASE) : path), parent)
+    , m_path(path)
+    , m_tempDir(std::move(tempDir))
+{
+    const bool temporary = m_tempDir != nullptr;
+    m_pool->setOpenHandler([temporary](QSqlDatabase &db) {
+        QSqlQuery query(db);
+        // Каскадное удаление записей на предметы и назначений
+        query.exec("PRAGMA foreign_keys = ON");
+        query.exec("PRAGMA journal_mode = WAL");
+        // Временная база не переживает процесс, сбрасывать ее на диск незачем
+        query.exec(temporary ? "PRAGMA synchronous = OFF" : "PRAGMA synchronous = NORMAL");
+    });
+}
+
+/**
+ * @brief Деструктор SqliteStorage
+ */
+SqliteStorage::~SqliteStorage()
+{
+    m_pool->releaseDatabase();
+}
+
+/**
+ * @brief Получение названия хранилища
+ * @return QString Название
+ */
+QString SqliteStorage::name() const
+{
+    return m_path.isEmpty() ? QStringLiteral("SQLite (временная база)") : QString("SQLite (%1)").arg(m_path);
+}
+
+/**
+ * @brief Построение параметров подключения
+ * @param path Путь к файлу
+ * @return ConnectionSettings Параметры
+ */
+ConnectionSettings SqliteStorage::settingsFor(const QString &path)
+{
+    ConnectionSettings settings;
+    settings.driver = "QSQLITE";
+    settings.hostName.clear();
+    settings.userName.clear();
+    settings.password.clear();
+    settings.connectTimeout = 0;
+    settings.databaseName = path;
+    settings.connectOptions = "QSQLITE_BUSY_TIMEOUT=5000";
+    return settings;
+}
+
+/**
+ * @brief Открытие хранилища
+ * @return bool Результат открытия
+ */
+bool SqliteStorage::open()
+{
+    if (m_tempDir && !m_tempDir->isValid()) {
+        qWarning() << "Не удалось создать каталог временной базы SQLite:" << m_tempDir->errorString();
+        return false;
+    }
+
+    QSqlDatabase db = database();
+    if (!db.isOpen()) {
+        return false;
+    }
+
+    static const QStringList schema = {
+        "CREATE TABLE IF NOT EXISTS teachers ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "full_name TEXT NOT NULL, "
+        "department TEXT NOT NULL)",
+        "CREATE TABLE IF NOT EXISTS students ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "full_name TEXT NOT NULL, "
+        "grade INTEGER CHECK (grade >= 1 AND grade <= 5))",
+        "CREATE TABLE IF NOT EXISTS subjects ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "name TEXT NOT NULL)",
+        "CREATE INDEX IF NOT EXISTS teachers_department_idx ON teachers (department)",
+        "CREATE INDEX IF NOT EXISTS students_grade_idx ON students (grade)",
+        // Без ROWID строки хранятся в B-дереве первичного ключа, поэтому
+        // он покрывает чтение состава предмета так же, как INCLUDE в PostgreSQL
+        "CREATE TABLE IF NOT EXISTS enrollments ("
+        "subject_id INTEGER NOT NULL REFERENCES subjects (id) ON DELETE CASCADE, "
+        "student_id INTEGER NOT NULL REFERENCES students (id) ON DELETE CASCADE, "
+        "grade INTEGER CHECK (grade >= 1 AND grade <= 5), "
+        "PRIMARY KEY (subject_id, student_id)) WITHOUT ROWID",
+        "CREATE INDEX IF NOT EXISTS enrollments_student_idx ON enrollments (student_id, grade)",
+        "CREATE TABLE IF NOT EXISTS assignments ("
+        "subject_id INTEGER NOT NULL REFERENCES subjects (id) ON DELETE CASCADE, "
+        "teacher_id INTEGER NOT NULL REFERENCES teachers (id) ON DELETE CASCADE, "
+        "PRIMARY KEY (subject_id, teacher_id)) WITHOUT ROWID",
+        "CREATE INDEX IF NOT EXISTS assignments_teacher_idx ON assignments (teacher_id)"
+    };
+
+    QSqlQuery query(db);
+    for (const QString &sql : schema) {
+        if (!query.exec(sql)) {
+            qWarning() << "Ошибка создания схемы SQLite:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Получение записей преподавателей по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> SqliteStorage::getTeachersByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<TeacherRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    // Текст запроса зависит от количества id, поэтому он не кэшируется
+    QSqlQuery query(database());
+    query.setForwardOnly(true);
+    if (!exec(query, QString("SELECT id, full_name, department FROM teachers "
+                            "WHERE id IN (%1) ORDER BY id").arg(toIdList(ids)))) {
+        qWarning() << "Ошибка загрузки teachers по id:" << query.lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+
+    records.reserve(ids.size());
+    while (query.next()) {
+        records.append(TeacherRecord{
+            query.value(0).toInt(),
+            query.value(1).toString(),
+            query.value(2).toString()
+        });
+    }
+    return records;
+}
+
+/**
+ * @brief Пакетное добавление преподавателей
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей
+ */
+QList<int> SqliteStorage::addTeachers(const QList<TeacherRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+
+    QVariantList fullNameColumn;
+    QVariantList departmentColumn;
+    fullNameColumn.reserve(records.size());
+    departmentColumn.reserve(records.size());
+    for (const TeacherRecord &record : records) {
+        fullNameColumn.append(record.fullName);
+        departmentColumn.append(record.department);
+    }
+    return insertBatch("teachers", {"full_name", "department"}, {fullNameColumn, departmentColumn});
+}
+
+/**
+ * @brief Поиск преподавателей
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<TeacherRecord> Найденные записи
+ */
+QList<TeacherRecord> SqliteStorage::searchTeachers(const QString &text, int limit) const
+{
+    QList<TeacherRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, department FROM teachers ORDER BY id");
+    if (!query || !exec(*query)) {
+        return records;
+    }
+
+    const QString folded = foldCase(text);
+    while (records.size() < limit && query->next()) {
+        const QString fullName = query->value(1).toString();
+        const QString department = query->value(2).toString();
+        if (foldCase(fullName).contains(folded) || foldCase(department).contains(folded)) {
+            records.append(TeacherRecord{query->value(0).toInt(), fullName, department});
+        }
+    }
+    query->finish();
+    return records;
+}
+
+/**
+ * @brief Получение записей студентов по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> SqliteStorage::getStudentsByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<StudentRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    QSqlQuery query(database());
+    query.setForwardOnly(true);
+    if (!exec(query, QString("SELECT id, full_name, grade FROM students "
+                            "WHERE id IN (%1) ORDER BY id").arg(toIdList(ids)))) {
+        qWarning() << "Ошибка загрузки students по id:" << query.lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+
+    records.reserve(ids.size());
+    while (query.next()) {
+        records.append(StudentRecord{
+            query.value(0).toInt(),
+            query.value(1).toString(),
+            query.value(2).toInt()
+        });
+    }
+    return records;
+}
+
+/**
+ * @brief Пакетное добавление студентов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей
+ */
+QList<int> SqliteStorage::addStudents(const QList<StudentRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+
+    QVariantList fullNameColumn;
+    QVariantList gradeColumn;
+    fullNameColumn.reserve(records.size());
+    gradeColumn.reserve(records.size());
+    for (const StudentRecord &record : records) {
+        fullNameColumn.append(record.fullName);
+        gradeColumn.append(record.grade);
+    }
+    return insertBatch("students", {"full_name", "grade"}, {fullNameColumn, gradeColumn});
+}
+
+/**
+ * @brief Поиск студентов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<StudentRecord> Найденные записи
+ */
+QList<StudentRecord> SqliteStorage::searchStudents(const QString &text, int limit) const
+{
+    QList<StudentRecord> records;
+    QSqlQuery *query = statement("SELECT id, full_name, grade FROM students ORDER BY id");
+    if (!query || !exec(*query)) {
+        return records;
+    }
+
+    const QString folded = foldCase(text);
+    while (records.size() < limit && query->next()) {
+        const QString fullName = query->value(1).toString();
+        if (foldCase(fullName).contains(folded)) {
+            records.append(StudentRecord{query->value(0).toInt(), fullName, query->value(2).toInt()});
+        }
+    }
+    query->finish();
+    return records;
+}
+
+/**
+ * @brief Получение записей предметов по списку id
+ * @param ids Идентификаторы
+ * @param ok false при ошибке запроса
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> SqliteStorage::getSubjectsByIds(const QList<int> &ids, bool *ok) const
+{
+    QList<SubjectRecord> records;
+    setOk(ok, true);
+    if (ids.isEmpty()) {
+        return records;
+    }
+
+    QSqlQuery query(database());
+    query.setForwardOnly(true);
+    if (!exec(query, QString("SELECT id, name FROM subjects "
+                            "WHERE id IN (%1) ORDER BY id").arg(toIdList(ids)))) {
+        qWarning() << "Ошибка загрузки subjects по id:" << query.lastError().text();
+        setOk(ok, false);
+        return records;
+    }
+
+    records.reserve(ids.size());
+    while (query.next()) {
+        records.append(SubjectRecord{
+            query.value(0).toInt(),
+            query.value(1).toString()
+        });
+    }
+    return records;
+}
+
+/**
+ * @brief Пакетное добавление предметов
+ * @param records Новые записи
+ * @return QList<int> Идентификаторы добавленных записей
+ */
+QList<int> SqliteStorage::addSubjects(const QList<SubjectRecord> &records)
+{
+    if (records.isEmpty()) {
+        return {};
+    }
+
+    QVariantList nameColumn;
+    nameColumn.reserve(records.size());
+    for (const SubjectRecord &record : records) {
+        nameColumn.append(record.name);
+    }
+    return insertBatch("subjects", {"name"}, {nameColumn});
+}
+
+/**
+ * @brief Поиск предметов
+ * @param text Строка поиска
+ * @param limit Максимальное количество результатов
+ * @return QList<SubjectRecord> Найденные записи
+ */
+QList<SubjectRecord> SqliteStorage::searchSubjects(const QString &text, int limit) const
+{
+    QList<SubjectRecord> records;
+    QSqlQuery *query = statement("SELECT id, name FROM subjects ORDER BY id");
+    if (!query || !exec(*query)) {
+        return records;
+    }
+
+    const QString folded = foldCase(text);
+    while (records.size() < limit && query->next()) {
+        const QString name = query->value(1).toString();
+        if (foldCase(name).contains(folded)) {
+            records.append(SubjectRecord{query->value(0).toInt(), name});
+        }
+    }
+    query->finish();
+    return records;
+}
+
+/**
+ * @brief Получение количества строк по таблицам
+ * @param mode Способ подсчета
+ * @return RecordCounts Количество строк
+ */
+RecordCounts SqliteStorage::getRecordCounts(CountMode mode) const
+{
+    RecordCounts counts;
+    counts.estimated = mode == CountMode::Estimated;
+
+    QSqlQuery *query = statement("SELECT (SELECT COUNT(*) FROM teachers), "
+                                 "(SELECT COUNT(*) FROM students), "
+                                 "(SELECT COUNT(*) FROM subjects)");
+    if (!query) {
+        return counts;
+    }
+    if (exec(*query) && query->next()) {
+        counts.teachers = query->value(0).toLongLong();
+        counts.students = query->value(1).toLongLong();
+        counts.subjects = query->value(2).toLongLong();
+    } else {
+        qWarning() << "Ошибка подсчета записей:" << query->lastError().text();
+    }
+    query->finish();
+    return counts;
+}
+
+/**
+ * @brief Начало транзакции с блокировкой записи
+ * @return bool Результат операции
+ */
+bool SqliteStorage::beginTransaction()
+{
+    QSqlDatabase db = database();
+    QSqlQuery control(db);
+    if (!db.isOpen() || !exec(control, "BEGIN IMMEDIATE")) {
+        qWarning() << "Не удалось начать транзакцию:" << control.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Пакетная вставка строк
+ * @param table Имя таблицы
+ * @param columns Имена столбцов
+ * @param values Значения по столбцам
+ * @return QList<int> Выданные идентификаторы
+ */
+QList<int> SqliteStorage::insertBatch(const QString &table, const QStringList &columns, const QList<QVariantList> &values)
+{
+    QSqlDatabase db = database();
+    QSqlQuery control(db);
+    if (!db.isOpen() || !control.exec("BEGIN IMMEDIATE")) {
+        qWarning() << "Не удалось начать транзакцию для" << table << ":" << control.lastError().text();
+        return {};
+    }
+
+    QStringList placeholders;
+    for (int i = 0; i < columns.size(); ++i) {
+        placeholders.append("?");
+    }
+    QSqlQuery *query = statement(QString("INSERT INTO %1 (%2) VALUES (%3)")
+                                 .arg(table, columns.join(", "), placeholders.join(", ")));
+    bool ok = query != nullptr;
+    if (ok) {
+        for (int i = 0; i < values.size(); ++i) {
+            query->bindValue(i, values.at(i));
+        }
+        ok = execBatch(*query);
+        if (!ok) {
+            qWarning() << "Ошибка пакетной вставки в" << table << ":" << query->lastError().text();
+        }
+        query->finish();
+    }
+
+    qint64 lastId = 0;
+    if (ok) {
+        ok = control.exec("SELECT last_insert_rowid()") && control.next();
+        lastId = control.value(0).toLongLong();
+        control.finish();
+    }
+
+    if (!ok || !db.commit()) {
+        qWarning() << "Пакет" << table << "не вставлен:" << db.lastError().text();
+        db.rollback();
+        return {};
+    }
+
+    const qsizetype count = values.isEmpty() ? 0 : values.first().size();
+    QList<int> ids;
+    ids.reserve(count);
+    for (qint64 id = lastId - count + 1; id <= lastId; ++id) {
+        ids.append(static_cast<int>(id));
+    }
+    return ids;
+}
+
+/**
+ * @brief Удаление преподавателей по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> SqliteStorage::deleteTeachers(const QList<int> &ids)
+{
+    return deleteByIds("teachers", ids);
+}
+
+/**
+ * @brief Удаление студентов по списку id
+ * @param ids Идентификаторы
+ * @return QList<StudentRecord> Удаленные записи
+ */
+QList<StudentRecord> SqliteStorage::deleteStudents(const QList<int> &ids)
+{
+    QList<StudentRecord> deleted;
+    if (ids.isEmpty()) {
+        return deleted;
+    }
+
+    // Текст запроса зависит от количества id, поэтому он не кэшируется
+    QSqlQuery query(database());
+    query.setForwardOnly(true);
+    if (!exec(query, QString("DELETE FROM students WHERE id IN (%1) "
+                             "RETURNING id, full_name, grade").arg(toIdList(ids)))) {
+        qWarning() << "Ошибка удаления из students по id:" << query.lastError().text();
+        return deleted;
+    }
+
+    deleted.reserve(ids.size());
+    while (query.next()) {
+        deleted.append(StudentRecord{
+            query.value(0).toInt(),
+            query.value(1).toString(),
+            query.value(2).toInt()
+        });
+    }
+
+    // RETURNING не гарантирует порядок строк
+    std::sort(deleted.begin(), deleted.end(), [](const StudentRecord &a, const StudentRecord &b) {
+        return a.id < b.id;
+    });
+    return deleted;
+}
+
+/**
+ * @brief Удаление предметов по списку id
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных записей
+ */
+QList<int> SqliteStorage::deleteSubjects(const QList<int> &ids)
+{
+    return deleteByIds("subjects", ids);
+}
+
+/**
+ * @brief Удаление строк по списку id
+ * @param table Имя таблицы
+ * @param ids Идентификаторы
+ * @return QList<int> Идентификаторы удаленных строк
+ */
+QList<int> SqliteStorage::deleteByIds(const QString &table, const QList<int> &ids)
+{
+    QList<int> deleted;
+    if (ids.isEmpty()) {
+        return deleted;
+    }
+
+    // Текст запроса зависит от количества id, поэтому он не кэшируется
+    QSqlQuery query(database());
+    query.setForwardOnly(true);
+    if (!exec(query, QString("DELETE FROM %1 WHERE id IN (%2) RETURNING id").arg(table, toIdList(ids)))) {
+        qWarning() << "Ошибка удаления из" << table << "по id:" << query.lastError().text();
+        return deleted;
+    }
+
+    deleted.reserve(ids.size());
+    while (query.next()) {
+        deleted.append(query.value(0).toInt());
+    }
+
+    // RETURNING не гарантирует порядок строк
+    std::sort(deleted.begin(), deleted.end());
+    return deleted;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file SqliteStorage.h
+ * @brief Заголовочный файл класса SqliteStorage
+ * @ingroup Models
+ *
+ * @class SqliteStorage
+ * @brief Хранилище в SQLite (драйвер QSQLITE)
+ *
+ * Работает с файлом или с временной базой. Временная база — файл во
+ * временном каталоге, который удаляется вместе с хранилищем: соединения
+ * всех потоков пула видят одни и те же таблицы, а в отличие от общего кэша
+ * (cache=shared) блокировки таблиц не возвращают SQLITE_LOCKED в обход
+ * QSQLITE_BUSY_TIMEOUT. В обоих случаях включается журнал WAL, чтобы
+ * чтение не ждало записи.
+ *
+ * Схема совпадает с PostgreSQL по столбцам, id — INTEGER PRIMARY KEY
+ * AUTOINCREMENT, поэтому идентификаторы удаленных строк не переиспользуются.
+ * Поиск — подстрока без учета регистра, проверяемая на стороне приложения:
+ * LIKE в SQLite не учитывает регистр только для ASCII. Оценки количества
+ * строк нет, getRecordCounts() всегда считает точно. Материализованных
+ * представлений тоже нет: состав предмета собирается соединением таблиц
+ * при каждом чтении (SqlStorage::getSubjectRoster()).
+ *
+ * Уведомлений об изменениях других клиентов нет.
+ *
+ * @note Требуется SQLite 3.35 или новее (INSERT/DELETE ... RETURNING)
+ */
+
+#ifndef SQLITESTORAGE_H
+#define SQLITESTORAGE_H
+
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVariantList>
+#include <memory>
+#include "SqlStorage.h"
+
+class SqliteStorage : public SqlStorage
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Конструктор
+     * @param path Путь к файлу базы; пустая строка или ":memory:" — временная база
+     * @param parent Родительский QObject
+     */
+    explicit SqliteStorage(const QString &path = QString(), QObject *parent = nullptr);
+
+    /**
+     * @brief Деструктор
+     * @details Закрывает соединение текущего потока до удаления временного
+     * каталога. Соединения других потоков закрываются завершением их потоков.
+     */
+    ~SqliteStorage() override;
+
+    /**
+     * @brief Получить название хранилища
+     * @return QString "SQLite" с путем к файлу или пометкой о временной базе
+     */
+    QString name() const override;
+
+    /**
+     * @brief Открыть соединение и создать таблицы
+     * @return bool true если соединение открыто и схема создана
+     */
+    bool open() override;
+
+    /**
+     * @brief Получить преподавателей по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<TeacherRecord> Найденные записи
+     */
+    QList<TeacherRecord> getTeachersByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить преподавателей в одной транзакции
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addTeachers(const QList<TeacherRecord> &records) override;
+
+    /**
+     * @brief Удалить преподавателей одним DELETE ... WHERE id IN (...)
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteTeachers(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти преподавателей по подстроке имени или кафедры
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     */
+    QList<TeacherRecord> searchTeachers(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить студентов по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<StudentRecord> Найденные записи
+     */
+    QList<StudentRecord> getStudentsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить студентов в одной транзакции
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addStudents(const QList<StudentRecord> &records) override;
+
+    /**
+     * @brief Удалить студентов одним DELETE ... WHERE id IN (...)
+     * @param ids Идентификаторы
+     * @return QList<StudentRecord> Удаленные записи по возрастанию id
+     */
+    QList<StudentRecord> deleteStudents(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти студентов по подстроке имени
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     */
+    QList<StudentRecord> searchStudents(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить предметы по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения
+     * @return QList<SubjectRecord> Найденные записи
+     */
+    QList<SubjectRecord> getSubjectsByIds(const QList<int> &ids, bool *ok = nullptr) const override;
+
+    /**
+     * @brief Добавить предметы в одной транзакции
+     * @param records Новые записи
+     * @return QList<int> Идентификаторы или пустой список при ошибке
+     */
+    QList<int> addSubjects(const QList<SubjectRecord> &records) override;
+
+    /**
+     * @brief Удалить предметы одним DELETE ... WHERE id IN (...)
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей по возрастанию
+     */
+    QList<int> deleteSubjects(const QList<int> &ids) override;
+
+    /**
+     * @brief Найти предметы по подстроке названия
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     */
+    QList<SubjectRecord> searchSubjects(const QString &text, int limit) const override;
+
+    /**
+     * @brief Получить точное количество строк по таблицам
+     * @param mode Способ подсчета (оценка не поддерживается и равна точному значению)
+     * @return RecordCounts Количество строк
+     */
+    RecordCounts getRecordCounts(CountMode mode) const override;
+
+    /**
+     * @brief Начать транзакцию с блокировкой записи
+     * @return bool true если транзакция начата
+     *
+     * @details BEGIN IMMEDIATE сразу берет блокировку записи, поэтому
+     * транзакция не упрется в чужую блокировку на первой вставке
+     */
+    bool beginTransaction() override;
+
+private:
+    /**
+     * @brief Конструктор с временным каталогом
+     * @param path Путь к файлу базы или пустая строка для временной базы
+     * @param tempDir Каталог временной базы или nullptr для файла
+     * @param parent Родительский QObject
+     */
+    SqliteStorage(const QString &path, std::unique_ptr<QTemporaryDir> tempDir, QObject *parent);
+
+    /**
+     * @brief Построить параметры подключения
+     * @param path Путь к файлу базы
+     * @return ConnectionSettings Параметры для ConnectionPool
+     */
+    static ConnectionSettings settingsFor(const QString &path);
+
+    /**
+     * @brief Вставить строки одной транзакцией
+     * @param table Имя таблицы
+     * @param columns Имена столбцов без id
+     * @param values Значения по столбцам
+     * @return QList<int> Выданные идентификаторы по возрастанию или пустой список при ошибке
+     *
+     * @details BEGIN IMMEDIATE берет блокировку записи сразу, поэтому
+     * AUTOINCREMENT выдает строкам пакета идущие подряд id
+     */
+    QList<int> insertBatch(const QString &table, const QStringList &columns, const QList<QVariantList> &values);
+
+    /**
+     * @brief Удалить строки по списку id одним запросом
+     * @param table Имя таблицы
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных строк по возрастанию
+     *
+     * @details В SQLite нет массивов, id подставляются в IN (...) числами
+     */
+    QList<int> deleteByIds(const QString &table, const QList<int> &ids);
+
+    QString m_path;     ///< Путь к файлу или пустая строка для временной базы
+    std::unique_ptr<QTemporaryDir> m_tempDir;   ///< Каталог временной базы или nullptr
+};
+
+#endif // SQLITESTORAGE_H
@@ -0,0 +1,92 @@
+/**
+ * @file StartupReport.cpp
+ * @brief Реализация класса StartupReport
+ * @ingroup Models
+ */
+
+#include "StartupReport.h"
+#include <QDebug>
+#include <QStringList>
+
+/**
+ * @brief Создание отчета при статической инициализации
+ * @details Отсчет начинается до входа в main()
+ */
+static const StartupReport &s_startupReport = StartupReport::instance();
+
+/**
+ * @brief Получение отчета процесса
+ * @return StartupReport& Экземпляр
+ */
+StartupReport &StartupReport::instance()
+{
+    static StartupReport report;
+    return report;
+}
+
+/**
+ * @brief Конструктор
+ */
+StartupReport::StartupReport()
+{
+    m_timer.start();
+}
+
+/**
+ * @brief Отметка этапа
+ * @param stage Название этапа
+ */
+void StartupReport::mark(const QString &stage)
+{
+    if (!contains(stage)) {
+        m_stages.append({stage, m_timer.elapsed()});
+    }
+}
+
+/**
+ * @brief Проверка отметки этапа
+ * @param stage Название этапа
+ * @return bool Этап отмечен
+ */
+bool StartupReport::contains(const QString &stage) const
+{
+    return elapsed(stage) >= 0;
+}
+
+/**
+ * @brief Получение времени этапа
+ * @param stage Название этапа
+ * @return qint64 Миллисекунды от запуска
+ */
+qint64 StartupReport::elapsed(const QString &stage) const
+{
+    for (const auto &entry : m_stages) {
+        if (entry.first == stage) {
+            return entry.second;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Формирование отчета
+ * @return QString Строка вида "main 5 мс → первый кадр 310 мс (+305)"
+ */
+QString StartupReport::summary() const
+{
+    QStringList parts;
+    qint64 previous = 0;
+    for (const auto &entry : m_stages) {
+        parts.append(QString("%1 %2 мс (+%3)").arg(entry.first).arg(entry.second).arg(entry.second - previous));
+        previous = entry.second;
+    }
+    return parts.join(" → ");
+}
+
+/**
+ * @brief Вывод отчета в лог
+ */
+void StartupReport::print() const
+{
+    qInfo().noquote() << "⏱ Запуск:" << summary();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file StartupReport.h
+ * @brief Заголовочный файл класса StartupReport
+ * @ingroup Models
+ *
+ * @class StartupReport
+ * @brief Замер этапов запуска приложения
+ *
+ * Отсчет начинается при статической инициализации, то есть до main(),
+ * и приближенно совпадает с запуском процесса. Этапы отмечаются методом
+ * mark(), повторная отметка этапа игнорируется. Итоговая строка
+ * выводится в лог методом print().
+ *
+ * Типичная последовательность: main → первый кадр → подключение → первые данные.
+ *
+ * @note Методы вызываются только из GUI потока
+ */
+
+#ifndef STARTUPREPORT_H
+#define STARTUPREPORT_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+class StartupReport
+{
+public:
+    /**
+     * @brief Получить отчет процесса
+     * @return StartupReport& Единственный экземпляр
+     */
+    static StartupReport &instance();
+
+    /**
+     * @brief Отметить завершение этапа
+     * @param stage Название этапа
+     */
+    void mark(const QString &stage);
+
+    /**
+     * @brief Проверить, отмечен ли этап
+     * @param stage Название этапа
+     * @return bool true если этап уже отмечен
+     */
+    bool contains(const QString &stage) const;
+
+    /**
+     * @brief Получить время этапа
+     * @param stage Название этапа
+     * @return qint64 Миллисекунды от запуска или -1, если этап не отмечен
+     */
+    qint64 elapsed(const QString &stage) const;
+
+    /**
+     * @brief Получить отчет одной строкой
+     * @return QString Этапы с временем от запуска и приростом
+     */
+    QString summary() const;
+
+    /**
+     * @brief Вывести отчет в лог
+     */
+    void print() const;
+
+private:
+    /**
+     * @brief Конструктор, запускает отсчет
+     */
+    StartupReport();
+
+    QElapsedTimer m_timer;                      ///< Время от запуска
+    QList<QPair<QString, qint64>> m_stages;     ///< Этапы в порядке отметки
+};
+
+#endif // STARTUPREPORT_H
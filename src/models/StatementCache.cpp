@@ -0,0 +1,65 @@
+/**
+ * @file StatementCache.cpp
+ * @brief Реализация класса StatementCache
+ * @ingroup Models
+ */
+
+#include "StatementCache.h"
+#include <QDebug>
+#include <QSqlError>
+
+/**
+ * @brief Деструктор StatementCache
+ */
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+/**
+ * @brief Получение подготовленного запроса
+ * @param db Соединение
+ * @param sql Текст запроса
+ * @param hit Признак попадания в кэш
+ * @return QSqlQuery* Запрос или nullptr
+ */
+QSqlQuery *StatementCache::prepare(const QSqlDatabase &db, const QString &sql, bool *hit)
+{
+    auto it = m_statements.constFind(sql);
+    if (it != m_statements.constEnd()) {
+        QSqlQuery *query = it.value();
+        query->finish();
+        *hit = true;
+        return query;
+    }
+
+    *hit = false;
+    auto *query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qWarning() << "Ошибка подготовки запроса:" << query->lastError().text() << sql;
+        delete query;
+        return nullptr;
+    }
+
+    m_statements.insert(sql, query);
+    return query;
+}
+
+/**
+ * @brief Очистка кэша
+ */
+void StatementCache::clear()
+{
+    qDeleteAll(m_statements);
+    m_statements.clear();
+}
+
+/**
+ * @brief Получение размера кэша
+ * @return int Количество подготовленных запросов
+ */
+int StatementCache::size() const
+{
+    return static_cast<int>(m_statements.size());
+}
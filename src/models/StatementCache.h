@@ -0,0 +1,69 @@
+/**
+ * @file StatementCache.h
+ * @brief Заголовочный файл класса StatementCache
+ * @ingroup Models
+ *
+ * @class StatementCache
+ * @brief Кэш подготовленных запросов одного соединения
+ *
+ * Каждый SQL текст подготавливается (prepare) один раз на соединение,
+ * при следующих обращениях возвращается тот же QSqlQuery, которому
+ * достаточно заново привязать параметры. Все запросы работают
+ * с курсором только вперед.
+ *
+ * Кэш принадлежит потоку своего соединения и не синхронизирован.
+ * Его нужно очистить до закрытия или переоткрытия соединения.
+ */
+
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+class StatementCache
+{
+public:
+    /**
+     * @brief Конструктор пустого кэша
+     */
+    StatementCache() = default;
+
+    /**
+     * @brief Деструктор кэша
+     * @details Удаляет все подготовленные запросы
+     */
+    ~StatementCache();
+
+    StatementCache(const StatementCache &) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+
+    /**
+     * @brief Получить подготовленный запрос
+     * @param db Соединение, для которого готовится запрос
+     * @param sql Текст запроса
+     * @param hit Сюда записывается true, если запрос взят из кэша
+     * @return QSqlQuery* Подготовленный запрос или nullptr при ошибке подготовки
+     *
+     * @details Результат предыдущего выполнения запроса освобождается
+     */
+    QSqlQuery *prepare(const QSqlDatabase &db, const QString &sql, bool *hit);
+
+    /**
+     * @brief Удалить все подготовленные запросы
+     */
+    void clear();
+
+    /**
+     * @brief Получить количество подготовленных запросов
+     * @return int Размер кэша
+     */
+    int size() const;
+
+private:
+    QHash<QString, QSqlQuery*> m_statements;   ///< Подготовленные запросы по тексту SQL
+};
+
+#endif // STATEMENTCACHE_H
@@ -0,0 +1,182 @@
+/**
+ * @file StorageBackend.cpp
+ * @brief Реализация класса StorageBackend
+ * @ingroup Models
+ */
+
+#include "StorageBackend.h"
+#include "ConnectionPool.h"
+#include "MemoryStorage.h"
+#include "PostgresStorage.h"
+#include "QueryMetrics.h"
+#include "SqliteStorage.h"
+#include <QDebug>
+
+/**
+ * @brief Создание хранилища по строке описания
+ * @param spec Строка описания
+ * @param parent Родительский QObject
+ * @return StorageBackend* Хранилище
+ */
+StorageBackend *StorageBackend::create(const QString &spec, QObject *parent)
+{
+    const QString value = (spec.isEmpty() ? defaultSpec() : spec).trimmed();
+    const QString kind = value.section(':', 0, 0).toLower();
+    const QString argument = value.section(':', 1);
+
+    if (kind == "memory") {
+        return new MemoryStorage(parent);
+    }
+    if (kind == "sqlite") {
+        return new SqliteStorage(argument, parent);
+    }
+    if (kind != "postgres" && kind != "postgresql" && kind != "pg") {
+        qWarning() << "Неизвестное хранилище" << value << ", используется PostgreSQL";
+    }
+    return new PostgresStorage(parent);
+}
+
+/**
+ * @brief Получение строки описания хранилища по умолчанию
+ * @return QString Строка описания
+ */
+QString StorageBackend::defaultSpec()
+{
+    const QString spec = qEnvironmentVariable(STORAGE_ENV);
+    return spec.isEmpty() ? QStringLiteral("postgres") : spec;
+}
+
+/**
+ * @brief Конструктор
+ * @param parent Родительский QObject
+ */
+StorageBackend::StorageBackend(QObject *parent)
+    : QObject(parent)
+    , m_metrics(new QueryMetrics(this))
+{
+}
+
+/**
+ * @brief Получение пула соединений
+ * @return ConnectionPool* Пул или nullptr
+ */
+ConnectionPool *StorageBackend::connectionPool() const
+{
+    return nullptr;
+}
+
+/**
+ * @brief Получение доли попаданий в кэш подготовленных запросов
+ * @return double Значение от 0 до 1
+ */
+double StorageBackend::statementCacheHitRate() const
+{
+    ConnectionPool *pool = connectionPool();
+    return pool ? pool->statementCacheHitRate() : 0.0;
+}
+
+/**
+ * @brief Открытие курсора по студентам
+ * @return std::unique_ptr<RecordCursor<StudentRecord>> nullptr: курсоры не поддерживаются
+ */
+std::unique_ptr<RecordCursor<StudentRecord>> StorageBackend::openStudentCursor()
+{
+    return nullptr;
+}
+
+/**
+ * @brief Пересборка составов предметов
+ * @return bool true: составы собираются при чтении
+ */
+bool StorageBackend::refreshRosters()
+{
+    return true;
+}
+
+/**
+ * @brief Начало транзакции
+ * @return bool true: хранилище без транзакций
+ */
+bool StorageBackend::beginTransaction()
+{
+    return true;
+}
+
+/**
+ * @brief Фиксация транзакции
+ * @return bool true: изменения уже применены
+ */
+bool StorageBackend::commitTransaction()
+{
+    return true;
+}
+
+/**
+ * @brief Откат транзакции
+ * @details Хранилище без транзакций откатить нечего
+ */
+void StorageBackend::rollbackTransaction()
+{
+}
+
+/**
+ * @brief Установка точки сохранения
+ * @return bool true: неудачная операция ничего не меняет
+ */
+bool StorageBackend::setSavepoint()
+{
+    return true;
+}
+
+/**
+ * @brief Снятие точки сохранения
+ * @param keep Оставить изменения после точки
+ * @return bool true
+ */
+bool StorageBackend::releaseSavepoint(bool keep)
+{
+    Q_UNUSED(keep);
+    return true;
+}
+
+/**
+ * @brief Получение статистики задержек операций
+ * @return QueryMetrics* Статистика
+ */
+QueryMetrics *StorageBackend::metrics() const
+{
+    return m_metrics;
+}
+
+/**
+ * @brief Приведение строки к виду для поиска
+ * @param text Строка
+ * @return QString Строка для сравнения
+ */
+QString StorageBackend::foldCase(const QString &text)
+{
+    QString folded = text.toCaseFolded();
+    folded.replace(QChar(0x0451), QChar(0x0435));
+    return folded;
+}
+
+/**
+ * @brief Запись результата чтения
+ * @param ok Параметр результата или nullptr
+ * @param value Результат
+ */
+void StorageBackend::setOk(bool *ok, bool value)
+{
+    if (ok) {
+        *ok = value;
+    }
+}
+
+/**
+ * @brief Сумма строк по таблицам
+ * @return qint64 Количество строк
+ */
+qint64 RecordCounts::total() const
+{
+    return teachers + students + subjects;
+}
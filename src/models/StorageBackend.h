@@ -0,0 +1,507 @@
+/**
+ * @file StorageBackend.h
+ * @brief Заголовочный файл класса StorageBackend
+ * @ingroup Models
+ *
+ * @class StorageBackend
+ * @brief Интерфейс хранилища записей
+ *
+ * Описывает CRUD операции и массовое чтение, которыми пользуется
+ * DatabaseManager. Реализации:
+ * - PostgresStorage — PostgreSQL (QPSQL), рабочее хранилище
+ * - SqliteStorage — SQLite (QSQLITE), файл или база в памяти
+ * - MemoryStorage — хеш-таблицы в памяти процесса, без SQL
+ *
+ * Хранилище выбирается строкой вида "postgres", "sqlite", "sqlite:путь"
+ * или "memory" (см. create()). По умолчанию строка берется из переменной
+ * окружения UNIVERSITY_DB_STORAGE, main() задает ее флагом --storage.
+ * SQLite и память позволяют измерять слои ViewModel и UI без сервера
+ * и без сетевых задержек.
+ *
+ * Задержки операций собирает DatabaseManager в metrics(), SQL хранилища
+ * дополнительно пишут туда медленные запросы.
+ *
+ * Методы вызываются из нескольких потоков одновременно и должны быть
+ * потокобезопасными. Сигналы о записи отправляет DatabaseManager,
+ * хранилище сообщает только об изменениях других клиентов (rowsChanged
+ * и tableChanged).
+ */
+
+#ifndef STORAGEBACKEND_H
+#define STORAGEBACKEND_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <array>
+#include <memory>
+#include "RecordCursor.h"
+#include "RosterEntry.h"
+#include "Teacher.h"
+#include "Student.h"
+#include "Subject.h"
+
+class ConnectionPool;
+class QueryMetrics;
+
+/**
+ * @struct RecordCounts
+ * @brief Количество строк в таблицах
+ */
+struct RecordCounts
+{
+    qint64 teachers = 0;    ///< Строк в teachers
+    qint64 students = 0;    ///< Строк в students
+    qint64 subjects = 0;    ///< Строк в subjects
+    bool estimated = false; ///< Значения взяты из оценки планировщика
+
+    /**
+     * @brief Получить количество строк во всех таблицах
+     * @return qint64 Сумма по таблицам
+     */
+    qint64 total() const;
+};
+
+/**
+ * @struct GradeSummary
+ * @brief Распределение оценок студентов и крайние по оценке студенты
+ *
+ * @details Собирается агрегирующими запросами, поэтому размер не зависит
+ * от количества студентов. Студенты без оценки не учитываются.
+ */
+struct GradeSummary
+{
+    std::array<qint64, 5> histogram{};  ///< Количество студентов с оценками 1..5
+    QList<StudentRecord> top;           ///< Старшие оценки: по убыванию оценки, затем id
+    QList<StudentRecord> bottom;        ///< Младшие оценки: по возрастанию оценки, затем id
+};
+
+class StorageBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Переменная окружения с хранилищем по умолчанию
+     */
+    static constexpr const char *STORAGE_ENV = "UNIVERSITY_DB_STORAGE";
+
+    /**
+     * @brief Способ подсчета строк
+     */
+    enum class CountMode {
+        Exact,      ///< Точное количество
+        Estimated   ///< Оценка; хранилища без статистики возвращают точное значение
+    };
+
+    /**
+     * @brief Создать хранилище по строке описания
+     * @param spec "postgres", "sqlite" (временная база), "sqlite:путь" или "memory";
+     * пустая строка означает defaultSpec()
+     * @param parent Родительский QObject
+     * @return StorageBackend* Хранилище; для неизвестной строки — PostgreSQL
+     */
+    static StorageBackend *create(const QString &spec = QString(), QObject *parent = nullptr);
+
+    /**
+     * @brief Получить строку описания хранилища по умолчанию
+     * @return QString Значение UNIVERSITY_DB_STORAGE или "postgres"
+     */
+    static QString defaultSpec();
+
+    /**
+     * @brief Конструктор
+     * @param parent Родительский QObject
+     */
+    explicit StorageBackend(QObject *parent = nullptr);
+
+    /**
+     * @brief Получить название хранилища для лога
+     * @return QString Название
+     */
+    virtual QString name() const = 0;
+
+    /**
+     * @brief Открыть хранилище в вызывающем потоке и подготовить схему
+     * @return bool true если хранилище готово к работе
+     */
+    virtual bool open() = 0;
+
+    /**
+     * @brief Получить текст последней ошибки открытия
+     * @return QString Текст ошибки
+     */
+    virtual QString lastError() const = 0;
+
+    /**
+     * @brief Получить пул соединений
+     * @return ConnectionPool* Пул или nullptr для хранилища без SQL
+     */
+    virtual ConnectionPool *connectionPool() const;
+
+    /**
+     * @brief Получить долю попаданий в кэш подготовленных запросов
+     * @return double Значение от 0 до 1, без пула — 0
+     */
+    double statementCacheHitRate() const;
+
+    /**
+     * @brief Получить статистику задержек операций
+     * @return QueryMetrics* Статистика, принадлежит хранилищу
+     */
+    QueryMetrics *metrics() const;
+
+    // Teacher operations
+
+    /**
+     * @brief Получить всех преподавателей
+     * @return QList<TeacherRecord> Записи в порядке возрастания id
+     */
+    virtual QList<TeacherRecord> getAllTeachers() const = 0;
+
+    /**
+     * @brief Получить страницу преподавателей
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей
+     * @return QList<TeacherRecord> Записи с id больше afterId в порядке возрастания id
+     */
+    virtual QList<TeacherRecord> getTeachersPage(int afterId, int limit) const = 0;
+
+    /**
+     * @brief Получить преподавателей по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения (пустой список не означает отсутствия строк)
+     * @return QList<TeacherRecord> Найденные записи в порядке возрастания id
+     */
+    virtual QList<TeacherRecord> getTeachersByIds(const QList<int> &ids, bool *ok = nullptr) const = 0;
+
+    /**
+     * @brief Найти преподавателя по id
+     * @param id Идентификатор
+     * @return TeacherRecord Запись или невалидная запись
+     */
+    virtual TeacherRecord getTeacherById(int id) const = 0;
+
+    /**
+     * @brief Добавить преподавателя
+     * @param fullName Полное имя
+     * @param department Кафедра
+     * @return TeacherRecord Добавленная запись или невалидная запись при ошибке
+     */
+    virtual TeacherRecord addTeacher(const QString &fullName, const QString &department) = 0;
+
+    /**
+     * @brief Добавить преподавателей одной операцией
+     * @param records Новые записи (id игнорируется)
+     * @return QList<int> Идентификаторы в порядке records или пустой список при ошибке
+     */
+    virtual QList<int> addTeachers(const QList<TeacherRecord> &records) = 0;
+
+    /**
+     * @brief Удалить преподавателя
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    virtual int deleteTeacher(int id) = 0;
+
+    /**
+     * @brief Удалить преподавателей по списку id одним запросом
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей в порядке возрастания;
+     * отсутствующие id и ошибка запроса дают записи, которых нет в списке
+     */
+    virtual QList<int> deleteTeachers(const QList<int> &ids) = 0;
+
+    /**
+     * @brief Найти преподавателей по имени или кафедре
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<TeacherRecord> Найденные записи
+     */
+    virtual QList<TeacherRecord> searchTeachers(const QString &text, int limit) const = 0;
+
+    // Student operations
+
+    /**
+     * @brief Получить всех студентов
+     * @return QList<StudentRecord> Записи в порядке возрастания id
+     */
+    virtual QList<StudentRecord> getAllStudents() const = 0;
+
+    /**
+     * @brief Получить страницу студентов
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей
+     * @return QList<StudentRecord> Записи с id больше afterId в порядке возрастания id
+     */
+    virtual QList<StudentRecord> getStudentsPage(int afterId, int limit) const = 0;
+
+    /**
+     * @brief Получить студентов по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения (пустой список не означает отсутствия строк)
+     * @return QList<StudentRecord> Найденные записи в порядке возрастания id
+     */
+    virtual QList<StudentRecord> getStudentsByIds(const QList<int> &ids, bool *ok = nullptr) const = 0;
+
+    /**
+     * @brief Найти студента по id
+     * @param id Идентификатор
+     * @return StudentRecord Запись или невалидная запись
+     */
+    virtual StudentRecord getStudentById(int id) const = 0;
+
+    /**
+     * @brief Добавить студента
+     * @param fullName Полное имя
+     * @param grade Оценка
+     * @return StudentRecord Добавленная запись или невалидная запись при ошибке
+     */
+    virtual StudentRecord addStudent(const QString &fullName, int grade) = 0;
+
+    /**
+     * @brief Добавить студентов одной операцией
+     * @param records Новые записи (id игнорируется)
+     * @return QList<int> Идентификаторы в порядке records или пустой список при ошибке
+     */
+    virtual QList<int> addStudents(const QList<StudentRecord> &records) = 0;
+
+    /**
+     * @brief Удалить студента
+     * @param id Идентификатор
+     * @return StudentRecord Удаленная запись или невалидная запись
+     * @details Оценка удаленной записи нужна аналитике для обновления
+     * гистограммы без перечитывания таблицы
+     */
+    virtual StudentRecord deleteStudent(int id) = 0;
+
+    /**
+     * @brief Удалить студентов по списку id одним запросом
+     * @param ids Идентификаторы
+     * @return QList<StudentRecord> Удаленные записи в порядке возрастания id;
+     * отсутствующие id и ошибка запроса дают записи, которых нет в списке
+     */
+    virtual QList<StudentRecord> deleteStudents(const QList<int> &ids) = 0;
+
+    /**
+     * @brief Найти студентов по имени
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<StudentRecord> Найденные записи
+     */
+    virtual QList<StudentRecord> searchStudents(const QString &text, int limit) const = 0;
+
+    /**
+     * @brief Открыть курсор по всем студентам в порядке возрастания id
+     * @return std::unique_ptr<RecordCursor<StudentRecord>> Курсор или nullptr,
+     * если хранилище не поддерживает курсоры или открыть его не удалось
+     *
+     * @details Курсор используется и удаляется в вызывающем потоке,
+     * до удаления хранилища. Реализация по умолчанию возвращает nullptr.
+     */
+    virtual std::unique_ptr<RecordCursor<StudentRecord>> openStudentCursor();
+
+    // Subject operations
+
+    /**
+     * @brief Получить все предметы
+     * @return QList<SubjectRecord> Записи в порядке возрастания id
+     */
+    virtual QList<SubjectRecord> getAllSubjects() const = 0;
+
+    /**
+     * @brief Получить страницу предметов
+     * @param afterId Идентификатор последней загруженной записи (0 для первой страницы)
+     * @param limit Максимальное количество записей
+     * @return QList<SubjectRecord> Записи с id больше afterId в порядке возрастания id
+     */
+    virtual QList<SubjectRecord> getSubjectsPage(int afterId, int limit) const = 0;
+
+    /**
+     * @brief Получить предметы по списку id
+     * @param ids Идентификаторы
+     * @param ok Если задан, false при ошибке чтения (пустой список не означает отсутствия строк)
+     * @return QList<SubjectRecord> Найденные записи в порядке возрастания id
+     */
+    virtual QList<SubjectRecord> getSubjectsByIds(const QList<int> &ids, bool *ok = nullptr) const = 0;
+
+    /**
+     * @brief Найти предмет по id
+     * @param id Идентификатор
+     * @return SubjectRecord Запись или невалидная запись
+     */
+    virtual SubjectRecord getSubjectById(int id) const = 0;
+
+    /**
+     * @brief Добавить предмет
+     * @param name Название
+     * @return SubjectRecord Добавленная запись или невалидная запись при ошибке
+     */
+    virtual SubjectRecord addSubject(const QString &name) = 0;
+
+    /**
+     * @brief Добавить предметы одной операцией
+     * @param records Новые записи (id игнорируется)
+     * @return QList<int> Идентификаторы в порядке records или пустой список при ошибке
+     */
+    virtual QList<int> addSubjects(const QList<SubjectRecord> &records) = 0;
+
+    /**
+     * @brief Удалить предмет
+     * @param id Идентификатор
+     * @return int Идентификатор удаленной записи или 0
+     */
+    virtual int deleteSubject(int id) = 0;
+
+    /**
+     * @brief Удалить предметы по списку id одним запросом
+     * @param ids Идентификаторы
+     * @return QList<int> Идентификаторы удаленных записей в порядке возрастания;
+     * отсутствующие id и ошибка запроса дают записи, которых нет в списке
+     */
+    virtual QList<int> deleteSubjects(const QList<int> &ids) = 0;
+
+    /**
+     * @brief Найти предметы по названию
+     * @param text Строка поиска
+     * @param limit Максимальное количество результатов
+     * @return QList<SubjectRecord> Найденные записи
+     */
+    virtual QList<SubjectRecord> searchSubjects(const QString &text, int limit) const = 0;
+
+    // Enrollments and rosters
+
+    /**
+     * @brief Записать студента на предмет или изменить его оценку
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка от 1 до 5 или 0, если оценки еще нет
+     * @return bool true если запись сохранена
+     */
+    virtual bool enrollStudent(int studentId, int subjectId, int grade) = 0;
+
+    /**
+     * @brief Назначить преподавателя на предмет
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return bool true если назначение сохранено или уже было
+     */
+    virtual bool assignTeacher(int teacherId, int subjectId) = 0;
+
+    /**
+     * @brief Получить состав предмета
+     * @param subjectId Идентификатор предмета
+     * @return QList<RosterEntry> Строки в порядке возрастания id студента,
+     * затем id преподавателя
+     *
+     * @details Хранилище с заранее собранными составами возвращает их
+     * на момент последнего refreshRosters()
+     */
+    virtual QList<RosterEntry> getSubjectRoster(int subjectId) const = 0;
+
+    /**
+     * @brief Пересобрать заранее собранные составы предметов
+     * @return bool true если составы актуальны
+     *
+     * @details Реализация по умолчанию ничего не делает: хранилища без
+     * материализованных представлений собирают состав при чтении
+     */
+    virtual bool refreshRosters();
+
+    // Transactions
+
+    /**
+     * @brief Начать транзакцию на соединении вызывающего потока
+     * @return bool true если транзакция начата
+     *
+     * @details Пока транзакция открыта, операции записи, вызванные из этого
+     * потока, выполняются внутри нее. Реализация по умолчанию ничего не делает:
+     * операции хранилища без SQL атомарны по отдельности.
+     */
+    virtual bool beginTransaction();
+
+    /**
+     * @brief Зафиксировать транзакцию вызывающего потока
+     * @return bool true если изменения зафиксированы
+     */
+    virtual bool commitTransaction();
+
+    /**
+     * @brief Откатить транзакцию вызывающего потока
+     */
+    virtual void rollbackTransaction();
+
+    /**
+     * @brief Поставить точку сохранения внутри транзакции
+     * @return bool true если точка поставлена
+     *
+     * @details Точка одна: следующий вызов допустим после releaseSavepoint()
+     */
+    virtual bool setSavepoint();
+
+    /**
+     * @brief Снять точку сохранения
+     * @param keep true — оставить изменения после точки, false — откатить их
+     * @return bool true если точка снята
+     *
+     * @details Откат к точке не прерывает транзакцию, поэтому ошибка одной
+     * операции не отменяет остальные операции пакета
+     */
+    virtual bool releaseSavepoint(bool keep);
+
+    // Statistics
+
+    /**
+     * @brief Получить количество строк по таблицам
+     * @param mode Способ подсчета
+     * @return RecordCounts Количество строк
+     */
+    virtual RecordCounts getRecordCounts(CountMode mode) const = 0;
+
+    /**
+     * @brief Получить распределение оценок и крайних по оценке студентов
+     * @param limit Сколько студентов вернуть в top и bottom
+     * @return GradeSummary Гистограмма по всей таблице и не больше limit
+     * студентов с каждого края
+     */
+    virtual GradeSummary getGradeSummary(int limit) const = 0;
+
+signals:
+    /**
+     * @brief Сигнал об изменении строк другим клиентом
+     * @param table Имя таблицы
+     * @param ids Идентификаторы строк
+     * @param inserted true для добавленных строк, false для измененных или удаленных
+     * @param previousGrades Для students — оценки до изменения в порядке ids,
+     * иначе пустой список
+     */
+    void rowsChanged(const QString &table, const QList<int> &ids, bool inserted,
+                     const QList<int> &previousGrades);
+
+    /**
+     * @brief Сигнал об изменении другим клиентом слишком многих строк таблицы
+     * @param table Имя таблицы
+     * @details Строки не перечисляются, таблицу нужно перечитать целиком
+     */
+    void tableChanged(const QString &table);
+
+protected:
+    /**
+     * @brief Привести строку к виду для поиска без учета регистра
+     * @param text Строка
+     * @return QString Строка в нижнем регистре с ё, замененной на е
+     */
+    static QString foldCase(const QString &text);
+
+    /**
+     * @brief Сообщить результат чтения через необязательный параметр
+     * @param ok Параметр результата или nullptr
+     * @param value Результат
+     */
+    static void setOk(bool *ok, bool value);
+
+private:
+    QueryMetrics *m_metrics;    ///< Статистика задержек операций
+};
+
+#endif // STORAGEBACKEND_H
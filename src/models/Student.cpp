@@ -97,4 +97,59 @@ void Student::setGrade(int grade)
 QString Student::toString() const
 {
     return QString("%1. %2 (Оценка: %3)").arg(m_id).arg(m_fullName).arg(m_grade);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Проверить, что запись соответствует строке таблицы
+ * @return bool true если id больше нуля
+ */
+bool StudentRecord::isValid() const
+{
+    return id > 0;
+}
+
+/**
+ * @brief Проверить поля перед записью в БД
+ * @return QString Текст ошибки или пустая строка
+ */
+QString StudentRecord::validationError() const
+{
+    if (fullName.isEmpty()) {
+        return "Имя не может быть пустым";
+    }
+    if (grade < 1 || grade > 5) {
+        return "Оценка должна быть от 1 до 5";
+    }
+    return QString();
+}
+
+/**
+ * @brief Преобразовать запись в строковое представление
+ * @return QString Строка формата "ID. Имя (Оценка: X)"
+ */
+QString StudentRecord::toString() const
+{
+    return QString("%1. %2 (Оценка: %3)").arg(id).arg(fullName).arg(grade);
+}
+
+/**
+ * @brief Сравнить записи по всем полям
+ * @param other Другая запись
+ * @return bool true если все поля совпадают
+ */
+bool StudentRecord::operator==(const StudentRecord &other) const
+{
+    return id == other.id &&
+           fullName == other.fullName &&
+           grade == other.grade;
+}
+
+/**
+ * @brief Проверить, отличаются ли записи
+ * @param other Другая запись
+ * @return bool true если хотя бы одно поле отличается
+ */
+bool StudentRecord::operator!=(const StudentRecord &other) const
+{
+    return !(*this == other);
+}
@@ -115,4 +115,61 @@ private:
     int m_grade;        ///< Оценка студента
 };
 
+/**
+ * @struct StudentRecord
+ * @brief Строка таблицы students в виде значения
+ * 
+ * @details Легковесная копируемая запись без QObject и сигналов.
+ * Используется моделями списков, для передачи данных между потоками
+ * и как элемент результатов массового чтения из БД. Q_GADGET делает поля
+ * доступными из QML без отдельного объекта на каждую строку.
+ */
+struct StudentRecord
+{
+    Q_GADGET
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString fullName MEMBER fullName)
+    Q_PROPERTY(int grade MEMBER grade)
+    
+public:
+    int id = 0;       ///< Идентификатор студента
+    QString fullName; ///< Полное имя студента
+    int grade = 0;    ///< Оценка студента
+    
+    /**
+     * @brief Проверить, что запись соответствует строке таблицы
+     * @return bool true если id задан (больше нуля)
+     */
+    bool isValid() const;
+    
+    /**
+     * @brief Проверить поля перед записью в БД
+     * @return QString Текст ошибки или пустая строка, если поля допустимы
+     * 
+     * @details Требуется непустое имя и оценка от 1 до 5. id не проверяется,
+     * так как новым записям его назначает БД.
+     */
+    QString validationError() const;
+    
+    /**
+     * @brief Преобразовать запись в строковое представление
+     * @return QString Строка в формате "ID. Имя (Оценка: X)"
+     */
+    QString toString() const;
+    
+    /**
+     * @brief Сравнить записи по всем полям
+     * @param other Другая запись
+     * @return bool true если все поля совпадают
+     */
+    bool operator==(const StudentRecord &other) const;
+    
+    /**
+     * @brief Проверить, отличаются ли записи
+     * @param other Другая запись
+     * @return bool true если хотя бы одно поле отличается
+     */
+    bool operator!=(const StudentRecord &other) const;
+};
+
 #endif // STUDENT_H
\ No newline at end of file
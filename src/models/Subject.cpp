@@ -75,4 +75,55 @@ void Subject::setName(const QString &name)
 QString Subject::toString() const
 {
     return QString("%1. %2").arg(m_id).arg(m_name);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Проверить, что запись соответствует строке таблицы
+ * @return bool true если id больше нуля
+ */
+bool SubjectRecord::isValid() const
+{
+    return id > 0;
+}
+
+/**
+ * @brief Проверить поля перед записью в БД
+ * @return QString Текст ошибки или пустая строка
+ */
+QString SubjectRecord::validationError() const
+{
+    if (name.isEmpty()) {
+        return "Название предмета не может быть пустым";
+    }
+    return QString();
+}
+
+/**
+ * @brief Преобразовать запись в строковое представление
+ * @return QString Строка формата "ID. Название"
+ */
+QString SubjectRecord::toString() const
+{
+    return QString("%1. %2").arg(id).arg(name);
+}
+
+/**
+ * @brief Сравнить записи по всем полям
+ * @param other Другая запись
+ * @return bool true если все поля совпадают
+ */
+bool SubjectRecord::operator==(const SubjectRecord &other) const
+{
+    return id == other.id &&
+           name == other.name;
+}
+
+/**
+ * @brief Проверить, отличаются ли записи
+ * @param other Другая запись
+ * @return bool true если хотя бы одно поле отличается
+ */
+bool SubjectRecord::operator!=(const SubjectRecord &other) const
+{
+    return !(*this == other);
+}
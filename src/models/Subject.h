@@ -90,4 +90,59 @@ private:
     QString m_name; ///< Название предмета
 };
 
+/**
+ * @struct SubjectRecord
+ * @brief Строка таблицы subjects в виде значения
+ * 
+ * @details Легковесная копируемая запись без QObject и сигналов.
+ * Используется моделями списков, для передачи данных между потоками
+ * и как элемент результатов массового чтения из БД. Q_GADGET делает поля
+ * доступными из QML без отдельного объекта на каждую строку.
+ */
+struct SubjectRecord
+{
+    Q_GADGET
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString name MEMBER name)
+    
+public:
+    int id = 0;   ///< Идентификатор предмета
+    QString name; ///< Название предмета
+    
+    /**
+     * @brief Проверить, что запись соответствует строке таблицы
+     * @return bool true если id задан (больше нуля)
+     */
+    bool isValid() const;
+    
+    /**
+     * @brief Проверить поля перед записью в БД
+     * @return QString Текст ошибки или пустая строка, если поля допустимы
+     * 
+     * @details Требуется непустое название. id не проверяется,
+     * так как новым записям его назначает БД.
+     */
+    QString validationError() const;
+    
+    /**
+     * @brief Преобразовать запись в строковое представление
+     * @return QString Строка в формате "ID. Название"
+     */
+    QString toString() const;
+    
+    /**
+     * @brief Сравнить записи по всем полям
+     * @param other Другая запись
+     * @return bool true если все поля совпадают
+     */
+    bool operator==(const SubjectRecord &other) const;
+    
+    /**
+     * @brief Проверить, отличаются ли записи
+     * @param other Другая запись
+     * @return bool true если хотя бы одно поле отличается
+     */
+    bool operator!=(const SubjectRecord &other) const;
+};
+
 #endif // SUBJECT_H
\ No newline at end of file
@@ -97,4 +97,56 @@ void Teacher::setDepartment(const QString &department)
 QString Teacher::toString() const
 {
     return QString("%1. %2 (%3)").arg(m_id).arg(m_fullName).arg(m_department);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Проверить, что запись соответствует строке таблицы
+ * @return bool true если id больше нуля
+ */
+bool TeacherRecord::isValid() const
+{
+    return id > 0;
+}
+
+/**
+ * @brief Проверить поля перед записью в БД
+ * @return QString Текст ошибки или пустая строка
+ */
+QString TeacherRecord::validationError() const
+{
+    if (fullName.isEmpty() || department.isEmpty()) {
+        return "Имя и кафедра не могут быть пустыми";
+    }
+    return QString();
+}
+
+/**
+ * @brief Преобразовать запись в строковое представление
+ * @return QString Строка формата "ID. Имя (Кафедра)"
+ */
+QString TeacherRecord::toString() const
+{
+    return QString("%1. %2 (%3)").arg(id).arg(fullName).arg(department);
+}
+
+/**
+ * @brief Сравнить записи по всем полям
+ * @param other Другая запись
+ * @return bool true если все поля совпадают
+ */
+bool TeacherRecord::operator==(const TeacherRecord &other) const
+{
+    return id == other.id &&
+           fullName == other.fullName &&
+           department == other.department;
+}
+
+/**
+ * @brief Проверить, отличаются ли записи
+ * @param other Другая запись
+ * @return bool true если хотя бы одно поле отличается
+ */
+bool TeacherRecord::operator!=(const TeacherRecord &other) const
+{
+    return !(*this == other);
+}
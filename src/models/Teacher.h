@@ -114,4 +114,61 @@ private:
     QString m_department;   ///< Кафедра преподавателя
 };
 
+/**
+ * @struct TeacherRecord
+ * @brief Строка таблицы teachers в виде значения
+ * 
+ * @details Легковесная копируемая запись без QObject и сигналов.
+ * Используется моделями списков, для передачи данных между потоками
+ * и как элемент результатов массового чтения из БД. Q_GADGET делает поля
+ * доступными из QML без отдельного объекта на каждую строку.
+ */
+struct TeacherRecord
+{
+    Q_GADGET
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString fullName MEMBER fullName)
+    Q_PROPERTY(QString department MEMBER department)
+    
+public:
+    int id = 0;         ///< Идентификатор преподавателя
+    QString fullName;   ///< Полное имя преподавателя
+    QString department; ///< Кафедра преподавателя
+    
+    /**
+     * @brief Проверить, что запись соответствует строке таблицы
+     * @return bool true если id задан (больше нуля)
+     */
+    bool isValid() const;
+    
+    /**
+     * @brief Проверить поля перед записью в БД
+     * @return QString Текст ошибки или пустая строка, если поля допустимы
+     * 
+     * @details Требуется непустые имя и кафедра. id не проверяется,
+     * так как новым записям его назначает БД.
+     */
+    QString validationError() const;
+    
+    /**
+     * @brief Преобразовать запись в строковое представление
+     * @return QString Строка в формате "ID. Имя (Кафедра)"
+     */
+    QString toString() const;
+    
+    /**
+     * @brief Сравнить записи по всем полям
+     * @param other Другая запись
+     * @return bool true если все поля совпадают
+     */
+    bool operator==(const TeacherRecord &other) const;
+    
+    /**
+     * @brief Проверить, отличаются ли записи
+     * @param other Другая запись
+     * @return bool true если хотя бы одно поле отличается
+     */
+    bool operator!=(const TeacherRecord &other) const;
+};
+
 #endif // TEACHER_H
\ No newline at end of file
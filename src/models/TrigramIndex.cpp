@@ -0,0 +1,223 @@
+/**
+ * @file TrigramIndex.cpp
+ * @brief Реализация класса TrigramIndex
+ * @ingroup Models
+ */
+
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @brief Нормализация строки
+ * @param text Исходная строка
+ * @return QString Нормализованная строка
+ */
+QString TrigramIndex::normalize(const QString &text)
+{
+    const QString folded = text.toCaseFolded();
+    QString result;
+    result.reserve(folded.size());
+    bool space = true;
+
+    for (QChar c : folded) {
+        if (c == QChar(0x0451)) {
+            // ё -> е
+            c = QChar(0x0435);
+        }
+        if (c.isLetterOrNumber()) {
+            result.append(c);
+            space = false;
+        } else if (!space) {
+            result.append(' ');
+            space = true;
+        }
+    }
+    if (result.endsWith(' ')) {
+        result.chop(1);
+    }
+    return result;
+}
+
+/**
+ * @brief Добавление записи
+ * @param id Идентификатор записи
+ * @param text Текст записи
+ */
+void TrigramIndex::insert(int id, const QString &text)
+{
+    remove(id);
+
+    const QString normalized = normalize(text);
+    m_texts.insert(id, normalized);
+
+    for (quint64 key : trigrams(normalized)) {
+        QList<int> &ids = m_postings[key];
+        // Новые записи обычно имеют наибольший id
+        if (ids.isEmpty() || ids.last() < id) {
+            ids.append(id);
+        } else {
+            ids.insert(std::lower_bound(ids.begin(), ids.end(), id) - ids.begin(), id);
+        }
+    }
+}
+
+/**
+ * @brief Удаление записи
+ * @param id Идентификатор записи
+ */
+void TrigramIndex::remove(int id)
+{
+    auto it = m_texts.find(id);
+    if (it == m_texts.end()) {
+        return;
+    }
+
+    for (quint64 key : trigrams(it.value())) {
+        auto postings = m_postings.find(key);
+        if (postings == m_postings.end()) {
+            continue;
+        }
+        QList<int> &ids = postings.value();
+        auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id) {
+            ids.erase(pos);
+        }
+        if (ids.isEmpty()) {
+            m_postings.erase(postings);
+        }
+    }
+    m_texts.erase(it);
+}
+
+/**
+ * @brief Вливание другого индекса
+ * @param other Индекс, построенный отдельно
+ */
+void TrigramIndex::merge(const TrigramIndex &other)
+{
+    for (auto it = other.m_texts.cbegin(); it != other.m_texts.cend(); ++it) {
+        remove(it.key());
+        m_texts.insert(it.key(), it.value());
+    }
+
+    for (auto it = other.m_postings.cbegin(); it != other.m_postings.cend(); ++it) {
+        QList<int> &ids = m_postings[it.key()];
+        const QList<int> &added = it.value();
+        // Вливаемая часть обычно состоит из новых записей с наибольшими id
+        if (ids.isEmpty() || ids.last() < added.first()) {
+            ids.append(added);
+        } else {
+            QList<int> merged;
+            merged.reserve(ids.size() + added.size());
+            std::merge(ids.cbegin(), ids.cend(), added.cbegin(), added.cend(), std::back_inserter(merged));
+            ids = std::move(merged);
+        }
+    }
+}
+
+/**
+ * @brief Проверка наличия записи
+ * @param id Идентификатор записи
+ * @return bool Результат проверки
+ */
+bool TrigramIndex::contains(int id) const
+{
+    return m_texts.contains(id);
+}
+
+/**
+ * @brief Очистка индекса
+ */
+void TrigramIndex::clear()
+{
+    m_postings.clear();
+    m_texts.clear();
+}
+
+/**
+ * @brief Получение размера индекса
+ * @return int Количество записей
+ */
+int TrigramIndex::size() const
+{
+    return static_cast<int>(m_texts.size());
+}
+
+/**
+ * @brief Поиск подстроки
+ * @param query Строка поиска
+ * @return QList<int> Найденные идентификаторы
+ */
+QList<int> TrigramIndex::search(const QString &query) const
+{
+    const QString needle = normalize(query);
+    QList<int> result;
+    if (needle.isEmpty()) {
+        return result;
+    }
+
+    if (needle.size() < 3) {
+        for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it) {
+            if (it.value().contains(needle)) {
+                result.append(it.key());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Списки триграмм запроса, от короткого к длинному
+    QList<const QList<int> *> lists;
+    for (quint64 key : trigrams(needle)) {
+        auto it = m_postings.constFind(key);
+        if (it == m_postings.constEnd()) {
+            return result;
+        }
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QList<int> *a, const QList<int> *b) {
+        return a->size() < b->size();
+    });
+
+    result = *lists.first();
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i) {
+        QList<int> next;
+        std::set_intersection(result.cbegin(), result.cend(),
+                              lists.at(i)->cbegin(), lists.at(i)->cend(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+
+    // Триграммы могут совпасть в другом порядке
+    result.erase(std::remove_if(result.begin(), result.end(), [this, &needle](int id) {
+        return !m_texts.value(id).contains(needle);
+    }), result.end());
+    return result;
+}
+
+/**
+ * @brief Разбиение строки на триграммы
+ * @param text Нормализованная строка
+ * @return QList<quint64> Ключи триграмм
+ *
+ * @details Ключ — три 16-битных кода символов в одном числе
+ */
+QList<quint64> TrigramIndex::trigrams(const QString &text)
+{
+    QList<quint64> keys;
+    if (text.size() < 3) {
+        return keys;
+    }
+
+    keys.reserve(text.size() - 2);
+    for (int i = 0; i + 2 < text.size(); ++i) {
+        const quint64 key = (quint64(text.at(i).unicode()) << 32)
+                          | (quint64(text.at(i + 1).unicode()) << 16)
+                          | quint64(text.at(i + 2).unicode());
+        keys.append(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
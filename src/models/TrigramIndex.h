@@ -0,0 +1,99 @@
+/**
+ * @file TrigramIndex.h
+ * @brief Заголовочный файл класса TrigramIndex
+ * @ingroup Models
+ *
+ * @class TrigramIndex
+ * @brief Инвертированный индекс по триграммам для поиска подстрок
+ *
+ * Текст каждой записи нормализуется (приведение регистра через
+ * QString::toCaseFolded(), «ё» заменяется на «е», все, кроме букв и цифр,
+ * становится пробелом) и разбивается на триграммы. Для каждой триграммы
+ * хранится упорядоченный список id записей (postings list).
+ *
+ * Поиск пересекает списки триграмм запроса, начиная с самого короткого,
+ * и проверяет кандидатов точным вхождением подстроки. Запросы короче
+ * трех символов проверяются перебором нормализованных строк.
+ *
+ * Класс не синхронизирован: индекс строится в фоновом потоке и затем
+ * передается в поток владельца целиком или вливается в его индекс merge().
+ */
+
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class TrigramIndex
+{
+public:
+    /**
+     * @brief Нормализовать строку для индексации и поиска
+     * @param text Исходная строка
+     * @return QString Строка без регистра, с «е» вместо «ё» и одиночными пробелами
+     */
+    static QString normalize(const QString &text);
+
+    /**
+     * @brief Добавить или заменить текст записи
+     * @param id Идентификатор записи
+     * @param text Текст записи
+     */
+    void insert(int id, const QString &text);
+
+    /**
+     * @brief Удалить запись из индекса
+     * @param id Идентификатор записи
+     */
+    void remove(int id);
+
+    /**
+     * @brief Влить записи другого индекса
+     * @param other Индекс, построенный отдельно
+     *
+     * @details Записи other заменяют записи с теми же id. Триграммы
+     * не пересчитываются: списки id сливаются, поэтому вливание части,
+     * построенной в фоне, в потоке владельца дешевле вставки ее строк.
+     */
+    void merge(const TrigramIndex &other);
+
+    /**
+     * @brief Проверить наличие записи
+     * @param id Идентификатор записи
+     * @return bool true если запись проиндексирована
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief Удалить все записи
+     */
+    void clear();
+
+    /**
+     * @brief Получить количество записей
+     * @return int Количество проиндексированных записей
+     */
+    int size() const;
+
+    /**
+     * @brief Найти записи, содержащие подстроку
+     * @param query Строка поиска (нормализуется)
+     * @return QList<int> Идентификаторы по возрастанию
+     */
+    QList<int> search(const QString &query) const;
+
+private:
+    /**
+     * @brief Получить триграммы нормализованной строки
+     * @param text Нормализованная строка
+     * @return QList<quint64> Уникальные ключи триграмм
+     */
+    static QList<quint64> trigrams(const QString &text);
+
+    QHash<quint64, QList<int>> m_postings;  ///< Триграмма -> id по возрастанию
+    QHash<int, QString> m_texts;            ///< id -> нормализованный текст
+};
+
+#endif // TRIGRAMINDEX_H
@@ -0,0 +1,146 @@
+/**
+ * @file WriteBatcher.cpp
+ * @brief Реализация класса WriteBatcher
+ * @ingroup Models
+ */
+
+#include "WriteBatcher.h"
+#include <QDebug>
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Конструктор WriteBatcher
+ * @param executor Функция выполнения пакета
+ * @param parent Родительский QObject
+ *
+ * @details Окно и размер пакета берутся из UNIVERSITY_WRITE_BATCH_MS
+ * и UNIVERSITY_WRITE_BATCH_SIZE
+ */
+WriteBatcher::WriteBatcher(const Executor &executor, QObject *parent)
+    : QObject(parent)
+    , m_executor(executor)
+    , m_maxOperations(DEFAULT_MAX_OPERATIONS)
+{
+    bool ok = false;
+    const int window = qEnvironmentVariableIntValue("UNIVERSITY_WRITE_BATCH_MS", &ok);
+    setWindow(ok ? window : DEFAULT_WINDOW);
+
+    const int maxOperations = qEnvironmentVariableIntValue("UNIVERSITY_WRITE_BATCH_SIZE", &ok);
+    if (ok) {
+        setMaxOperations(maxOperations);
+    }
+
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &WriteBatcher::flush);
+}
+
+/**
+ * @brief Постановка операции в очередь
+ * @param operation Операция
+ * @return QFuture<WriteResult> Результат операции
+ *
+ * @details Окно отсчитывается от первой операции пакета и не продлевается
+ * следующими, поэтому задержка записи не больше window()
+ */
+QFuture<WriteResult> WriteBatcher::enqueue(const WriteOperation &operation)
+{
+    auto promise = std::make_shared<QPromise<WriteResult>>();
+    QFuture<WriteResult> future = promise->future();
+    promise->start();
+    m_pending.append({operation, promise});
+
+    if (m_pending.size() >= m_maxOperations) {
+        flush();
+    } else if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+    return future;
+}
+
+/**
+ * @brief Отправка накопленных операций
+ * @return QFuture<QList<WriteResult>> Результаты пакета
+ *
+ * @details Результаты раздаются операциям в потоке владельца. Если пакет
+ * не выполнен (рабочий поток остановлен), обещания уничтожаются
+ * незавершенными и QFuture операций переходят в состояние canceled.
+ */
+QFuture<QList<WriteResult>> WriteBatcher::flush()
+{
+    m_timer.stop();
+    if (m_pending.isEmpty()) {
+        return QFuture<QList<WriteResult>>();
+    }
+
+    const QList<Pending> batch = std::exchange(m_pending, {});
+    QList<WriteOperation> operations;
+    operations.reserve(batch.size());
+    for (const Pending &pending : batch) {
+        operations.append(pending.operation);
+    }
+
+    QFuture<QList<WriteResult>> future = m_executor(operations);
+    future.then(this, [this, batch](const QList<WriteResult> &results) {
+        int failed = 0;
+        for (qsizetype i = 0; i < batch.size(); ++i) {
+            const WriteResult result = results.value(i);
+            if (!result.ok) {
+                ++failed;
+            }
+            batch.at(i).promise->addResult(result);
+            batch.at(i).promise->finish();
+        }
+        if (failed > 0) {
+            qWarning() << "Пакет записи:" << failed << "из" << batch.size() << "операций не выполнено";
+        }
+        emit batchCompleted(static_cast<int>(batch.size()), failed);
+    });
+    return future;
+}
+
+/**
+ * @brief Получение количества операций в очереди
+ * @return int Количество операций
+ */
+int WriteBatcher::pendingCount() const
+{
+    return static_cast<int>(m_pending.size());
+}
+
+/**
+ * @brief Получение окна накопления
+ * @return int Миллисекунды
+ */
+int WriteBatcher::window() const
+{
+    return m_timer.interval();
+}
+
+/**
+ * @brief Установка окна накопления
+ * @param msecs Миллисекунды
+ */
+void WriteBatcher::setWindow(int msecs)
+{
+    m_timer.setInterval(std::max(0, msecs));
+}
+
+/**
+ * @brief Получение максимального размера пакета
+ * @return int Количество операций
+ */
+int WriteBatcher::maxOperations() const
+{
+    return m_maxOperations;
+}
+
+/**
+ * @brief Установка максимального размера пакета
+ * @param count Количество операций
+ */
+void WriteBatcher::setMaxOperations(int count)
+{
+    m_maxOperations = std::max(1, count);
+}
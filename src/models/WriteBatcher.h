@@ -0,0 +1,138 @@
+/**
+ * @file WriteBatcher.h
+ * @brief Заголовочный файл класса WriteBatcher
+ * @ingroup Models
+ *
+ * @class WriteBatcher
+ * @brief Очередь операций записи, выполняемых пакетами
+ *
+ * Операции из интерфейса (добавление и удаление записей) не отправляются
+ * в базу по одной: очередь собирает их в течение window() миллисекунд
+ * после первой операции или до maxOperations() операций и передает
+ * пакетом функции выполнения (AsyncDatabaseManager::applyWrites()).
+ * Пакет выполняется в одной транзакции, поэтому удаление 50 записей
+ * стоит одну фиксацию на сервере, а модели получают по одному сигналу
+ * на таблицу вместо 50.
+ *
+ * Каждая операция получает собственный QFuture<WriteResult>, так что
+ * об ошибке можно сообщить по конкретной записи.
+ *
+ * Окно задается переменной окружения UNIVERSITY_WRITE_BATCH_MS
+ * (по умолчанию DEFAULT_WINDOW), размер пакета — UNIVERSITY_WRITE_BATCH_SIZE
+ * (по умолчанию DEFAULT_MAX_OPERATIONS). Окно 0 объединяет только
+ * операции, поставленные в очередь за одну итерацию цикла событий.
+ *
+ * Объект не потокобезопасен и используется в потоке владельца.
+ */
+
+#ifndef WRITEBATCHER_H
+#define WRITEBATCHER_H
+
+#include <QObject>
+#include <QFuture>
+#include <QList>
+#include <QPromise>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include "WriteOperation.h"
+
+class WriteBatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Функция выполнения пакета
+     * @details Возвращает результаты в порядке операций
+     */
+    using Executor = std::function<QFuture<QList<WriteResult>>(const QList<WriteOperation> &)>;
+
+    /**
+     * @brief Окно накопления по умолчанию, мс
+     */
+    static constexpr int DEFAULT_WINDOW = 20;
+
+    /**
+     * @brief Размер пакета по умолчанию
+     */
+    static constexpr int DEFAULT_MAX_OPERATIONS = 100;
+
+    /**
+     * @brief Конструктор
+     * @param executor Функция выполнения пакета
+     * @param parent Родительский QObject
+     */
+    explicit WriteBatcher(const Executor &executor, QObject *parent = nullptr);
+
+    /**
+     * @brief Поставить операцию в очередь
+     * @param operation Операция
+     * @return QFuture<WriteResult> Результат операции после фиксации пакета;
+     * отменяется, если пакет не был выполнен
+     */
+    QFuture<WriteResult> enqueue(const WriteOperation &operation);
+
+    /**
+     * @brief Отправить накопленные операции, не дожидаясь окна
+     * @return QFuture<QList<WriteResult>> Результаты пакета или пустой
+     * QFuture, если очередь пуста
+     */
+    QFuture<QList<WriteResult>> flush();
+
+    /**
+     * @brief Получить количество операций в очереди
+     * @return int Операции, еще не отправленные в базу
+     */
+    int pendingCount() const;
+
+    /**
+     * @brief Получить окно накопления
+     * @return int Миллисекунды
+     */
+    int window() const;
+
+    /**
+     * @brief Задать окно накопления
+     * @param msecs Миллисекунды, отрицательные значения считаются нулем
+     */
+    void setWindow(int msecs);
+
+    /**
+     * @brief Получить максимальный размер пакета
+     * @return int Количество операций
+     */
+    int maxOperations() const;
+
+    /**
+     * @brief Задать максимальный размер пакета
+     * @param count Количество операций, не меньше 1
+     */
+    void setMaxOperations(int count);
+
+signals:
+    /**
+     * @brief Сигнал о выполнении пакета
+     * @param operations Количество операций в пакете
+     * @param failed Количество неудачных операций
+     */
+    void batchCompleted(int operations, int failed);
+
+private:
+    /**
+     * @struct Pending
+     * @brief Операция в очереди и обещание ее результата
+     */
+    struct Pending
+    {
+        WriteOperation operation;                       ///< Операция
+        std::shared_ptr<QPromise<WriteResult>> promise; ///< Результат для вызывающего
+    };
+
+    Executor m_executor;        ///< Выполнение пакета
+    QTimer m_timer;             ///< Окно накопления
+    QList<Pending> m_pending;   ///< Операции в очереди
+    int m_maxOperations;        ///< Максимальный размер пакета
+};
+
+#endif // WRITEBATCHER_H
@@ -0,0 +1,141 @@
+/**
+ * @file WriteOperation.h
+ * @brief Операции записи для пакетного выполнения
+ * @ingroup Models
+ *
+ * @struct WriteOperation
+ * @brief Одна операция записи: добавление или удаление записи,
+ * запись студента на предмет или назначение преподавателя
+ *
+ * Операции накапливает WriteBatcher, а выполняет пакетом
+ * DatabaseManager::applyWrites() в одной транзакции.
+ *
+ * @struct WriteResult
+ * @brief Результат одной операции пакета
+ */
+
+#ifndef WRITEOPERATION_H
+#define WRITEOPERATION_H
+
+#include <QString>
+
+struct WriteOperation
+{
+    /**
+     * @brief Вид операции
+     */
+    enum Type {
+        AddTeacher,     ///< Добавить преподавателя (name, department)
+        AddStudent,     ///< Добавить студента (name, grade)
+        AddSubject,     ///< Добавить предмет (name)
+        DeleteTeacher,  ///< Удалить преподавателя (id)
+        DeleteStudent,  ///< Удалить студента (id)
+        DeleteSubject,  ///< Удалить предмет (id)
+        EnrollStudent,  ///< Записать студента на предмет (id студента, subjectId, grade)
+        AssignTeacher   ///< Назначить преподавателя на предмет (id преподавателя, subjectId)
+    };
+
+    Type type = AddTeacher; ///< Вид операции
+    int id = 0;             ///< Идентификатор удаляемой записи, студента или преподавателя
+    int subjectId = 0;      ///< Идентификатор предмета для записи и назначения
+    QString name;           ///< Имя или название новой записи
+    QString department;     ///< Кафедра нового преподавателя
+    int grade = 0;          ///< Оценка нового студента или оценка по предмету
+
+    /**
+     * @brief Создать операцию добавления преподавателя
+     * @param fullName Полное имя
+     * @param department Кафедра
+     * @return WriteOperation Операция
+     */
+    static WriteOperation addTeacher(const QString &fullName, const QString &department)
+    {
+        WriteOperation operation;
+        operation.type = AddTeacher;
+        operation.name = fullName;
+        operation.department = department;
+        return operation;
+    }
+
+    /**
+     * @brief Создать операцию добавления студента
+     * @param fullName Полное имя
+     * @param grade Оценка
+     * @return WriteOperation Операция
+     */
+    static WriteOperation addStudent(const QString &fullName, int grade)
+    {
+        WriteOperation operation;
+        operation.type = AddStudent;
+        operation.name = fullName;
+        operation.grade = grade;
+        return operation;
+    }
+
+    /**
+     * @brief Создать операцию добавления предмета
+     * @param name Название
+     * @return WriteOperation Операция
+     */
+    static WriteOperation addSubject(const QString &name)
+    {
+        WriteOperation operation;
+        operation.type = AddSubject;
+        operation.name = name;
+        return operation;
+    }
+
+    /**
+     * @brief Создать операцию удаления
+     * @param type DeleteTeacher, DeleteStudent или DeleteSubject
+     * @param id Идентификатор записи
+     * @return WriteOperation Операция
+     */
+    static WriteOperation remove(Type type, int id)
+    {
+        WriteOperation operation;
+        operation.type = type;
+        operation.id = id;
+        return operation;
+    }
+
+    /**
+     * @brief Создать операцию записи студента на предмет
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка или 0
+     * @return WriteOperation Операция
+     */
+    static WriteOperation enroll(int studentId, int subjectId, int grade)
+    {
+        WriteOperation operation;
+        operation.type = EnrollStudent;
+        operation.id = studentId;
+        operation.subjectId = subjectId;
+        operation.grade = grade;
+        return operation;
+    }
+
+    /**
+     * @brief Создать операцию назначения преподавателя на предмет
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return WriteOperation Операция
+     */
+    static WriteOperation assign(int teacherId, int subjectId)
+    {
+        WriteOperation operation;
+        operation.type = AssignTeacher;
+        operation.id = teacherId;
+        operation.subjectId = subjectId;
+        return operation;
+    }
+};
+
+struct WriteResult
+{
+    bool ok = false;    ///< Операция выполнена и зафиксирована
+    int id = 0;         ///< Идентификатор добавленной, удаленной или связанной записи
+};
+
+#endif // WRITEOPERATION_H
@@ -0,0 +1,375 @@
+/**
+ * @file GradeAnalytics.cpp
+ * @brief Реализация класса GradeAnalytics
+ * @ingroup ViewModels
+ */
+
+#include "GradeAnalytics.h"
+#include <QVariantMap>
+#include <algorithm>
+
+/**
+ * @brief Проверка допустимости оценки
+ * @param grade Оценка
+ * @return bool true для оценок от MIN_GRADE до MAX_GRADE
+ */
+static bool isGradeInRange(int grade)
+{
+    return grade >= GradeAnalytics::MIN_GRADE && grade <= GradeAnalytics::MAX_GRADE;
+}
+
+/**
+ * @brief Порядок списка лучших студентов
+ * @param a Первая запись
+ * @param b Вторая запись
+ * @return bool true если a стоит раньше b (ORDER BY grade DESC, id)
+ */
+static bool ranksHigher(const StudentRecord &a, const StudentRecord &b)
+{
+    return a.grade != b.grade ? a.grade > b.grade : a.id < b.id;
+}
+
+/**
+ * @brief Порядок списка худших студентов
+ * @param a Первая запись
+ * @param b Вторая запись
+ * @return bool true если a стоит раньше b (ORDER BY grade, id)
+ */
+static bool ranksLower(const StudentRecord &a, const StudentRecord &b)
+{
+    return a.grade != b.grade ? a.grade < b.grade : a.id < b.id;
+}
+
+/**
+ * @brief Вставка записи в список крайних студентов
+ * @param edge Список крайних студентов
+ * @param record Новая запись
+ * @param before Порядок списка
+ * @param complete Список содержал всех студентов с оценкой
+ *
+ * @details Запись за последней строкой неполного списка не вставляется:
+ * между ними могут быть студенты, которых нет в памяти
+ */
+template <typename Less>
+static void insertEdge(QList<StudentRecord> &edge, const StudentRecord &record, Less before, bool complete)
+{
+    const auto it = std::lower_bound(edge.begin(), edge.end(), record, before);
+    if (it == edge.end() && !complete) {
+        return;
+    }
+    edge.insert(it - edge.begin(), record);
+    if (edge.size() > GradeAnalytics::SUMMARY_LIMIT) {
+        edge.removeLast();
+    }
+}
+
+/**
+ * @brief Удаление записи из списка крайних студентов
+ * @param edge Список крайних студентов
+ * @param id Идентификатор
+ */
+static void removeEdge(QList<StudentRecord> &edge, int id)
+{
+    edge.removeIf([id](const StudentRecord &record) { return record.id == id; });
+}
+
+/**
+ * @brief Конструктор
+ * @param parent Родительский QObject
+ */
+GradeAnalytics::GradeAnalytics(QObject *parent)
+    : QObject(parent)
+    , m_histogram{}
+    , m_count(0)
+    , m_sum(0)
+    , m_loading(false)
+    , m_stale(false)
+{
+}
+
+/**
+ * @brief Начало загрузки сводки
+ *
+ * @details Изменения, о которых сообщили до запроса, сводка уже учтет
+ */
+void GradeAnalytics::beginLoad()
+{
+    m_stale = false;
+    if (!m_loading) {
+        m_loading = true;
+        emit loadingChanged();
+    }
+}
+
+/**
+ * @brief Замена данных сводкой
+ * @param summary Гистограмма и крайние студенты
+ *
+ * @details Изменения, пришедшие во время загрузки, могли как попасть
+ * в сводку, так и нет, поэтому вместо их повторного применения
+ * сводка запрашивается еще раз
+ */
+void GradeAnalytics::setSummary(const GradeSummary &summary)
+{
+    m_count = 0;
+    m_sum = 0;
+    for (int grade = MIN_GRADE; grade <= MAX_GRADE; ++grade) {
+        const qint64 count = summary.histogram[grade - MIN_GRADE];
+        m_histogram[grade - MIN_GRADE] = count;
+        m_count += count;
+        m_sum += count * grade;
+    }
+    m_top = summary.top.mid(0, SUMMARY_LIMIT);
+    m_bottom = summary.bottom.mid(0, SUMMARY_LIMIT);
+
+    if (m_loading) {
+        m_loading = false;
+        emit loadingChanged();
+    }
+    emit changed();
+
+    if (m_stale) {
+        emit reloadRequested();
+    }
+}
+
+/**
+ * @brief Учет добавленных студентов
+ * @param records Новые записи
+ */
+void GradeAnalytics::insertStudents(const QList<StudentRecord> &records)
+{
+    if (records.isEmpty()) {
+        return;
+    }
+    for (const StudentRecord &record : records) {
+        if (const StudentRecord *tracked = findTracked(record.id)) {
+            remove(*tracked);
+        }
+        add(record);
+    }
+    if (m_loading) {
+        m_stale = true;
+    }
+    emit changed();
+}
+
+/**
+ * @brief Учет измененных студентов
+ * @param records Записи после изменения
+ * @param previousGrades Оценки до изменения в порядке records
+ */
+void GradeAnalytics::updateStudents(const QList<StudentRecord> &records, const QList<int> &previousGrades)
+{
+    if (records.isEmpty()) {
+        return;
+    }
+    for (qsizetype i = 0; i < records.size(); ++i) {
+        const StudentRecord &record = records.at(i);
+        if (removeKnown(record.id, previousGrades.value(i))) {
+            add(record);
+        }
+    }
+    checkEdges();
+    if (m_loading) {
+        m_stale = true;
+    }
+    emit changed();
+}
+
+/**
+ * @brief Учет удаленных студентов
+ * @param records Удаленные записи
+ */
+void GradeAnalytics::removeStudents(const QList<StudentRecord> &records)
+{
+    if (records.isEmpty()) {
+        return;
+    }
+    for (const StudentRecord &record : records) {
+        removeKnown(record.id, record.grade);
+    }
+    checkEdges();
+    if (m_loading) {
+        m_stale = true;
+    }
+    emit changed();
+}
+
+/**
+ * @brief Получение количества студентов
+ * @return int Количество
+ */
+int GradeAnalytics::count() const
+{
+    return static_cast<int>(m_count);
+}
+
+/**
+ * @brief Получение среднего балла
+ * @return double Средний балл
+ */
+double GradeAnalytics::mean() const
+{
+    return m_count == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+}
+
+/**
+ * @brief Получение распределения оценок
+ * @return QVariantList Количество по оценкам 1..5
+ */
+QVariantList GradeAnalytics::histogram() const
+{
+    QVariantList result;
+    result.reserve(MAX_GRADE);
+    for (qint64 count : m_histogram) {
+        result.append(count);
+    }
+    return result;
+}
+
+/**
+ * @brief Получение лучших студентов
+ * @return QVariantList Студенты
+ */
+QVariantList GradeAnalytics::topStudents() const
+{
+    return pick(m_top);
+}
+
+/**
+ * @brief Получение худших студентов
+ * @return QVariantList Студенты
+ */
+QVariantList GradeAnalytics::bottomStudents() const
+{
+    return pick(m_bottom);
+}
+
+/**
+ * @brief Проверка загрузки
+ * @return bool Состояние загрузки
+ */
+bool GradeAnalytics::isLoading() const
+{
+    return m_loading;
+}
+
+/**
+ * @brief Поиск записи среди крайних студентов
+ * @param id Идентификатор
+ * @return const StudentRecord* Запись или nullptr
+ */
+const StudentRecord *GradeAnalytics::findTracked(int id) const
+{
+    for (const QList<StudentRecord> *edge : {&m_top, &m_bottom}) {
+        for (const StudentRecord &record : *edge) {
+            if (record.id == id) {
+                return &record;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Учет новой записи
+ * @param record Запись студента
+ */
+void GradeAnalytics::add(const StudentRecord &record)
+{
+    if (!isGradeInRange(record.grade)) {
+        return;
+    }
+
+    // Полнота списков проверяется до увеличения счетчика
+    const bool topComplete = m_top.size() == m_count;
+    const bool bottomComplete = m_bottom.size() == m_count;
+    insertEdge(m_top, record, ranksHigher, topComplete);
+    insertEdge(m_bottom, record, ranksLower, bottomComplete);
+
+    ++m_histogram[record.grade - MIN_GRADE];
+    ++m_count;
+    m_sum += record.grade;
+}
+
+/**
+ * @brief Удаление записи с известной оценкой
+ * @param record Запись студента
+ */
+void GradeAnalytics::remove(const StudentRecord &record)
+{
+    // Запись копируется: ссылка может указывать в изменяемый список
+    const StudentRecord removed = record;
+    removeEdge(m_top, removed.id);
+    removeEdge(m_bottom, removed.id);
+
+    --m_histogram[removed.grade - MIN_GRADE];
+    --m_count;
+    m_sum -= removed.grade;
+}
+
+/**
+ * @brief Удаление записи с оценкой из списка крайних или из аргумента
+ * @param id Идентификатор
+ * @param grade Оценка до изменения или 0
+ * @return bool false если оценка неизвестна
+ *
+ * @details Оценка из списка крайних надежнее: она обновляется вместе
+ * с записью
+ */
+bool GradeAnalytics::removeKnown(int id, int grade)
+{
+    if (const StudentRecord *tracked = findTracked(id)) {
+        remove(*tracked);
+        return true;
+    }
+    if (!isGradeInRange(grade)) {
+        markStale();
+        return false;
+    }
+    remove(StudentRecord{id, QString(), grade});
+    return true;
+}
+
+/**
+ * @brief Отметка устаревшей сводки
+ */
+void GradeAnalytics::markStale()
+{
+    const bool wasStale = m_stale;
+    m_stale = true;
+    if (!m_loading && !wasStale) {
+        emit reloadRequested();
+    }
+}
+
+/**
+ * @brief Проверка количества крайних студентов
+ */
+void GradeAnalytics::checkEdges()
+{
+    const qint64 needed = std::min<qint64>(TOP_COUNT, m_count);
+    if (m_top.size() < needed || m_bottom.size() < needed) {
+        markStale();
+    }
+}
+
+/**
+ * @brief Выбор студентов с края
+ * @param edge Список крайних студентов
+ * @return QVariantList Студенты
+ */
+QVariantList GradeAnalytics::pick(const QList<StudentRecord> &edge)
+{
+    QVariantList result;
+    for (qsizetype pos = 0; pos < edge.size() && result.size() < TOP_COUNT; ++pos) {
+        const StudentRecord &record = edge.at(pos);
+        QVariantMap student;
+        student.insert("id", record.id);
+        student.insert("fullName", record.fullName);
+        student.insert("grade", record.grade);
+        result.append(student);
+    }
+    return result;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file GradeAnalytics.h
+ * @brief Заголовочный файл класса GradeAnalytics
+ * @ingroup ViewModels
+ *
+ * @class GradeAnalytics
+ * @brief Распределение оценок, средний балл и лучшие/худшие студенты
+ *
+ * Гистограмма и средний балл считаются в БД (GROUP BY grade),
+ * лучшие и худшие студенты запрашиваются через ORDER BY grade ... LIMIT
+ * (см. StorageBackend::getGradeSummary()). В памяти хранятся только
+ * гистограмма, сумма оценок и до SUMMARY_LIMIT студентов с каждого края,
+ * поэтому размер аналитики не зависит от размера таблицы.
+ *
+ * Поверх загруженной сводки изменения применяются за O(1):
+ * - добавление учитывает оценку новой записи в гистограмме и сумме,
+ *   а при попадании на край вставляет запись в список крайних
+ * - удаление использует оценку, возвращенную DELETE ... RETURNING
+ *   (для удалений другими клиентами — пришедшую в уведомлении)
+ * - изменение использует прежнюю оценку из уведомления
+ *
+ * Сводка перечитывается (reloadRequested()), только когда после удалений
+ * или изменений на краю осталось меньше TOP_COUNT студентов, а в таблице
+ * их больше, когда прежняя оценка неизвестна, и когда изменения пришли
+ * во время загрузки и могли как попасть в сводку, так и нет.
+ *
+ * @property int GradeAnalytics::count
+ * @brief Количество студентов
+ *
+ * @property double GradeAnalytics::mean
+ * @brief Средний балл (0 если студентов нет)
+ *
+ * @property QVariantList GradeAnalytics::histogram
+ * @brief Количество студентов с оценками 1..5
+ *
+ * @property QVariantList GradeAnalytics::topStudents
+ * @brief Студенты с самыми высокими оценками (id, fullName, grade)
+ *
+ * @property QVariantList GradeAnalytics::bottomStudents
+ * @brief Студенты с самыми низкими оценками (id, fullName, grade)
+ *
+ * @property bool GradeAnalytics::loading
+ * @brief Идет загрузка сводки оценок
+ */
+
+#ifndef GRADEANALYTICS_H
+#define GRADEANALYTICS_H
+
+#include <QObject>
+#include <QList>
+#include <QVariantList>
+#include <array>
+#include "../models/StorageBackend.h"
+
+class GradeAnalytics : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY changed)
+    Q_PROPERTY(double mean READ mean NOTIFY changed)
+    Q_PROPERTY(QVariantList histogram READ histogram NOTIFY changed)
+    Q_PROPERTY(QVariantList topStudents READ topStudents NOTIFY changed)
+    Q_PROPERTY(QVariantList bottomStudents READ bottomStudents NOTIFY changed)
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+
+public:
+    /**
+     * @brief Минимальная оценка
+     */
+    static constexpr int MIN_GRADE = 1;
+
+    /**
+     * @brief Максимальная оценка
+     */
+    static constexpr int MAX_GRADE = 5;
+
+    /**
+     * @brief Количество лучших и худших студентов
+     */
+    static constexpr int TOP_COUNT = 5;
+
+    /**
+     * @brief Сколько студентов запрашивается с каждого края
+     * @details Запас сверх TOP_COUNT позволяет удалять показанных
+     * студентов без повторного запроса
+     */
+    static constexpr int SUMMARY_LIMIT = TOP_COUNT * 4;
+
+    /**
+     * @brief Конструктор
+     * @param parent Родительский QObject
+     */
+    explicit GradeAnalytics(QObject *parent = nullptr);
+
+    /**
+     * @brief Отметить начало загрузки сводки
+     * @details Изменения до setSummary() снова запросят сводку после нее
+     */
+    void beginLoad();
+
+    /**
+     * @brief Заменить данные сводкой из БД
+     * @param summary Гистограмма и крайние студенты
+     */
+    void setSummary(const GradeSummary &summary);
+
+    /**
+     * @brief Учесть добавленных студентов
+     * @param records Новые записи
+     */
+    void insertStudents(const QList<StudentRecord> &records);
+
+    /**
+     * @brief Учесть измененных студентов
+     * @param records Записи после изменения
+     * @param previousGrades Оценки до изменения в порядке records, 0 если неизвестна
+     */
+    void updateStudents(const QList<StudentRecord> &records, const QList<int> &previousGrades);
+
+    /**
+     * @brief Учесть удаленных студентов
+     * @param records Удаленные записи с оценкой (0, если неизвестна)
+     */
+    void removeStudents(const QList<StudentRecord> &records);
+
+    /**
+     * @brief Получить количество студентов с оценкой
+     * @return int Количество
+     */
+    int count() const;
+
+    /**
+     * @brief Получить средний балл
+     * @return double Средний балл
+     */
+    double mean() const;
+
+    /**
+     * @brief Получить распределение оценок
+     * @return QVariantList Пять чисел для оценок 1..5
+     */
+    QVariantList histogram() const;
+
+    /**
+     * @brief Получить лучших студентов
+     * @return QVariantList Объекты {id, fullName, grade}
+     */
+    QVariantList topStudents() const;
+
+    /**
+     * @brief Получить худших студентов
+     * @return QVariantList Объекты {id, fullName, grade}
+     */
+    QVariantList bottomStudents() const;
+
+    /**
+     * @brief Проверить, идет ли загрузка сводки
+     * @return bool true между beginLoad() и setSummary()
+     */
+    bool isLoading() const;
+
+signals:
+    /**
+     * @brief Сигнал об изменении показателей
+     */
+    void changed();
+
+    /**
+     * @brief Сигнал о начале или завершении загрузки
+     */
+    void loadingChanged();
+
+    /**
+     * @brief Сигнал о том, что сводку нужно перечитать из БД
+     */
+    void reloadRequested();
+
+private:
+    /**
+     * @brief Найти запись среди крайних студентов
+     * @param id Идентификатор
+     * @return const StudentRecord* Запись с известной оценкой или nullptr
+     */
+    const StudentRecord *findTracked(int id) const;
+
+    /**
+     * @brief Учесть новую запись без сигнала
+     * @param record Запись студента
+     */
+    void add(const StudentRecord &record);
+
+    /**
+     * @brief Убрать запись с известной оценкой без сигнала
+     * @param record Запись студента
+     */
+    void remove(const StudentRecord &record);
+
+    /**
+     * @brief Убрать запись, взяв оценку из списка крайних или из аргумента
+     * @param id Идентификатор
+     * @param grade Оценка до изменения или 0
+     * @return bool false если оценка неизвестна и сводка отмечена устаревшей
+     */
+    bool removeKnown(int id, int grade);
+
+    /**
+     * @brief Отметить сводку устаревшей
+     * @details Вне загрузки сразу отправляет reloadRequested()
+     */
+    void markStale();
+
+    /**
+     * @brief Проверить, хватает ли крайних студентов для показа
+     * @details Если на краю осталось меньше TOP_COUNT записей, а в таблице
+     * их больше, сводка отмечается устаревшей
+     */
+    void checkEdges();
+
+    /**
+     * @brief Собрать студентов с края
+     * @param edge Список крайних студентов
+     * @return QVariantList Объекты {id, fullName, grade}
+     */
+    static QVariantList pick(const QList<StudentRecord> &edge);
+
+    std::array<qint64, MAX_GRADE> m_histogram;  ///< Количество по оценкам 1..5
+    qint64 m_count;                     ///< Студентов с оценкой
+    qint64 m_sum;                       ///< Сумма оценок
+    QList<StudentRecord> m_top;         ///< Первые студенты по убыванию оценки, затем id
+    QList<StudentRecord> m_bottom;      ///< Первые студенты по возрастанию оценки, затем id
+
+    bool m_loading;                     ///< Идет загрузка сводки
+    bool m_stale;                       ///< Сводка устарела, нужен повторный запрос
+};
+
+#endif // GRADEANALYTICS_H
@@ -0,0 +1,324 @@
+/**
+ * @file RecordFilterModel.cpp
+ * @brief Реализация класса RecordFilterModel
+ * @ingroup ViewModels
+ */
+
+#include "RecordFilterModel.h"
+#include <QFuture>
+#include <QPromise>
+#include <QThreadPool>
+#include <algorithm>
+#include <memory>
+
+/**
+ * @brief Конструктор модели
+ * @param parent Родительский QObject
+ */
+RecordFilterModel::RecordFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+    , m_buildGeneration(0)
+    , m_partialBuilds(0)
+    , m_rebuilding(false)
+    , m_indexing(false)
+{
+}
+
+/**
+ * @brief Получение строки фильтра
+ * @return QString Строка фильтра
+ */
+QString RecordFilterModel::filterText() const
+{
+    return m_filterText;
+}
+
+/**
+ * @brief Установка строки фильтра
+ * @param text Строка фильтра
+ *
+ * @details Поиск по индексу выполняется синхронно: пересечение списков
+ * триграмм занимает доли миллисекунды и на сотнях тысяч строк
+ */
+void RecordFilterModel::setFilterText(const QString &text)
+{
+    if (m_filterText == text) {
+        return;
+    }
+    m_filterText = text;
+
+    const QString needle = TrigramIndex::normalize(text);
+    if (needle != m_needle) {
+        m_needle = needle;
+        m_matches = m_needle.isEmpty() ? QList<int>() : m_index.search(m_needle);
+        invalidateRowsFilter();
+    }
+    emit filterTextChanged();
+}
+
+/**
+ * @brief Проверка перестройки индекса
+ * @return bool Состояние перестройки
+ */
+bool RecordFilterModel::isIndexing() const
+{
+    return m_indexing;
+}
+
+/**
+ * @brief Проверка строки фильтром
+ * @param sourceRow Строка исходной модели
+ * @param sourceParent Родительский индекс
+ * @return bool Результат проверки
+ */
+bool RecordFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    if (m_needle.isEmpty() || sourceParent.isValid()) {
+        return true;
+    }
+    return std::binary_search(m_matches.cbegin(), m_matches.cend(), m_idAt(sourceRow));
+}
+
+/**
+ * @brief Подключение к исходной модели
+ * @param model Исходная модель
+ * @param idAt Функция получения id строки
+ * @param textAt Функция получения текста строки
+ */
+void RecordFilterModel::setAccessors(QAbstractItemModel *model, const IdAccessor &idAt, const TextAccessor &textAt)
+{
+    if (sourceModel()) {
+        disconnect(sourceModel(), nullptr, this, nullptr);
+    }
+
+    m_idAt = idAt;
+    m_textAt = textAt;
+
+    connect(model, &QAbstractItemModel::rowsInserted, this,
+            [this](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid()) {
+            indexRows(first, last);
+        }
+    });
+    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+            [this](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid()) {
+            unindexRows(first, last);
+        }
+    });
+    connect(model, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        indexRows(topLeft.row(), bottomRight.row());
+    });
+    connect(model, &QAbstractItemModel::modelReset, this, &RecordFilterModel::rebuild);
+
+    setSourceModel(model);
+    rebuild();
+}
+
+/**
+ * @brief Перестройка индекса
+ *
+ * @details Текст строк копируется в потоке GUI, индекс строится в общем
+ * пуле потоков. Результат устаревшей перестройки отбрасывается по номеру.
+ * Перебираются все rowCount() строк исходной модели, включая временные,
+ * — тот же диапазон, что покрывают m_idAt и m_textAt.
+ */
+void RecordFilterModel::rebuild()
+{
+    const int rows = sourceModel() ? sourceModel()->rowCount() : 0;
+    QList<std::pair<int, QString>> snapshot;
+    snapshot.reserve(rows);
+    for (int row = 0; row < rows; ++row) {
+        snapshot.append({m_idAt(row), m_textAt(row)});
+    }
+
+    const quint64 generation = ++m_buildGeneration;
+    m_pending.clear();
+    m_rebuilding = true;
+    updateIndexing();
+
+    auto promise = std::make_shared<QPromise<TrigramIndex>>();
+    QFuture<TrigramIndex> future = promise->future();
+    promise->start();
+
+    QThreadPool::globalInstance()->start([promise, snapshot = std::move(snapshot)]() {
+        TrigramIndex index;
+        for (const auto &row : snapshot) {
+            index.insert(row.first, row.second);
+        }
+        promise->addResult(std::move(index));
+        promise->finish();
+    });
+
+    future.then(this, [this, generation](const TrigramIndex &index) {
+        if (generation != m_buildGeneration) {
+            return;
+        }
+
+        m_index = index;
+        for (const PendingChange &change : std::as_const(m_pending)) {
+            if (change.removed) {
+                m_index.remove(change.id);
+            } else {
+                m_index.insert(change.id, change.text);
+            }
+        }
+        m_pending.clear();
+
+        m_rebuilding = false;
+        updateIndexing();
+
+        if (!m_needle.isEmpty()) {
+            m_matches = m_index.search(m_needle);
+            invalidateRowsFilter();
+        }
+    });
+}
+
+/**
+ * @brief Фоновая индексация вставленных строк
+ * @param first Первая строка
+ * @param last Последняя строка
+ *
+ * @details Результат отбрасывается, если после запуска началась полная
+ * перестройка: ее снимок уже содержит эти строки. Изменения, пришедшие
+ * во время индексации, повторяются после вливания, начиная с позиции
+ * m_pending на момент запуска.
+ */
+void RecordFilterModel::indexInBackground(int first, int last)
+{
+    if (m_rebuilding) {
+        // Результат перестройки заменит индекс целиком, поэтому строки
+        // должны попасть в ее снимок
+        rebuild();
+        return;
+    }
+
+    QList<std::pair<int, QString>> snapshot;
+    snapshot.reserve(last - first + 1);
+    for (int row = first; row <= last; ++row) {
+        snapshot.append({m_idAt(row), m_textAt(row)});
+    }
+
+    const quint64 generation = m_buildGeneration;
+    const qsizetype pendingFrom = m_pending.size();
+    ++m_partialBuilds;
+    updateIndexing();
+
+    auto promise = std::make_shared<QPromise<TrigramIndex>>();
+    QFuture<TrigramIndex> future = promise->future();
+    promise->start();
+
+    QThreadPool::globalInstance()->start([promise, snapshot = std::move(snapshot)]() {
+        TrigramIndex index;
+        for (const auto &row : snapshot) {
+            index.insert(row.first, row.second);
+        }
+        promise->addResult(std::move(index));
+        promise->finish();
+    });
+
+    future.then(this, [this, generation, pendingFrom](const TrigramIndex &part) {
+        --m_partialBuilds;
+        if (generation == m_buildGeneration) {
+            m_index.merge(part);
+            for (qsizetype i = pendingFrom; i < m_pending.size(); ++i) {
+                const PendingChange &change = m_pending.at(i);
+                if (!part.contains(change.id)) {
+                    continue;
+                }
+                if (change.removed) {
+                    m_index.remove(change.id);
+                } else {
+                    m_index.insert(change.id, change.text);
+                }
+            }
+        }
+        updateIndexing();
+    });
+}
+
+/**
+ * @brief Обновление признака индексации
+ *
+ * @details Когда фоновых построений не осталось, отложенные изменения
+ * больше некому повторять
+ */
+void RecordFilterModel::updateIndexing()
+{
+    const bool indexing = m_rebuilding || m_partialBuilds > 0;
+    if (!indexing) {
+        m_pending.clear();
+    }
+    if (indexing != m_indexing) {
+        m_indexing = indexing;
+        emit indexingChanged();
+    }
+}
+
+/**
+ * @brief Индексация строк
+ * @param first Первая строка
+ * @param last Последняя строка
+ */
+void RecordFilterModel::indexRows(int first, int last)
+{
+    if (last - first + 1 > INCREMENTAL_LIMIT) {
+        // Крупная вставка (импорт, подгрузка страниц) индексируется в фоне,
+        // принадлежность фильтру проверяется сразу по тексту
+        if (!m_needle.isEmpty()) {
+            for (int row = first; row <= last; ++row) {
+                updateMatch(m_idAt(row), m_textAt(row));
+            }
+        }
+        indexInBackground(first, last);
+        return;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        const int id = m_idAt(row);
+        const QString text = m_textAt(row);
+        m_index.insert(id, text);
+        if (m_indexing) {
+            m_pending.append({id, text, false});
+        }
+        if (!m_needle.isEmpty()) {
+            updateMatch(id, text);
+        }
+    }
+}
+
+/**
+ * @brief Удаление строк из индекса
+ * @param first Первая строка
+ * @param last Последняя строка
+ */
+void RecordFilterModel::unindexRows(int first, int last)
+{
+    for (int row = first; row <= last; ++row) {
+        const int id = m_idAt(row);
+        m_index.remove(id);
+        if (m_indexing) {
+            m_pending.append({id, QString(), true});
+        }
+    }
+}
+
+/**
+ * @brief Обновление принадлежности записи фильтру
+ * @param id Идентификатор записи
+ * @param text Текст записи
+ */
+void RecordFilterModel::updateMatch(int id, const QString &text)
+{
+    const auto it = std::lower_bound(m_matches.begin(), m_matches.end(), id);
+    const bool present = it != m_matches.end() && *it == id;
+    const bool matches = TrigramIndex::normalize(text).contains(m_needle);
+
+    if (matches && !present) {
+        m_matches.insert(it - m_matches.begin(), id);
+    } else if (!matches && present) {
+        m_matches.erase(it);
+    }
+}
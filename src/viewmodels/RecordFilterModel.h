@@ -0,0 +1,205 @@
+/**
+ * @file RecordFilterModel.h
+ * @brief Заголовочный файл класса RecordFilterModel
+ * @ingroup ViewModels
+ *
+ * @class RecordFilterModel
+ * @brief Фильтр загруженных строк модели списка без запросов к БД
+ *
+ * Прокси-модель над RecordListModel. По тексту строк исходной модели
+ * строится TrigramIndex, а filterText отбирает строки, текст которых
+ * содержит строку фильтра (без учета регистра, «ё» равно «е»).
+ *
+ * Индекс поддерживается инкрементально по сигналам исходной модели:
+ * - вставка строк добавляет их в индекс (больше INCREMENTAL_LIMIT строк
+ *   за раз — индексируются в фоне и вливаются в индекс через TrigramIndex::merge())
+ * - удаление строк удаляет их из индекса
+ * - изменение строк переиндексирует их
+ * - сброс модели запускает перестройку индекса в фоновом потоке
+ *
+ * Пока индекс или его часть строится в фоне, изменения применяются
+ * к текущему индексу и повторяются после готовности фоновой части.
+ *
+ * Принадлежность новых и измененных строк фильтру проверяется
+ * напрямую по тексту, поэтому фильтр остается точным во время перестройки.
+ * canFetchMore()/fetchMore() передаются исходной модели, так что
+ * прокрутка отфильтрованного списка подгружает следующие страницы.
+ *
+ * @property QString RecordFilterModel::filterText
+ * @brief Строка фильтра. Пустая строка показывает все строки
+ *
+ * @property bool RecordFilterModel::indexing
+ * @brief Индекс или его часть строится в фоновом потоке
+ */
+
+#ifndef RECORDFILTERMODEL_H
+#define RECORDFILTERMODEL_H
+
+#include <QSortFilterProxyModel>
+#include <QList>
+#include <QString>
+#include <functional>
+#include "RecordListModel.h"
+#include "../models/TrigramIndex.h"
+
+class RecordFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    Q_PROPERTY(bool indexing READ isIndexing NOTIFY indexingChanged)
+
+public:
+    /**
+     * @brief Максимальное количество строк, индексируемых в потоке GUI за одну вставку
+     */
+    static constexpr int INCREMENTAL_LIMIT = 2000;
+
+    /**
+     * @brief Функция получения id строки исходной модели
+     */
+    using IdAccessor = std::function<int(int row)>;
+
+    /**
+     * @brief Функция получения индексируемого текста строки исходной модели
+     */
+    using TextAccessor = std::function<QString(int row)>;
+
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit RecordFilterModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Задать исходную модель
+     * @param model Модель списка записей
+     * @param text Функция получения индексируемого текста записи
+     *
+     * @details Индекс строится в фоне по уже загруженным строкам.
+     * Строки читаются через recordAtRow(), поэтому временные записи
+     * в конце списка индексируются и фильтруются наравне с остальными.
+     */
+    template <typename Record>
+    void setRecordSource(RecordListModel<Record> *model, std::function<QString(const Record &)> text)
+    {
+        setAccessors(model,
+                     [model](int row) { return model->recordAtRow(row).id; },
+                     [model, text](int row) { return text(model->recordAtRow(row)); });
+    }
+
+    /**
+     * @brief Получить строку фильтра
+     * @return QString Строка фильтра
+     */
+    QString filterText() const;
+
+    /**
+     * @brief Установить строку фильтра
+     * @param text Строка фильтра
+     */
+    void setFilterText(const QString &text);
+
+    /**
+     * @brief Проверить, строится ли индекс
+     * @return bool true пока идет фоновая перестройка или индексация вставки
+     */
+    bool isIndexing() const;
+
+signals:
+    /**
+     * @brief Сигнал об изменении строки фильтра
+     */
+    void filterTextChanged();
+
+    /**
+     * @brief Сигнал о начале или завершении перестройки индекса
+     */
+    void indexingChanged();
+
+protected:
+    /**
+     * @brief Проверить, проходит ли строка фильтр
+     * @param sourceRow Строка исходной модели
+     * @param sourceParent Родительский индекс
+     * @return bool true если id строки есть среди найденных
+     */
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    /**
+     * @struct PendingChange
+     * @brief Изменение, поступившее во время фоновой перестройки
+     */
+    struct PendingChange
+    {
+        int id = 0;             ///< Идентификатор записи
+        QString text;           ///< Новый текст записи
+        bool removed = false;   ///< Запись удалена
+    };
+
+    /**
+     * @brief Подключиться к исходной модели
+     * @param model Исходная модель
+     * @param idAt Функция получения id строки
+     * @param textAt Функция получения текста строки
+     *
+     * @details Сигналы подключаются до setSourceModel(), чтобы индекс
+     * обновлялся раньше, чем прокси перепроверит строки
+     */
+    void setAccessors(QAbstractItemModel *model, const IdAccessor &idAt, const TextAccessor &textAt);
+
+    /**
+     * @brief Перестроить индекс в фоновом потоке
+     */
+    void rebuild();
+
+    /**
+     * @brief Проиндексировать вставленные строки в фоновом потоке
+     * @param first Первая строка
+     * @param last Последняя строка
+     *
+     * @details Готовая часть вливается в текущий индекс. Если в это время
+     * идет полная перестройка, вместо этого перестройка запускается заново
+     */
+    void indexInBackground(int first, int last);
+
+    /**
+     * @brief Обновить признак индексации по числу фоновых построений
+     */
+    void updateIndexing();
+
+    /**
+     * @brief Проиндексировать строки исходной модели
+     * @param first Первая строка
+     * @param last Последняя строка
+     */
+    void indexRows(int first, int last);
+
+    /**
+     * @brief Удалить строки исходной модели из индекса
+     * @param first Первая строка
+     * @param last Последняя строка
+     */
+    void unindexRows(int first, int last);
+
+    /**
+     * @brief Обновить принадлежность записи текущему фильтру
+     * @param id Идентификатор записи
+     * @param text Текст записи
+     */
+    void updateMatch(int id, const QString &text);
+
+    IdAccessor m_idAt;              ///< Получение id строки исходной модели
+    TextAccessor m_textAt;          ///< Получение текста строки исходной модели
+    TrigramIndex m_index;           ///< Индекс загруженных строк
+    QString m_filterText;           ///< Строка фильтра
+    QString m_needle;               ///< Нормализованная строка фильтра
+    QList<int> m_matches;           ///< id строк, проходящих фильтр, по возрастанию
+    QList<PendingChange> m_pending; ///< Изменения во время перестройки
+    quint64 m_buildGeneration;      ///< Номер текущей перестройки
+    int m_partialBuilds;            ///< Фоновых индексаций вставок в работе
+    bool m_rebuilding;              ///< Идет полная перестройка
+    bool m_indexing;                ///< Идет перестройка или индексация вставки
+};
+
+#endif // RECORDFILTERMODEL_H
@@ -0,0 +1,675 @@
+/**
+ * @file RecordListModel.h
+ * @brief Шаблонная базовая модель списка записей
+ * @ingroup ViewModels
+ *
+ * @class RecordListModel
+ * @brief Базовая QAbstractListModel для записей, упорядоченных по id
+ *
+ * Хранит записи одного типа (TeacherRecord, StudentRecord, SubjectRecord)
+ * в порядке возрастания id и применяет изменения инкрементально:
+ * - setRecords() сравнивает новый набор с текущим и сообщает представлению
+ *   только о вставленных, удаленных и измененных диапазонах строк
+ * - insertRecord() и removeRecord() затрагивают ровно одну строку
+ * - insertRecords() добавляет пакет новых записей одним диапазоном строк
+ *
+ * Благодаря этому QML ListView не пересоздает делегаты и сохраняет позицию прокрутки.
+ * 
+ * Если задан загрузчик страниц (setPageLoader), модель работает в постраничном
+ * режиме: reload() загружает первую страницу, следующие страницы подгружаются
+ * через canFetchMore()/fetchMore() по мере прокрутки. Когда представление
+ * запрашивает строки ближе prefetchDistance() к концу, следующая страница
+ * запрашивается заранее.
+ * 
+ * Для оптимистичного обновления интерфейса модель показывает записи,
+ * еще не подтвержденные базой:
+ * - insertProvisional() добавляет запись с временным отрицательным id
+ *   в конец списка, после загруженных строк; removeProvisional() убирает ее,
+ *   когда придет настоящая запись или запись не удалось сохранить
+ * - hideRecord() сразу убирает строку удаляемой записи, restoreRecord()
+ *   возвращает ее, если удаление не удалось; скрытая запись не появляется
+ *   снова при перечитывании, пока удаление не подтвердит removeRecord()
+ *
+ * Модель также может показывать результаты поиска в порядке ранжирования
+ * (setRankedRecords). В этом режиме записи не упорядочены по id, поэтому
+ * поиск строки линейный, а insertRecord() ничего не делает.
+ * 
+ * Наследники реализуют data() и roleNames().
+ *
+ * @tparam Record Тип записи с полем int id и оператором ==
+ */
+
+#ifndef RECORDLISTMODEL_H
+#define RECORDLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QFuture>
+#include <QHash>
+#include <QPromise>
+#include <QList>
+#include <QMetaObject>
+#include <algorithm>
+#include <functional>
+
+template <typename Record>
+class RecordListModel : public QAbstractListModel
+{
+public:
+    /**
+     * @brief Функция загрузки страницы записей
+     * @details Принимает id последней загруженной записи и размер страницы,
+     * возвращает записи с большими id в порядке возрастания
+     */
+    using PageLoader = std::function<QFuture<QList<Record>>(int afterId, int limit)>;
+
+    /**
+     * @brief Проверить, является ли id временным
+     * @param id Идентификатор записи
+     * @return bool true для записи, еще не подтвержденной базой
+     */
+    static bool isProvisionalId(int id)
+    {
+        return id < 0;
+    }
+
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit RecordListModel(QObject *parent = nullptr)
+        : QAbstractListModel(parent)
+        , m_pageSize(0)
+        , m_generation(0)
+        , m_loading(false)
+        , m_endReached(true)
+        , m_sortedById(true)
+        , m_prefetchScheduled(false)
+    {
+    }
+
+    /**
+     * @brief Включить постраничную загрузку
+     * @param loader Функция загрузки страницы
+     * @param pageSize Размер страницы
+     */
+    void setPageLoader(const PageLoader &loader, int pageSize)
+    {
+        m_pageLoader = loader;
+        m_pageSize = std::max(1, pageSize);
+        m_endReached = false;
+    }
+
+    /**
+     * @brief Проверить, есть ли еще незагруженные страницы
+     * @param parent Родительский индекс
+     * @return bool true если последняя страница еще не получена
+     */
+    bool canFetchMore(const QModelIndex &parent) const override
+    {
+        return !parent.isValid() && m_pageLoader && !m_endReached;
+    }
+
+    /**
+     * @brief Запросить следующую страницу
+     * @param parent Родительский индекс
+     *
+     * @details Страница запрашивается асинхронно по id последней строки.
+     * Повторный вызов до получения ответа игнорируется. Если запрос
+     * завершился исключением или отменен, следующий вызов повторит его.
+     */
+    void fetchMore(const QModelIndex &parent) override
+    {
+        if (parent.isValid() || !m_pageLoader || m_endReached || m_loading) {
+            return;
+        }
+
+        m_loading = true;
+        const quint64 generation = m_generation;
+        const int afterId = m_records.isEmpty() ? 0 : m_records.last().id;
+
+        auto failed = [this, generation]() {
+            if (generation == m_generation) {
+                m_loading = false;
+            }
+        };
+        m_pageLoader(afterId, m_pageSize).then(this, [this, generation](const QList<Record> &page) {
+            if (generation != m_generation) {
+                return;
+            }
+            m_loading = false;
+            appendPage(page);
+            m_endReached = page.size() < m_pageSize;
+        }).onFailed(this, failed).onCanceled(this, failed);
+    }
+
+    /**
+     * @brief Перечитать уже загруженный диапазон строк
+     *
+     * @details Загружает с начала столько строк, сколько уже показано
+     * (но не меньше одной страницы), и применяет их через setRecords().
+     * Ответы на запросы, отправленные до вызова, отбрасываются. Ошибка
+     * запроса оставляет прежние строки и снимает признак загрузки.
+     *
+     * @return QFuture<void> Завершается после применения ответа в потоке модели
+     */
+    QFuture<void> reload()
+    {
+        if (!m_pageLoader) {
+            QPromise<void> promise;
+            promise.start();
+            promise.finish();
+            return promise.future();
+        }
+
+        const quint64 generation = ++m_generation;
+        const int limit = std::max(static_cast<int>(m_records.size()), m_pageSize);
+        m_loading = true;
+
+        auto failed = [this, generation]() {
+            if (generation == m_generation) {
+                m_loading = false;
+            }
+        };
+        return m_pageLoader(0, limit).then(this, [this, generation, limit](const QList<Record> &records) {
+            if (generation != m_generation) {
+                return;
+            }
+            m_loading = false;
+            setRecords(records);
+            m_endReached = records.size() < limit;
+        }).onFailed(this, failed).onCanceled(this, failed);
+    }
+
+    /**
+     * @brief Расстояние до конца списка, с которого начинается предзагрузка
+     * @return int Количество строк
+     */
+    int prefetchDistance() const
+    {
+        return std::max(1, m_pageSize / 4);
+    }
+
+    /**
+     * @brief Количество строк в модели
+     * @param parent Родительский индекс (для списка всегда невалидный)
+     * @return int Количество записей вместе с временными
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(m_records.size() + m_provisional.size());
+    }
+
+    /**
+     * @brief Получить все подтвержденные записи модели
+     * @return const QList<Record>& Записи в порядке возрастания id без временных
+     */
+    const QList<Record> &records() const
+    {
+        return m_records;
+    }
+
+    /**
+     * @brief Получить запись строки, включая временные
+     * @param row Номер строки от 0 до rowCount() - 1
+     * @return const Record& Подтвержденная запись или, после них, временная
+     *
+     * @details В отличие от records() покрывает все строки модели,
+     * поэтому подходит для прокси и подписчиков на rowsInserted.
+     * Предзагрузку следующей страницы не запускает.
+     */
+    const Record &recordAtRow(int row) const
+    {
+        if (row >= m_records.size()) {
+            return m_provisional.at(row - m_records.size());
+        }
+        return m_records.at(row);
+    }
+
+    /**
+     * @brief Найти строку записи по id
+     * @param id Идентификатор записи
+     * @return int Номер строки или -1 если запись не найдена
+     *
+     * @details Двоичный поиск, так как записи упорядочены по id
+     */
+    int indexOfId(int id) const
+    {
+        if (isProvisionalId(id)) {
+            for (int i = 0; i < m_provisional.size(); ++i) {
+                if (m_provisional.at(i).id == id) {
+                    return static_cast<int>(m_records.size()) + i;
+                }
+            }
+            return -1;
+        }
+
+        if (!m_sortedById) {
+            for (int row = 0; row < m_records.size(); ++row) {
+                if (m_records.at(row).id == id) {
+                    return row;
+                }
+            }
+            return -1;
+        }
+
+        const auto it = lowerBound(id);
+        if (it != m_records.cend() && it->id == id) {
+            return static_cast<int>(it - m_records.cbegin());
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Заменить содержимое модели новым набором записей
+     * @param records Новые записи, упорядоченные по id
+     *
+     * @details Выполняет слияние двух упорядоченных списков и генерирует
+     * beginInsertRows/beginRemoveRows для непрерывных диапазонов,
+     * а измененные соседние строки объединяет в один dataChanged.
+     * Скрытые записи пропускаются, временные строки остаются в конце.
+     */
+    void setRecords(const QList<Record> &incoming)
+    {
+        const QList<Record> records = withoutHidden(incoming);
+        if (!m_sortedById) {
+            // Порядок ранжирования несовместим со слиянием по id
+            beginResetModel();
+            m_records = records;
+            m_sortedById = true;
+            endResetModel();
+            return;
+        }
+
+        int row = 0;
+        int next = 0;
+        int changedFirst = -1;
+        int changedLast = -1;
+
+        auto flushChanged = [&]() {
+            if (changedFirst >= 0) {
+                emit dataChanged(index(changedFirst), index(changedLast));
+                changedFirst = changedLast = -1;
+            }
+        };
+
+        while (next < records.size() || row < m_records.size()) {
+            if (row >= m_records.size()) {
+                // Оставшиеся новые записи добавляются в конец
+                flushChanged();
+                const int count = static_cast<int>(records.size()) - next;
+                beginInsertRows(QModelIndex(), row, row + count - 1);
+                m_records.append(records.mid(next));
+                endInsertRows();
+                break;
+            }
+
+            if (next >= records.size()) {
+                // Оставшиеся старые записи удалены
+                flushChanged();
+                beginRemoveRows(QModelIndex(), row, static_cast<int>(m_records.size()) - 1);
+                m_records.remove(row, m_records.size() - row);
+                endRemoveRows();
+                break;
+            }
+
+            const int currentId = m_records.at(row).id;
+            const int incomingId = records.at(next).id;
+
+            if (currentId == incomingId) {
+                if (m_records.at(row) != records.at(next)) {
+                    m_records[row] = records.at(next);
+                    if (changedFirst >= 0 && changedLast == row - 1) {
+                        changedLast = row;
+                    } else {
+                        flushChanged();
+                        changedFirst = changedLast = row;
+                    }
+                }
+                ++row;
+                ++next;
+            } else if (currentId < incomingId) {
+                // Диапазон строк, отсутствующих в новом наборе
+                flushChanged();
+                int last = row;
+                while (last + 1 < m_records.size() && m_records.at(last + 1).id < incomingId) {
+                    ++last;
+                }
+                beginRemoveRows(QModelIndex(), row, last);
+                m_records.remove(row, last - row + 1);
+                endRemoveRows();
+            } else {
+                // Диапазон новых строк перед текущей
+                flushChanged();
+                int last = next;
+                while (last + 1 < records.size() && records.at(last + 1).id < currentId) {
+                    ++last;
+                }
+                const int count = last - next + 1;
+                beginInsertRows(QModelIndex(), row, row + count - 1);
+                for (int i = 0; i < count; ++i) {
+                    m_records.insert(row + i, records.at(next + i));
+                }
+                endInsertRows();
+                row += count;
+                next += count;
+            }
+        }
+
+        flushChanged();
+    }
+
+    /**
+     * @brief Заменить содержимое модели ранжированными результатами
+     * @param records Записи в порядке убывания релевантности
+     *
+     * @details Результаты поиска меняются целиком, поэтому модель сбрасывается
+     */
+    void setRankedRecords(const QList<Record> &records)
+    {
+        beginResetModel();
+        m_records = records;
+        m_sortedById = false;
+        endResetModel();
+    }
+
+    /**
+     * @brief Вставить или обновить одну запись
+     * @param record Запись для вставки
+     *
+     * @details Если запись с таким id уже есть, она обновляется через dataChanged.
+     * В постраничном режиме запись за пределами загруженного диапазона пропускается.
+     * Для скрытой записи обновляется только сохраненная копия.
+     */
+    void insertRecord(const Record &record)
+    {
+        if (!m_sortedById) {
+            // Результаты поиска не пополняются новыми записями
+            return;
+        }
+        if (const auto hidden = m_hidden.find(record.id); hidden != m_hidden.end()) {
+            *hidden = record;
+            return;
+        }
+        if (!isLoaded(record.id)) {
+            // Запись придет вместе со следующей страницей
+            return;
+        }
+
+        const auto it = lowerBound(record.id);
+        const int row = static_cast<int>(it - m_records.cbegin());
+
+        if (it != m_records.cend() && it->id == record.id) {
+            if (*it != record) {
+                m_records[row] = record;
+                emit dataChanged(index(row), index(row));
+            }
+            return;
+        }
+
+        beginInsertRows(QModelIndex(), row, row);
+        m_records.insert(row, record);
+        endInsertRows();
+    }
+
+    /**
+     * @brief Вставить пакет записей
+     * @param records Записи в порядке возрастания id
+     *
+     * @details Новые записи обычно получают id больше всех загруженных,
+     * тогда они добавляются в конец одним beginInsertRows. Иначе каждая
+     * запись вставляется через insertRecord().
+     */
+    void insertRecords(const QList<Record> &records)
+    {
+        if (records.isEmpty() || !m_sortedById) {
+            return;
+        }
+
+        if (!m_records.isEmpty() && records.first().id <= m_records.last().id) {
+            for (const Record &record : records) {
+                insertRecord(record);
+            }
+            return;
+        }
+
+        if (!isLoaded(records.first().id)) {
+            // Записи придут вместе со следующими страницами
+            return;
+        }
+
+        appendPage(records);
+    }
+
+    /**
+     * @brief Удалить запись по id
+     * @param id Идентификатор записи
+     * @return bool true если запись была в модели (в том числе скрытой)
+     */
+    bool removeRecord(int id)
+    {
+        if (m_hidden.remove(id)) {
+            return true;
+        }
+        if (isProvisionalId(id)) {
+            return removeProvisional(id);
+        }
+
+        const int row = indexOfId(id);
+        if (row < 0) {
+            return false;
+        }
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_records.removeAt(row);
+        endRemoveRows();
+        return true;
+    }
+
+    /**
+     * @brief Показать запись, еще не сохраненную в базе
+     * @param record Запись с временным id (см. isProvisionalId())
+     *
+     * @details Строка добавляется в конец списка. Результаты поиска
+     * временными записями не пополняются.
+     */
+    void insertProvisional(const Record &record)
+    {
+        if (!m_sortedById || !isProvisionalId(record.id) || indexOfId(record.id) >= 0) {
+            return;
+        }
+
+        const int row = rowCount();
+        beginInsertRows(QModelIndex(), row, row);
+        m_provisional.append(record);
+        endInsertRows();
+    }
+
+    /**
+     * @brief Убрать временную запись
+     * @param id Временный идентификатор
+     * @return bool true если запись была в модели
+     *
+     * @details Вызывается и после подтверждения (настоящая запись уже
+     * пришла сигналом о добавлении), и после ошибки записи
+     */
+    bool removeProvisional(int id)
+    {
+        const int row = indexOfId(id);
+        if (!isProvisionalId(id) || row < 0) {
+            return false;
+        }
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_provisional.removeAt(row - m_records.size());
+        endRemoveRows();
+        return true;
+    }
+
+    /**
+     * @brief Скрыть запись до подтверждения ее удаления
+     * @param id Идентификатор записи
+     * @return bool true если запись была в модели
+     */
+    bool hideRecord(int id)
+    {
+        const int row = isProvisionalId(id) ? -1 : indexOfId(id);
+        if (row < 0) {
+            return false;
+        }
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_hidden.insert(id, m_records.takeAt(row));
+        endRemoveRows();
+        return true;
+    }
+
+    /**
+     * @brief Вернуть скрытую запись, если удалить ее не удалось
+     * @param id Идентификатор записи
+     * @return bool true если запись была скрыта
+     */
+    bool restoreRecord(int id)
+    {
+        const auto it = m_hidden.find(id);
+        if (it == m_hidden.end()) {
+            return false;
+        }
+
+        const Record record = *it;
+        m_hidden.erase(it);
+        if (m_sortedById) {
+            insertRecord(record);
+        } else {
+            // Место в ранжировании не сохранено, запись возвращается в конец
+            const int row = static_cast<int>(m_records.size());
+            beginInsertRows(QModelIndex(), row, row);
+            m_records.append(record);
+            endInsertRows();
+        }
+        return true;
+    }
+
+protected:
+    /**
+     * @brief Получить запись по индексу модели
+     * @param index Индекс модели
+     * @return const Record* Запись или nullptr для невалидного индекса
+     *
+     * @details Обращение к строкам у конца списка запускает предзагрузку следующей страницы
+     */
+    const Record *recordAt(const QModelIndex &index) const
+    {
+        if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
+            return nullptr;
+        }
+        if (index.row() < m_records.size() && index.row() >= m_records.size() - prefetchDistance()) {
+            schedulePrefetch();
+        }
+        return &recordAtRow(index.row());
+    }
+
+private:
+    /**
+     * @brief Проверить, попадает ли id в загруженный диапазон
+     * @param id Идентификатор записи
+     * @return bool true если модель не постраничная, все страницы загружены
+     * или id не больше id последней загруженной строки
+     */
+    bool isLoaded(int id) const
+    {
+        if (!m_pageLoader || m_endReached) {
+            return true;
+        }
+        return !m_records.isEmpty() && id <= m_records.last().id;
+    }
+
+    /**
+     * @brief Добавить загруженную страницу в конец модели
+     * @param page Записи страницы
+     */
+    void appendPage(const QList<Record> &page)
+    {
+        QList<Record> fresh;
+        fresh.reserve(page.size());
+        for (const Record &record : page) {
+            if (m_hidden.contains(record.id)) {
+                continue;
+            }
+            if (m_records.isEmpty() || record.id > m_records.last().id) {
+                fresh.append(record);
+            }
+        }
+        if (fresh.isEmpty()) {
+            return;
+        }
+
+        const int first = static_cast<int>(m_records.size());
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(fresh.size()) - 1);
+        m_records.append(fresh);
+        endInsertRows();
+    }
+
+    /**
+     * @brief Убрать скрытые записи из набора
+     * @param records Записи
+     * @return QList<Record> Записи без скрытых
+     */
+    QList<Record> withoutHidden(const QList<Record> &records) const
+    {
+        if (m_hidden.isEmpty()) {
+            return records;
+        }
+        QList<Record> visible;
+        visible.reserve(records.size());
+        for (const Record &record : records) {
+            if (!m_hidden.contains(record.id)) {
+                visible.append(record);
+            }
+        }
+        return visible;
+    }
+
+    /**
+     * @brief Запланировать загрузку следующей страницы
+     *
+     * @details Вызывается из константного data(), поэтому сама загрузка
+     * откладывается до следующей итерации цикла событий
+     */
+    void schedulePrefetch() const
+    {
+        if (m_prefetchScheduled || m_loading || !canFetchMore(QModelIndex())) {
+            return;
+        }
+
+        m_prefetchScheduled = true;
+        auto *self = const_cast<RecordListModel *>(this);
+        QMetaObject::invokeMethod(self, [self]() {
+            self->m_prefetchScheduled = false;
+            self->fetchMore(QModelIndex());
+        }, Qt::QueuedConnection);
+    }
+
+    /**
+     * @brief Найти первую запись с id не меньше заданного
+     * @param id Идентификатор
+     * @return Итератор на найденную запись
+     */
+    typename QList<Record>::const_iterator lowerBound(int id) const
+    {
+        return std::lower_bound(m_records.cbegin(), m_records.cend(), id,
+                                [](const Record &record, int value) { return record.id < value; });
+    }
+
+    QList<Record> m_records;            ///< Записи в порядке возрастания id
+    QList<Record> m_provisional;        ///< Временные записи в порядке добавления
+    QHash<int, Record> m_hidden;        ///< Скрытые записи, ожидающие удаления
+    PageLoader m_pageLoader;            ///< Загрузчик страниц (пустой в обычном режиме)
+    int m_pageSize;                     ///< Размер страницы
+    quint64 m_generation;               ///< Номер текущего reload(), старые ответы отбрасываются
+    bool m_loading;                     ///< Идет загрузка страницы
+    bool m_endReached;                  ///< Последняя страница получена
+    bool m_sortedById;                  ///< Записи упорядочены по id (не результаты поиска)
+    mutable bool m_prefetchScheduled;   ///< Предзагрузка уже запланирована
+};
+
+#endif // RECORDLISTMODEL_H
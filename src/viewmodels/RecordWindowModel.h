@@ -0,0 +1,306 @@
+/**
+ * @file RecordWindowModel.h
+ * @brief Шаблонная модель списка с окнами строк по требованию
+ * @ingroup ViewModels
+ *
+ * @class RecordWindowModel
+ * @brief QAbstractListModel над курсором, хранящая ограниченное число окон
+ *
+ * Количество строк известно заранее (из снимка курсора), а сами строки
+ * читаются окнами по WINDOW_SIZE, когда представление обращается к ним
+ * через data(). Пока окно не получено, data() возвращает пустой QVariant,
+ * после получения модель сообщает dataChanged для строк окна.
+ *
+ * В памяти остается не больше MAX_WINDOWS окон: при переполнении удаляется
+ * окно, к которому дольше всего не обращались. Поэтому объем памяти
+ * не зависит от размера таблицы, и по списку из миллионов строк можно
+ * прокручивать в любом направлении.
+ *
+ * Окно, которое не удалось прочитать или которое пришло пустым (например,
+ * строки в конце удалили другим клиентом), запоминается: повторный запрос
+ * отправляется не раньше чем через RETRY_DELAY, с удвоением задержки,
+ * и не больше MAX_ATTEMPTS раз. Поэтому прокрутка по таким строкам
+ * не засыпает рабочий поток запросами. По истечении задержки модель
+ * сообщает dataChanged для строк окна: если они еще видны, представление
+ * обращается к data(), и окно запрашивается снова.
+ *
+ * В отличие от RecordListModel, модель не применяет изменения по одной
+ * записи: она показывает зафиксированный снимок до следующего setSource().
+ *
+ * Наследники реализуют data() через recordAt() и roleNames().
+ *
+ * @tparam Record Тип записи
+ */
+
+#ifndef RECORDWINDOWMODEL_H
+#define RECORDWINDOWMODEL_H
+
+#include <QAbstractListModel>
+#include <QDeadlineTimer>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+template <typename Record>
+class RecordWindowModel : public QAbstractListModel
+{
+public:
+    /**
+     * @brief Функция чтения окна строк
+     * @details Принимает номер первой строки и размер окна
+     */
+    using WindowLoader = std::function<QFuture<QList<Record>>(qint64 offset, int limit)>;
+
+    /**
+     * @brief Количество строк в окне
+     */
+    static constexpr int WINDOW_SIZE = 500;
+
+    /**
+     * @brief Максимальное количество окон в памяти
+     */
+    static constexpr int MAX_WINDOWS = 8;
+
+    /**
+     * @brief Задержка перед повторным запросом неполученного окна, мс
+     * @details Удваивается после каждой неудачной попытки
+     */
+    static constexpr int RETRY_DELAY = 500;
+
+    /**
+     * @brief Максимальное количество запросов одного окна
+     */
+    static constexpr int MAX_ATTEMPTS = 3;
+
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit RecordWindowModel(QObject *parent = nullptr)
+        : QAbstractListModel(parent)
+        , m_count(0)
+        , m_generation(0)
+    {
+    }
+
+    /**
+     * @brief Задать источник строк
+     * @param loader Функция чтения окна
+     * @param count Количество строк в источнике
+     *
+     * @details Модель сбрасывается, ответы предыдущего источника отбрасываются
+     */
+    void setSource(const WindowLoader &loader, qint64 count)
+    {
+        beginResetModel();
+        ++m_generation;
+        m_loader = loader;
+        m_count = std::max<qint64>(0, count);
+        m_windows.clear();
+        m_recent.clear();
+        m_pending.clear();
+        m_failed.clear();
+        endResetModel();
+    }
+
+    /**
+     * @brief Убрать источник и очистить модель
+     */
+    void clear()
+    {
+        setSource(WindowLoader(), 0);
+    }
+
+    /**
+     * @brief Количество строк в модели
+     * @param parent Родительский индекс (для списка всегда невалидный)
+     * @return int Количество строк источника, но не больше INT_MAX
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        if (parent.isValid()) {
+            return 0;
+        }
+        return static_cast<int>(std::min<qint64>(m_count, std::numeric_limits<int>::max()));
+    }
+
+    /**
+     * @brief Количество окон, находящихся в памяти
+     * @return int Не больше MAX_WINDOWS
+     */
+    int residentWindows() const
+    {
+        return static_cast<int>(m_windows.size());
+    }
+
+protected:
+    /**
+     * @brief Получить запись по индексу модели
+     * @param index Индекс модели
+     * @return const Record* Запись или nullptr, если окно еще не получено
+     *
+     * @details Обращение к отсутствующему окну запрашивает его, а обращение
+     * к последней четверти окна заранее запрашивает следующее
+     */
+    const Record *recordAt(const QModelIndex &index) const
+    {
+        if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
+            return nullptr;
+        }
+
+        const qint64 window = index.row() / WINDOW_SIZE;
+        const int offset = index.row() % WINDOW_SIZE;
+        if (offset >= WINDOW_SIZE - WINDOW_SIZE / 4) {
+            requestWindow(window + 1);
+        }
+
+        const auto it = m_windows.constFind(window);
+        if (it == m_windows.cend()) {
+            requestWindow(window);
+            return nullptr;
+        }
+        touch(window);
+        return offset < it->size() ? &it->at(offset) : nullptr;
+    }
+
+private:
+    /**
+     * @struct Failure
+     * @brief Неудачные запросы окна
+     */
+    struct Failure
+    {
+        int attempts = 0;           ///< Количество неудачных запросов
+        QDeadlineTimer retryAfter;  ///< Раньше этого момента окно не запрашивается
+    };
+
+    /**
+     * @brief Запросить окно, если его нет в памяти и оно еще не запрошено
+     * @param window Номер окна
+     *
+     * @details Вызывается из константного data(); сам запрос асинхронный.
+     * Окно после неудачного запроса ждет окончания задержки, а после
+     * MAX_ATTEMPTS неудач больше не запрашивается до setSource().
+     */
+    void requestWindow(qint64 window) const
+    {
+        const qint64 first = window * WINDOW_SIZE;
+        if (!m_loader || first >= m_count || m_windows.contains(window) || m_pending.contains(window)) {
+            return;
+        }
+        if (const auto failure = m_failed.constFind(window); failure != m_failed.cend()
+            && (failure->attempts >= MAX_ATTEMPTS || !failure->retryAfter.hasExpired())) {
+            return;
+        }
+
+        m_pending.insert(window);
+        auto *self = const_cast<RecordWindowModel *>(this);
+        const quint64 generation = m_generation;
+        const int limit = static_cast<int>(std::min<qint64>(WINDOW_SIZE, m_count - first));
+        auto failed = [self, generation, window]() {
+            if (generation != self->m_generation) {
+                return;
+            }
+            self->m_pending.remove(window);
+            self->markFailed(window);
+        };
+        m_loader(first, limit).then(self, [self, generation, window](const QList<Record> &records) {
+            if (generation != self->m_generation) {
+                return;
+            }
+            self->m_pending.remove(window);
+            self->storeWindow(window, records);
+        }).onFailed(self, failed).onCanceled(self, failed);
+    }
+
+    /**
+     * @brief Запомнить неудачный запрос окна и запланировать повтор
+     * @param window Номер окна
+     *
+     * @details Таймер не запрашивает окно сам: строки, ушедшие из вида,
+     * перечитывать незачем. Он снимает задержку и сообщает dataChanged,
+     * а представление обращается к data() только для видимых строк.
+     */
+    void markFailed(qint64 window)
+    {
+        Failure &failure = m_failed[window];
+        ++failure.attempts;
+        const int delay = RETRY_DELAY << (failure.attempts - 1);
+        failure.retryAfter = QDeadlineTimer(delay);
+        if (failure.attempts >= MAX_ATTEMPTS) {
+            return;
+        }
+
+        const quint64 generation = m_generation;
+        QTimer::singleShot(delay, this, [this, generation, window]() {
+            const auto it = m_failed.find(window);
+            if (generation != m_generation || it == m_failed.end() || m_windows.contains(window)) {
+                return;
+            }
+            // Таймер может сработать чуть раньше дедлайна
+            it->retryAfter = QDeadlineTimer(0);
+
+            const qint64 first = window * WINDOW_SIZE;
+            const qint64 last = std::min<qint64>(first + WINDOW_SIZE, rowCount()) - 1;
+            if (last >= first) {
+                emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)));
+            }
+        });
+    }
+
+    /**
+     * @brief Сохранить полученное окно и сообщить об изменении его строк
+     * @param window Номер окна
+     * @param records Строки окна
+     *
+     * @details Пустое окно считается неудачным запросом
+     */
+    void storeWindow(qint64 window, const QList<Record> &records)
+    {
+        if (records.isEmpty()) {
+            markFailed(window);
+            return;
+        }
+
+        m_failed.remove(window);
+        m_windows.insert(window, records);
+        touch(window);
+        while (m_recent.size() > MAX_WINDOWS) {
+            m_windows.remove(m_recent.takeFirst());
+        }
+
+        const qint64 first = window * WINDOW_SIZE;
+        const qint64 last = std::min<qint64>(first + records.size(), rowCount()) - 1;
+        if (last >= first) {
+            emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)));
+        }
+    }
+
+    /**
+     * @brief Отметить окно как последнее использованное
+     * @param window Номер окна
+     */
+    void touch(qint64 window) const
+    {
+        if (!m_recent.isEmpty() && m_recent.last() == window) {
+            return;
+        }
+        m_recent.removeOne(window);
+        m_recent.append(window);
+    }
+
+    WindowLoader m_loader;                  ///< Чтение окна (пустое без источника)
+    qint64 m_count;                         ///< Количество строк источника
+    quint64 m_generation;                   ///< Номер источника, старые ответы отбрасываются
+    QHash<qint64, QList<Record>> m_windows; ///< Окна в памяти по номеру
+    mutable QList<qint64> m_recent;         ///< Номера окон от давно использованного к недавнему
+    mutable QSet<qint64> m_pending;         ///< Запрошенные окна
+    QHash<qint64, Failure> m_failed;        ///< Окна, которые не удалось получить
+};
+
+#endif // RECORDWINDOWMODEL_H
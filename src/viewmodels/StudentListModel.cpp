@@ -0,0 +1,76 @@
+/**
+ * @file StudentListModel.cpp
+ * @brief Реализация класса StudentListModel
+ * @ingroup ViewModels
+ */
+
+#include "StudentListModel.h"
+
+/**
+ * @brief Конструктор StudentListModel
+ * @param parent Родительский QObject
+ */
+StudentListModel::StudentListModel(QObject *parent)
+    : RecordListModel<StudentRecord>(parent)
+{
+}
+
+/**
+ * @brief Получение данных строки
+ * @param index Индекс строки
+ * @param role Роль данных
+ * @return QVariant Значение роли
+ */
+QVariant StudentListModel::data(const QModelIndex &index, int role) const
+{
+    const StudentRecord *record = recordAt(index);
+    return record ? recordData(*record, role) : QVariant();
+}
+
+/**
+ * @brief Получение имен ролей
+ * @return QHash<int, QByteArray> Имена ролей для QML
+ */
+QHash<int, QByteArray> StudentListModel::roleNames() const
+{
+    return recordRoleNames();
+}
+
+/**
+ * @brief Получение значения роли для записи
+ * @param record Запись студента
+ * @param role Роль данных
+ * @return QVariant Значение роли
+ */
+QVariant StudentListModel::recordData(const StudentRecord &record, int role)
+{
+    switch (role) {
+    case Qt::DisplayRole:
+        return record.toString();
+    case IdRole:
+        return record.id;
+    case FullNameRole:
+        return record.fullName;
+    case GradeRole:
+        return record.grade;
+    case PendingRole:
+        return isProvisionalId(record.id);
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Получение имен ролей студентов
+ * @return QHash<int, QByteArray> Имена ролей для QML
+ */
+QHash<int, QByteArray> StudentListModel::recordRoleNames()
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { IdRole, "recordId" },
+        { FullNameRole, "fullName" },
+        { GradeRole, "grade" },
+        { PendingRole, "pending" }
+    };
+}
@@ -0,0 +1,75 @@
+/**
+ * @file StudentListModel.h
+ * @brief Заголовочный файл класса StudentListModel
+ * @ingroup ViewModels
+ * 
+ * @class StudentListModel
+ * @brief Модель списка студентов для QML ListView
+ * 
+ * Роли модели:
+ * - display: строковое представление записи
+ * - recordId: идентификатор записи
+ * - fullName: полное имя
+ * - grade: оценка
+ * - pending: запись еще не сохранена в базе (временный id)
+ */
+
+#ifndef STUDENTLISTMODEL_H
+#define STUDENTLISTMODEL_H
+
+#include "RecordListModel.h"
+#include "../models/Student.h"
+
+class StudentListModel : public RecordListModel<StudentRecord>
+{
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief Роли данных модели
+     */
+    enum Roles {
+        IdRole = Qt::UserRole + 1,  ///< Идентификатор записи
+        FullNameRole,               ///< Полное имя
+        GradeRole,                  ///< Оценка
+        PendingRole                 ///< Запись ожидает подтверждения базой
+    };
+    
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit StudentListModel(QObject *parent = nullptr);
+    
+    /**
+     * @brief Получить данные строки для роли
+     * @param index Индекс строки
+     * @param role Роль данных
+     * @return QVariant Значение роли или пустой QVariant
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Получить имена ролей для QML
+     * @return QHash<int, QByteArray> Соответствие ролей и имен
+     */
+    QHash<int, QByteArray> roleNames() const override;
+    
+    /**
+     * @brief Получить значение роли для записи
+     * @param record Запись студента
+     * @param role Роль данных
+     * @return QVariant Значение роли или пустой QVariant
+     * 
+     * @details Общая реализация для StudentListModel и StudentWindowModel
+     */
+    static QVariant recordData(const StudentRecord &record, int role);
+    
+    /**
+     * @brief Получить имена ролей студентов
+     * @return QHash<int, QByteArray> Соответствие ролей и имен
+     */
+    static QHash<int, QByteArray> recordRoleNames();
+};
+
+#endif // STUDENTLISTMODEL_H
@@ -0,0 +1,38 @@
+/**
+ * @file StudentWindowModel.cpp
+ * @brief Реализация класса StudentWindowModel
+ * @ingroup ViewModels
+ */
+
+#include "StudentWindowModel.h"
+#include "StudentListModel.h"
+
+/**
+ * @brief Конструктор StudentWindowModel
+ * @param parent Родительский QObject
+ */
+StudentWindowModel::StudentWindowModel(QObject *parent)
+    : RecordWindowModel<StudentRecord>(parent)
+{
+}
+
+/**
+ * @brief Получение данных строки
+ * @param index Индекс строки
+ * @param role Роль данных
+ * @return QVariant Значение роли
+ */
+QVariant StudentWindowModel::data(const QModelIndex &index, int role) const
+{
+    const StudentRecord *record = recordAt(index);
+    return record ? StudentListModel::recordData(*record, role) : QVariant();
+}
+
+/**
+ * @brief Получение имен ролей
+ * @return QHash<int, QByteArray> Имена ролей для QML
+ */
+QHash<int, QByteArray> StudentWindowModel::roleNames() const
+{
+    return StudentListModel::recordRoleNames();
+}
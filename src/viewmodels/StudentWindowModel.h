@@ -0,0 +1,46 @@
+/**
+ * @file StudentWindowModel.h
+ * @brief Заголовочный файл класса StudentWindowModel
+ * @ingroup ViewModels
+ * 
+ * @class StudentWindowModel
+ * @brief Модель списка студентов над серверным курсором
+ * 
+ * Роли совпадают со StudentListModel, поэтому ListView может
+ * переключаться между моделями без изменения делегата.
+ * Строки окна, которое еще загружается, возвращают пустые значения.
+ */
+
+#ifndef STUDENTWINDOWMODEL_H
+#define STUDENTWINDOWMODEL_H
+
+#include "RecordWindowModel.h"
+#include "../models/Student.h"
+
+class StudentWindowModel : public RecordWindowModel<StudentRecord>
+{
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit StudentWindowModel(QObject *parent = nullptr);
+    
+    /**
+     * @brief Получить данные строки для роли
+     * @param index Индекс строки
+     * @param role Роль данных
+     * @return QVariant Значение роли или пустой QVariant, пока окно загружается
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Получить имена ролей для QML
+     * @return QHash<int, QByteArray> Соответствие ролей и имен
+     */
+    QHash<int, QByteArray> roleNames() const override;
+};
+
+#endif // STUDENTWINDOWMODEL_H
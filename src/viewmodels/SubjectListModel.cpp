@@ -0,0 +1,57 @@
+/**
+ * @file SubjectListModel.cpp
+ * @brief Реализация класса SubjectListModel
+ * @ingroup ViewModels
+ */
+
+#include "SubjectListModel.h"
+
+/**
+ * @brief Конструктор SubjectListModel
+ * @param parent Родительский QObject
+ */
+SubjectListModel::SubjectListModel(QObject *parent)
+    : RecordListModel<SubjectRecord>(parent)
+{
+}
+
+/**
+ * @brief Получение данных строки
+ * @param index Индекс строки
+ * @param role Роль данных
+ * @return QVariant Значение роли
+ */
+QVariant SubjectListModel::data(const QModelIndex &index, int role) const
+{
+    const SubjectRecord *record = recordAt(index);
+    if (!record) {
+        return QVariant();
+    }
+    
+    switch (role) {
+    case Qt::DisplayRole:
+        return record->toString();
+    case IdRole:
+        return record->id;
+    case NameRole:
+        return record->name;
+    case PendingRole:
+        return isProvisionalId(record->id);
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Получение имен ролей
+ * @return QHash<int, QByteArray> Имена ролей для QML
+ */
+QHash<int, QByteArray> SubjectListModel::roleNames() const
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { IdRole, "recordId" },
+        { NameRole, "name" },
+        { PendingRole, "pending" }
+    };
+}
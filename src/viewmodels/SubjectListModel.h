@@ -0,0 +1,57 @@
+/**
+ * @file SubjectListModel.h
+ * @brief Заголовочный файл класса SubjectListModel
+ * @ingroup ViewModels
+ * 
+ * @class SubjectListModel
+ * @brief Модель списка предметов для QML ListView
+ * 
+ * Роли модели:
+ * - display: строковое представление записи
+ * - recordId: идентификатор записи
+ * - name: название
+ * - pending: запись еще не сохранена в базе (временный id)
+ */
+
+#ifndef SUBJECTLISTMODEL_H
+#define SUBJECTLISTMODEL_H
+
+#include "RecordListModel.h"
+#include "../models/Subject.h"
+
+class SubjectListModel : public RecordListModel<SubjectRecord>
+{
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief Роли данных модели
+     */
+    enum Roles {
+        IdRole = Qt::UserRole + 1,  ///< Идентификатор записи
+        NameRole,                   ///< Название
+        PendingRole                 ///< Запись ожидает подтверждения базой
+    };
+    
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit SubjectListModel(QObject *parent = nullptr);
+    
+    /**
+     * @brief Получить данные строки для роли
+     * @param index Индекс строки
+     * @param role Роль данных
+     * @return QVariant Значение роли или пустой QVariant
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Получить имена ролей для QML
+     * @return QHash<int, QByteArray> Соответствие ролей и имен
+     */
+    QHash<int, QByteArray> roleNames() const override;
+};
+
+#endif // SUBJECTLISTMODEL_H
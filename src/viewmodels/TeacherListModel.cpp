@@ -0,0 +1,60 @@
+/**
+ * @file TeacherListModel.cpp
+ * @brief Реализация класса TeacherListModel
+ * @ingroup ViewModels
+ */
+
+#include "TeacherListModel.h"
+
+/**
+ * @brief Конструктор TeacherListModel
+ * @param parent Родительский QObject
+ */
+TeacherListModel::TeacherListModel(QObject *parent)
+    : RecordListModel<TeacherRecord>(parent)
+{
+}
+
+/**
+ * @brief Получение данных строки
+ * @param index Индекс строки
+ * @param role Роль данных
+ * @return QVariant Значение роли
+ */
+QVariant TeacherListModel::data(const QModelIndex &index, int role) const
+{
+    const TeacherRecord *record = recordAt(index);
+    if (!record) {
+        return QVariant();
+    }
+    
+    switch (role) {
+    case Qt::DisplayRole:
+        return record->toString();
+    case IdRole:
+        return record->id;
+    case FullNameRole:
+        return record->fullName;
+    case DepartmentRole:
+        return record->department;
+    case PendingRole:
+        return isProvisionalId(record->id);
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Получение имен ролей
+ * @return QHash<int, QByteArray> Имена ролей для QML
+ */
+QHash<int, QByteArray> TeacherListModel::roleNames() const
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { IdRole, "recordId" },
+        { FullNameRole, "fullName" },
+        { DepartmentRole, "department" },
+        { PendingRole, "pending" }
+    };
+}
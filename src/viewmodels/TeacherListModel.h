@@ -0,0 +1,59 @@
+/**
+ * @file TeacherListModel.h
+ * @brief Заголовочный файл класса TeacherListModel
+ * @ingroup ViewModels
+ * 
+ * @class TeacherListModel
+ * @brief Модель списка преподавателей для QML ListView
+ * 
+ * Роли модели:
+ * - display: строковое представление записи
+ * - recordId: идентификатор записи
+ * - fullName: полное имя
+ * - department: кафедра
+ * - pending: запись еще не сохранена в базе (временный id)
+ */
+
+#ifndef TEACHERLISTMODEL_H
+#define TEACHERLISTMODEL_H
+
+#include "RecordListModel.h"
+#include "../models/Teacher.h"
+
+class TeacherListModel : public RecordListModel<TeacherRecord>
+{
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief Роли данных модели
+     */
+    enum Roles {
+        IdRole = Qt::UserRole + 1,  ///< Идентификатор записи
+        FullNameRole,               ///< Полное имя
+        DepartmentRole,             ///< Кафедра
+        PendingRole                 ///< Запись ожидает подтверждения базой
+    };
+    
+    /**
+     * @brief Конструктор модели
+     * @param parent Родительский QObject
+     */
+    explicit TeacherListModel(QObject *parent = nullptr);
+    
+    /**
+     * @brief Получить данные строки для роли
+     * @param index Индекс строки
+     * @param role Роль данных
+     * @return QVariant Значение роли или пустой QVariant
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Получить имена ролей для QML
+     * @return QHash<int, QByteArray> Соответствие ролей и имен
+     */
+    QHash<int, QByteArray> roleNames() const override;
+};
+
+#endif // TEACHERLISTMODEL_H
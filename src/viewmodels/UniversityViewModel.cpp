@@ -8,26 +8,195 @@
 #include <QDebug>
 #include <QTimer> 
 #include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QUrl>
+#include <memory>
+#include "../models/StartupReport.h"
+
+/**
+ * @brief Размер страницы списков по умолчанию
+ * @details Может быть переопределен переменной окружения UNIVERSITY_PAGE_SIZE
+ */
+static const int DEFAULT_PAGE_SIZE = 200;
 
 /**
  * @brief Конструктор UniversityViewModel
  * @param parent Родительский QObject
  * 
  * @details Инициализирует менеджер БД и настраивает соединения сигналов.
+ * Добавление и удаление записей применяются к моделям точечно,
+ * полное обновление выполняется при подключении и по refresh().
  * Автоматически пытается подключиться к БД с небольшой задержкой.
  */
 UniversityViewModel::UniversityViewModel(QObject *parent)
     : QObject(parent)
-    , m_dbManager(new DatabaseManager(this))
+    , m_dbManager(new AsyncDatabaseManager(this))
+    , m_teachers(new TeacherListModel(this))
+    , m_students(new StudentListModel(this))
+    , m_subjects(new SubjectListModel(this))
+    , m_teacherResults(new TeacherListModel(this))
+    , m_studentResults(new StudentListModel(this))
+    , m_subjectResults(new SubjectListModel(this))
+    , m_teacherFilter(new RecordFilterModel(this))
+    , m_studentFilter(new RecordFilterModel(this))
+    , m_subjectFilter(new RecordFilterModel(this))
+    , m_gradeAnalytics(new GradeAnalytics(this))
+    , m_gradeSummaryGeneration(0)
+    , m_studentWindow(new StudentWindowModel(this))
+    , m_cursorBrowsing(false)
+    , m_cursorGeneration(0)
+    , m_importer(new ImportPipeline(m_dbManager, this))
+    , m_optimisticUpdates(true)
+    , m_lastProvisionalId(0)
+    , m_rosterSubjectId(0)
+    , m_rosterGeneration(0)
+    , m_searchGeneration(0)
+    , m_pendingSearches(0)
 {
-    // Подключаем сигналы от менеджера БД
-    connect(m_dbManager, &DatabaseManager::dataChanged, this, &UniversityViewModel::refresh);
-    connect(m_dbManager, &DatabaseManager::databaseConnected, this, [this](bool success) {
+    m_searchTimer.setSingleShot(true);
+    m_searchTimer.setInterval(SEARCH_DEBOUNCE_INTERVAL);
+    connect(&m_searchTimer, &QTimer::timeout, this, &UniversityViewModel::runSearch);
+    
+    // Аналитика просит перечитать сводку, когда не может обновить ее сама
+    m_gradeSummaryTimer.setSingleShot(true);
+    m_gradeSummaryTimer.setInterval(GRADE_SUMMARY_DELAY);
+    connect(&m_gradeSummaryTimer, &QTimer::timeout, this, &UniversityViewModel::reloadGradeSummary);
+    connect(m_gradeAnalytics, &GradeAnalytics::reloadRequested, &m_gradeSummaryTimer, qOverload<>(&QTimer::start));
+    
+    // Списки загружаются постранично по мере прокрутки
+    const int pageSize = qEnvironmentVariableIsSet("UNIVERSITY_PAGE_SIZE")
+        ? qEnvironmentVariableIntValue("UNIVERSITY_PAGE_SIZE")
+        : DEFAULT_PAGE_SIZE;
+    m_teachers->setPageLoader([this](int afterId, int limit) {
+        return m_dbManager->getTeachersPage(afterId, limit);
+    }, pageSize);
+    m_students->setPageLoader([this](int afterId, int limit) {
+        return m_dbManager->getStudentsPage(afterId, limit);
+    }, pageSize);
+    m_subjects->setPageLoader([this](int afterId, int limit) {
+        return m_dbManager->getSubjectsPage(afterId, limit);
+    }, pageSize);
+    
+    // Фильтры индексируют загруженные строки и следят за изменениями моделей
+    m_teacherFilter->setRecordSource<TeacherRecord>(m_teachers, [](const TeacherRecord &record) {
+        return record.fullName + ' ' + record.department;
+    });
+    m_studentFilter->setRecordSource<StudentRecord>(m_students, [](const StudentRecord &record) {
+        return record.fullName;
+    });
+    m_subjectFilter->setRecordSource<SubjectRecord>(m_subjects, [](const SubjectRecord &record) {
+        return record.name;
+    });
+    
+    connect(m_importer, &ImportPipeline::errorOccurred, this, &UniversityViewModel::errorOccurred);
+    
+    // Одиночные изменения применяются к моделям без перечитывания таблиц
+    connect(m_dbManager, &AsyncDatabaseManager::teacherAdded, this, [this](const TeacherRecord &record) {
+        m_teachers->insertRecord(record);
+        ++m_counts.teachers;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::teacherDeleted, this, [this](int id) {
+        m_teachers->removeRecord(id);
+        m_teacherResults->removeRecord(id);
+        --m_counts.teachers;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::teachersAdded, this, [this](const QList<TeacherRecord> &records) {
+        m_teachers->insertRecords(records);
+        m_counts.teachers += records.size();
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::studentAdded, this, [this](const StudentRecord &record) {
+        m_students->insertRecord(record);
+        m_gradeAnalytics->insertStudents({record});
+        ++m_counts.students;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::studentDeleted, this, [this](const StudentRecord &record) {
+        m_students->removeRecord(record.id);
+        m_studentResults->removeRecord(record.id);
+        m_gradeAnalytics->removeStudents({record});
+        --m_counts.students;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::studentsAdded, this, [this](const QList<StudentRecord> &records) {
+        m_students->insertRecords(records);
+        m_gradeAnalytics->insertStudents(records);
+        m_counts.students += records.size();
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::subjectAdded, this, [this](const SubjectRecord &record) {
+        m_subjects->insertRecord(record);
+        ++m_counts.subjects;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::subjectDeleted, this, [this](int id) {
+        m_subjects->removeRecord(id);
+        m_subjectResults->removeRecord(id);
+        --m_counts.subjects;
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::subjectsAdded, this, [this](const QList<SubjectRecord> &records) {
+        m_subjects->insertRecords(records);
+        m_counts.subjects += records.size();
+        emit dataChanged();
+    });
+    
+    // Изменения других клиентов приходят через LISTEN/NOTIFY
+    connect(m_dbManager, &AsyncDatabaseManager::teachersUpdated, this, [this](const QList<TeacherRecord> &records) {
+        m_teachers->insertRecords(records);
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::teachersDeleted, this, [this](const QList<int> &ids) {
+        for (int id : ids) {
+            m_teachers->removeRecord(id);
+            m_teacherResults->removeRecord(id);
+        }
+        m_counts.teachers -= ids.size();
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::studentsUpdated, this,
+            [this](const QList<StudentRecord> &records, const QList<int> &previousGrades) {
+        m_students->insertRecords(records);
+        m_gradeAnalytics->updateStudents(records, previousGrades);
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::studentsDeleted, this, [this](const QList<StudentRecord> &records) {
+        for (const StudentRecord &record : records) {
+            m_students->removeRecord(record.id);
+            m_studentResults->removeRecord(record.id);
+        }
+        m_gradeAnalytics->removeStudents(records);
+        m_counts.students -= records.size();
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::subjectsUpdated, this, [this](const QList<SubjectRecord> &records) {
+        m_subjects->insertRecords(records);
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::subjectsDeleted, this, [this](const QList<int> &ids) {
+        for (int id : ids) {
+            m_subjects->removeRecord(id);
+            m_subjectResults->removeRecord(id);
+        }
+        m_counts.subjects -= ids.size();
+        emit dataChanged();
+    });
+    connect(m_dbManager, &AsyncDatabaseManager::tableReloadRequired, this, &UniversityViewModel::reloadTable);
+    
+    connect(m_dbManager, &AsyncDatabaseManager::rostersRefreshed, this, [this](bool success) {
+        if (success && m_rosterSubjectId > 0) {
+            loadRoster(m_rosterSubjectId);
+        }
+    });
+    
+    connect(m_dbManager, &AsyncDatabaseManager::databaseConnected, this, [this](bool success) {
         if (success) {
+            StartupReport::instance().mark("подключение");
             refresh();
         }
-        emit connectionChanged();
     });
+    connect(m_dbManager, &AsyncDatabaseManager::connectionStateChanged,
+            this, &UniversityViewModel::connectionChanged);
     
     // Пытаемся подключиться к БД с задержкой (после инициализации UI)
     QTimer::singleShot(0, this, &UniversityViewModel::connectToDatabase);
@@ -40,16 +209,22 @@ UniversityViewModel::UniversityViewModel(QObject *parent)
  */
 UniversityViewModel::~UniversityViewModel()
 {
+    // Импорт пишет через m_dbManager, поэтому останавливается раньше него
+    delete m_importer;
+    m_importer = nullptr;
+    
     // DatabaseManager будет удален автоматически как дочерний объект
 }
 
 /**
  * @brief Подключение к базе данных
- * @return bool Результат подключения
+ * 
+ * @details Подключение выполняется в рабочем потоке БД,
+ * результат приходит сигналом databaseConnected
  */
-bool UniversityViewModel::connectToDatabase()
+void UniversityViewModel::connectToDatabase()
 {
-    return m_dbManager->connectToDatabase();
+    m_dbManager->connectToDatabase();
 }
 
 /**
@@ -62,218 +237,1012 @@ bool UniversityViewModel::isConnected() const
 }
 
 /**
- * @brief Получение списка преподавателей
- * @return QStringList Список преподавателей
+ * @brief Получение названия хранилища
+ * @return QString Название
+ */
+QString UniversityViewModel::storageName() const
+{
+    return m_dbManager->storageName();
+}
+
+/**
+ * @brief Получение состояния подключения
+ * @return AsyncDatabaseManager::ConnectionState Состояние
+ */
+AsyncDatabaseManager::ConnectionState UniversityViewModel::connectionState() const
+{
+    return m_dbManager->connectionState();
+}
+
+/**
+ * @brief Получение задержки до повтора подключения
+ * @return int Миллисекунды
  */
-QStringList UniversityViewModel::teachers() const
+int UniversityViewModel::retryDelay() const
+{
+    return m_dbManager->retryDelay();
+}
+
+/**
+ * @brief Получение модели списка преподавателей
+ * @return TeacherListModel* Модель преподавателей
+ */
+TeacherListModel *UniversityViewModel::teachers() const
 {
     return m_teachers;
 }
 
 /**
- * @brief Получение списка студентов
- * @return QStringList Список студентов
+ * @brief Получение модели списка студентов
+ * @return StudentListModel* Модель студентов
  */
-QStringList UniversityViewModel::students() const
+StudentListModel *UniversityViewModel::students() const
 {
     return m_students;
 }
 
 /**
- * @brief Получение списка предметов
- * @return QStringList Список предметов
+ * @brief Получение модели списка предметов
+ * @return SubjectListModel* Модель предметов
  */
-QStringList UniversityViewModel::subjects() const
+SubjectListModel *UniversityViewModel::subjects() const
 {
     return m_subjects;
 }
 
 /**
- * @brief Получение общего количества записей
- * @return int Количество записей
+ * @brief Получение результатов поиска преподавателей
+ * @return TeacherListModel* Модель результатов
  */
-int UniversityViewModel::totalRecords() const
+TeacherListModel *UniversityViewModel::teacherResults() const
+{
+    return m_teacherResults;
+}
+
+/**
+ * @brief Получение результатов поиска студентов
+ * @return StudentListModel* Модель результатов
+ */
+StudentListModel *UniversityViewModel::studentResults() const
+{
+    return m_studentResults;
+}
+
+/**
+ * @brief Получение результатов поиска предметов
+ * @return SubjectListModel* Модель результатов
+ */
+SubjectListModel *UniversityViewModel::subjectResults() const
+{
+    return m_subjectResults;
+}
+
+/**
+ * @brief Получение строки поиска
+ * @return QString Строка поиска
+ */
+QString UniversityViewModel::searchText() const
 {
-    return m_teachers.size() + m_students.size() + m_subjects.size();
+    return m_searchText;
+}
+
+/**
+ * @brief Установка строки поиска
+ * @param text Строка поиска
+ */
+void UniversityViewModel::setSearchText(const QString &text)
+{
+    if (m_searchText == text) {
+        return;
+    }
+    m_searchText = text;
+    emit searchTextChanged();
+    
+    if (text.trimmed().isEmpty()) {
+        m_searchTimer.stop();
+        runSearch();
+    } else {
+        m_searchTimer.start();
+    }
 }
 
 /**
- * @brief Обновление списка преподавателей
+ * @brief Проверка выполнения поиска
+ * @return bool Состояние поиска
+ */
+bool UniversityViewModel::isSearching() const
+{
+    return m_pendingSearches > 0;
+}
+
+/**
+ * @brief Выполнение поиска
  * 
- * @details Загружает данные из БД и преобразует в строковый формат
+ * @details Три таблицы ищутся параллельно на соединениях пула
  */
-void UniversityViewModel::updateTeachers()
+void UniversityViewModel::runSearch()
 {
-    QList<Teacher*> teacherList = m_dbManager->getAllTeachers();
-    m_teachers.clear();
+    const quint64 generation = ++m_searchGeneration;
+    m_teacherSearch.cancel();
+    m_studentSearch.cancel();
+    m_subjectSearch.cancel();
     
-    for (Teacher *teacher : teacherList) {
-        m_teachers.append(teacher->toString());
-        teacher->deleteLater(); // Очистка памяти
+    const QString text = m_searchText.trimmed();
+    if (text.isEmpty() || !m_dbManager->isConnected()) {
+        m_teacherResults->setRankedRecords({});
+        m_studentResults->setRankedRecords({});
+        m_subjectResults->setRankedRecords({});
+        m_pendingSearches = 0;
+        emit searchingChanged();
+        return;
     }
+    
+    m_pendingSearches = 3;
+    emit searchingChanged();
+    
+    auto finishOne = [this, generation]() {
+        if (generation == m_searchGeneration && --m_pendingSearches == 0) {
+            emit searchingChanged();
+        }
+    };
+    
+    m_teacherSearch = m_dbManager->searchTeachers(text, SEARCH_LIMIT);
+    m_teacherSearch.then(this, [this, generation, finishOne](const QList<TeacherRecord> &records) {
+        if (generation == m_searchGeneration) {
+            m_teacherResults->setRankedRecords(records);
+        }
+        finishOne();
+    });
+    m_studentSearch = m_dbManager->searchStudents(text, SEARCH_LIMIT);
+    m_studentSearch.then(this, [this, generation, finishOne](const QList<StudentRecord> &records) {
+        if (generation == m_searchGeneration) {
+            m_studentResults->setRankedRecords(records);
+        }
+        finishOne();
+    });
+    m_subjectSearch = m_dbManager->searchSubjects(text, SEARCH_LIMIT);
+    m_subjectSearch.then(this, [this, generation, finishOne](const QList<SubjectRecord> &records) {
+        if (generation == m_searchGeneration) {
+            m_subjectResults->setRankedRecords(records);
+        }
+        finishOne();
+    });
+}
+
+/**
+ * @brief Получение фильтра преподавателей
+ * @return RecordFilterModel* Прокси-модель
+ */
+RecordFilterModel *UniversityViewModel::teacherFilter() const
+{
+    return m_teacherFilter;
 }
 
 /**
- * @brief Обновление списка студентов
+ * @brief Получение фильтра студентов
+ * @return RecordFilterModel* Прокси-модель
+ */
+RecordFilterModel *UniversityViewModel::studentFilter() const
+{
+    return m_studentFilter;
+}
+
+/**
+ * @brief Получение фильтра предметов
+ * @return RecordFilterModel* Прокси-модель
+ */
+RecordFilterModel *UniversityViewModel::subjectFilter() const
+{
+    return m_subjectFilter;
+}
+
+/**
+ * @brief Получение строки фильтра
+ * @return QString Строка фильтра
+ */
+QString UniversityViewModel::filterText() const
+{
+    return m_filterText;
+}
+
+/**
+ * @brief Установка строки фильтра
+ * @param text Строка фильтра
+ */
+void UniversityViewModel::setFilterText(const QString &text)
+{
+    if (m_filterText == text) {
+        return;
+    }
+    
+    m_filterText = text;
+    m_teacherFilter->setFilterText(text);
+    m_studentFilter->setFilterText(text);
+    m_subjectFilter->setFilterText(text);
+    emit filterTextChanged();
+}
+
+/**
+ * @brief Получение аналитики оценок
+ * @return GradeAnalytics* Аналитика оценок
+ */
+GradeAnalytics *UniversityViewModel::gradeAnalytics() const
+{
+    return m_gradeAnalytics;
+}
+
+/**
+ * @brief Получение модели студентов над курсором
+ * @return StudentWindowModel* Модель
+ */
+StudentWindowModel *UniversityViewModel::studentWindow() const
+{
+    return m_studentWindow;
+}
+
+/**
+ * @brief Проверка просмотра через курсор
+ * @return bool Режим включен
+ */
+bool UniversityViewModel::cursorBrowsing() const
+{
+    return m_cursorBrowsing;
+}
+
+/**
+ * @brief Включение или выключение просмотра через курсор
+ * @param enabled Открыть курсор
+ * 
+ * @details Открытие, чтение окон и закрытие выполняются в рабочем потоке
+ * по порядку, поэтому быстрое повторное переключение не оставляет
+ * открытых курсоров
+ */
+void UniversityViewModel::setCursorBrowsing(bool enabled)
+{
+    if (m_cursorBrowsing == enabled) {
+        return;
+    }
+    
+    m_cursorBrowsing = enabled;
+    emit cursorBrowsingChanged();
+    const quint64 generation = ++m_cursorGeneration;
+    
+    if (!enabled) {
+        m_studentWindow->clear();
+        m_dbManager->closeStudentCursor();
+        return;
+    }
+    
+    m_dbManager->openStudentCursor().then(this, [this, generation](qint64 count) {
+        if (generation != m_cursorGeneration) {
+            return;
+        }
+        if (count < 0) {
+            m_cursorBrowsing = false;
+            emit cursorBrowsingChanged();
+            emit errorOccurred("Просмотр через курсор недоступен: " + storageName());
+            return;
+        }
+        
+        m_studentWindow->setSource([this](qint64 offset, int limit) {
+            return m_dbManager->fetchStudentCursor(offset, limit);
+        }, count);
+        qDebug() << "Курсор по студентам открыт, строк:" << count;
+    });
+}
+
+/**
+ * @brief Получение конвейера импорта
+ * @return ImportPipeline* Конвейер импорта
+ */
+ImportPipeline *UniversityViewModel::importer() const
+{
+    return m_importer;
+}
+
+/**
+ * @brief Получение общего количества записей
+ * @return int Количество записей в БД
  * 
- * @details Загружает данные из БД и преобразует в строковый формат
+ * @details Списки загружаются постранично, поэтому значение берется из БД
+ * при обновлении и корректируется при добавлении и удалении записей
+ */
+int UniversityViewModel::totalRecords() const
+{
+    return static_cast<int>(m_counts.total());
+}
+
+/**
+ * @brief Получение количества преподавателей
+ * @return int Количество строк
+ */
+int UniversityViewModel::teacherCount() const
+{
+    return static_cast<int>(m_counts.teachers);
+}
+
+/**
+ * @brief Получение количества студентов
+ * @return int Количество строк
+ */
+int UniversityViewModel::studentCount() const
+{
+    return static_cast<int>(m_counts.students);
+}
+
+/**
+ * @brief Получение количества предметов
+ * @return int Количество строк
+ */
+int UniversityViewModel::subjectCount() const
+{
+    return static_cast<int>(m_counts.subjects);
+}
+
+/**
+ * @brief Проверка способа подсчета строк
+ * @return bool Используется оценка
+ */
+bool UniversityViewModel::estimatedCounts() const
+{
+    return m_counts.estimated;
+}
+
+/**
+ * @brief Выбор способа подсчета строк
+ * @param estimated Использовать оценку
+ */
+void UniversityViewModel::setEstimatedCounts(bool estimated)
+{
+    if (m_counts.estimated == estimated) {
+        return;
+    }
+    
+    m_counts.estimated = estimated;
+    emit estimatedCountsChanged();
+    reloadCounts();
+}
+
+/**
+ * @brief Проверка оптимистичного обновления
+ * @return bool Изменения показываются до ответа базы
+ */
+bool UniversityViewModel::optimisticUpdates() const
+{
+    return m_optimisticUpdates;
+}
+
+/**
+ * @brief Включение оптимистичного обновления
+ * @param enabled Показывать изменения до ответа базы
+ */
+void UniversityViewModel::setOptimisticUpdates(bool enabled)
+{
+    if (m_optimisticUpdates == enabled) {
+        return;
+    }
+    
+    m_optimisticUpdates = enabled;
+    emit optimisticUpdatesChanged();
+}
+
+/**
+ * @brief Выдача временного id
+ * @return int Отрицательный id или 0
+ */
+int UniversityViewModel::nextProvisionalId()
+{
+    return m_optimisticUpdates ? --m_lastProvisionalId : 0;
+}
+
+/**
+ * @brief Перечитывание таблицы, измененной целиком
+ * @param table Имя таблицы
+ */
+void UniversityViewModel::reloadTable(const QString &table)
+{
+    if (table == "teachers") {
+        m_teachers->reload();
+    } else if (table == "students") {
+        m_students->reload();
+        reloadGradeSummary();
+    } else if (table == "subjects") {
+        m_subjects->reload();
+    } else {
+        return;
+    }
+    if (!m_searchText.trimmed().isEmpty()) {
+        runSearch();
+    }
+    reloadCounts();
+}
+
+/**
+ * @brief Перечитывание количества строк
  */
-void UniversityViewModel::updateStudents()
+void UniversityViewModel::reloadCounts()
 {
-    QList<Student*> studentList = m_dbManager->getAllStudents();
-    m_students.clear();
+    if (!m_dbManager->isConnected()) {
+        return;
+    }
     
-    for (Student *student : studentList) {
-        m_students.append(student->toString());
-        student->deleteLater(); // Очистка памяти
+    const auto mode = m_counts.estimated ? DatabaseManager::CountMode::Estimated
+                                         : DatabaseManager::CountMode::Exact;
+    m_dbManager->getRecordCounts(mode).then(this, [this](const RecordCounts &counts) {
+        if (counts.estimated != m_counts.estimated) {
+            // Режим переключили, пока шел запрос
+            return;
+        }
+        m_counts = counts;
+        emit dataChanged();
+        qDebug() << "Данные обновлены. Всего записей:" << m_counts.total()
+                 << (m_counts.estimated ? "(оценка)" : "");
+    });
+}
+
+/**
+ * @brief Запрос сводки оценок
+ * 
+ * @details Читаются гистограмма и GradeAnalytics::SUMMARY_LIMIT студентов
+ * с каждого края, а не вся таблица студентов
+ */
+void UniversityViewModel::reloadGradeSummary()
+{
+    if (!m_dbManager->isConnected()) {
+        return;
     }
+    
+    m_gradeSummaryTimer.stop();
+    const quint64 generation = ++m_gradeSummaryGeneration;
+    m_gradeAnalytics->beginLoad();
+    m_dbManager->getGradeSummary(GradeAnalytics::SUMMARY_LIMIT).then(this, [this, generation](const GradeSummary &summary) {
+        if (generation != m_gradeSummaryGeneration) {
+            return;
+        }
+        m_gradeAnalytics->setSummary(summary);
+    });
 }
 
 /**
- * @brief Обновление списка предметов
+ * @brief Получение доли попаданий в кэш подготовленных запросов
+ * @return double Значение от 0 до 1
  * 
- * @details Загружает данные из БД и преобразует в строковый формат
+ * @details Обновляется в QML вместе с totalRecords по сигналу dataChanged
+ */
+double UniversityViewModel::statementCacheHitRate() const
+{
+    return m_dbManager->statementCacheHitRate();
+}
+
+/**
+ * @brief Получение снимка статистики операций хранилища
+ * @return QVariantMap Снимок
+ * 
+ * @details Как и statementCacheHitRate, обновляется по сигналу dataChanged
+ */
+QVariantMap UniversityViewModel::queryMetrics() const
+{
+    return m_dbManager->queryMetrics();
+}
+
+/**
+ * @brief Получение порога медленного запроса
+ * @return int Миллисекунды
  */
-void UniversityViewModel::updateSubjects()
+int UniversityViewModel::slowQueryThreshold() const
 {
-    QList<Subject*> subjectList = m_dbManager->getAllSubjects();
-    m_subjects.clear();
+    return m_dbManager->slowQueryThreshold();
+}
+
+/**
+ * @brief Установка порога медленного запроса
+ * @param msecs Миллисекунды
+ */
+void UniversityViewModel::setSlowQueryThreshold(int msecs)
+{
+    if (m_dbManager->slowQueryThreshold() == msecs) {
+        return;
+    }
     
-    for (Subject *subject : subjectList) {
-        m_subjects.append(subject->toString());
-        subject->deleteLater(); // Очистка памяти
+    m_dbManager->setSlowQueryThreshold(msecs);
+    emit slowQueryThresholdChanged();
+}
+
+/**
+ * @brief Сохранение статистики операций хранилища в JSON
+ * @param path Путь к файлу или file:// URL
+ * @return bool Файл записан
+ */
+bool UniversityViewModel::dumpQueryMetrics(const QString &path)
+{
+    const QUrl url(path);
+    QFile file(url.isLocalFile() ? url.toLocalFile() : path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit errorOccurred("Не удалось сохранить статистику запросов: " + file.errorString());
+        return false;
     }
+    
+    file.write(QJsonDocument(m_dbManager->queryMetricsJson()).toJson());
+    qDebug() << "Статистика запросов сохранена в" << file.fileName();
+    return true;
 }
 
 /**
  * @brief Добавление преподавателя
  * @param name Имя преподавателя
  * @param department Кафедра
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::addTeacher(const QString &name, const QString &department)
 {
-    if (name.isEmpty() || department.isEmpty()) {
-        emit errorOccurred("Имя и кафедра не могут быть пустыми");
+    const QString error = TeacherRecord{0, name, department}.validationError();
+    if (!error.isEmpty()) {
+        emit errorOccurred(error);
         return false;
     }
     
-    bool success = m_dbManager->addTeacher(name, department);
-    if (success) {
-        qDebug() << "Преподаватель добавлен:" << name;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось добавить преподавателя");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
     }
-    return success;
+    
+    const int provisionalId = nextProvisionalId();
+    m_teachers->insertProvisional(TeacherRecord{provisionalId, name, department});
+    
+    // Исключение или отмена в очереди записи не должны оставить строку-заглушку
+    auto failed = [this, name, provisionalId]() {
+        m_teachers->removeProvisional(provisionalId);
+        emit errorOccurred(QString("Не удалось добавить преподавателя %1").arg(name));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::addTeacher(name, department)).then(this, [this, name, provisionalId](const WriteResult &result) {
+        // Подтвержденная запись уже пришла сигналом о добавлении
+        m_teachers->removeProvisional(provisionalId);
+        if (result.ok) {
+            qDebug() << "Преподаватель добавлен, ID:" << result.id;
+        } else {
+            emit errorOccurred(QString("Не удалось добавить преподавателя %1").arg(name));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
 }
 
 /**
  * @brief Добавление студента
  * @param name Имя студента
  * @param grade Оценка
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::addStudent(const QString &name, int grade)
 {
-    if (name.isEmpty()) {
-        emit errorOccurred("Имя не может быть пустым");
+    const QString error = StudentRecord{0, name, grade}.validationError();
+    if (!error.isEmpty()) {
+        emit errorOccurred(error);
         return false;
     }
     
-    if (grade < 1 || grade > 5) {
-        emit errorOccurred("Оценка должна быть от 1 до 5");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
         return false;
     }
     
-    bool success = m_dbManager->addStudent(name, grade);
-    if (success) {
-        qDebug() << "Студент добавлен:" << name;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось добавить студента");
-    }
-    return success;
+    const int provisionalId = nextProvisionalId();
+    m_students->insertProvisional(StudentRecord{provisionalId, name, grade});
+    
+    // Исключение или отмена в очереди записи не должны оставить строку-заглушку
+    auto failed = [this, name, provisionalId]() {
+        m_students->removeProvisional(provisionalId);
+        emit errorOccurred(QString("Не удалось добавить студента %1").arg(name));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::addStudent(name, grade)).then(this, [this, name, provisionalId](const WriteResult &result) {
+        // Подтвержденная запись уже пришла сигналом о добавлении
+        m_students->removeProvisional(provisionalId);
+        if (result.ok) {
+            qDebug() << "Студент добавлен, ID:" << result.id;
+        } else {
+            emit errorOccurred(QString("Не удалось добавить студента %1").arg(name));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
 }
 
 /**
  * @brief Добавление предмета
  * @param name Название предмета
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::addSubject(const QString &name)
 {
-    if (name.isEmpty()) {
-        emit errorOccurred("Название предмета не может быть пустым");
+    const QString error = SubjectRecord{0, name}.validationError();
+    if (!error.isEmpty()) {
+        emit errorOccurred(error);
         return false;
     }
     
-    bool success = m_dbManager->addSubject(name);
-    if (success) {
-        qDebug() << "Предмет добавлен:" << name;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось добавить предмет");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
     }
-    return success;
+    
+    const int provisionalId = nextProvisionalId();
+    m_subjects->insertProvisional(SubjectRecord{provisionalId, name});
+    
+    // Исключение или отмена в очереди записи не должны оставить строку-заглушку
+    auto failed = [this, name, provisionalId]() {
+        m_subjects->removeProvisional(provisionalId);
+        emit errorOccurred(QString("Не удалось добавить предмет %1").arg(name));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::addSubject(name)).then(this, [this, name, provisionalId](const WriteResult &result) {
+        // Подтвержденная запись уже пришла сигналом о добавлении
+        m_subjects->removeProvisional(provisionalId);
+        if (result.ok) {
+            qDebug() << "Предмет добавлен, ID:" << result.id;
+        } else {
+            emit errorOccurred(QString("Не удалось добавить предмет %1").arg(name));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
 }
 
 /**
  * @brief Удаление преподавателя
  * @param id Идентификатор преподавателя
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::deleteTeacher(int id)
 {
-    bool success = m_dbManager->deleteTeacher(id);
-    if (success) {
-        qDebug() << "Преподаватель удален, ID:" << id;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось удалить преподавателя");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
     }
-    return success;
+    
+    if (m_optimisticUpdates) {
+        m_teachers->hideRecord(id);
+        m_teacherResults->hideRecord(id);
+    }
+    
+    // Исключение или отмена в очереди записи возвращают скрытую строку
+    auto failed = [this, id]() {
+        m_teachers->restoreRecord(id);
+        m_teacherResults->restoreRecord(id);
+        emit errorOccurred(QString("Не удалось удалить преподавателя (ID: %1)").arg(id));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::remove(WriteOperation::DeleteTeacher, id)).then(this, [this, id](const WriteResult &result) {
+        if (result.ok) {
+            qDebug() << "Преподаватель удален, ID:" << result.id;
+        } else {
+            m_teachers->restoreRecord(id);
+            m_teacherResults->restoreRecord(id);
+            emit errorOccurred(QString("Не удалось удалить преподавателя (ID: %1)").arg(id));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
 }
 
 /**
  * @brief Удаление студента
  * @param id Идентификатор студента
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::deleteStudent(int id)
 {
-    bool success = m_dbManager->deleteStudent(id);
-    if (success) {
-        qDebug() << "Студент удален, ID:" << id;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось удалить студента");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
     }
-    return success;
+    
+    if (m_optimisticUpdates) {
+        m_students->hideRecord(id);
+        m_studentResults->hideRecord(id);
+    }
+    
+    // Исключение или отмена в очереди записи возвращают скрытую строку
+    auto failed = [this, id]() {
+        m_students->restoreRecord(id);
+        m_studentResults->restoreRecord(id);
+        emit errorOccurred(QString("Не удалось удалить студента (ID: %1)").arg(id));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::remove(WriteOperation::DeleteStudent, id)).then(this, [this, id](const WriteResult &result) {
+        if (result.ok) {
+            qDebug() << "Студент удален, ID:" << result.id;
+        } else {
+            m_students->restoreRecord(id);
+            m_studentResults->restoreRecord(id);
+            emit errorOccurred(QString("Не удалось удалить студента (ID: %1)").arg(id));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
 }
 
 /**
  * @brief Удаление предмета
  * @param id Идентификатор предмета
- * @return bool Результат операции
+ * @return bool true если операция поставлена в очередь записи
  */
 bool UniversityViewModel::deleteSubject(int id)
 {
-    bool success = m_dbManager->deleteSubject(id);
-    if (success) {
-        qDebug() << "Предмет удален, ID:" << id;
-        refresh();
-    } else {
-        emit errorOccurred("Не удалось удалить предмет");
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
     }
-    return success;
+    
+    if (m_optimisticUpdates) {
+        m_subjects->hideRecord(id);
+        m_subjectResults->hideRecord(id);
+    }
+    
+    // Исключение или отмена в очереди записи возвращают скрытую строку
+    auto failed = [this, id]() {
+        m_subjects->restoreRecord(id);
+        m_subjectResults->restoreRecord(id);
+        emit errorOccurred(QString("Не удалось удалить предмет (ID: %1)").arg(id));
+    };
+    m_dbManager->enqueueWrite(WriteOperation::remove(WriteOperation::DeleteSubject, id)).then(this, [this, id](const WriteResult &result) {
+        if (result.ok) {
+            qDebug() << "Предмет удален, ID:" << result.id;
+        } else {
+            m_subjects->restoreRecord(id);
+            m_subjectResults->restoreRecord(id);
+            emit errorOccurred(QString("Не удалось удалить предмет (ID: %1)").arg(id));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
+}
+
+/**
+ * @brief Удаление выбранных преподавателей
+ * @param ids Идентификаторы
+ * @return bool true если запрос отправлен в БД
+ */
+bool UniversityViewModel::deleteTeachers(const QList<int> &ids)
+{
+    if (ids.isEmpty()) {
+        return false;
+    }
+    
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+    
+    if (m_optimisticUpdates) {
+        for (int id : ids) {
+            m_teachers->hideRecord(id);
+            m_teacherResults->hideRecord(id);
+        }
+    }
+    
+    // Исключение или отмена удаления возвращают все скрытые строки
+    auto failed = [this, ids]() {
+        for (int id : ids) {
+            m_teachers->restoreRecord(id);
+            m_teacherResults->restoreRecord(id);
+        }
+        emit errorOccurred(QString("Не удалось удалить преподавателей: %1").arg(ids.size()));
+    };
+    m_dbManager->deleteTeachers(ids).then(this, [this](const QList<WriteResult> &results) {
+        int failed = 0;
+        for (const WriteResult &result : results) {
+            if (!result.ok) {
+                ++failed;
+                m_teachers->restoreRecord(result.id);
+                m_teacherResults->restoreRecord(result.id);
+            }
+        }
+        qDebug() << "Удалено преподавателей:" << results.size() - failed;
+        if (failed > 0) {
+            emit errorOccurred(QString("Не удалось удалить преподавателей: %1 из %2").arg(failed).arg(results.size()));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
+}
+
+/**
+ * @brief Удаление выбранных студентов
+ * @param ids Идентификаторы
+ * @return bool true если запрос отправлен в БД
+ */
+bool UniversityViewModel::deleteStudents(const QList<int> &ids)
+{
+    if (ids.isEmpty()) {
+        return false;
+    }
+    
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+    
+    if (m_optimisticUpdates) {
+        for (int id : ids) {
+            m_students->hideRecord(id);
+            m_studentResults->hideRecord(id);
+        }
+    }
+    
+    // Исключение или отмена удаления возвращают все скрытые строки
+    auto failed = [this, ids]() {
+        for (int id : ids) {
+            m_students->restoreRecord(id);
+            m_studentResults->restoreRecord(id);
+        }
+        emit errorOccurred(QString("Не удалось удалить студентов: %1").arg(ids.size()));
+    };
+    m_dbManager->deleteStudents(ids).then(this, [this](const QList<WriteResult> &results) {
+        int failed = 0;
+        for (const WriteResult &result : results) {
+            if (!result.ok) {
+                ++failed;
+                m_students->restoreRecord(result.id);
+                m_studentResults->restoreRecord(result.id);
+            }
+        }
+        qDebug() << "Удалено студентов:" << results.size() - failed;
+        if (failed > 0) {
+            emit errorOccurred(QString("Не удалось удалить студентов: %1 из %2").arg(failed).arg(results.size()));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
+}
+
+/**
+ * @brief Удаление выбранных предметов
+ * @param ids Идентификаторы
+ * @return bool true если запрос отправлен в БД
+ */
+bool UniversityViewModel::deleteSubjects(const QList<int> &ids)
+{
+    if (ids.isEmpty()) {
+        return false;
+    }
+    
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+    
+    if (m_optimisticUpdates) {
+        for (int id : ids) {
+            m_subjects->hideRecord(id);
+            m_subjectResults->hideRecord(id);
+        }
+    }
+    
+    // Исключение или отмена удаления возвращают все скрытые строки
+    auto failed = [this, ids]() {
+        for (int id : ids) {
+            m_subjects->restoreRecord(id);
+            m_subjectResults->restoreRecord(id);
+        }
+        emit errorOccurred(QString("Не удалось удалить предметов: %1").arg(ids.size()));
+    };
+    m_dbManager->deleteSubjects(ids).then(this, [this](const QList<WriteResult> &results) {
+        int failed = 0;
+        for (const WriteResult &result : results) {
+            if (!result.ok) {
+                ++failed;
+                m_subjects->restoreRecord(result.id);
+                m_subjectResults->restoreRecord(result.id);
+            }
+        }
+        qDebug() << "Удалено предметов:" << results.size() - failed;
+        if (failed > 0) {
+            emit errorOccurred(QString("Не удалось удалить предметов: %1 из %2").arg(failed).arg(results.size()));
+        }
+    }).onFailed(this, failed).onCanceled(this, failed);
+    return true;
+}
+
+/**
+ * @brief Получение загруженного состава предмета
+ * @return QVariantList Строки состава
+ */
+QVariantList UniversityViewModel::roster() const
+{
+    QVariantList rows;
+    rows.reserve(m_roster.size());
+    for (const RosterEntry &entry : m_roster) {
+        rows.append(QVariant::fromValue(entry));
+    }
+    return rows;
+}
+
+/**
+ * @brief Получение предмета загруженного состава
+ * @return int Идентификатор предмета
+ */
+int UniversityViewModel::rosterSubjectId() const
+{
+    return m_rosterSubjectId;
+}
+
+/**
+ * @brief Запись студента на предмет
+ * @param studentId Идентификатор студента
+ * @param subjectId Идентификатор предмета
+ * @param grade Оценка или 0
+ * @return bool true если операция поставлена в очередь
+ */
+bool UniversityViewModel::enrollStudent(int studentId, int subjectId, int grade)
+{
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+    if (studentId <= 0 || subjectId <= 0) {
+        emit errorOccurred("Укажите ID студента и предмета");
+        return false;
+    }
+    if (grade < 0 || grade > 5) {
+        emit errorOccurred("Оценка должна быть от 1 до 5");
+        return false;
+    }
+    
+    m_dbManager->enqueueWrite(WriteOperation::enroll(studentId, subjectId, grade)).then(this, [this, studentId, subjectId](const WriteResult &result) {
+        if (result.ok) {
+            qDebug() << "Студент" << studentId << "записан на предмет" << subjectId;
+        } else {
+            emit errorOccurred(QString("Не удалось записать студента (ID: %1) на предмет (ID: %2)")
+                               .arg(studentId).arg(subjectId));
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Назначение преподавателя на предмет
+ * @param teacherId Идентификатор преподавателя
+ * @param subjectId Идентификатор предмета
+ * @return bool true если операция поставлена в очередь
+ */
+bool UniversityViewModel::assignTeacher(int teacherId, int subjectId)
+{
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return false;
+    }
+    if (teacherId <= 0 || subjectId <= 0) {
+        emit errorOccurred("Укажите ID преподавателя и предмета");
+        return false;
+    }
+    
+    m_dbManager->enqueueWrite(WriteOperation::assign(teacherId, subjectId)).then(this, [this, teacherId, subjectId](const WriteResult &result) {
+        if (result.ok) {
+            qDebug() << "Преподаватель" << teacherId << "назначен на предмет" << subjectId;
+        } else {
+            emit errorOccurred(QString("Не удалось назначить преподавателя (ID: %1) на предмет (ID: %2)")
+                               .arg(teacherId).arg(subjectId));
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Загрузка состава предмета
+ * @param subjectId Идентификатор предмета
+ */
+void UniversityViewModel::loadRoster(int subjectId)
+{
+    if (!m_dbManager->isConnected()) {
+        emit errorOccurred("Нет подключения к базе данных");
+        return;
+    }
+    
+    const quint64 generation = ++m_rosterGeneration;
+    m_rosterSubjectId = subjectId;
+    m_dbManager->getSubjectRoster(subjectId).then(this, [this, generation](const QList<RosterEntry> &roster) {
+        if (generation != m_rosterGeneration) {
+            return;
+        }
+        m_roster = roster;
+        emit rosterChanged();
+    });
 }
 
 /**
  * @brief Обновление всех данных
  * 
- * @details Загружает актуальные данные из всех таблиц БД
- * и обновляет соответствующие списки
+ * @details Асинхронно перечитывает уже загруженные страницы всех списков
+ * и общее количество записей. Модели применяют только отличия.
  */
 void UniversityViewModel::refresh()
 {
@@ -281,10 +1250,23 @@ void UniversityViewModel::refresh()
         return;
     }
     
-    updateTeachers();
-    updateStudents();
-    updateSubjects();
+    const QList<QFuture<void>> reloads = {m_teachers->reload(), m_students->reload(), m_subjects->reload()};
+    
+    // Первый полный показ данных завершает отчет о запуске
+    if (!StartupReport::instance().contains("первые данные")) {
+        auto remaining = std::make_shared<int>(static_cast<int>(reloads.size()));
+        for (QFuture<void> reload : reloads) {
+            reload.then(this, [remaining]() {
+                if (--*remaining == 0) {
+                    StartupReport::instance().mark("первые данные");
+                    StartupReport::instance().print();
+                }
+            });
+        }
+    }
+    
+    // Аналитика считается в БД по всей таблице, а не по загруженным страницам
+    reloadGradeSummary();
     
-    emit dataChanged();
-    qDebug() << "Данные обновлены. Всего записей:" << totalRecords();
-}
\ No newline at end of file
+    reloadCounts();
+}
@@ -12,43 +12,186 @@
  * - Управляет обновлением данных
  * - Отслеживает состояние подключения к БД
  * 
- * @property QStringList UniversityViewModel::teachers
- * @brief Список преподавателей в строковом формате
+ * Все обращения к БД выполняются асинхронно через AsyncDatabaseManager,
+ * результаты применяются по мере поступления. Добавление и удаление записей
+ * идут через очередь пакетной записи: серия удалений фиксируется одной
+ * транзакцией и применяется к моделям одним изменением на таблицу.
  * 
- * @property QStringList UniversityViewModel::students
- * @brief Список студентов в строковом формате
+ * @property TeacherListModel* UniversityViewModel::teachers
+ * @brief Модель списка преподавателей
  * 
- * @property QStringList UniversityViewModel::subjects
- * @brief Список предметов в строковом формате
+ * @property StudentListModel* UniversityViewModel::students
+ * @brief Модель списка студентов
+ * 
+ * @property SubjectListModel* UniversityViewModel::subjects
+ * @brief Модель списка предметов
  * 
  * @property int UniversityViewModel::totalRecords
- * @brief Общее количество записей во всех таблицах
+ * @brief Общее количество записей во всех таблицах БД (не только загруженных)
+ * 
+ * @property int UniversityViewModel::teacherCount
+ * @brief Количество преподавателей в БД
+ * 
+ * @property int UniversityViewModel::studentCount
+ * @brief Количество студентов в БД
+ * 
+ * @property int UniversityViewModel::subjectCount
+ * @brief Количество предметов в БД
+ * 
+ * @property bool UniversityViewModel::estimatedCounts
+ * @brief Брать количество строк из оценки планировщика (pg_class.reltuples)
+ * вместо точных счетчиков
  * 
  * @property bool UniversityViewModel::isConnected
  * @brief Состояние подключения к базе данных
+ * 
+ * @property QString UniversityViewModel::storageName
+ * @brief Название хранилища данных (PostgreSQL, SQLite или память)
+ * 
+ * @property AsyncDatabaseManager::ConnectionState UniversityViewModel::connectionState
+ * @brief Этап подключения: подключение, повтор после ошибки, подключено
+ * 
+ * @property int UniversityViewModel::retryDelay
+ * @brief Задержка до повтора подключения в миллисекундах на момент
+ * последнего изменения состояния
+ * 
+ * @property QString UniversityViewModel::searchText
+ * @brief Строка поиска. Запрос к БД выполняется через SEARCH_DEBOUNCE_INTERVAL
+ * после последнего изменения, предыдущий незавершенный поиск отменяется
+ * 
+ * @property bool UniversityViewModel::searching
+ * @brief Идет поиск
+ * 
+ * @property TeacherListModel* UniversityViewModel::teacherResults
+ * @brief Найденные преподаватели по убыванию сходства
+ * 
+ * @property StudentListModel* UniversityViewModel::studentResults
+ * @brief Найденные студенты по убыванию сходства
+ * 
+ * @property SubjectListModel* UniversityViewModel::subjectResults
+ * @brief Найденные предметы по убыванию сходства
+ * 
+ * @property RecordFilterModel* UniversityViewModel::teacherFilter
+ * @brief Загруженные преподаватели, отфильтрованные по filterText
+ * 
+ * @property RecordFilterModel* UniversityViewModel::studentFilter
+ * @brief Загруженные студенты, отфильтрованные по filterText
+ * 
+ * @property RecordFilterModel* UniversityViewModel::subjectFilter
+ * @brief Загруженные предметы, отфильтрованные по filterText
+ * 
+ * @property QString UniversityViewModel::filterText
+ * @brief Строка фильтра загруженных строк. Применяется сразу, без запросов к БД
+ * 
+ * @property GradeAnalytics* UniversityViewModel::gradeAnalytics
+ * @brief Распределение оценок, средний балл, лучшие и худшие студенты
+ * 
+ * @property ImportPipeline* UniversityViewModel::importer
+ * @brief Импорт записей из CSV и JSON файлов
+ * 
+ * @property double UniversityViewModel::statementCacheHitRate
+ * @brief Доля запросов, взятых из кэша подготовленных запросов (0..1)
+ * 
+ * @property QVariantMap UniversityViewModel::queryMetrics
+ * @brief Задержки операций хранилища (p50/p95/p99 в мс), строки, байты
+ * и последние медленные запросы, см. QueryMetrics::snapshot()
+ * 
+ * @property StudentWindowModel* UniversityViewModel::studentWindow
+ * @brief Студенты из серверного курсора; заполняется, пока включен cursorBrowsing
+ * 
+ * @property bool UniversityViewModel::cursorBrowsing
+ * @brief Просмотр студентов через курсор: снимок таблицы читается окнами,
+ * в памяти остается ограниченное число строк. Доступен только в PostgreSQL
+ * 
+ * @property bool UniversityViewModel::optimisticUpdates
+ * @brief Показывать добавление и удаление сразу, до ответа базы.
+ * Новая запись получает временный отрицательный id и роль pending,
+ * после подтверждения ее заменяет настоящая запись. Если запись
+ * не удалась, изменение откатывается и отправляется errorOccurred
+ * 
+ * @property int UniversityViewModel::slowQueryThreshold
+ * @brief Порог медленного запроса в миллисекундах, 0 отключает журнал
+ * 
+ * @property QVariantList UniversityViewModel::roster
+ * @brief Состав предмета rosterSubjectId: список RosterEntry. Перечитывается
+ * после каждой пересборки составов (AsyncDatabaseManager::rostersRefreshed)
+ * 
+ * @property int UniversityViewModel::rosterSubjectId
+ * @brief Предмет, состав которого загружен, или 0
  */
 
 #ifndef UNIVERSITYVIEWMODEL_H
 #define UNIVERSITYVIEWMODEL_H
 
 #include <QObject>
-#include <QStringList>
-#include <QAbstractListModel>
-#include "../models/DatabaseManager.h"
+#include <QFuture>
+#include <QTimer>
+#include <QVariantList>
+#include "../models/AsyncDatabaseManager.h"
+#include "../models/ImportPipeline.h"
+#include "../models/RosterEntry.h"
 #include "../models/Teacher.h"
 #include "../models/Student.h"
 #include "../models/Subject.h"
+#include "TeacherListModel.h"
+#include "StudentListModel.h"
+#include "SubjectListModel.h"
+#include "StudentWindowModel.h"
+#include "RecordFilterModel.h"
+#include "GradeAnalytics.h"
 
 class UniversityViewModel : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(QStringList teachers READ teachers NOTIFY dataChanged)
-    Q_PROPERTY(QStringList students READ students NOTIFY dataChanged)
-    Q_PROPERTY(QStringList subjects READ subjects NOTIFY dataChanged)
+    Q_PROPERTY(TeacherListModel *teachers READ teachers CONSTANT)
+    Q_PROPERTY(StudentListModel *students READ students CONSTANT)
+    Q_PROPERTY(SubjectListModel *subjects READ subjects CONSTANT)
+    Q_PROPERTY(TeacherListModel *teacherResults READ teacherResults CONSTANT)
+    Q_PROPERTY(StudentListModel *studentResults READ studentResults CONSTANT)
+    Q_PROPERTY(SubjectListModel *subjectResults READ subjectResults CONSTANT)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+    Q_PROPERTY(bool searching READ isSearching NOTIFY searchingChanged)
+    Q_PROPERTY(RecordFilterModel *teacherFilter READ teacherFilter CONSTANT)
+    Q_PROPERTY(RecordFilterModel *studentFilter READ studentFilter CONSTANT)
+    Q_PROPERTY(RecordFilterModel *subjectFilter READ subjectFilter CONSTANT)
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    Q_PROPERTY(GradeAnalytics *gradeAnalytics READ gradeAnalytics CONSTANT)
+    Q_PROPERTY(StudentWindowModel *studentWindow READ studentWindow CONSTANT)
+    Q_PROPERTY(bool cursorBrowsing READ cursorBrowsing WRITE setCursorBrowsing NOTIFY cursorBrowsingChanged)
+    Q_PROPERTY(ImportPipeline *importer READ importer CONSTANT)
     Q_PROPERTY(int totalRecords READ totalRecords NOTIFY dataChanged)
+    Q_PROPERTY(int teacherCount READ teacherCount NOTIFY dataChanged)
+    Q_PROPERTY(int studentCount READ studentCount NOTIFY dataChanged)
+    Q_PROPERTY(int subjectCount READ subjectCount NOTIFY dataChanged)
+    Q_PROPERTY(bool estimatedCounts READ estimatedCounts WRITE setEstimatedCounts NOTIFY estimatedCountsChanged)
+    Q_PROPERTY(bool optimisticUpdates READ optimisticUpdates WRITE setOptimisticUpdates NOTIFY optimisticUpdatesChanged)
     Q_PROPERTY(bool isConnected READ isConnected NOTIFY connectionChanged)
+    Q_PROPERTY(QString storageName READ storageName CONSTANT)
+    Q_PROPERTY(AsyncDatabaseManager::ConnectionState connectionState READ connectionState NOTIFY connectionChanged)
+    Q_PROPERTY(int retryDelay READ retryDelay NOTIFY connectionChanged)
+    Q_PROPERTY(double statementCacheHitRate READ statementCacheHitRate NOTIFY dataChanged)
+    Q_PROPERTY(QVariantMap queryMetrics READ queryMetrics NOTIFY dataChanged)
+    Q_PROPERTY(int slowQueryThreshold READ slowQueryThreshold WRITE setSlowQueryThreshold NOTIFY slowQueryThresholdChanged)
+    Q_PROPERTY(QVariantList roster READ roster NOTIFY rosterChanged)
+    Q_PROPERTY(int rosterSubjectId READ rosterSubjectId NOTIFY rosterChanged)
     
 public:
+    /**
+     * @brief Задержка поиска после последнего изменения searchText, мс
+     */
+    static constexpr int SEARCH_DEBOUNCE_INTERVAL = 250;
+    
+    /**
+     * @brief Максимальное количество результатов поиска в каждой таблице
+     */
+    static constexpr int SEARCH_LIMIT = 100;
+    
+    /**
+     * @brief Задержка повторного запроса сводки оценок, мс
+     * @details Удаления подряд (например, пакетом) перечитывают сводку один раз
+     */
+    static constexpr int GRADE_SUMMARY_DELAY = 200;
+    
     /**
      * @brief Конструктор UniversityViewModel
      * @param parent Родительский QObject
@@ -63,22 +206,125 @@ public:
     ~UniversityViewModel();
     
     /**
-     * @brief Получить список преподавателей
-     * @return QStringList Список преподавателей
+     * @brief Получить модель списка преподавателей
+     * @return TeacherListModel* Модель преподавателей
+     */
+    TeacherListModel *teachers() const;
+    
+    /**
+     * @brief Получить модель списка студентов
+     * @return StudentListModel* Модель студентов
      */
-    QStringList teachers() const;
+    StudentListModel *students() const;
     
     /**
-     * @brief Получить список студентов
-     * @return QStringList Список студентов
+     * @brief Получить модель списка предметов
+     * @return SubjectListModel* Модель предметов
      */
-    QStringList students() const;
+    SubjectListModel *subjects() const;
     
     /**
-     * @brief Получить список предметов
-     * @return QStringList Список предметов
+     * @brief Получить результаты поиска преподавателей
+     * @return TeacherListModel* Модель результатов
      */
-    QStringList subjects() const;
+    TeacherListModel *teacherResults() const;
+    
+    /**
+     * @brief Получить результаты поиска студентов
+     * @return StudentListModel* Модель результатов
+     */
+    StudentListModel *studentResults() const;
+    
+    /**
+     * @brief Получить результаты поиска предметов
+     * @return SubjectListModel* Модель результатов
+     */
+    SubjectListModel *subjectResults() const;
+    
+    /**
+     * @brief Получить строку поиска
+     * @return QString Строка поиска
+     */
+    QString searchText() const;
+    
+    /**
+     * @brief Установить строку поиска
+     * @param text Строка поиска
+     * 
+     * @details Перезапускает таймер задержки. Пустая строка сразу
+     * очищает результаты и отменяет текущий поиск.
+     */
+    void setSearchText(const QString &text);
+    
+    /**
+     * @brief Проверить, идет ли поиск
+     * @return bool true пока не получены результаты всех таблиц
+     */
+    bool isSearching() const;
+    
+    /**
+     * @brief Получить фильтр преподавателей
+     * @return RecordFilterModel* Прокси-модель над teachers
+     */
+    RecordFilterModel *teacherFilter() const;
+    
+    /**
+     * @brief Получить фильтр студентов
+     * @return RecordFilterModel* Прокси-модель над students
+     */
+    RecordFilterModel *studentFilter() const;
+    
+    /**
+     * @brief Получить фильтр предметов
+     * @return RecordFilterModel* Прокси-модель над subjects
+     */
+    RecordFilterModel *subjectFilter() const;
+    
+    /**
+     * @brief Получить строку фильтра
+     * @return QString Строка фильтра
+     */
+    QString filterText() const;
+    
+    /**
+     * @brief Установить строку фильтра всех списков
+     * @param text Строка фильтра
+     */
+    void setFilterText(const QString &text);
+    
+    /**
+     * @brief Получить аналитику оценок
+     * @return GradeAnalytics* Аналитика оценок
+     */
+    GradeAnalytics *gradeAnalytics() const;
+    
+    /**
+     * @brief Получить модель студентов над курсором
+     * @return StudentWindowModel* Модель
+     */
+    StudentWindowModel *studentWindow() const;
+    
+    /**
+     * @brief Проверить, включен ли просмотр через курсор
+     * @return bool true если курсор открыт или открывается
+     */
+    bool cursorBrowsing() const;
+    
+    /**
+     * @brief Включить или выключить просмотр студентов через курсор
+     * @param enabled true чтобы открыть курсор
+     * 
+     * @details При включении курсор открывается на снимке таблицы, при
+     * выключении закрывается. Если хранилище не поддерживает курсоры,
+     * режим выключается и отправляется errorOccurred.
+     */
+    void setCursorBrowsing(bool enabled);
+    
+    /**
+     * @brief Получить конвейер импорта
+     * @return ImportPipeline* Конвейер импорта
+     */
+    ImportPipeline *importer() const;
     
     /**
      * @brief Получить общее количество записей
@@ -86,17 +332,120 @@ public:
      */
     int totalRecords() const;
     
+    /**
+     * @brief Получить количество преподавателей
+     * @return int Количество строк teachers
+     */
+    int teacherCount() const;
+    
+    /**
+     * @brief Получить количество студентов
+     * @return int Количество строк students
+     */
+    int studentCount() const;
+    
+    /**
+     * @brief Получить количество предметов
+     * @return int Количество строк subjects
+     */
+    int subjectCount() const;
+    
+    /**
+     * @brief Проверить, используется ли оценка количества строк
+     * @return bool true для pg_class.reltuples, false для точных счетчиков
+     */
+    bool estimatedCounts() const;
+    
+    /**
+     * @brief Выбрать способ подсчета строк
+     * @param estimated true для оценки планировщика
+     * 
+     * @details Счетчики сразу перечитываются из БД
+     */
+    void setEstimatedCounts(bool estimated);
+    
+    /**
+     * @brief Проверить, включено ли оптимистичное обновление списков
+     * @return bool true если изменения показываются до ответа базы
+     */
+    bool optimisticUpdates() const;
+    
+    /**
+     * @brief Включить или выключить оптимистичное обновление списков
+     * @param enabled true чтобы показывать изменения до ответа базы
+     * 
+     * @details Уже показанные временные изменения дожидаются ответа базы
+     */
+    void setOptimisticUpdates(bool enabled);
+    
     /**
      * @brief Проверить подключение к БД
      * @return bool Состояние подключения
      */
     bool isConnected() const;
     
+    /**
+     * @brief Получить название хранилища
+     * @return QString Название
+     */
+    QString storageName() const;
+    
+    /**
+     * @brief Получить состояние подключения
+     * @return AsyncDatabaseManager::ConnectionState Состояние
+     */
+    AsyncDatabaseManager::ConnectionState connectionState() const;
+    
+    /**
+     * @brief Получить задержку до повтора подключения
+     * @return int Миллисекунды или 0, если повтор не запланирован
+     */
+    int retryDelay() const;
+    
+    /**
+     * @brief Получить долю попаданий в кэш подготовленных запросов
+     * @return double Значение от 0 до 1
+     */
+    double statementCacheHitRate() const;
+    
+    /**
+     * @brief Получить снимок статистики операций хранилища
+     * @return QVariantMap Снимок QueryMetrics::snapshot()
+     */
+    QVariantMap queryMetrics() const;
+    
+    /**
+     * @brief Получить порог медленного запроса
+     * @return int Миллисекунды
+     */
+    int slowQueryThreshold() const;
+    
+    /**
+     * @brief Задать порог медленного запроса
+     * @param msecs Миллисекунды, 0 отключает журнал
+     */
+    void setSlowQueryThreshold(int msecs);
+    
+    /**
+     * @brief Получить загруженный состав предмета
+     * @return QVariantList Строки RosterEntry
+     */
+    QVariantList roster() const;
+    
+    /**
+     * @brief Получить предмет загруженного состава
+     * @return int Идентификатор предмета или 0
+     */
+    int rosterSubjectId() const;
+    
     /**
      * @brief Добавить преподавателя (инвокабельный метод для QML)
      * @param name Имя преподавателя
      * @param department Кафедра
-     * @return bool Результат операции
+     * @return bool true если данные прошли проверку и операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool addTeacher(const QString &name, const QString &department);
     
@@ -104,53 +453,140 @@ public:
      * @brief Добавить студента (инвокабельный метод для QML)
      * @param name Имя студента
      * @param grade Оценка
-     * @return bool Результат операции
+     * @return bool true если данные прошли проверку и операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool addStudent(const QString &name, int grade);
     
     /**
      * @brief Добавить предмет (инвокабельный метод для QML)
      * @param name Название предмета
-     * @return bool Результат операции
+     * @return bool true если данные прошли проверку и операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool addSubject(const QString &name);
     
     /**
      * @brief Удалить преподавателя по ID (инвокабельный метод для QML)
      * @param id Идентификатор преподавателя
-     * @return bool Результат операции
+     * @return bool true если операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool deleteTeacher(int id);
     
     /**
      * @brief Удалить студента по ID (инвокабельный метод для QML)
      * @param id Идентификатор студента
-     * @return bool Результат операции
+     * @return bool true если операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool deleteStudent(int id);
     
     /**
      * @brief Удалить предмет по ID (инвокабельный метод для QML)
      * @param id Идентификатор предмета
-     * @return bool Результат операции
+     * @return bool true если операция поставлена в очередь записи
+     * 
+     * @details Операция выполняется в пакете с соседними (см. WriteBatcher),
+     * ее ошибка сообщается сигналом errorOccurred
      */
     Q_INVOKABLE bool deleteSubject(int id);
     
+    /**
+     * @brief Удалить выбранных преподавателей одним запросом (инвокабельный метод для QML)
+     * @param ids Идентификаторы выбранных записей
+     * @return bool true если запрос отправлен в БД
+     * 
+     * @details Строки сразу скрываются из списков, если включен optimisticUpdates.
+     * Записи, которые удалить не удалось, возвращаются в списки, а их
+     * количество сообщается сигналом errorOccurred
+     */
+    Q_INVOKABLE bool deleteTeachers(const QList<int> &ids);
+    
+    /**
+     * @brief Удалить выбранных студентов одним запросом (инвокабельный метод для QML)
+     * @param ids Идентификаторы выбранных записей
+     * @return bool true если запрос отправлен в БД
+     * 
+     * @details Строки сразу скрываются из списков, если включен optimisticUpdates.
+     * Записи, которые удалить не удалось, возвращаются в списки, а их
+     * количество сообщается сигналом errorOccurred
+     */
+    Q_INVOKABLE bool deleteStudents(const QList<int> &ids);
+    
+    /**
+     * @brief Удалить выбранных предметов одним запросом (инвокабельный метод для QML)
+     * @param ids Идентификаторы выбранных записей
+     * @return bool true если запрос отправлен в БД
+     * 
+     * @details Строки сразу скрываются из списков, если включен optimisticUpdates.
+     * Записи, которые удалить не удалось, возвращаются в списки, а их
+     * количество сообщается сигналом errorOccurred
+     */
+    Q_INVOKABLE bool deleteSubjects(const QList<int> &ids);
+    
+    /**
+     * @brief Записать студента на предмет (инвокабельный метод для QML)
+     * @param studentId Идентификатор студента
+     * @param subjectId Идентификатор предмета
+     * @param grade Оценка от 1 до 5 или 0, если оценки еще нет
+     * @return bool true если данные прошли проверку и операция поставлена в очередь записи
+     * 
+     * @details Повторная запись меняет оценку. Ошибка сообщается сигналом errorOccurred
+     */
+    Q_INVOKABLE bool enrollStudent(int studentId, int subjectId, int grade);
+    
+    /**
+     * @brief Назначить преподавателя на предмет (инвокабельный метод для QML)
+     * @param teacherId Идентификатор преподавателя
+     * @param subjectId Идентификатор предмета
+     * @return bool true если операция поставлена в очередь записи
+     */
+    Q_INVOKABLE bool assignTeacher(int teacherId, int subjectId);
+    
+    /**
+     * @brief Загрузить состав предмета (инвокабельный метод для QML)
+     * @param subjectId Идентификатор предмета
+     * 
+     * @details Результат приходит сигналом rosterChanged. Ответ на запрос
+     * предыдущего предмета отбрасывается
+     */
+    Q_INVOKABLE void loadRoster(int subjectId);
+    
     /**
      * @brief Обновить данные (инвокабельный метод для QML)
+     * @details Асинхронно перечитывает загруженные страницы списков и счетчик записей
      */
     Q_INVOKABLE void refresh();
     
     /**
      * @brief Подключиться к базе данных (инвокабельный метод для QML)
-     * @return bool Результат подключения
+     * @details Результат приходит сигналом connectionChanged
+     */
+    Q_INVOKABLE void connectToDatabase();
+    
+    /**
+     * @brief Сохранить статистику операций хранилища в JSON (инвокабельный метод для QML)
+     * @param path Путь к файлу или file:// URL
+     * @return bool true если файл записан
+     * 
+     * @details Ошибка записи сообщается сигналом errorOccurred
      */
-    Q_INVOKABLE bool connectToDatabase();
+    Q_INVOKABLE bool dumpQueryMetrics(const QString &path);
     
 signals:
     /**
      * @brief Сигнал об изменении данных
-     * @details Генерируется при любом изменении данных в БД
+     * @details Генерируется при любом изменении данных в БД.
+     * Строки списков сообщают о своих изменениях через модели.
      */
     void dataChanged();
     
@@ -159,6 +595,46 @@ signals:
      */
     void connectionChanged();
     
+    /**
+     * @brief Сигнал об изменении строки поиска
+     */
+    void searchTextChanged();
+    
+    /**
+     * @brief Сигнал о начале или завершении поиска
+     */
+    void searchingChanged();
+    
+    /**
+     * @brief Сигнал об изменении строки фильтра
+     */
+    void filterTextChanged();
+    
+    /**
+     * @brief Сигнал об изменении способа подсчета строк
+     */
+    void estimatedCountsChanged();
+    
+    /**
+     * @brief Сигнал о включении или выключении оптимистичного обновления
+     */
+    void optimisticUpdatesChanged();
+    
+    /**
+     * @brief Сигнал о включении или выключении просмотра через курсор
+     */
+    void cursorBrowsingChanged();
+    
+    /**
+     * @brief Сигнал об изменении порога медленного запроса
+     */
+    void slowQueryThresholdChanged();
+    
+    /**
+     * @brief Сигнал об изменении загруженного состава предмета
+     */
+    void rosterChanged();
+    
     /**
      * @brief Сигнал об ошибке
      * @param message Текст ошибки
@@ -167,25 +643,69 @@ signals:
     
 private:
     /**
-     * @brief Обновить список преподавателей
+     * @brief Выполнить поиск по текущей строке
+     * @details Отменяет предыдущие запросы; ответы на них отбрасываются
+     * по номеру поиска
      */
-    void updateTeachers();
+    void runSearch();
     
     /**
-     * @brief Обновить список студентов
+     * @brief Перечитать количество строк таблиц одним запросом
      */
-    void updateStudents();
+    void reloadCounts();
     
     /**
-     * @brief Обновить список предметов
+     * @brief Перечитать таблицу, измененную другим клиентом целиком
+     * @param table Имя таблицы
+     * @details Перезагружаются модель таблицы, результаты поиска,
+     * количество строк и для студентов сводка оценок
      */
-    void updateSubjects();
+    void reloadTable(const QString &table);
     
-private:
-    DatabaseManager *m_dbManager;   ///< Менеджер базы данных
-    QStringList m_teachers;         ///< Кэшированный список преподавателей
-    QStringList m_students;         ///< Кэшированный список студентов
-    QStringList m_subjects;         ///< Кэшированный список предметов
+    /**
+     * @brief Запросить сводку оценок для аналитики
+     * @details Ответы на предыдущие запросы отбрасываются по номеру
+     */
+    void reloadGradeSummary();
+    
+    /**
+     * @brief Выдать временный id для записи, ожидающей подтверждения
+     * @return int Отрицательный id или 0, если оптимистичное обновление выключено
+     */
+    int nextProvisionalId();
+    
+    AsyncDatabaseManager *m_dbManager; ///< Асинхронный менеджер базы данных
+    TeacherListModel *m_teachers;   ///< Модель списка преподавателей
+    StudentListModel *m_students;   ///< Модель списка студентов
+    SubjectListModel *m_subjects;   ///< Модель списка предметов
+    TeacherListModel *m_teacherResults; ///< Результаты поиска преподавателей
+    StudentListModel *m_studentResults; ///< Результаты поиска студентов
+    SubjectListModel *m_subjectResults; ///< Результаты поиска предметов
+    RecordFilterModel *m_teacherFilter; ///< Фильтр загруженных преподавателей
+    RecordFilterModel *m_studentFilter; ///< Фильтр загруженных студентов
+    RecordFilterModel *m_subjectFilter; ///< Фильтр загруженных предметов
+    GradeAnalytics *m_gradeAnalytics; ///< Аналитика оценок
+    QTimer m_gradeSummaryTimer;     ///< Таймер повторного запроса сводки оценок
+    quint64 m_gradeSummaryGeneration; ///< Номер запроса сводки, старые ответы отбрасываются
+    StudentWindowModel *m_studentWindow; ///< Студенты из курсора
+    bool m_cursorBrowsing;          ///< Включен просмотр через курсор
+    quint64 m_cursorGeneration;     ///< Номер включения курсора, старые ответы отбрасываются
+    ImportPipeline *m_importer;     ///< Импорт из файлов
+    RecordCounts m_counts;          ///< Количество строк в таблицах БД
+    bool m_optimisticUpdates;       ///< Изменения показываются до ответа базы
+    int m_lastProvisionalId;        ///< Последний выданный временный id
+    QList<RosterEntry> m_roster;    ///< Загруженный состав предмета
+    int m_rosterSubjectId;          ///< Предмет загруженного состава
+    quint64 m_rosterGeneration;     ///< Номер запроса состава, старые ответы отбрасываются
+    
+    QString m_searchText;           ///< Строка поиска
+    QString m_filterText;           ///< Строка фильтра
+    QTimer m_searchTimer;           ///< Таймер задержки поиска
+    quint64 m_searchGeneration;     ///< Номер текущего поиска
+    int m_pendingSearches;          ///< Незавершенные запросы текущего поиска
+    QFuture<QList<TeacherRecord>> m_teacherSearch; ///< Текущий поиск преподавателей
+    QFuture<QList<StudentRecord>> m_studentSearch; ///< Текущий поиск студентов
+    QFuture<QList<SubjectRecord>> m_subjectSearch; ///< Текущий поиск предметов
 };
 
 #endif // UNIVERSITYVIEWMODEL_H
\ No newline at end of file
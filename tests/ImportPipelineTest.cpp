@@ -0,0 +1,86 @@
+/**
+ * @file ImportPipelineTest.cpp
+ * @brief Тесты разбора файлов ImportPipeline
+ *
+ * @class ImportPipelineTest
+ * @brief Импорт JSON в хранилище в памяти
+ *
+ * Файл импортируется целиком через конвейер, затем проверяется
+ * количество принятых и отклоненных строк и записанные оценки.
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "AsyncDatabaseManager.h"
+#include "ImportPipeline.h"
+#include "StorageBackend.h"
+
+class ImportPipelineTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Выбрать хранилище в памяти
+     */
+    void initTestCase();
+
+    /**
+     * @brief Дробные и слишком большие оценки в JSON отклоняются
+     */
+    void jsonRejectsNonIntegralGrades();
+};
+
+/**
+ * @brief Выбор хранилища в памяти
+ */
+void ImportPipelineTest::initTestCase()
+{
+    qputenv(StorageBackend::STORAGE_ENV, "memory");
+}
+
+/**
+ * @brief Дробные и слишком большие оценки в JSON отклоняются
+ *
+ * @details Раньше 4.5 усекалось до 4, а 1e20 превращалось в мусор
+ */
+void ImportPipelineTest::jsonRejectsNonIntegralGrades()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("students.jsonl");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(R"({"full_name": "Иванов Иван Иванович", "grade": 4}
+{"full_name": "Петрова Анна Сергеевна", "grade": 4.5}
+{"full_name": "Сидоров Пётр Олегович", "grade": 1e20}
+{"full_name": "Орлова Мария Павловна", "grade": 5.0}
+)");
+    file.close();
+
+    AsyncDatabaseManager manager;
+    manager.connectToDatabase();
+    QTRY_VERIFY(manager.isConnected());
+
+    ImportPipeline pipeline(&manager);
+    QSignalSpy finished(&pipeline, &ImportPipeline::finished);
+    QVERIFY(pipeline.start(QUrl::fromLocalFile(path), "students"));
+    QTRY_COMPARE(finished.count(), 1);
+
+    QCOMPARE(pipeline.importedRows(), 2);
+    QCOMPARE(pipeline.rejectedRows(), 2);
+
+    QFuture<QList<StudentRecord>> students = manager.getAllStudents();
+    QTRY_VERIFY(students.isFinished());
+    const QList<StudentRecord> records = students.result();
+    QCOMPARE(records.size(), 2);
+    QCOMPARE(records.at(0).fullName, QString("Иванов Иван Иванович"));
+    QCOMPARE(records.at(0).grade, 4);
+    QCOMPARE(records.at(1).fullName, QString("Орлова Мария Павловна"));
+    QCOMPARE(records.at(1).grade, 5);
+}
+
+QTEST_GUILESS_MAIN(ImportPipelineTest)
+
+#include "ImportPipelineTest.moc"
@@ -0,0 +1,129 @@
+/**
+ * @file RecordFilterModelTest.cpp
+ * @brief Тесты фильтра загруженных строк RecordFilterModel
+ *
+ * @class RecordFilterModelTest
+ * @brief Проверки фильтра над моделью со временными записями
+ *
+ * Временные записи добавляются в конец списка после загруженных строк,
+ * поэтому фильтр должен индексировать и проверять их наравне с остальными.
+ */
+
+#include <QtTest>
+
+#include "RecordFilterModel.h"
+#include "StudentListModel.h"
+
+class RecordFilterModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Добавление и удаление временной записи при подключенном фильтре
+     */
+    void provisionalRowWithFilter();
+
+    /**
+     * @brief Перестройка индекса захватывает временные записи
+     */
+    void rebuildIncludesProvisional();
+
+    /**
+     * @brief Крупная вставка вливается в индекс без потери прежних строк
+     */
+    void largeInsertMergesIntoIndex();
+};
+
+/**
+ * @brief Добавление и удаление временной записи при подключенном фильтре
+ */
+void RecordFilterModelTest::provisionalRowWithFilter()
+{
+    StudentListModel model;
+    model.setRecords({StudentRecord{1, "Иванов Иван Иванович", 5},
+                      StudentRecord{2, "Петрова Анна Сергеевна", 4}});
+
+    RecordFilterModel filter;
+    filter.setRecordSource<StudentRecord>(&model, [](const StudentRecord &record) {
+        return record.fullName;
+    });
+    QTRY_VERIFY(!filter.isIndexing());
+
+    model.insertProvisional(StudentRecord{-1, "Сидоров Пётр Олегович", 3});
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(filter.rowCount(), 3);
+
+    filter.setFilterText("сидоров");
+    QCOMPARE(filter.rowCount(), 1);
+    QCOMPARE(filter.index(0, 0).data(StudentListModel::IdRole).toInt(), -1);
+
+    filter.setFilterText("петр");
+    QCOMPARE(filter.rowCount(), 2);
+
+    QVERIFY(model.removeProvisional(-1));
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(filter.rowCount(), 1);
+    QCOMPARE(filter.index(0, 0).data(StudentListModel::IdRole).toInt(), 2);
+}
+
+/**
+ * @brief Перестройка индекса захватывает временные записи
+ */
+void RecordFilterModelTest::rebuildIncludesProvisional()
+{
+    StudentListModel model;
+    model.setRecords({StudentRecord{1, "Иванов Иван Иванович", 5}});
+    model.insertProvisional(StudentRecord{-1, "Сидоров Пётр Олегович", 3});
+
+    RecordFilterModel filter;
+    filter.setRecordSource<StudentRecord>(&model, [](const StudentRecord &record) {
+        return record.fullName;
+    });
+    QTRY_VERIFY(!filter.isIndexing());
+
+    filter.setFilterText("сидоров");
+    QCOMPARE(filter.rowCount(), 1);
+    QCOMPARE(filter.index(0, 0).data(StudentListModel::IdRole).toInt(), -1);
+}
+
+/**
+ * @brief Крупная вставка вливается в индекс без потери прежних строк
+ */
+void RecordFilterModelTest::largeInsertMergesIntoIndex()
+{
+    StudentListModel model;
+    model.setRecords({StudentRecord{1, "Иванов Иван Иванович", 5}});
+
+    RecordFilterModel filter;
+    filter.setRecordSource<StudentRecord>(&model, [](const StudentRecord &record) {
+        return record.fullName;
+    });
+    QTRY_VERIFY(!filter.isIndexing());
+
+    QList<StudentRecord> batch;
+    const int count = RecordFilterModel::INCREMENTAL_LIMIT + 1;
+    for (int i = 0; i < count; ++i) {
+        batch.append(StudentRecord{i + 2, QString("Студент %1").arg(i), 4});
+    }
+    model.insertRecords(batch);
+    QVERIFY(filter.isIndexing());
+
+    // Строка удаляется, пока ее часть индекса строится в фоне
+    QVERIFY(model.removeRecord(2));
+    QTRY_VERIFY(!filter.isIndexing());
+
+    filter.setFilterText("иванов");
+    QCOMPARE(filter.rowCount(), 1);
+    QCOMPARE(filter.index(0, 0).data(StudentListModel::IdRole).toInt(), 1);
+
+    filter.setFilterText("студент");
+    QCOMPARE(filter.rowCount(), count - 1);
+
+    filter.setFilterText("студент 0");
+    QCOMPARE(filter.rowCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(RecordFilterModelTest)
+
+#include "RecordFilterModelTest.moc"